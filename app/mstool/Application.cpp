@@ -1,6 +1,7 @@
 // Copyright 2012-2015 Jan de Cuveland <cmail@cuveland.de>
 
 #include "Application.hpp"
+#include "Crc32c.hpp"
 #include "FlesnetPatternGenerator.hpp"
 #include "MicrosliceAnalyzer.hpp"
 #include "MicrosliceInputArchive.hpp"
@@ -40,6 +41,9 @@ Application::Application(Parameters const& par) : par_(par) {
 
   // Sink setup
   if (par_.analyze) {
+    if (par_.crc_engine) {
+      set_crc32c_engine(*par_.crc_engine);
+    }
     sinks_.push_back(std::unique_ptr<fles::MicrosliceSink>(
         new MicrosliceAnalyzer(100000, 3, std::cout, "")));
   }
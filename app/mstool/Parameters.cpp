@@ -21,6 +21,7 @@ void Parameters::parse_options(int argc, char* argv[]) {
   unsigned log_level = 2;
   unsigned log_syslog = 2;
   std::string log_file;
+  std::string crc_engine_name;
 
   po::options_description general("General options");
   auto general_add = general.add_options();
@@ -55,6 +56,9 @@ void Parameters::parse_options(int argc, char* argv[]) {
   auto sink_add = sink.add_options();
   sink_add("analyze,a", po::value<bool>(&analyze)->implicit_value(true),
            "enable/disable pattern check");
+  sink_add("crc-engine", po::value<std::string>(&crc_engine_name),
+           "CRC-32C implementation for the pattern check, one of 'software', "
+           "'crc32', 'pclmul', or 'vpclmul' (default: fastest supported)");
   sink_add("dump_verbosity,v", po::value<size_t>(&dump_verbosity),
            "set output debug dump verbosity");
   sink_add("output-archive,o", po::value<std::string>(&output_archive),
@@ -99,4 +103,15 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (input_sources > 1) {
     throw ParametersException("more than one input source specified");
   }
+
+  if (vm.count("crc-engine") != 0u) {
+    crc_engine = crc32c_engine_from_string(crc_engine_name);
+    if (!crc_engine) {
+      throw ParametersException("invalid crc-engine: " + crc_engine_name);
+    }
+    if (!crc32c_engine_supported(*crc_engine)) {
+      throw ParametersException("crc-engine not supported by this CPU: " +
+                                crc_engine_name);
+    }
+  }
 }
@@ -1,7 +1,9 @@
 // Copyright 2012-2015 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "Crc32c.hpp"
 #include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -28,6 +30,7 @@ struct Parameters {
 
   // sink selection
   bool analyze = false;
+  std::optional<Crc32cEngine> crc_engine;
   size_t dump_verbosity = 0;
   std::string output_archive;
 };
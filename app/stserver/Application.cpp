@@ -9,6 +9,15 @@ using namespace std::chrono_literals;
 Application::Application(Parameters const& par,
                          volatile sig_atomic_t* signal_status)
     : m_par(par) {
+  // All threads are created afterwards and inherit the CPU affinity
+  if (m_par.numa_node() >= 0) {
+    if (run_on_numa_node(m_par.numa_node())) {
+      INFO("Running on NUMA node {}", m_par.numa_node());
+    } else {
+      WARN("Cannot run on NUMA node {}", m_par.numa_node());
+    }
+  }
+
   // start up monitoring
   if (!m_par.monitor_uri().empty()) {
     m_monitor = std::make_unique<cbm::Monitor>(m_par.monitor_uri());
@@ -16,7 +25,9 @@ Application::Application(Parameters const& par,
 
   // Create StSender
   m_st_sender = std::make_unique<StSender>(
-      m_par.tsmanager_address(), m_par.listen_port(), m_par.sender_info());
+      m_par.tsmanager_address(), m_par.listen_port(), m_par.sender_info(),
+      m_par.send_workers(), m_par.rails(), m_par.batch_delay(),
+      m_monitor.get());
 
   // Create StBuilder
   m_st_builder = std::make_unique<StBuilder>(
@@ -27,7 +38,7 @@ Application::Application(Parameters const& par,
       m_par.timeslice_duration_ns(), m_par.timeout_ns(),
       m_par.data_buffer_size(), m_par.desc_buffer_size(),
       m_par.overlap_before_ns(), m_par.overlap_after_ns(),
-      m_par.aggregation_buffer_size());
+      m_par.aggregation_buffer_size(), m_par.huge_pages(), m_par.numa_node());
 
   // Register memory region with UCX for RDMA and start sender thread
   m_st_sender->set_memory_region(m_st_builder->get_memory_region());
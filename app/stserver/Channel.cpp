@@ -34,7 +34,8 @@ Channel::Channel(cri::basic_dma_channel* dma_channel,
                  uint64_t overlap_after_ns,
                  std::string name)
     : m_dma_channel(dma_channel), m_overlap_before_ns(overlap_before_ns),
-      m_overlap_after_ns(overlap_after_ns), m_name(std::move(name)) {
+      m_overlap_after_ns(overlap_after_ns), m_name(std::move(name)),
+      m_time_index(desc_buffer.size()) {
 
   // initialize buffer interface
   m_desc_buffer =
@@ -49,19 +50,14 @@ void Channel::ack_before(uint64_t time) {
   // and rely on other call to update it from HW
   uint64_t write_index = m_dma_channel->get_desc_index();
   uint64_t read_index = m_read_index;
-  auto desc_begin = m_desc_buffer->get_iter(read_index);
-  auto desc_end = m_desc_buffer->get_iter(write_index);
+  m_time_index.update(*m_desc_buffer, write_index);
 
   // Find the first element with a time greater than requested time and deduce 1
   // to get the last element with a time <= requested time. We deduce the
   // overlap_before from the requested time to ensure next component can still
   // be built. This has to be the same logic as in find_component!
   time -= m_overlap_before_ns;
-  auto it =
-      std::upper_bound(desc_begin, desc_end, time,
-                       [](uint64_t t, const fles::MicrosliceDescriptor& desc) {
-                         return t < desc.idx;
-                       });
+  uint64_t it = m_time_index.upper_bound(read_index, write_index, time);
 
   // To delete all elements before (aka time less than) the requested
   // time, we set the read index to the found element (the element the read
@@ -71,15 +67,14 @@ void Channel::ack_before(uint64_t time) {
   // time is less than the first element the function returns desc_begin (=
   // read_index). Setting the read index to desc_begin would not harm but we do
   // nothing to reduce strain on the hardware.
-  if (it != desc_begin) {
+  if (it != read_index) {
     it--;
-    set_read_index(it.get_index());
+    set_read_index(it);
   }
 
   TRACE("{}: ack before: searching for time {} in range {} - {}. Setting read "
         "index to {}",
-        m_name, pt(time), desc_begin.get_index(), desc_end.get_index(),
-        it.get_index());
+        m_name, pt(time), read_index, write_index, it);
 
   return;
 }
@@ -89,6 +84,7 @@ Channel::State Channel::check_availability(uint64_t start_time,
 
   uint64_t write_index = m_dma_channel->get_desc_index();
   uint64_t read_index = m_read_index;
+  m_time_index.update(*m_desc_buffer, write_index);
 
   uint64_t first_ms_time = start_time - m_overlap_before_ns;
   uint64_t last_ms_time = start_time + duration + m_overlap_after_ns;
@@ -100,20 +96,20 @@ Channel::State Channel::check_availability(uint64_t start_time,
     TRACE("{}: write and read index are equal, no data available", m_name);
     return Channel::State::TryLater;
   }
-  if (first_ms_time < m_desc_buffer->at(read_index).idx) {
+  if (first_ms_time < m_time_index.time(read_index)) {
     // the first (oldest) microslice in the buffer is younger than the first
     // microslice we want, so we can never provide that component
     TRACE("{}: Failed; begin want= {} have={}, difference={}", m_name,
-          pt(first_ms_time), pt(m_desc_buffer->at(read_index).idx),
-          int64_t(first_ms_time - m_desc_buffer->at(read_index).idx));
+          pt(first_ms_time), pt(m_time_index.time(read_index)),
+          int64_t(first_ms_time - m_time_index.time(read_index)));
     return Channel::State::Failed;
   }
-  if (last_ms_time >= m_desc_buffer->at(write_index - 1).idx) {
+  if (last_ms_time >= m_time_index.time(write_index - 1)) {
     // the last (youngest) microslice in the buffer is older than the last
     // microslice we want, so we can't provide that component yet
     TRACE("{}: TryLater: end want={} have={}, difference={}", m_name,
-          pt(last_ms_time), pt(m_desc_buffer->at(write_index - 1).idx),
-          int64_t(last_ms_time - m_desc_buffer->at(write_index - 1).idx));
+          pt(last_ms_time), pt(m_time_index.time(write_index - 1)),
+          int64_t(last_ms_time - m_time_index.time(write_index - 1)));
     return Channel::State::TryLater;
   }
   return Channel::State::Ok;
@@ -188,48 +184,39 @@ std::pair<uint64_t, uint64_t> Channel::find_component(uint64_t start_time,
                                                       uint64_t duration) {
   uint64_t write_index = m_dma_channel->get_desc_index();
   uint64_t read_index = m_read_index;
+  m_time_index.update(*m_desc_buffer, write_index);
 
   uint64_t first_ms_time = start_time - m_overlap_before_ns;
   uint64_t last_ms_time = start_time + duration + m_overlap_after_ns;
 
-  auto desc_begin = m_desc_buffer->get_iter(read_index);
-  auto desc_end = m_desc_buffer->get_iter(write_index);
-
   // We search for microslice in the range [first_ms_time, last_ms_time)
   // (we use the index from the first search to limit the second search)
 
-  // search for begin iterator, i.e., the microslice before the first microslice
+  // search for begin index, i.e., the microslice before the first microslice
   // > time
-  auto first_it =
-      std::upper_bound(desc_begin, desc_end, first_ms_time,
-                       [](uint64_t t, const fles::MicrosliceDescriptor& desc) {
-                         return t < desc.idx;
-                       });
-  if (first_it == desc_begin || first_it == desc_end) {
+  uint64_t first_idx =
+      m_time_index.upper_bound(read_index, write_index, first_ms_time);
+  if (first_idx == read_index || first_idx == write_index) {
     throw std::out_of_range("Component::find_component: beginning of "
                             "component out of range");
   }
-  first_it--; // we want the first microslice <= time
-  uint64_t first_idx = first_it.get_index();
-
-  // search for the end iterator, i.e., the first microslice >= time
-  auto last_it = std::lower_bound(first_it, desc_end, last_ms_time,
-                                  [](const fles::MicrosliceDescriptor& desc,
-                                     uint64_t t) { return desc.idx < t; });
-  if (last_it == desc_begin || last_it == desc_end) {
+  first_idx--; // we want the first microslice <= time
+
+  // search for the end index, i.e., the first microslice >= time
+  uint64_t last_idx =
+      m_time_index.lower_bound(first_idx, write_index, last_ms_time);
+  if (last_idx == read_index || last_idx == write_index) {
     throw std::out_of_range(
         "Component::find_component: end of component out of range");
   }
-  uint64_t last_idx = last_it.get_index();
 
-  // INFO technically we are not allowed to dereference last_it because its ms
-  // is not guaranteed to be written
   TRACE(
       "{}: find_component: want [{}, {}), have [{}, {}), diff {}, {}, idx [{}, "
       "{}), {} microslices",
-      m_name, pt(first_ms_time), pt(last_ms_time), pt(first_it->idx),
-      pt(last_it->idx), int64_t(first_it->idx - first_ms_time),
-      int64_t(last_it->idx - last_ms_time), first_idx, last_idx,
+      m_name, pt(first_ms_time), pt(last_ms_time),
+      pt(m_time_index.time(first_idx)), pt(m_time_index.time(last_idx)),
+      int64_t(m_time_index.time(first_idx) - first_ms_time),
+      int64_t(m_time_index.time(last_idx) - last_ms_time), first_idx, last_idx,
       last_idx - first_idx);
 
   return {first_idx, last_idx};
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "MicrosliceDescriptor.hpp"
+#include "MicrosliceTimeIndex.hpp"
 #include "RingBufferView.hpp"
 #include "SubTimeslice.hpp"
 #include "dma_channel.hpp"
@@ -54,6 +55,9 @@ private:
       m_desc_buffer;
   std::unique_ptr<RingBufferView<uint8_t, false>> m_data_buffer;
 
+  // shadow copy of the microslice start times for fast searching
+  MicrosliceTimeIndex m_time_index;
+
   uint64_t m_read_index = 0; // hardware value is also initialized to 0
 
   std::pair<uint64_t, uint64_t> find_component(uint64_t start_time,
@@ -94,6 +94,24 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(m_tsmanager_address),
              "address (and optionally port number) of the tsmanager server to "
              "connect to");
+  config_add("send-workers",
+             po::value<uint32_t>(&m_send_workers)
+                 ->default_value(m_send_workers)
+                 ->value_name("<n>"),
+             "number of UCX worker threads sending data to tsbuilders "
+             "(builder connections are distributed across them)");
+  config_add("rail",
+             po::value<std::vector<std::string>>(&m_rails)
+                 ->composing()
+                 ->value_name("<devices>[/<transports>]"),
+             "network devices (and optionally UCX transports) of a rail for "
+             "striped transfers, e.g., \"mlx5_0:1\" or \"lo/tcp\" (may be "
+             "given repeatedly; rail n > 0 listens at listen-port + n)");
+  config_add(
+      "batch-delay",
+      po::value<Nanoseconds>(&m_batch_delay)->default_value(m_batch_delay),
+      "maximum time to hold back announcements to the tsmanager for batching "
+      "at high message rates (with suffix ns, us, ms, s)");
   config_add("pgen-channels,P",
              po::value<uint32_t>(&m_pgen_channels)
                  ->default_value(m_pgen_channels)
@@ -114,7 +132,8 @@ void Parameters::parse_options(int argc, char* argv[]) {
              po::value<uint32_t>(&m_pgen_flags)->default_value(m_pgen_flags),
              "flags for pattern generator channels (0: no flags, "
              "1: generate pattern, 2: randomize sizes, "
-             "3: generate pattern + randomize sizes, ...)");
+             "3: generate pattern + randomize sizes, 4: compute CRC-32C, "
+             "...)");
 
   config_add("timeslice-duration",
              po::value<Nanoseconds>(&m_timeslice_duration)
@@ -148,6 +167,15 @@ void Parameters::parse_options(int argc, char* argv[]) {
              "set to 0 to disable aggregation and use scatter-gather sends "
              "(supports SI units: kB, MB, GB, etc. or binary: KiB, MiB, "
              "GiB, etc.)");
+  config_add("huge-pages",
+             po::value<HugePages>(&m_huge_pages)->default_value(m_huge_pages),
+             "page size for the readout and aggregation buffers: none, "
+             "transparent, 2M, or 1G (the shared memory segment uses "
+             "transparent huge pages instead of explicit ones)");
+  config_add("numa-node",
+             po::value<int>(&m_numa_node)->default_value(m_numa_node),
+             "NUMA node to bind the buffers and to run the threads on "
+             "(-1: no binding)");
 
   po::options_description cmdline_options("Allowed options", terminal_width,
                                           terminal_width / 2);
@@ -220,6 +248,16 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (timeout_ns() <= 0) {
     throw ParametersException("timeout must be greater than 0");
   }
+  if (m_send_workers == 0) {
+    throw ParametersException("number of send workers must be at least 1");
+  }
+  if (m_batch_delay.count() < 0) {
+    throw ParametersException("batch delay must not be negative");
+  }
+  if (m_rails.size() > MAX_RAILS) {
+    throw ParametersException(
+        std::format("number of rails must not exceed {}", MAX_RAILS));
+  }
 
   INFO("Shared memory file: {}", m_shm_id);
   INFO("{}", buffer_info());
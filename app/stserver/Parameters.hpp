@@ -3,13 +3,16 @@
    Authors: Dirk Hutter, Jan de Cuveland */
 #pragma once
 
+#include "MemoryPlacement.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "OptionValues.hpp"
 #include "SubTimeslice.hpp"
 #include "TsbProtocol.hpp"
+#include <chrono>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace option_value_literals;
 
@@ -48,6 +51,11 @@ public:
     return m_tsmanager_address;
   }
   [[nodiscard]] SenderInfo sender_info() const { return m_sender_info; }
+  [[nodiscard]] uint32_t send_workers() const { return m_send_workers; }
+  [[nodiscard]] std::vector<std::string> rails() const { return m_rails; }
+  [[nodiscard]] std::chrono::nanoseconds batch_delay() const {
+    return m_batch_delay;
+  }
 
   // Pattern generator parameters
   [[nodiscard]] uint32_t pgen_channels() const { return m_pgen_channels; }
@@ -82,6 +90,10 @@ public:
     return m_aggregation_buffer_size.value();
   }
 
+  // Memory and thread placement
+  [[nodiscard]] HugePages huge_pages() const { return m_huge_pages; }
+  [[nodiscard]] int numa_node() const { return m_numa_node; }
+
 private:
   void parse_options(int argc, char* argv[]);
   [[nodiscard]] std::string buffer_info() const;
@@ -95,6 +107,9 @@ private:
   std::string m_advertise_host;
   SenderInfo m_sender_info;
   std::string m_tsmanager_address = "login";
+  uint32_t m_send_workers = 1;
+  std::vector<std::string> m_rails;
+  Nanoseconds m_batch_delay = 100_us;
 
   // Pattern generator parameters
   uint32_t m_pgen_channels = 0;
@@ -112,4 +127,8 @@ private:
   Nanoseconds m_overlap_before = 100_us;
   Nanoseconds m_overlap_after = 100_us;
   SizeValue m_aggregation_buffer_size = 10_GiB;
+
+  // Memory and thread placement
+  HugePages m_huge_pages = HugePages::none;
+  int m_numa_node = -1;
 };
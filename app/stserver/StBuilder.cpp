@@ -32,6 +32,28 @@ shm_allocate(boost::interprocess::managed_shared_memory* shm,
   return {static_cast<T*>(buffer_raw), count};
 }
 
+// Apply huge page and NUMA settings to a buffer before it is first used
+void place_memory(void* addr,
+                  std::size_t size,
+                  HugePages huge_pages,
+                  int numa_node,
+                  std::string_view name) {
+  if (huge_pages != HugePages::none) {
+    if (advise_huge_pages(addr, size)) {
+      INFO("Using transparent huge pages for {}", name);
+    } else {
+      WARN("Cannot use transparent huge pages for {}", name);
+    }
+  }
+  if (numa_node >= 0) {
+    if (bind_memory_to_numa_node(addr, size, numa_node)) {
+      INFO("Bound {} to NUMA node {}", name, numa_node);
+    } else {
+      WARN("Cannot bind {} to NUMA node {}", name, numa_node);
+    }
+  }
+}
+
 } // namespace
 
 StBuilder::StBuilder(volatile sig_atomic_t* signal_status,
@@ -51,7 +73,9 @@ StBuilder::StBuilder(volatile sig_atomic_t* signal_status,
                      size_t desc_buffer_size,
                      int64_t overlap_before_ns,
                      int64_t overlap_after_ns,
-                     size_t aggregation_buffer_size)
+                     size_t aggregation_buffer_size,
+                     HugePages huge_pages,
+                     int numa_node)
     : m_signal_status(signal_status), m_shm_id(std::move(shm_id)),
       m_timeslice_duration_ns(timeslice_duration_ns), m_timeout_ns(timeout_ns),
       m_overlap_before_ns(overlap_before_ns),
@@ -118,6 +142,8 @@ StBuilder::StBuilder(volatile sig_atomic_t* signal_status,
        human_readable_count(shm_size, true));
   m_shm = std::make_unique<boost::interprocess::managed_shared_memory>(
       boost::interprocess::create_only, m_shm_id.c_str(), shm_size);
+  place_memory(m_shm->get_address(), m_shm->get_size(), huge_pages, numa_node,
+               "shared memory segment");
 
   // Create Channel objects for each CRI channel
   for (auto* cri_channel : m_cri_channels) {
@@ -143,10 +169,13 @@ StBuilder::StBuilder(volatile sig_atomic_t* signal_status,
   }
 
   if (aggregation_buffer_size > 0) {
-    m_aggregation_buffer.resize(aggregation_buffer_size);
-    m_aggregation_free_chunks.emplace(0, m_aggregation_buffer.size());
-    INFO("Contiguous aggregation buffer: {}",
-         human_readable_count(m_aggregation_buffer.size(), true));
+    m_aggregation_buffer = MappedBuffer(aggregation_buffer_size, huge_pages);
+    place_memory(m_aggregation_buffer.data(), m_aggregation_buffer.size(),
+                 HugePages::none, numa_node, "aggregation buffer");
+    m_aggregation_allocator = RingAllocator(m_aggregation_buffer.size());
+    INFO("Contiguous aggregation buffer: {} (huge pages: {})",
+         human_readable_count(m_aggregation_buffer.size(), true),
+         to_string(huge_pages));
   }
 
   // Create Channel objects for pattern generator channels if requested
@@ -169,81 +198,26 @@ StBuilder::StBuilder(volatile sig_atomic_t* signal_status,
         m_pgen_channels.back().get(), desc_buffer, data_buffer,
         overlap_before_ns, overlap_after_ns, channel_name));
   }
+
+  if (m_monitor != nullptr) {
+    auto& series = m_monitor->RegisterSeries(
+        "stserver_announce", {{"host", m_sender_info.address},
+                              {"port", std::to_string(m_sender_info.port)}});
+    m_announce_count = series.Counter("subtimeslice_count");
+    m_announce_delay =
+        series.Histogram("delay_ns", {1000000, 2000000, 5000000, 10000000,
+                                      20000000, 50000000, 100000000,
+                                      200000000, 500000000, 1000000000});
+  }
 }
 
 std::span<std::byte> StBuilder::get_memory_region() const {
   if (!m_aggregation_buffer.empty()) {
-    return {const_cast<std::byte*>(m_aggregation_buffer.data()),
-            m_aggregation_buffer.size()};
+    return {m_aggregation_buffer.data(), m_aggregation_buffer.size()};
   }
   return {static_cast<std::byte*>(m_shm->get_address()), m_shm->get_size()};
 }
 
-std::optional<StBuilder::AggregationAllocation>
-StBuilder::try_allocate_aggregation_slot(size_t size) {
-  if (size == 0) {
-    return AggregationAllocation{0, 0};
-  }
-
-  // Best-fit: pick the smallest free chunk that still satisfies the request.
-  // Compared to first-fit this keeps large contiguous regions intact for large
-  // subtimeslices, which minimizes external fragmentation for this workload of
-  // mixed-size, roughly-FIFO allocations.
-  auto best = m_aggregation_free_chunks.end();
-  for (auto it = m_aggregation_free_chunks.begin();
-       it != m_aggregation_free_chunks.end(); ++it) {
-    if (it->second < size) {
-      continue;
-    }
-    if (best == m_aggregation_free_chunks.end() || it->second < best->second) {
-      best = it;
-      if (best->second == size) {
-        break; // exact fit, cannot do better
-      }
-    }
-  }
-  if (best == m_aggregation_free_chunks.end()) {
-    return std::nullopt;
-  }
-
-  const size_t offset = best->first;
-  const size_t chunk_size = best->second;
-  m_aggregation_free_chunks.erase(best);
-  if (chunk_size > size) {
-    m_aggregation_free_chunks.emplace(offset + size, chunk_size - size);
-  }
-
-  return AggregationAllocation{offset, size};
-}
-
-void StBuilder::release_aggregation_slot(
-    const AggregationAllocation& allocation) {
-  if (allocation.size == 0) {
-    return;
-  }
-
-  size_t offset = allocation.offset;
-  size_t size = allocation.size;
-
-  auto it = m_aggregation_free_chunks.lower_bound(offset);
-
-  if (it != m_aggregation_free_chunks.begin()) {
-    auto prev = std::prev(it);
-    if (prev->first + prev->second == offset) {
-      offset = prev->first;
-      size += prev->second;
-      m_aggregation_free_chunks.erase(prev);
-    }
-  }
-
-  if (it != m_aggregation_free_chunks.end() && offset + size == it->first) {
-    size += it->second;
-    m_aggregation_free_chunks.erase(it);
-  }
-
-  m_aggregation_free_chunks.emplace(offset, size);
-}
-
 void StBuilder::run() {
   for (auto&& channel : m_channels) {
     // ack far in the future to clear all elements
@@ -325,10 +299,10 @@ void StBuilder::handle_completions() {
       // provide_subtimeslice, right after the microslice data was copied into
       // the aggregation buffer. A completion here only signals that the
       // network transfer is done, so the sole resource to free is the
-      // aggregation buffer slot. Slots are independent, so this is handled
-      // per subtimeslice and is insensitive to completion order.
-      // (release_aggregation_slot is a no-op for a zero-size allocation.)
-      release_aggregation_slot(it->second.allocation);
+      // aggregation buffer slot. Slots may be released in any order; their
+      // space is reused once all older slots have been released as well.
+      // (Releasing a zero-size allocation is a no-op.)
+      m_aggregation_allocator.release(it->second.allocation);
       m_subtimeslices.erase(it);
     } else {
       // Non-aggregation mode: the microslice data still lives in the readout
@@ -380,7 +354,7 @@ void StBuilder::provide_subtimeslice(std::vector<Channel::State> const& states,
   uint64_t ts_id = start_time / duration;
 
   // Aggregation buffer slot held for this subtimeslice (size 0 = none).
-  AggregationAllocation slot;
+  RingAllocator::Allocation slot;
 
   if (!m_aggregation_buffer.empty()) {
     // Optional double buffering: copy the scattered microslice data out of the
@@ -396,7 +370,7 @@ void StBuilder::provide_subtimeslice(std::vector<Channel::State> const& states,
         });
 
     if (payload_size > 0) {
-      if (auto allocation = try_allocate_aggregation_slot(payload_size)) {
+      if (auto allocation = m_aggregation_allocator.allocate(payload_size)) {
         std::byte* base = m_aggregation_buffer.data() + allocation->offset;
         size_t write_offset = 0;
         for (auto& component : st.components) {
@@ -415,7 +389,6 @@ void StBuilder::provide_subtimeslice(std::vector<Channel::State> const& states,
       } else {
         // Aggregation buffer full: drop the payload for this subtimeslice
         // rather than stalling readout.
-        ++m_aggregation_allocation_failures;
         st.set_flag(TsFlag::MissingComponents);
         st.components.clear();
       }
@@ -428,11 +401,24 @@ void StBuilder::provide_subtimeslice(std::vector<Channel::State> const& states,
     }
   }
 
-  // Announce the subtimeslice
-  m_st_sender.announce_subtimeslice(ts_id, st);
+  // Announce the subtimeslice. If the sender's queue is full, handle
+  // completions while waiting, as the sender may be waiting for us to receive
+  // them. The subtimeslice is registered first, so that the ring buffers are
+  // not released beyond it in the meantime.
   m_subtimeslices[ts_id] = SubtimesliceState{false, slot};
+  while (!m_st_sender.try_announce_subtimeslice(ts_id, st)) {
+    if (m_st_sender.has_stopped()) {
+      return;
+    }
+    handle_completions();
+    std::this_thread::yield();
+  }
 
   // Update statistics
+  const auto now_ns = static_cast<uint64_t>(fles::system::current_time_ns());
+  m_announce_count.Add();
+  m_announce_delay.Record(
+      now_ns > start_time + duration ? now_ns - (start_time + duration) : 0);
   ++m_timeslice_count;
   m_component_count += st.components.size();
   for (const auto& comp : st.components) {
@@ -446,7 +432,7 @@ void StBuilder::provide_subtimeslice(std::vector<Channel::State> const& states,
 
 void StBuilder::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
 
   float max_buffer_utilization = 0.0;
 
@@ -479,6 +465,8 @@ void StBuilder::report_status() {
     }
   }
 
+  auto aggregation = m_aggregation_allocator.statistics();
+
   if (m_monitor != nullptr) {
     m_monitor->QueueMetric(
         "stserver_status",
@@ -489,14 +477,30 @@ void StBuilder::report_status() {
          {"microslice_count", m_microslice_count},
          {"data_bytes", m_data_bytes},
          {"timeslice_incomplete_count", m_timeslice_incomplete_count},
-         {"aggregation_allocation_failures", m_aggregation_allocation_failures},
+         {"aggregation_allocation_failures", aggregation.failure_count},
          {"buffer_utilization", max_buffer_utilization}});
+    if (!m_aggregation_buffer.empty()) {
+      m_monitor->QueueMetric(
+          "stserver_aggregation_status",
+          {{"host", m_sender_info.address},
+           {"port", std::to_string(m_sender_info.port)}},
+          {{"allocation_count", aggregation.allocation_count},
+           {"failure_count", aggregation.failure_count},
+           {"fragmentation_failure_count",
+            aggregation.fragmentation_failure_count},
+           {"used_bytes", aggregation.used_bytes},
+           {"live_bytes", aggregation.live_bytes},
+           {"blocked_bytes", aggregation.blocked_bytes},
+           {"padding_bytes", aggregation.padding_bytes},
+           {"fragmentation", m_aggregation_allocator.fragmentation()}});
+    }
   }
 
-  if (m_aggregation_allocation_failures > m_reported_aggregation_failures) {
-    WARN("Aggregation buffer full: dropped {} subtimeslice(s) so far",
-         m_aggregation_allocation_failures);
-    m_reported_aggregation_failures = m_aggregation_allocation_failures;
+  if (aggregation.failure_count > m_reported_aggregation_failures) {
+    WARN("Aggregation buffer full: dropped {} subtimeslice(s) so far ({} due "
+         "to fragmentation)",
+         aggregation.failure_count, aggregation.fragmentation_failure_count);
+    m_reported_aggregation_failures = aggregation.failure_count;
   }
 
   if (max_buffer_utilization > 0.9) {
@@ -507,9 +511,23 @@ void StBuilder::report_status() {
     WARN("High buffer utilization ({:.1f}%), retracting {} pending "
          "subtimeslices",
          max_buffer_utilization * 100.0, pending_count);
-    for (auto& [ts_id, state] : m_subtimeslices) {
+    std::vector<uint64_t> pending_ids;
+    for (const auto& [ts_id, state] : m_subtimeslices) {
       if (!state.completed) {
-        m_st_sender.retract_subtimeslice(ts_id);
+        pending_ids.push_back(ts_id);
+      }
+    }
+    for (auto ts_id : pending_ids) {
+      while (!m_st_sender.try_retract_subtimeslice(ts_id)) {
+        if (m_st_sender.has_stopped()) {
+          break;
+        }
+        handle_completions();
+        std::this_thread::yield();
+        auto it = m_subtimeslices.find(ts_id);
+        if (it == m_subtimeslices.end() || it->second.completed) {
+          break; // completed in the meantime
+        }
       }
     }
     // TODO: Find a better solution
@@ -4,8 +4,10 @@
 #pragma once
 
 #include "Channel.hpp"
+#include "MemoryPlacement.hpp"
 #include "Monitor.hpp"
 #include "Parameters.hpp"
+#include "RingAllocator.hpp"
 #include "Scheduler.hpp"
 #include "StSender.hpp"
 #include "SubTimeslice.hpp"
@@ -41,7 +43,9 @@ public:
             size_t desc_buffer_size,
             int64_t overlap_before_ns,
             int64_t overlap_after_ns,
-            size_t aggregation_buffer_size);
+            size_t aggregation_buffer_size,
+            HugePages huge_pages,
+            int numa_node);
 
   StBuilder(const StBuilder&) = delete;
   void operator=(const StBuilder&) = delete;
@@ -53,27 +57,19 @@ public:
   [[nodiscard]] std::span<std::byte> get_memory_region() const;
 
 private:
-  struct AggregationAllocation {
-    size_t offset = 0;
-    size_t size = 0;
-  };
-
   // Per-subtimeslice bookkeeping for the window between announcing a
   // subtimeslice and the builder confirming it. `completed` tracks the
   // confirmation; `allocation` holds the aggregation buffer slot to free on
   // confirmation (size 0 if no slot is held, e.g. in non-aggregation mode).
   struct SubtimesliceState {
     bool completed = false;
-    AggregationAllocation allocation;
+    RingAllocator::Allocation allocation;
   };
 
   void handle_completions();
   void provide_subtimeslice(std::vector<Channel::State> const& states,
                             uint64_t start_time,
                             uint64_t duration);
-  [[nodiscard]] std::optional<AggregationAllocation>
-  try_allocate_aggregation_slot(size_t size);
-  void release_aggregation_slot(const AggregationAllocation& allocation);
 
   volatile std::sig_atomic_t* m_signal_status;
   std::string m_shm_id;
@@ -90,9 +86,9 @@ private:
   std::unique_ptr<boost::interprocess::managed_shared_memory> m_shm;
   std::vector<std::unique_ptr<Channel>> m_channels;
 
-  std::vector<std::byte> m_aggregation_buffer;
-  std::map<size_t, size_t> m_aggregation_free_chunks;
-  size_t m_aggregation_allocation_failures = 0;
+  MappedBuffer m_aggregation_buffer;
+  // Subtimeslices are allocated in order and mostly released in order
+  RingAllocator m_aggregation_allocator{0};
   size_t m_reported_aggregation_failures = 0;
 
   std::map<uint64_t, SubtimesliceState> m_subtimeslices;
@@ -102,6 +98,10 @@ private:
   size_t m_microslice_count = 0; ///< total number of processed microslices
   size_t m_data_bytes = 0;       ///< total number of processed content bytes
   size_t m_timeslice_incomplete_count = 0; ///< number of incomplete timeslices
+  /// Announced subtimeslices and time from their end to the announcement,
+  /// updated per subtimeslice and reported by the monitor
+  cbm::MetricCounter m_announce_count;
+  cbm::MetricHistogram m_announce_delay;
 
   void report_status();
 
@@ -9,10 +9,13 @@
 #include "Utility.hpp"
 #include "log.hpp"
 #include "monitoring/SystemInfo.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <latch>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <optional>
@@ -62,14 +65,58 @@ void append_component_blocks(std::vector<std::vector<ucp_dt_iov>>& blocks,
   }
 }
 
+// Extract the part [offset, offset + size) of a scatter-gather list into
+// `result`, replacing its previous contents
+void slice_iov(const std::vector<ucp_dt_iov>& block,
+               uint64_t offset,
+               uint64_t size,
+               std::vector<ucp_dt_iov>& result) {
+  result.clear();
+  for (const auto& iov : block) {
+    if (size == 0) {
+      break;
+    }
+    if (offset >= iov.length) {
+      offset -= iov.length;
+      continue;
+    }
+    const uint64_t length = std::min<uint64_t>(iov.length - offset, size);
+    result.push_back({static_cast<std::byte*>(iov.buffer) + offset, length});
+    offset = 0;
+    size -= length;
+  }
+}
+
 } // namespace
 
 StSender::StSender(std::string_view manager_address,
                    uint16_t listen_port,
-                   SenderInfo sender_info)
+                   SenderInfo sender_info,
+                   std::size_t num_workers,
+                   std::vector<std::string> rails,
+                   std::chrono::nanoseconds batch_delay,
+                   cbm::Monitor* monitor)
     : m_manager_address(manager_address), m_listen_port(listen_port),
-      m_sender_info(std::move(sender_info)),
-      m_sender_info_bytes(to_bytes(m_sender_info)) {
+      m_rails(std::move(rails)), m_sender_info(std::move(sender_info)),
+      m_sender_info_bytes(to_bytes(m_sender_info)), m_monitor(monitor),
+      m_announce_batching(batch_delay, MAX_BATCH_SIZE),
+      m_num_workers(num_workers) {
+  if (num_workers == 0) {
+    throw std::invalid_argument("number of send workers must be at least 1");
+  }
+  if (m_rails.size() > MAX_RAILS) {
+    throw std::invalid_argument("too many rails");
+  }
+  for (std::size_t i = 0; i < num_workers; ++i) {
+    m_send_workers.push_back(
+        std::make_unique<SendWorker>(this, i, m_queue_capacity));
+  }
+  for (std::size_t rail = 1; rail < m_rails.size(); ++rail) {
+    m_send_workers.push_back(std::make_unique<SendWorker>(
+        this, m_send_workers.size(), m_queue_capacity));
+    m_send_workers.back()->rail = rail;
+  }
+
   // Initialize event handling
   m_queue_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
   if (m_queue_event_fd == -1) {
@@ -114,47 +161,58 @@ void StSender::start() {
 }
 
 void StSender::stop() {
+  m_stopping = true;
   if (m_worker_thread.joinable()) {
     m_worker_thread.request_stop();
     m_worker_thread.join();
   }
 }
 
-void StSender::announce_subtimeslice(TsId id, const StHandle& st) {
-  {
-    std::lock_guard<std::mutex> lock(m_queue_mutex);
-    m_pending_announcements.emplace_back(id, st);
+bool StSender::try_announce_subtimeslice(TsId id, const StHandle& st) {
+  SenderCommand* cmd = m_commands.back();
+  if (cmd == nullptr) {
+    m_command_stats.full_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
   }
+  cmd->type = SenderCommand::Type::Announce;
+  cmd->id = id;
+  cmd->sth = st; // reuses the memory of the slot
+  cmd->enqueue_time = std::chrono::steady_clock::now();
+  m_commands.push();
   notify_queue_update();
+  return true;
 }
 
-void StSender::retract_subtimeslice(TsId id) {
-  {
-    std::lock_guard<std::mutex> lock(m_queue_mutex);
-    auto it = std::find_if(m_pending_announcements.begin(),
-                           m_pending_announcements.end(),
-                           [id](const auto& item) { return item.first == id; });
-    if (it != m_pending_announcements.end()) {
-      {
-        std::lock_guard<std::mutex> lock(m_completions_mutex);
-        m_completed.push(id);
-      }
-      m_pending_announcements.erase(it);
-      return;
-    }
-    m_pending_retractions.emplace_back(id);
+bool StSender::try_retract_subtimeslice(TsId id) {
+  SenderCommand* cmd = m_commands.back();
+  if (cmd == nullptr) {
+    m_command_stats.full_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
   }
+  cmd->type = SenderCommand::Type::Retract;
+  cmd->id = id;
+  cmd->enqueue_time = std::chrono::steady_clock::now();
+  m_commands.push();
   notify_queue_update();
+  return true;
 }
 
 std::optional<TsId> StSender::try_receive_completion() {
-  std::lock_guard<std::mutex> lock(m_completions_mutex);
-  if (m_completed.empty()) {
-    return std::nullopt;
+  // Check the queues of all send workers, starting with a different one each
+  // time so that none of them is starved
+  const std::size_t num_queues = m_send_workers.size();
+  for (std::size_t i = 0; i < num_queues; ++i) {
+    const std::size_t q = (m_next_completion_queue + i) % num_queues;
+    auto& completions = m_send_workers[q]->completions;
+    if (SenderCompletion* c = completions.front()) {
+      TsId id = c->id;
+      m_completion_stats.record(c->enqueue_time);
+      completions.pop();
+      m_next_completion_queue = (q + 1) % num_queues;
+      return id;
+    }
   }
-  TsId id = m_completed.front();
-  m_completed.pop();
-  return id;
+  return std::nullopt;
 }
 
 // Main operation loop
@@ -162,10 +220,17 @@ std::optional<TsId> StSender::try_receive_completion() {
 void StSender::operator()(std::stop_token stop_token) {
   cbm::system::set_thread_name("StSender");
 
-  if (!ucx::util::init(m_context, m_worker, m_epoll_fd, m_ucx_loop_mode)) {
+  const bool shared_context = m_num_workers > 1;
+  const std::string_view rail0 =
+      m_rails.empty() ? std::string_view() : m_rails.front();
+  if (!ucx::util::init(m_context, m_worker, m_epoll_fd, m_ucx_loop_mode,
+                       shared_context, rail0)) {
     ERROR("Failed to initialize UCX");
     return;
   }
+  SendWorker& w0 = *m_send_workers.front();
+  w0.worker = m_worker;
+  w0.epoll_fd = m_epoll_fd;
   if (!m_memory_region.empty()) {
     if (auto memh = ucx::util::register_memory(m_context, m_memory_region)) {
       m_buffer_memh = *memh;
@@ -173,15 +238,21 @@ void StSender::operator()(std::stop_token stop_token) {
   }
   if (!ucx::util::set_receive_handler(m_worker, AM_MANAGER_RELEASE_ST,
                                       on_manager_release, this) ||
+      !ucx::util::set_receive_handler(m_worker, AM_MANAGER_RELEASE_ST_BATCH,
+                                      on_manager_release_batch, this) ||
       !ucx::util::set_receive_handler(m_worker, AM_BUILDER_REQUEST_ST,
-                                      on_builder_request, this)) {
+                                      on_builder_request, &w0)) {
     ERROR("Failed to register receive handlers");
     return;
   }
+  w0.is_ready = true;
+  start_send_workers();
   connect_to_manager_if_needed();
+  report_status();
   if (!ucx::util::create_listener(m_worker, m_listener, m_listen_port,
                                   on_new_connection, this)) {
     ERROR("Failed to create UCX listener at port {}", m_listen_port);
+    stop_send_workers();
     return;
   }
 
@@ -192,10 +263,18 @@ void StSender::operator()(std::stop_token stop_token) {
     if (process_queues() > 0) {
       continue;
     }
+    // Announcements queued in a burst of commands are sent together
+    if (m_announce_batching.due(Scheduler::clock::now())) {
+      flush_announcements();
+    }
     m_tasks.timer();
 
-    if (!ucx::util::arm_worker_and_wait(m_worker, m_epoll_fd,
-                                        ucx::util::EPOLL_TIMEOUT_MS,
+    auto timer_wait_ms = std::chrono::ceil<std::chrono::milliseconds>(
+                             m_tasks.when_next() - Scheduler::clock::now())
+                             .count();
+    int timeout_ms = static_cast<int>(std::clamp<int64_t>(
+        timer_wait_ms, 0, ucx::util::EPOLL_TIMEOUT_MS));
+    if (!ucx::util::arm_worker_and_wait(m_worker, m_epoll_fd, timeout_ms,
                                         m_ucx_loop_mode)) {
       break;
     }
@@ -206,7 +285,8 @@ void StSender::operator()(std::stop_token stop_token) {
     m_listener = nullptr;
   }
   disconnect_from_manager();
-  disconnect_from_builders();
+  stop_send_workers();
+  disconnect_from_builders(w0);
   // Drain remaining UCX internal operations (e.g., rendezvous protocol
   // buffers) before destroying the worker
   while (ucp_worker_progress(m_worker) != 0) {
@@ -215,14 +295,167 @@ void StSender::operator()(std::stop_token stop_token) {
     ucx::util::unregister_memory(m_context, m_buffer_memh);
     m_buffer_memh = nullptr;
   }
+  w0.worker = nullptr;
   ucx::util::cleanup(m_context, m_worker);
   flush_announced();
 }
 
+// Send worker management
+
+void StSender::start_send_workers() {
+  if (m_send_workers.size() <= 1) {
+    return;
+  }
+
+  // Wait for all workers to be initialized (or to have failed), so that no
+  // connection is assigned to a worker that is not ready
+  std::latch initialized(static_cast<std::ptrdiff_t>(m_send_workers.size()) -
+                         1);
+  for (std::size_t i = 1; i < m_send_workers.size(); ++i) {
+    SendWorker& w = *m_send_workers[i];
+    w.thread = std::jthread([this, &w, &initialized](std::stop_token st) {
+      cbm::system::set_thread_name("StSender/" + std::to_string(w.index));
+      bool ok = init_send_worker(w);
+      initialized.count_down();
+      if (ok) {
+        run_send_worker(w, st);
+      }
+      for (int* fd : {&w.epoll_fd, &w.queue_event_fd}) {
+        if (*fd != -1) {
+          close(*fd);
+          *fd = -1;
+        }
+      }
+    });
+  }
+  initialized.wait();
+
+  std::size_t ready =
+      std::count_if(m_send_workers.begin(), m_send_workers.end(),
+                    [](const auto& w) { return w->is_ready.load(); });
+  INFO("Using {} of {} send workers", ready, m_send_workers.size());
+}
+
+void StSender::stop_send_workers() {
+  for (std::size_t i = 1; i < m_send_workers.size(); ++i) {
+    SendWorker& w = *m_send_workers[i];
+    if (w.thread.joinable()) {
+      w.thread.request_stop();
+      w.thread.join();
+    }
+  }
+}
+
+bool StSender::init_send_worker(SendWorker& w) {
+  w.queue_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  w.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (w.queue_event_fd == -1 || w.epoll_fd == -1) {
+    ERROR("Send worker {}: failed to create event handling", w.index);
+    return false;
+  }
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLET; // Edge-triggered
+  ev.data.fd = w.queue_event_fd;
+  if (epoll_ctl(w.epoll_fd, EPOLL_CTL_ADD, w.queue_event_fd, &ev) == -1) {
+    ERROR("Send worker {}: epoll_ctl failed for connection queue", w.index);
+    return false;
+  }
+
+  // Additional rails use a context of their own, restricted to the devices
+  // of the rail
+  if (w.rail > 0 && !ucx::util::create_context(w.context, m_ucx_loop_mode,
+                                               false, m_rails[w.rail])) {
+    ERROR("Send worker {}: failed to create UCX context for rail {} ('{}')",
+          w.index, w.rail, m_rails[w.rail]);
+    return false;
+  }
+  ucp_context_h context = w.rail > 0 ? w.context : m_context;
+  if (!ucx::util::create_worker(context, w.worker, w.epoll_fd,
+                                m_ucx_loop_mode)) {
+    ERROR("Send worker {}: failed to create UCX worker", w.index);
+    ucx::util::cleanup(w.context, w.worker);
+    return false;
+  }
+  if (!ucx::util::set_receive_handler(w.worker, AM_BUILDER_REQUEST_ST,
+                                      on_builder_request, &w)) {
+    ERROR("Send worker {}: failed to register receive handler", w.index);
+    ucx::util::cleanup(w.context, w.worker);
+    return false;
+  }
+
+  if (w.rail > 0) {
+    if (!m_memory_region.empty()) {
+      if (auto memh = ucx::util::register_memory(w.context, m_memory_region)) {
+        w.memh = *memh;
+      }
+    }
+    const auto port = static_cast<uint16_t>(m_listen_port + w.rail);
+    if (!ucx::util::create_listener(w.worker, w.listener, port,
+                                    on_new_rail_connection, &w)) {
+      ERROR("Failed to create UCX listener for rail {} at port {}", w.rail,
+            port);
+      if (w.memh != nullptr) {
+        ucx::util::unregister_memory(w.context, w.memh);
+        w.memh = nullptr;
+      }
+      ucx::util::cleanup(w.context, w.worker);
+      return false;
+    }
+    INFO("Listening for rail {} ('{}') at port {}", w.rail, m_rails[w.rail],
+         port);
+  }
+
+  w.is_ready = true;
+  return true;
+}
+
+void StSender::run_send_worker(SendWorker& w, std::stop_token stop_token) {
+  while (!stop_token.stop_requested()) {
+    if (ucp_worker_progress(w.worker) != 0) {
+      continue;
+    }
+    if (process_pending_connections(w) > 0) {
+      continue;
+    }
+    if (!ucx::util::arm_worker_and_wait(w.worker, w.epoll_fd,
+                                        ucx::util::EPOLL_TIMEOUT_MS,
+                                        m_ucx_loop_mode)) {
+      break;
+    }
+  }
+
+  w.is_ready = false;
+  if (w.listener != nullptr) {
+    ucp_listener_destroy(w.listener);
+    w.listener = nullptr;
+  }
+  disconnect_from_builders(w);
+  while (ucp_worker_progress(w.worker) != 0) {
+  }
+  if (w.memh != nullptr) {
+    ucx::util::unregister_memory(w.context, w.memh);
+    w.memh = nullptr;
+  }
+  // Destroys the rail's own context, if any
+  ucx::util::cleanup(w.context, w.worker);
+}
+
+std::size_t StSender::process_pending_connections(SendWorker& w) {
+  std::deque<std::pair<ucp_conn_request_h, std::string>> connections;
+  {
+    std::lock_guard<std::mutex> lock(w.connections_mutex);
+    connections.swap(w.pending_connections);
+  }
+  for (const auto& [conn_request, client_address] : connections) {
+    accept_connection(w, conn_request, client_address);
+  }
+  return connections.size();
+}
+
 // Manager connection management
 
 void StSender::connect_to_manager_if_needed() {
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
   if (!m_manager_connecting && !m_manager_connected &&
       !m_worker_thread.get_stop_token().stop_requested()) {
     connect_to_manager();
@@ -329,24 +562,32 @@ void StSender::disconnect_from_manager(bool force) {
 
   ucx::util::close_endpoint(m_worker, m_manager_ep, force);
   m_manager_ep = nullptr;
+  m_announce_batch.clear();
+  m_announce_batching.sent();
 
   // Flush all announced subtimeslices
-  auto it = m_announced.begin();
-  while (it != m_announced.end()) {
-    const auto& [id, ah] = *it;
-    if (ah->active_send_requests > 0) {
-      DEBUG("{}| Marking for release (currently sending)", id);
-      ah->pending_release = true;
-      ++it;
-    } else {
-      DEBUG("{}| Releasing", id);
-      {
-        std::lock_guard<std::mutex> lock(m_completions_mutex);
-        m_completed.push(id);
+  std::vector<TsId> released;
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    auto it = m_announced.begin();
+    while (it != m_announced.end()) {
+      const auto& [id, ah] = *it;
+      if (ah->active_send_requests > 0) {
+        DEBUG("{}| Marking for release (currently sending)", id);
+        ah->pending_release = true;
+        ++it;
+      } else {
+        DEBUG("{}| Releasing", id);
+        released.push_back(id);
+        it = m_announced.erase(it);
       }
-      it = m_announced.erase(it);
     }
   }
+  // Queue the completions without holding the lock (may wait for the
+  // StBuilder to make room)
+  for (const TsId id : released) {
+    complete(id);
+  }
 }
 
 // Manager message handling
@@ -375,11 +616,6 @@ void StSender::do_announce_subtimeslice(TsId id, const StHandle& sth) {
     num_microslices += c.num_microslices;
   }
 
-  // Serialize subtimeslice structure for transmission to the manager. The
-  // builder no longer receives this descriptor directly; the manager relays
-  // the (merged) descriptor as part of the assignment.
-  auto st_descriptor_bytes = serialize_descriptor(st_descriptor);
-
   // Assemble the scatter-gather lists of the transfer blocks (two per
   // component) pointing at the (registered) microslice data. Each block is
   // later sent as one tagged message into a receive the builder pre-posts
@@ -394,32 +630,54 @@ void StSender::do_announce_subtimeslice(TsId id, const StHandle& sth) {
     blocks.emplace_back();
   }
 
-  // Store for future use (and retention during send)
-  m_announced.emplace(
-      id, std::make_unique<AnnouncementHandle>(
-              id, std::move(st_descriptor_bytes), std::move(blocks)));
-  auto& ah = *m_announced.at(id);
+  // Store for future use (and retention during send). The send workers
+  // access the handle only through the map.
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    m_announced.emplace(
+        id, std::make_unique<AnnouncementHandle>(id, std::move(blocks)));
+  }
 
   DEBUG("{}| Announcing ({}c, {}m, {}, flags={:04x})", id,
         st_descriptor.components.size(), num_microslices,
         human_readable_count(ms_data_size, true), st_descriptor.flags);
 
-  // Send announcement to manager
-  std::array<uint64_t, 2> hdr{id, ms_data_size};
-  auto header = std::as_bytes(std::span(hdr));
-  auto buffer = std::as_bytes(std::span(ah.st_descriptor_bytes));
-  ucx::util::send_active_message(
-      m_manager_ep, AM_SENDER_ANNOUNCE_ST, header, buffer,
-      ucx::util::on_generic_send_complete, this,
-      UCP_AM_SEND_FLAG_COPY_HEADER | UCP_AM_SEND_FLAG_REPLY);
+  // Queue the announcement to the manager. The builder does not receive
+  // this descriptor directly; the manager relays the (merged) descriptor as
+  // part of the assignment.
+  const bool first = m_announce_batching.pending() == 0;
+  append_announcement(m_announce_batch, id, ms_data_size, st_descriptor);
+  m_announcement_count++;
+  m_announce_batching.add(Scheduler::clock::now());
+  if (m_announce_batching.full()) {
+    flush_announcements();
+  } else if (first && m_announce_batching.max_delay().count() > 0) {
+    m_tasks.add(
+        [this] {
+          if (m_announce_batching.due(Scheduler::clock::now())) {
+            flush_announcements();
+          }
+        },
+        m_announce_batching.deadline());
+  }
 }
 
 void StSender::do_retract_subtimeslice(TsId id) {
+  if (retract_announced(id)) {
+    complete(id);
+  }
+}
+
+// Returns true if the subtimeslice has been released and is to be completed
+bool StSender::retract_announced(TsId id) {
+  std::lock_guard<std::mutex> lock(m_announced_mutex);
   auto it = m_announced.find(id);
   if (it != m_announced.end()) {
     auto& ah = *it->second;
     if (!ah.pending_release) {
       DEBUG("{}| Retracting subtimeslice", id);
+      // Keep the order of announcement and retraction
+      flush_announcements();
 
       // Send retraction to manager
       std::array<uint64_t, 1> hdr{id};
@@ -433,11 +691,8 @@ void StSender::do_retract_subtimeslice(TsId id) {
         DEBUG("{}| Marking for release (currently sending)", id);
         ah.pending_release = true;
       } else {
-        {
-          std::lock_guard<std::mutex> lock(m_completions_mutex);
-          m_completed.push(id);
-        }
         m_announced.erase(it);
+        return true;
       }
     } else {
       WARN("{}| Attempted to retract subtimeslice already marked for release",
@@ -446,6 +701,50 @@ void StSender::do_retract_subtimeslice(TsId id) {
   } else {
     WARN("{}| Attempted to retract unknown subtimeslice", id);
   }
+  return false;
+}
+
+void StSender::flush_announcements() {
+  const std::size_t count = m_announce_batching.pending();
+  if (count == 0) {
+    return;
+  }
+  m_announce_batching.sent();
+  m_announce_message_count++;
+
+  // The buffer is kept until the send completes
+  auto buffer =
+      std::make_unique<std::vector<std::byte>>(std::move(m_announce_batch));
+  m_announce_batch.clear();
+  auto* raw_ptr = buffer.release();
+  auto on_complete = [](void* request, ucs_status_t status, void* user_data) {
+    auto buffer = std::unique_ptr<std::vector<std::byte>>(
+        static_cast<std::vector<std::byte>*>(user_data));
+    ucx::util::on_generic_send_complete(request, status, user_data);
+  };
+
+  bool sent = false;
+  if (count == 1) {
+    // A single announcement is sent as the unbatched message
+    wire::StAnnouncementHeader h{};
+    std::memcpy(&h, raw_ptr->data(), sizeof(h));
+    std::array<uint64_t, 2> hdr{h.id, h.ms_data_size};
+    auto header = std::as_bytes(std::span(hdr));
+    auto descriptor = std::span(*raw_ptr).subspan(sizeof(h));
+    sent = ucx::util::send_active_message(
+        m_manager_ep, AM_SENDER_ANNOUNCE_ST, header, descriptor, on_complete,
+        raw_ptr, UCP_AM_SEND_FLAG_COPY_HEADER | UCP_AM_SEND_FLAG_REPLY);
+  } else {
+    std::array<uint64_t, 1> hdr{count};
+    auto header = std::as_bytes(std::span(hdr));
+    sent = ucx::util::send_active_message(
+        m_manager_ep, AM_SENDER_ANNOUNCE_ST_BATCH, header, *raw_ptr,
+        on_complete, raw_ptr,
+        UCP_AM_SEND_FLAG_COPY_HEADER | UCP_AM_SEND_FLAG_REPLY);
+  }
+  if (!sent) {
+    delete raw_ptr;
+  }
 }
 
 ucs_status_t StSender::handle_manager_release(
@@ -460,6 +759,59 @@ ucs_status_t StSender::handle_manager_release(
   }
 
   TsId id = *static_cast<const uint64_t*>(header);
+  m_release_message_count++;
+  bool released = false;
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    released = release_announced(id);
+  }
+  if (released) {
+    complete(id);
+  }
+  return UCS_OK;
+}
+
+ucs_status_t StSender::handle_manager_release_batch(
+    const void* header,
+    size_t header_length,
+    void* data,
+    size_t length,
+    [[maybe_unused]] const ucp_am_recv_param_t* param) {
+  if (header_length != sizeof(uint64_t)) {
+    ERROR("Invalid manager request received");
+    return UCS_OK;
+  }
+  const uint64_t count = *static_cast<const uint64_t*>(header);
+  if (count == 0 || count > MAX_BATCH_SIZE ||
+      length != count * sizeof(uint64_t)) {
+    ERROR("Invalid manager request received");
+    return UCS_OK;
+  }
+
+  // The data is not necessarily aligned
+  std::array<TsId, MAX_BATCH_SIZE> ids{};
+  std::memcpy(ids.data(), data, length);
+  m_release_message_count++;
+  // Keep the released ids at the front of the array
+  std::size_t released = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    for (const TsId id : std::span(ids).first(count)) {
+      if (release_announced(id)) {
+        ids[released++] = id;
+      }
+    }
+  }
+  for (const TsId id : std::span(ids).first(released)) {
+    complete(id);
+  }
+  return UCS_OK;
+}
+
+// Requires m_announced_mutex to be held. Returns true if the subtimeslice
+// has been released and is to be completed (after releasing the lock).
+bool StSender::release_announced(TsId id) {
+  m_release_count++;
   auto it = m_announced.find(id);
   if (it != m_announced.end()) {
     auto& ah = *it->second;
@@ -468,16 +820,13 @@ ucs_status_t StSender::handle_manager_release(
       ah.pending_release = true;
     } else {
       DEBUG("{}| Releasing", id);
-      {
-        std::lock_guard<std::mutex> lock(m_completions_mutex);
-        m_completed.push(id);
-      }
       m_announced.erase(it);
+      return true;
     }
   } else {
     WARN("{}| Received release for unknown subtimeslice", id);
   }
-  return UCS_OK;
+  return false;
 }
 
 // Builder connection management
@@ -492,21 +841,60 @@ void StSender::handle_new_connection(ucp_conn_request_h conn_request) {
     return;
   }
 
-  auto ep = ucx::util::accept(m_worker, conn_request, on_endpoint_error, this);
+  // Assign the connection to the next ready send worker of rail 0
+  // (round-robin). The endpoint is created on that worker's thread.
+  SendWorker* w = nullptr;
+  for (std::size_t i = 0; i < m_num_workers && w == nullptr; ++i) {
+    SendWorker& candidate = *m_send_workers[m_next_send_worker];
+    m_next_send_worker = (m_next_send_worker + 1) % m_num_workers;
+    if (candidate.is_ready) {
+      w = &candidate;
+    }
+  }
+  if (w == nullptr || w->index == 0) {
+    accept_connection(*m_send_workers.front(), conn_request, *client_address);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(w->connections_mutex);
+    w->pending_connections.emplace_back(conn_request, *client_address);
+  }
+  notify(w->queue_event_fd);
+}
+
+void StSender::handle_new_rail_connection(SendWorker& w,
+                                          ucp_conn_request_h conn_request) {
+  // Called on the rail's worker thread, so the endpoint is created directly
+  auto client_address = ucx::util::get_client_address(conn_request);
+  if (!client_address) {
+    ERROR("Failed to retrieve client address from connection request");
+    ucp_listener_reject(w.listener, conn_request);
+    return;
+  }
+  accept_connection(w, conn_request, *client_address);
+}
+
+void StSender::accept_connection(SendWorker& w,
+                                 ucp_conn_request_h conn_request,
+                                 const std::string& client_address) {
+  auto ep = ucx::util::accept(w.worker, conn_request, on_endpoint_error, &w);
   if (!ep) {
     ERROR("Failed to create endpoint for new connection");
     return;
   }
 
-  m_builders[*ep] = *client_address;
-  DEBUG("Accepted connection from '{}'", *client_address);
+  w.builders[*ep] = client_address;
+  DEBUG("Accepted connection from '{}' on send worker {}", client_address,
+        w.index);
 }
 
-void StSender::handle_endpoint_error(ucp_ep_h ep, ucs_status_t status) {
-  auto it = m_builders.find(ep);
-  if (it != m_builders.end()) {
+void StSender::handle_endpoint_error(SendWorker& w,
+                                     ucp_ep_h ep,
+                                     ucs_status_t status) {
+  auto it = w.builders.find(ep);
+  if (it != w.builders.end()) {
     INFO("Disconnect from builder '{}': {}", it->second, status);
-    m_builders.erase(it);
+    w.builders.erase(it);
   } else {
     ERROR("Received error for unknown endpoint: {}", status);
   }
@@ -515,14 +903,15 @@ void StSender::handle_endpoint_error(ucp_ep_h ep, ucs_status_t status) {
 // Builder message handling
 
 ucs_status_t
-StSender::handle_builder_request(const void* header,
+StSender::handle_builder_request(SendWorker& w,
+                                 const void* header,
                                  size_t header_length,
                                  [[maybe_unused]] void* data,
                                  size_t length,
                                  const ucp_am_recv_param_t* param) {
   auto hdr = std::span<const uint64_t>(static_cast<const uint64_t*>(header),
                                        header_length / sizeof(uint64_t));
-  if (hdr.size() != 2 || length != 0 ||
+  if ((hdr.size() != 2 && hdr.size() != 5) || length != 0 ||
       (param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP) == 0u) {
     ERROR("Invalid builder request received");
     return UCS_OK;
@@ -530,14 +919,48 @@ StSender::handle_builder_request(const void* header,
 
   TsId id = hdr[0];
   uint64_t tag = hdr[1];
-  send_subtimeslice_to_builder(id, param->reply_ep, tag);
+  // Single-rail requests carry no rail information
+  uint64_t rail = 0;
+  uint64_t num_rails = 1;
+  uint64_t stripe_size = 0;
+  if (hdr.size() == 5) {
+    rail = hdr[2];
+    num_rails = hdr[3];
+    stripe_size = hdr[4];
+  }
+  if (rail != w.rail || rail >= num_rails || num_rails > MAX_RAILS) {
+    ERROR("{}| Invalid builder request for rail {} of {} on rail {}", id, rail,
+          num_rails, w.rail);
+    return UCS_OK;
+  }
+
+  w.request_count.fetch_add(1, std::memory_order_relaxed);
+  send_subtimeslice_to_builder(w, id, param->reply_ep, tag, num_rails,
+                               stripe_size);
   return UCS_OK;
 }
 
-void StSender::send_subtimeslice_to_builder(TsId id,
+void StSender::send_subtimeslice_to_builder(SendWorker& w,
+                                            TsId id,
                                             ucp_ep_h ep,
-                                            uint64_t tag) {
-  if (!m_announced.contains(id)) {
+                                            uint64_t tag,
+                                            std::size_t num_rails,
+                                            uint64_t stripe_size) {
+  // Look up the subtimeslice and hold a reference (counted as an active send
+  // request) while posting the sends, so that it is not released by the main
+  // thread in the meantime. The block lists are immutable after the
+  // announcement and can be read without holding the lock.
+  AnnouncementHandle* ah_ptr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    auto it = m_announced.find(id);
+    if (it != m_announced.end()) {
+      ah_ptr = it->second.get();
+      ah_ptr->active_send_requests++;
+    }
+  }
+
+  if (ah_ptr == nullptr) {
     // Subtimeslice not found: send a zero-byte tag-matched message so the
     // builder's first pre-posted recv completes (with a length of 0 it will
     // be marked as Failed there and the remaining pre-posted recvs of this
@@ -555,7 +978,7 @@ void StSender::send_subtimeslice_to_builder(TsId id,
     }
     return;
   }
-  auto& ah = *m_announced.at(id);
+  const auto& ah = *ah_ptr;
 
   // Send the transfer blocks as separate tagged messages, all with the same
   // tag: tag matching is FIFO per tag, so they complete the builder's
@@ -564,52 +987,105 @@ void StSender::send_subtimeslice_to_builder(TsId id,
   // the aggregation buffer): for the iov datatype UCX cannot use the
   // single-RDMA-read rendezvous protocol and falls back to fragmented sends
   // at roughly half the achievable bandwidth. Only blocks split by a ring
-  // buffer wrap-around still use the iov datatype.
-  DEBUG("{}| Sending {} blocks to builder '{}'", id, ah.blocks.size(),
-        m_builders[ep]);
-  for (const auto& block : ah.blocks) {
-    ucp_request_param_t req_param{};
-    req_param.op_attr_mask =
-        UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    req_param.cb.send = on_builder_send_complete;
-    req_param.user_data = this;
-
-    const void* send_buffer = nullptr;
-    size_t send_count = 0;
-    if (block.size() == 1) {
-      send_buffer = block[0].buffer;
-      send_count = block[0].length;
-    } else if (block.size() > 1) {
-      req_param.op_attr_mask |= UCP_OP_ATTR_FIELD_DATATYPE;
-      req_param.datatype = ucp_dt_make_iov();
-      send_buffer = block.data();
-      send_count = block.size();
+  // buffer wrap-around still use the iov datatype. With multiple rails, the
+  // blocks are split into chunks, and only this rail's chunks are sent.
+  auto builder_it = w.builders.find(ep);
+  DEBUG("{}| Sending {} blocks to builder '{}' (worker {}, rail {} of {})", id,
+        ah.blocks.size(),
+        builder_it != w.builders.end() ? std::string_view(builder_it->second)
+                                       : std::string_view("<unknown>"),
+        w.index, w.rail, num_rails);
+  auto block_size = [&ah](std::size_t b) {
+    uint64_t size = 0;
+    for (const auto& iov : ah.blocks[b]) {
+      size += iov.length;
     }
+    return size;
+  };
+  std::size_t posted_requests = 0;
+  bool failed = false;
+  for_each_rail_chunk(
+      ah.blocks.size(), block_size, w.rail, num_rails, stripe_size,
+      [&](const StDataChunk& chunk) {
+        if (failed) {
+          return;
+        }
+        const auto& block = ah.blocks[chunk.block];
+        ucp_request_param_t req_param{};
+        req_param.op_attr_mask =
+            UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
+        req_param.cb.send = on_builder_send_complete;
+        req_param.user_data = &w;
+
+        const void* send_buffer = nullptr;
+        size_t send_count = 0;
+        std::unique_ptr<std::vector<ucp_dt_iov>> iov;
+        if (block.size() == 1) {
+          send_buffer =
+              static_cast<const std::byte*>(block[0].buffer) + chunk.offset;
+          send_count = chunk.size;
+        } else if (block.size() > 1) {
+          req_param.op_attr_mask |= UCP_OP_ATTR_FIELD_DATATYPE;
+          req_param.datatype = ucp_dt_make_iov();
+          if (chunk.offset == 0 && chunk.size == block_size(chunk.block)) {
+            send_buffer = block.data();
+            send_count = block.size();
+          } else {
+            // Reuse the list of a completed send, if available
+            if (w.iov_pool.empty()) {
+              iov = std::make_unique<std::vector<ucp_dt_iov>>();
+            } else {
+              iov = std::move(w.iov_pool.back());
+              w.iov_pool.pop_back();
+            }
+            slice_iov(block, chunk.offset, chunk.size, *iov);
+            send_buffer = iov->data();
+            send_count = iov->size();
+          }
+        }
 
-    ucs_status_ptr_t request =
-        ucp_tag_send_nbx(ep, send_buffer, send_count, tag, &req_param);
+        ucs_status_ptr_t request =
+            ucp_tag_send_nbx(ep, send_buffer, send_count, tag, &req_param);
+
+        if (UCS_PTR_IS_ERR(request)) {
+          ucs_status_t status = UCS_PTR_STATUS(request);
+          ERROR("Failed to send tag message: {}", status);
+          // Stop sending; the builder handles the missing chunks via its
+          // timeout. Keep the announced subtimeslice.
+          if (iov) {
+            w.iov_pool.push_back(std::move(iov));
+          }
+          failed = true;
+          return;
+        }
 
-    if (UCS_PTR_IS_ERR(request)) {
-      ucs_status_t status = UCS_PTR_STATUS(request);
-      ERROR("Failed to send tag message: {}", status);
-      // Stop sending; the builder handles the missing blocks via its timeout.
-      // Keep the announced subtimeslice.
-      return;
-    }
+        w.block_count.fetch_add(1, std::memory_order_relaxed);
+        w.byte_count.fetch_add(chunk.size, std::memory_order_relaxed);
 
-    if (request == nullptr) {
-      // Operation has completed successfully in-place
-      continue;
-    }
+        if (request == nullptr) {
+          // Operation has completed successfully in-place
+          if (iov) {
+            w.iov_pool.push_back(std::move(iov));
+          }
+          return;
+        }
+
+        // Keep the element in m_announced until the send completes and store
+        // the request
+        w.active_send_requests[request] = {id, std::move(iov)};
+        ++posted_requests;
+      });
 
-    // Keep the element in m_announced until the send completes and store the
-    // request
-    m_active_send_requests[request] = id;
-    ah.active_send_requests++;
+  // Convert the reference held while posting into the posted requests
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    ah_ptr->active_send_requests += posted_requests;
   }
+  release_send_requests(w, id, 1);
 }
 
-void StSender::handle_builder_send_complete(void* request,
+void StSender::handle_builder_send_complete(SendWorker& w,
+                                            void* request,
                                             ucs_status_t status) {
   if (UCS_PTR_IS_ERR(request)) {
     ERROR("Send operation failed: {}", status);
@@ -617,25 +1093,16 @@ void StSender::handle_builder_send_complete(void* request,
     ERROR("Send operation completed with status: {}", status);
   }
 
-  if (!m_active_send_requests.contains(request)) {
+  auto it = w.active_send_requests.find(request);
+  if (it == w.active_send_requests.end()) {
     ERROR("Received completion for unknown send request");
   } else {
-    TsId id = m_active_send_requests.at(request);
-    if (!m_announced.contains(id)) {
-      ERROR("{}| Sent subtimeslice not found in announced list", id);
-    } else {
-      auto& ah = *m_announced.at(id);
-      ah.active_send_requests--;
-      if (ah.pending_release && ah.active_send_requests == 0) {
-        DEBUG("{}| Releasing after send completion", id);
-        {
-          std::lock_guard<std::mutex> lock(m_completions_mutex);
-          m_completed.push(id);
-        }
-        m_announced.erase(id);
-      }
+    TsId id = it->second.id;
+    if (it->second.iov) {
+      w.iov_pool.push_back(std::move(it->second.iov));
     }
-    m_active_send_requests.erase(request);
+    w.active_send_requests.erase(it);
+    release_send_requests(w, id, 1);
   }
 
   if (request != nullptr) {
@@ -643,72 +1110,168 @@ void StSender::handle_builder_send_complete(void* request,
   }
 }
 
-void StSender::disconnect_from_builders() {
-  if (m_builders.empty()) {
+void StSender::release_send_requests(SendWorker& w,
+                                     TsId id,
+                                     std::size_t count) {
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    auto it = m_announced.find(id);
+    if (it == m_announced.end()) {
+      ERROR("{}| Sent subtimeslice not found in announced list", id);
+      return;
+    }
+    auto& ah = *it->second;
+    ah.active_send_requests -= count;
+    if (!ah.pending_release || ah.active_send_requests != 0) {
+      return;
+    }
+    DEBUG("{}| Releasing after send completion", id);
+    m_announced.erase(it);
+  }
+  // The completion is queued by the worker that completed the last send
+  complete(w, id);
+}
+
+void StSender::disconnect_from_builders(SendWorker& w) {
+  if (w.builders.empty()) {
     return;
   }
-  INFO("Disconnecting from {} builders", m_builders.size());
+  INFO("Disconnecting from {} builders", w.builders.size());
 
   // Collect endpoints and clear map before closing, so that error
   // callbacks during close do not modify the map during iteration
   std::vector<ucp_ep_h> eps_to_close;
-  eps_to_close.reserve(m_builders.size());
-  for (auto& [ep, _] : m_builders) {
+  eps_to_close.reserve(w.builders.size());
+  for (auto& [ep, _] : w.builders) {
     eps_to_close.push_back(ep);
   }
-  m_builders.clear();
+  w.builders.clear();
 
   for (auto* ep : eps_to_close) {
-    ucx::util::close_endpoint(m_worker, ep, true);
+    ucx::util::close_endpoint(w.worker, ep, true);
   }
 }
 
 // Queue processing
 
-void StSender::notify_queue_update() const {
+void StSender::notify(int event_fd) {
   uint64_t value = 1;
-  ssize_t ret = write(m_queue_event_fd, &value, sizeof(value));
+  ssize_t ret = write(event_fd, &value, sizeof(value));
   if (ret != sizeof(value)) {
-    ERROR("Failed to write to m_queue_event_fd: {}", strerror(errno));
+    ERROR("Failed to write to event fd: {}", strerror(errno));
   }
 }
 
 std::size_t StSender::process_queues() {
-  std::deque<std::pair<TsId, StHandle>> announcements;
-  std::deque<TsId> retractions;
-  {
-    std::lock_guard<std::mutex> lock(m_queue_mutex);
-    if (m_pending_announcements.empty() && m_pending_retractions.empty()) {
-      return 0;
+  // Process the commands in order, but at most one queue length at a time to
+  // keep the UCX worker progressing
+  std::size_t count = 0;
+  for (; count < m_commands.capacity(); ++count) {
+    SenderCommand* cmd = m_commands.front();
+    if (cmd == nullptr) {
+      break;
+    }
+    m_command_stats.record(cmd->enqueue_time);
+    if (!m_manager_connected) {
+      // Manager not registered, skipping announcements
+      if (cmd->type == SenderCommand::Type::Announce) {
+        complete(cmd->id);
+      }
+    } else if (cmd->type == SenderCommand::Type::Announce) {
+      do_announce_subtimeslice(cmd->id, cmd->sth);
+    } else {
+      do_retract_subtimeslice(cmd->id);
     }
-    announcements.swap(m_pending_announcements);
-    retractions.swap(m_pending_retractions);
+    m_commands.pop();
   }
+  return count;
+}
 
-  if (!m_manager_connected) {
-    // Manager not registered, skipping announcements
-    for (const auto& [id, sth] : announcements) {
-      std::lock_guard<std::mutex> lock(m_completions_mutex);
-      m_completed.push(id);
-    }
-    return announcements.size();
+// Must not be called with m_announced_mutex held: waits while the completion
+// queue is full, which would block the send workers
+void StSender::complete(SendWorker& w, TsId id) {
+  SenderCompletion* c = w.completions.back();
+  if (c == nullptr) {
+    // The StBuilder receives completions continuously (also while waiting to
+    // queue a command), so it will make room unless it has stopped
+    m_completion_stats.full_count.fetch_add(1, std::memory_order_relaxed);
+    do {
+      if (m_stopping) {
+        DEBUG("{}| Dropping completion, sender is stopping", id);
+        return;
+      }
+      std::this_thread::yield();
+      c = w.completions.back();
+    } while (c == nullptr);
   }
+  c->id = id;
+  c->enqueue_time = std::chrono::steady_clock::now();
+  w.completions.push();
+}
 
-  for (auto id : retractions) {
-    do_retract_subtimeslice(id);
+void StSender::flush_announced() {
+  std::vector<TsId> flushed;
+  {
+    std::lock_guard<std::mutex> lock(m_announced_mutex);
+    for (const auto& [id, st] : m_announced) {
+      DEBUG("{}| Flushing announced subtimeslice", id);
+      flushed.push_back(id);
+    }
+    m_announced.clear();
   }
-  for (const auto& [id, sth] : announcements) {
-    do_announce_subtimeslice(id, sth);
+  for (const TsId id : flushed) {
+    complete(id);
   }
-
-  return announcements.size() + retractions.size();
 }
 
-void StSender::flush_announced() {
-  for (const auto& [id, st] : m_announced) {
-    DEBUG("{}| Flushing announced subtimeslice", id);
-    std::lock_guard<std::mutex> lock(m_completions_mutex);
-    m_completed.push(id);
+// Monitoring
+
+void StSender::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+  Scheduler::time_type now = Scheduler::clock::now();
+
+  if (m_monitor != nullptr) {
+    for (const auto& w : m_send_workers) {
+      m_monitor->QueueMetric(
+          "stserver_sender_status",
+          {{"host", m_sender_info.address},
+           {"port", std::to_string(m_sender_info.port)},
+           {"worker", std::to_string(w->index)},
+           {"rail", std::to_string(w->rail)}},
+          {{"request_count", w->request_count.load()},
+           {"block_count", w->block_count.load()},
+           {"byte_count", w->byte_count.load()}});
+    }
+
+    std::size_t completion_queue_size = 0;
+    for (const auto& w : m_send_workers) {
+      completion_queue_size += w->completions.size();
+    }
+    auto report_queue = [&](const std::string& queue, QueueStats& stats,
+                            std::size_t size) {
+      m_monitor->QueueMetric(
+          "stserver_sender_queue_status",
+          {{"host", m_sender_info.address},
+           {"port", std::to_string(m_sender_info.port)},
+           {"queue", queue}},
+          {{"count", stats.count.load()},
+           {"full_count", stats.full_count.load()},
+           {"latency_ns_sum", stats.latency_ns_sum.load()},
+           {"latency_ns_max", stats.latency_ns_max.exchange(0)},
+           {"size", size}});
+    };
+    report_queue("command", m_command_stats, m_commands.size());
+    report_queue("completion", m_completion_stats, completion_queue_size);
+
+    m_monitor->QueueMetric(
+        "stserver_manager_status",
+        {{"host", m_sender_info.address},
+         {"port", std::to_string(m_sender_info.port)}},
+        {{"announcement_count", m_announcement_count},
+         {"announce_message_count", m_announce_message_count},
+         {"release_count", m_release_count},
+         {"release_message_count", m_release_message_count}});
   }
-  m_announced.clear();
+
+  m_tasks.add([this] { report_status(); }, now + interval);
 }
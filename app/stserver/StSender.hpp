@@ -3,15 +3,21 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include "AdaptiveBatching.hpp"
+#include "FlatHashMap.hpp"
+#include "Monitor.hpp"
 #include "Scheduler.hpp"
+#include "SpscQueue.hpp"
 #include "SubTimeslice.hpp"
 #include "ucxutil.hpp"
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <span>
 #include <string>
 #include <string_view>
@@ -30,30 +36,124 @@ using namespace std::chrono_literals;
 // StSender: Announce subtimeslices to tsmanager and send them to tsbuilders
 
 struct AnnouncementHandle {
-  AnnouncementHandle(TsId id,
-                     std::vector<std::byte> st_descriptor_bytes,
-                     std::vector<std::vector<ucp_dt_iov>> blocks)
-      : id(id), st_descriptor_bytes(std::move(st_descriptor_bytes)),
-        blocks(std::move(blocks)) {}
+  AnnouncementHandle(TsId id, std::vector<std::vector<ucp_dt_iov>> blocks)
+      : id(id), blocks(std::move(blocks)) {}
 
   // Cannot be moved or copied (pointer to data is used by ucx)
   AnnouncementHandle(const AnnouncementHandle&) = delete;
   AnnouncementHandle& operator=(const AnnouncementHandle&) = delete;
 
   const TsId id;
-  std::vector<std::byte> st_descriptor_bytes;
   /// Scatter-gather lists of the transfer blocks (two per component:
   /// microslice descriptors, then content), each sent as one tagged message
   std::vector<std::vector<ucp_dt_iov>> blocks;
-  size_t active_send_requests = 0;
-  bool pending_release = false;
+  size_t active_send_requests = 0; ///< guarded by StSender::m_announced_mutex
+  bool pending_release = false;     ///< guarded by StSender::m_announced_mutex
+};
+
+/// An announcement or retraction of a subtimeslice, passed from the StBuilder
+/// to the sender thread
+struct SenderCommand {
+  enum class Type { Announce, Retract };
+  Type type = Type::Announce;
+  TsId id;
+  StHandle sth; ///< the subtimeslice (announcements only)
+  std::chrono::steady_clock::time_point enqueue_time;
+};
+
+/// A completed subtimeslice, passed from a sender thread to the StBuilder
+struct SenderCompletion {
+  TsId id;
+  std::chrono::steady_clock::time_point enqueue_time;
+};
+
+/// Counters of a queue between the StBuilder and the sender threads
+struct QueueStats {
+  std::atomic<uint64_t> count = 0;          ///< transferred items
+  std::atomic<uint64_t> full_count = 0;     ///< attempts to add to full queue
+  std::atomic<uint64_t> latency_ns_sum = 0; ///< total time spent in queue
+  std::atomic<uint64_t> latency_ns_max = 0; ///< maximum since last report
+
+  void record(std::chrono::steady_clock::time_point enqueue_time) {
+    auto latency = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - enqueue_time)
+            .count());
+    count.fetch_add(1, std::memory_order_relaxed);
+    latency_ns_sum.fetch_add(latency, std::memory_order_relaxed);
+    uint64_t max = latency_ns_max.load(std::memory_order_relaxed);
+    while (latency > max &&
+           !latency_ns_max.compare_exchange_weak(max, latency,
+                                                 std::memory_order_relaxed)) {
+    }
+  }
+};
+
+class StSender;
+
+/// An outstanding send request of a transfer chunk
+struct SendRequest {
+  TsId id = 0;
+  /// Scatter-gather list of a partial multi-fragment block (kept alive until
+  /// the send completes)
+  std::unique_ptr<std::vector<ucp_dt_iov>> iov;
+};
+
+/// A UCX worker of the data path, driven by its own thread. Builder endpoints
+/// are sharded across the send workers; each worker exclusively owns its
+/// endpoints and outstanding send requests. Worker 0 is driven by the main
+/// sender thread, which additionally handles the listener and the manager.
+/// Additional rails (rail > 0) are served by one send worker each, with a
+/// UCX context restricted to the rail's devices and a listener of its own.
+struct SendWorker {
+  SendWorker(StSender* sender, std::size_t index, std::size_t queue_capacity)
+      : sender(sender), index(index), completions(queue_capacity) {}
+  SendWorker(const SendWorker&) = delete;
+  SendWorker& operator=(const SendWorker&) = delete;
+
+  StSender* const sender;
+  const std::size_t index;
+  std::size_t rail = 0;
+  ucp_context_h context = nullptr; ///< own context (rail > 0 only)
+  ucp_mem_h memh = nullptr;        ///< registration in own context
+  ucp_listener_h listener = nullptr;
+  ucp_worker_h worker = nullptr;
+  int epoll_fd = -1;
+  int queue_event_fd = -1;
+  std::atomic_bool is_ready = false;
+
+  /// Connection requests accepted by the listener, to be completed on this
+  /// worker (together with the client address)
+  std::deque<std::pair<ucp_conn_request_h, std::string>> pending_connections;
+  std::mutex connections_mutex;
+
+  std::unordered_map<ucp_ep_h, std::string> builders;
+  FlatHashMap<ucs_status_ptr_t, SendRequest> active_send_requests;
+  /// Scatter-gather lists of completed partial-block sends, reused to avoid
+  /// an allocation per striped chunk
+  std::vector<std::unique_ptr<std::vector<ucp_dt_iov>>> iov_pool;
+
+  /// Subtimeslices completed on this worker's thread, to be received by the
+  /// StBuilder (single producer, single consumer)
+  SpscQueue<SenderCompletion> completions;
+
+  // Throughput counters (written by the worker thread, read for monitoring)
+  std::atomic<uint64_t> request_count = 0; ///< served builder requests
+  std::atomic<uint64_t> block_count = 0;   ///< sent transfer blocks
+  std::atomic<uint64_t> byte_count = 0;    ///< sent bytes
+
+  std::jthread thread;
 };
 
 class StSender {
 public:
   StSender(std::string_view manager_address,
            uint16_t listen_port,
-           SenderInfo sender_info);
+           SenderInfo sender_info,
+           std::size_t num_workers = 1,
+           std::vector<std::string> rails = {},
+           std::chrono::nanoseconds batch_delay = {},
+           cbm::Monitor* monitor = nullptr);
   ~StSender();
   StSender(const StSender&) = delete;
   StSender& operator=(const StSender&) = delete;
@@ -62,8 +162,10 @@ public:
   void set_memory_region(std::span<std::byte> region);
   void start();
   void stop();
-  void announce_subtimeslice(TsId id, const StHandle& sth);
-  void retract_subtimeslice(TsId id);
+  // The following methods are to be called from a single (StBuilder) thread.
+  // The try_... methods return false if the queue to the sender is full.
+  [[nodiscard]] bool try_announce_subtimeslice(TsId id, const StHandle& sth);
+  [[nodiscard]] bool try_retract_subtimeslice(TsId id);
   std::optional<TsId> try_receive_completion();
   bool has_stopped() const { return m_thread_stopped; }
 
@@ -72,28 +174,49 @@ private:
 
   std::string m_manager_address;
   uint16_t m_listen_port;
+  /// Device specifications of the rails (empty: single rail, UCX defaults)
+  std::vector<std::string> m_rails;
   SenderInfo m_sender_info;
   static constexpr ucx::util::LoopMode m_ucx_loop_mode =
       ucx::util::LoopMode::busy_poll;
   std::vector<std::byte> m_sender_info_bytes;
+  cbm::Monitor* m_monitor = nullptr;
+
+  /// Capacity of the queues between the StBuilder and the sender threads
+  static constexpr std::size_t m_queue_capacity = 4096;
 
   int m_queue_event_fd = -1;
-  std::deque<std::pair<TsId, StHandle>> m_pending_announcements;
-  std::deque<TsId> m_pending_retractions;
-  std::mutex m_queue_mutex;
-  std::queue<TsId> m_completed;
-  std::mutex m_completions_mutex;
+  /// Announcements and retractions from the StBuilder, in order
+  SpscQueue<SenderCommand> m_commands{m_queue_capacity};
+  QueueStats m_command_stats;
+  QueueStats m_completion_stats;
+  /// The send worker whose completion queue is checked first
+  std::size_t m_next_completion_queue = 0;
   int m_epoll_fd = -1;
 
-  std::unordered_map<TsId, std::unique_ptr<AnnouncementHandle>> m_announced;
-  std::unordered_map<ucs_status_ptr_t, TsId> m_active_send_requests;
+  /// Announced subtimeslices, shared between the main thread (announce,
+  /// retract, release) and the send workers (transfer to builders)
+  FlatHashMap<TsId, std::unique_ptr<AnnouncementHandle>> m_announced;
+  std::mutex m_announced_mutex;
+
+  /// Announcements not yet sent to the manager (see flush_announcements)
+  std::vector<std::byte> m_announce_batch;
+  AdaptiveBatching m_announce_batching;
+  uint64_t m_announcement_count = 0;
+  uint64_t m_announce_message_count = 0;
+  uint64_t m_release_count = 0;
+  uint64_t m_release_message_count = 0;
 
   ucp_context_h m_context = nullptr;
-  ucp_worker_h m_worker = nullptr;
+  ucp_worker_h m_worker = nullptr; ///< worker 0, owned by the main thread
   ucp_mem_h m_buffer_memh = nullptr;
   std::span<std::byte> m_memory_region;
   ucp_listener_h m_listener = nullptr;
-  std::unordered_map<ucp_ep_h, std::string> m_builders;
+
+  /// Send workers of rail 0 (`m_num_workers`), then one per additional rail
+  std::vector<std::unique_ptr<SendWorker>> m_send_workers;
+  std::size_t m_num_workers;
+  std::size_t m_next_send_worker = 0; ///< round-robin connection assignment
 
   static constexpr auto m_manager_retry_interval = 2s;
   bool m_mute_manager_reconnect = false;
@@ -103,6 +226,7 @@ private:
   bool m_manager_connected = false;
 
   std::jthread m_worker_thread;
+  std::atomic_bool m_stopping = false;
   std::atomic_bool m_thread_stopped = false;
 
   // Main operation loop
@@ -119,37 +243,78 @@ private:
   // Manager message handling
   void do_announce_subtimeslice(TsId id, const StHandle& sth);
   void do_retract_subtimeslice(TsId id);
+  bool retract_announced(TsId id);
+  void flush_announcements();
   ucs_status_t handle_manager_release(const void* header,
                                       size_t header_length,
                                       void* data,
                                       size_t length,
                                       const ucp_am_recv_param_t* param);
+  ucs_status_t handle_manager_release_batch(const void* header,
+                                            size_t header_length,
+                                            void* data,
+                                            size_t length,
+                                            const ucp_am_recv_param_t* param);
+  bool release_announced(TsId id);
+
+  // Send worker management
+  void start_send_workers();
+  void stop_send_workers();
+  void run_send_worker(SendWorker& w, std::stop_token stop_token);
+  bool init_send_worker(SendWorker& w);
+  std::size_t process_pending_connections(SendWorker& w);
 
   // Builder connection management
   void handle_new_connection(ucp_conn_request_h conn_request);
-  void handle_endpoint_error(ucp_ep_h ep, ucs_status_t status);
+  void handle_new_rail_connection(SendWorker& w,
+                                  ucp_conn_request_h conn_request);
+  void accept_connection(SendWorker& w,
+                         ucp_conn_request_h conn_request,
+                         const std::string& client_address);
+  void handle_endpoint_error(SendWorker& w, ucp_ep_h ep, ucs_status_t status);
 
   // Builder message handling
-  ucs_status_t handle_builder_request(const void* header,
+  ucs_status_t handle_builder_request(SendWorker& w,
+                                      const void* header,
                                       size_t header_length,
                                       void* data,
                                       size_t length,
                                       const ucp_am_recv_param_t* param);
-  void send_subtimeslice_to_builder(TsId id, ucp_ep_h ep, uint64_t tag);
-  void handle_builder_send_complete(void* request, ucs_status_t status);
-  void disconnect_from_builders();
+  void send_subtimeslice_to_builder(SendWorker& w,
+                                    TsId id,
+                                    ucp_ep_h ep,
+                                    uint64_t tag,
+                                    std::size_t num_rails,
+                                    uint64_t stripe_size);
+  void handle_builder_send_complete(SendWorker& w,
+                                    void* request,
+                                    ucs_status_t status);
+  void release_send_requests(SendWorker& w, TsId id, std::size_t count);
+  void disconnect_from_builders(SendWorker& w);
 
   // Queue processing
-  void notify_queue_update() const;
+  static void notify(int event_fd);
+  void notify_queue_update() const { notify(m_queue_event_fd); }
   std::size_t process_queues();
+  void complete(SendWorker& w, TsId id);
+  void complete(TsId id) { complete(*m_send_workers.front(), id); }
   void flush_announced();
 
+  // Monitoring
+  void report_status();
+
   // UCX static callbacks (trampolines)
   static void on_new_connection(ucp_conn_request_h conn_request, void* arg) {
     static_cast<StSender*>(arg)->handle_new_connection(conn_request);
   }
+  static void on_new_rail_connection(ucp_conn_request_h conn_request,
+                                     void* arg) {
+    auto* w = static_cast<SendWorker*>(arg);
+    w->sender->handle_new_rail_connection(*w, conn_request);
+  }
   static void on_endpoint_error(void* arg, ucp_ep_h ep, ucs_status_t status) {
-    static_cast<StSender*>(arg)->handle_endpoint_error(ep, status);
+    auto* w = static_cast<SendWorker*>(arg);
+    w->sender->handle_endpoint_error(*w, ep, status);
   }
   static void on_manager_error(void* arg, ucp_ep_h ep, ucs_status_t status) {
     static_cast<StSender*>(arg)->handle_manager_error(ep, status);
@@ -160,8 +325,9 @@ private:
                                          void* data,
                                          size_t length,
                                          const ucp_am_recv_param_t* param) {
-    return static_cast<StSender*>(arg)->handle_builder_request(
-        header, header_length, data, length, param);
+    auto* w = static_cast<SendWorker*>(arg);
+    return w->sender->handle_builder_request(*w, header, header_length, data,
+                                             length, param);
   }
   static ucs_status_t on_manager_release(void* arg,
                                          const void* header,
@@ -172,11 +338,21 @@ private:
     return static_cast<StSender*>(arg)->handle_manager_release(
         header, header_length, data, length, param);
   }
+  static ucs_status_t
+  on_manager_release_batch(void* arg,
+                           const void* header,
+                           size_t header_length,
+                           void* data,
+                           size_t length,
+                           const ucp_am_recv_param_t* param) {
+    return static_cast<StSender*>(arg)->handle_manager_release_batch(
+        header, header_length, data, length, param);
+  }
   static void on_builder_send_complete(void* request,
                                        ucs_status_t status,
                                        void* user_data) {
-    static_cast<StSender*>(user_data)->handle_builder_send_complete(request,
-                                                                    status);
+    auto* w = static_cast<SendWorker*>(user_data);
+    w->sender->handle_builder_send_complete(*w, request, status);
   }
   static void on_manager_register_complete(void* request,
                                            ucs_status_t status,
@@ -3,8 +3,10 @@
    Author: Jan de Cuveland */
 
 #include "pgen_channel.hpp"
+#include "Crc32c.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "monitoring/SystemInfo.hpp"
+#include <algorithm>
 #include <chrono>
 #include <sys/types.h>
 
@@ -31,6 +33,8 @@ pgen_channel::pgen_channel(std::span<fles::MicrosliceDescriptor> desc_buffer,
       m_channel_index(channel_index), m_duration_ns(duration_ns),
       m_typical_content_size(typical_content_size), m_flags(flags),
       m_random_distribution(typical_content_size),
+      m_pattern_crc(channel_index,
+                    has_flag(PgenFlags::ComputeCrc) ? typical_content_size : 0),
       m_worker_thread(&pgen_channel::thread_work, this) {}
 
 void pgen_channel::set_sw_read_pointers(uint64_t data_offset,
@@ -110,6 +114,9 @@ void pgen_channel::generate_microslice(uint64_t time_ns) {
     // flags |= static_cast<uint16_t>(fles::MicrosliceFlags::SkippedMicroslice);
     m_skipped_microslice = false;
   }
+  if (has_flag(PgenFlags::ComputeCrc)) {
+    flags |= static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid);
+  }
   const auto sys_id = static_cast<uint8_t>(fles::Subsystem::FLES);
   const auto sys_ver =
       static_cast<uint8_t>(has_flag(PgenFlags::GeneratePattern)
@@ -146,6 +153,14 @@ void pgen_channel::generate_microslice(uint64_t time_ns) {
     m_data_write_index += content_bytes;
   }
 
+  if (has_flag(PgenFlags::ComputeCrc)) {
+    // Unmodified buffer content is possibly wrapping around
+    crc = has_flag(PgenFlags::GeneratePattern)
+              ? m_pattern_crc.crc(content_bytes)
+              : crc32c_ring(m_data_buffer.ptr(), m_data_buffer.bytes(),
+                            m_data_buffer.offset_bytes(offset), content_bytes);
+  }
+
   // Write to descriptor buffer
   const_cast<fles::MicrosliceDescriptor&>(
       m_desc_buffer.at(m_desc_write_index)) =
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "dma_channel.hpp"
+#include "fles_core/FlesnetPatternCrc.hpp"
 #include "fles_core/RingBufferView.hpp"
 #include "fles_ipc/MicrosliceDescriptor.hpp"
 #include <atomic>
@@ -21,7 +22,10 @@ enum class PgenFlags : uint32_t {
   GeneratePattern = 1 << 0,
 
   // Randomize the sizes of the microslices
-  RandomizeSizes = 1 << 1
+  RandomizeSizes = 1 << 1,
+
+  // Provide the real CRC-32C of the content (and set the CrcValid flag)
+  ComputeCrc = 1 << 2
 };
 
 class pgen_channel : public basic_dma_channel {
@@ -59,6 +63,9 @@ private:
   std::default_random_engine m_random_generator;
   std::poisson_distribution<unsigned int> m_random_distribution;
 
+  // Precomputed CRCs of the generated pattern (used with ComputeCrc)
+  FlesnetPatternCrc m_pattern_crc;
+
   std::jthread m_worker_thread;
   void thread_work(std::stop_token stop_token);
   void generate_microslice(uint64_t time_ns);
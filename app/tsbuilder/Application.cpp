@@ -13,8 +13,14 @@ Application::Application(Parameters const& par,
     : m_par(par), m_producer_address("inproc://" + par.shm_id()),
       m_worker_address("ipc://@" + par.shm_id()),
       m_item_distributor(m_zmq_context, m_producer_address, m_worker_address),
-      m_timeslice_buffer(
-          m_zmq_context, m_producer_address, par.shm_id(), par.buffer_size()),
+      m_timeslice_buffer(m_zmq_context,
+                         m_producer_address,
+                         par.shm_id(),
+                         par.buffer_size(),
+                         par.shm_item_channel(),
+                         par.legacy_work_items(),
+                         par.huge_pages(),
+                         par.numa_node()),
       m_distributor_thread(std::ref(m_item_distributor)) {
   if (!par.monitor_uri().empty()) {
     m_monitor = std::make_unique<cbm::Monitor>(m_par.monitor_uri());
@@ -23,9 +29,10 @@ Application::Application(Parameters const& par,
   // wait a moment to allow the timeslice buffer clients to connect
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-  m_ts_builder = std::make_unique<TsBuilder>(signal_status, m_timeslice_buffer,
-                                             par.tsmanager_address(),
-                                             par.timeout_ns(), m_monitor.get());
+  m_ts_builder = std::make_unique<TsBuilder>(
+      signal_status, m_timeslice_buffer, par.tsmanager_address(),
+      par.timeout_ns(), par.rails(), par.stripe_size(),
+      par.publish_components(), m_monitor.get());
 }
 
 void Application::run() { m_ts_builder->run(); }
@@ -4,6 +4,7 @@
 
 #include "Parameters.hpp"
 #include "System.hpp"
+#include "TsbProtocol.hpp"
 #include "log.hpp"
 #include <boost/program_options.hpp>
 #include <fstream>
@@ -55,6 +56,30 @@ void Parameters::parse_options(int argc, char* argv[]) {
   config_add("timeout",
              po::value<Nanoseconds>(&m_timeout)->default_value(m_timeout),
              "timeout for data reception (with suffix ns, us, ms, s)");
+  config_add("rail",
+             po::value<std::vector<std::string>>(&m_rails)
+                 ->composing()
+                 ->value_name("<devices>[/<transports>]"),
+             "network devices (and optionally UCX transports) of a rail for "
+             "striped transfers, e.g., \"mlx5_0:1\" or \"lo/tcp\" (may be "
+             "given repeatedly; requires the same number of rails at the "
+             "senders)");
+  config_add("stripe-size",
+             po::value<SizeValue>(&m_stripe_size)->default_value(m_stripe_size),
+             "size of the chunks transfer blocks are split into when using "
+             "multiple rails or early publishing (supports SI units: kB, MB, "
+             "GB, etc. or binary: KiB, MiB, GiB, etc.)");
+  config_add("publish-components",
+             po::value<std::vector<std::size_t>>(&m_publish_components)
+                 ->multitoken()
+                 ->composing()
+                 ->value_name("<index> ..."),
+             "publish each timeslice early, consisting of only the given "
+             "components, as soon as these are received (for consumers "
+             "processing a subset of the components); the early work item is "
+             "flagged as partial timeslice, the complete timeslice follows as "
+             "a separate work item once the consumers have completed the "
+             "early one (requires senders supporting striped transfers)");
   config_add("shm-id",
              po::value<std::string>(&m_shm_id)->default_value(m_shm_id),
              "shared memory identifier for timeslice buffer");
@@ -62,6 +87,23 @@ void Parameters::parse_options(int argc, char* argv[]) {
              po::value<SizeValue>(&m_buffer_size)->default_value(m_buffer_size),
              "size of the timeslice buffer in bytes (supports SI units: kB, "
              "MB, GB, etc. or binary: KiB, MiB, GiB, etc.)");
+  config_add("shm-item-channel",
+             po::value<bool>(&m_shm_item_channel)->implicit_value(true),
+             "pass timeslices to clients through a channel in shared memory "
+             "instead of ZMQ messages (clients use shm://<id>?channel=shm)");
+  config_add("legacy-work-items",
+             po::value<bool>(&m_legacy_work_items)->implicit_value(true),
+             "encode work items as Boost archives for clients built against "
+             "an older fles_ipc library");
+  config_add("huge-pages",
+             po::value<HugePages>(&m_huge_pages)->default_value(m_huge_pages),
+             "use transparent huge pages for the timeslice buffer if not "
+             "none (explicit huge pages cannot back the shared memory "
+             "segment, so 2M and 1G also select transparent huge pages)");
+  config_add("numa-node",
+             po::value<int>(&m_numa_node)->default_value(m_numa_node),
+             "NUMA node to bind the timeslice buffer and to run the threads "
+             "on (-1: no binding)");
 
   po::options_description cmdline_options("Allowed options", terminal_width,
                                           terminal_width / 2);
@@ -104,4 +146,11 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (timeout_ns() <= 0) {
     throw ParametersException("timeout must be greater than 0");
   }
+  if (m_rails.size() > MAX_RAILS) {
+    throw ParametersException(
+        std::format("number of rails must not exceed {}", MAX_RAILS));
+  }
+  if (m_stripe_size.value() == 0) {
+    throw ParametersException("stripe size must be greater than 0");
+  }
 }
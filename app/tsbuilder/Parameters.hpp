@@ -3,10 +3,13 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include "MemoryPlacement.hpp"
 #include "OptionValues.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace option_value_literals;
 
@@ -30,8 +33,17 @@ public:
     return m_tsmanager_address;
   }
   [[nodiscard]] int64_t timeout_ns() const { return m_timeout.count(); }
+  [[nodiscard]] std::vector<std::string> rails() const { return m_rails; }
+  [[nodiscard]] uint64_t stripe_size() const { return m_stripe_size.value(); }
+  [[nodiscard]] std::vector<std::size_t> publish_components() const {
+    return m_publish_components;
+  }
   [[nodiscard]] std::string shm_id() const { return m_shm_id; }
   [[nodiscard]] size_t buffer_size() const { return m_buffer_size.value(); }
+  [[nodiscard]] bool shm_item_channel() const { return m_shm_item_channel; }
+  [[nodiscard]] bool legacy_work_items() const { return m_legacy_work_items; }
+  [[nodiscard]] HugePages huge_pages() const { return m_huge_pages; }
+  [[nodiscard]] int numa_node() const { return m_numa_node; }
 
 private:
   void parse_options(int argc, char* argv[]);
@@ -39,6 +51,13 @@ private:
   std::string m_monitor_uri;
   std::string m_tsmanager_address = "login";
   Nanoseconds m_timeout = 1_s;
+  std::vector<std::string> m_rails;
+  SizeValue m_stripe_size = 1_MiB;
+  std::vector<std::size_t> m_publish_components;
   std::string m_shm_id = "flesnet_ts_builder";
   SizeValue m_buffer_size = 20_GiB;
+  bool m_shm_item_channel = false;
+  bool m_legacy_work_items = false;
+  HugePages m_huge_pages = HugePages::none;
+  int m_numa_node = -1;
 };
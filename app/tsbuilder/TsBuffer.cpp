@@ -6,12 +6,14 @@
 #include "SubTimeslice.hpp"
 #include "TimesliceDescriptor.hpp"
 #include "TimesliceShmWorkItem.hpp"
+#include "TimesliceShmWorkItemEncoding.hpp"
 #include "Utility.hpp"
-#include <boost/archive/binary_oarchive.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <cassert>
 #include <memory>
+#include <new>
+#include <stdexcept>
 
 namespace zmq {
 class context_t;
@@ -20,16 +22,35 @@ class context_t;
 TsBuffer::TsBuffer(zmq::context_t& context,
                    const std::string& distributor_address,
                    std::string shm_identifier,
-                   std::size_t buffer_size)
-    : ItemProducer(context, distributor_address),
-      m_shm_identifier(std::move(shm_identifier)), m_buffer_size(buffer_size) {
+                   std::size_t buffer_size,
+                   bool shm_item_channel,
+                   bool legacy_work_items,
+                   HugePages huge_pages,
+                   int numa_node)
+    : m_shm_identifier(std::move(shm_identifier)), m_buffer_size(buffer_size),
+      m_legacy_work_items(legacy_work_items), m_allocator(0) {
   boost::uuids::random_generator uuid_gen;
   m_shm_uuid = uuid_gen();
+  m_work_item.shm_uuid = m_shm_uuid;
+  m_work_item.shm_identifier = m_shm_identifier;
 
   boost::interprocess::shared_memory_object::remove(m_shm_identifier.c_str());
 
-  constexpr size_t overhead_size = 4096; // Wild guess, let's hope it's enough
-  size_t managed_shm_size = m_buffer_size + overhead_size;
+  // Segment manager header, plus the bookkeeping of each allocation (block
+  // header, named object header and index node, less than 128 bytes with
+  // current Boost versions) for the uuid and the timeslice data region
+  using segment_manager =
+      boost::interprocess::managed_shared_memory::segment_manager;
+  constexpr size_t allocation_overhead = 256;
+  size_t managed_shm_size = m_buffer_size + segment_manager::get_min_size() +
+                            sizeof(boost::uuids::uuid) +
+                            2 * allocation_overhead;
+  if (shm_item_channel) {
+    // Space for the channel and the work item payloads
+    constexpr size_t payload_space = 1 << 20;
+    managed_shm_size +=
+        sizeof(ShmItemChannel) + allocation_overhead + payload_space;
+  }
 
   INFO("Creating shared memory segment '{}' of size {}", m_shm_identifier,
        human_readable_count(managed_shm_size, true));
@@ -39,10 +60,43 @@ TsBuffer::TsBuffer(zmq::context_t& context,
 
   m_managed_shm->construct<boost::uuids::uuid>(
       boost::interprocess::unique_instance)(m_shm_uuid);
+
+  // The timeslice data region is allocated once and managed by the ring
+  // allocator, as timeslices are mostly released in order
+  m_data = static_cast<std::byte*>(
+      m_managed_shm->allocate(m_buffer_size, std::nothrow));
+  if (m_data == nullptr) {
+    throw std::runtime_error("shared memory segment too small for timeslice "
+                             "buffer");
+  }
+  m_allocator = RingAllocator(m_buffer_size);
+  if (huge_pages != HugePages::none) {
+    if (advise_huge_pages(m_data, m_buffer_size)) {
+      INFO("Using transparent huge pages for timeslice buffer");
+    } else {
+      WARN("Cannot use transparent huge pages for timeslice buffer");
+    }
+  }
+  if (numa_node >= 0) {
+    if (bind_memory_to_numa_node(m_data, m_buffer_size, numa_node)) {
+      INFO("Bound timeslice buffer to NUMA node {}", numa_node);
+    } else {
+      WARN("Cannot bind timeslice buffer to NUMA node {}", numa_node);
+    }
+  }
   DEBUG("Shared memory segment '{}' initialized", m_shm_identifier);
+
+  if (shm_item_channel) {
+    m_shm_item_producer = std::make_unique<ShmItemProducer>(*m_managed_shm);
+    INFO("Using shared memory item channel");
+  } else {
+    m_item_producer =
+        std::make_unique<ItemProducer>(context, distributor_address);
+  }
 }
 
 TsBuffer::~TsBuffer() {
+  m_shm_item_producer = nullptr;
   INFO("Removing shared memory segment '{}'", m_shm_identifier);
   boost::interprocess::shared_memory_object::remove(m_shm_identifier.c_str());
 }
@@ -57,10 +111,11 @@ void TsBuffer::send_work_item(std::byte* buffer,
   d.flags = ts_desc.flags;
   d.num_components = ts_desc.components.size();
 
-  fles::TimesliceShmWorkItem item{};
-  item.shm_uuid = m_shm_uuid;
-  item.shm_identifier = m_shm_identifier;
+  // The work item object is reused to avoid reallocating its vectors
+  fles::TimesliceShmWorkItem& item = m_work_item;
   item.ts_desc = d;
+  item.data.clear();
+  item.tsc_desc.clear();
   for (const auto& c : ts_desc.components) {
     fles::TimesliceComponentDescriptor tscd{};
     tscd.ts_num = static_cast<uint64_t>(id); // unused
@@ -73,9 +128,13 @@ void TsBuffer::send_work_item(std::byte* buffer,
     item.tsc_desc.push_back(tscd);
   }
 
-  std::vector<std::byte> bytes = to_bytes(item);
-  std::string bytes_str(reinterpret_cast<const char*>(bytes.data()),
-                        bytes.size());
-  ItemProducer::send_work_item(id, bytes_str);
+  const std::string bytes_str = m_legacy_work_items
+                                    ? fles::encode_work_item_boost(item)
+                                    : fles::encode_work_item_binary(item);
+  if (m_shm_item_producer) {
+    m_shm_item_producer->send_work_item(id, bytes_str);
+  } else {
+    m_item_producer->send_work_item(id, bytes_str);
+  }
   m_outstanding.insert(id);
 }
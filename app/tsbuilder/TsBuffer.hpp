@@ -4,7 +4,11 @@
 #pragma once
 
 #include "ItemProducer.hpp"
+#include "MemoryPlacement.hpp"
+#include "RingAllocator.hpp"
+#include "ShmItemProducer.hpp"
 #include "SubTimeslice.hpp"
+#include "TimesliceShmWorkItem.hpp"
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <cstddef>
@@ -23,15 +27,22 @@ class context_t;
 }
 
 /// Timeslice buffer container class.
-/** A TsBuffer object represents the build node's timeslice buffer
+/** A TsBuffer object represents the build node's timeslice buffer. Work items
+ * are passed to the workers either through the ItemDistributor (ZMQ) or
+ * through an item channel in the shared memory segment. Timeslice data is
+ * placed in a region of the shared memory segment used as a ring.
  */
 
-class TsBuffer : public ItemProducer {
+class TsBuffer {
 public:
   TsBuffer(zmq::context_t& context,
            const std::string& distributor_address,
            std::string shm_identifier,
-           std::size_t buffer_size);
+           std::size_t buffer_size,
+           bool shm_item_channel,
+           bool legacy_work_items,
+           HugePages huge_pages,
+           int numa_node);
 
   TsBuffer(const TsBuffer&) = delete;
   void operator=(const TsBuffer&) = delete;
@@ -45,16 +56,33 @@ public:
             m_managed_shm->get_size()};
   }
 
+  /// Retrieve the number of bytes not occupied by timeslices.
   [[nodiscard]] std::size_t get_free_memory() const {
-    return m_managed_shm->get_free_memory();
+    return m_buffer_size - m_allocator.statistics().live_bytes;
   }
 
-  [[nodiscard]] std::byte* allocate(std::size_t size) {
-    void* raw_ptr = m_managed_shm->allocate(size, std::nothrow);
-    return static_cast<std::byte*>(raw_ptr);
+  /// Retrieve the size of the largest timeslice that can be allocated.
+  [[nodiscard]] std::size_t get_max_allocation() const {
+    return m_allocator.max_allocation();
   }
 
-  void deallocate(std::byte* ptr) { m_managed_shm->deallocate(ptr); }
+  [[nodiscard]] std::optional<RingAllocator::Allocation>
+  allocate(std::size_t size) {
+    return m_allocator.allocate(size);
+  }
+
+  void deallocate(const RingAllocator::Allocation& allocation) {
+    m_allocator.release(allocation);
+  }
+
+  [[nodiscard]] std::byte*
+  get_address(const RingAllocator::Allocation& allocation) const {
+    return m_data + allocation.offset;
+  }
+
+  [[nodiscard]] const RingAllocator& get_allocator() const {
+    return m_allocator;
+  }
 
   /// Send a work item to the item distributor.
   void send_work_item(std::byte* buffer, TsId id, const StDescriptor& ts_desc);
@@ -62,7 +90,10 @@ public:
   /// Receive a completion from the item distributor.
   [[nodiscard]] std::optional<ItemID> try_receive_completion() {
     ItemID id;
-    if (!ItemProducer::try_receive_completion(&id)) {
+    const bool received =
+        m_shm_item_producer ? m_shm_item_producer->try_receive_completion(&id)
+                            : m_item_producer->try_receive_completion(&id);
+    if (!received) {
       return std::nullopt;
     }
     if (m_outstanding.erase(id) != 1) {
@@ -75,8 +106,18 @@ private:
   std::string m_shm_identifier;    ///< shared memory identifier
   boost::uuids::uuid m_shm_uuid{}; ///< shared memory UUID
   std::size_t m_buffer_size;       ///< buffer size in bytes
+  bool m_legacy_work_items;        ///< encode work items as Boost archives
+
+  fles::TimesliceShmWorkItem m_work_item; ///< reused work item object
 
   std::unique_ptr<boost::interprocess::managed_shared_memory>
       m_managed_shm;              ///< shared memory object
   std::set<ItemID> m_outstanding; ///< set of outstanding work items
+
+  std::byte* m_data = nullptr; ///< timeslice data region in shared memory
+  RingAllocator m_allocator;   ///< allocator for the timeslice data region
+
+  std::unique_ptr<ItemProducer> m_item_producer; ///< ZMQ item transport
+  std::unique_ptr<ShmItemProducer>
+      m_shm_item_producer; ///< shared memory item transport
 };
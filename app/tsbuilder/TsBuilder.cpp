@@ -8,6 +8,7 @@
 #include "TsbProtocol.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <array>
 #include <cstddef>
@@ -28,12 +29,38 @@ TsBuilder::TsBuilder(volatile sig_atomic_t* signal_status,
                      TsBuffer& timeslice_buffer,
                      std::string_view manager_address,
                      int64_t timeout_ns,
+                     std::vector<std::string> rails,
+                     uint64_t stripe_size,
+                     std::vector<std::size_t> publish_components,
                      cbm::Monitor* monitor)
     : m_signal_status(signal_status), m_timeslice_buffer(timeslice_buffer),
       m_manager_address(manager_address), m_timeout_ns(timeout_ns),
+      m_rail_specs(std::move(rails)), m_stripe_size(stripe_size),
+      m_publish_components(std::move(publish_components)),
       m_hostname(fles::system::current_hostname()),
       m_builder_info(m_hostname, fles::system::current_pid()),
       m_builder_info_bytes(to_bytes(m_builder_info)), m_monitor(monitor) {
+  if (m_rail_specs.size() > MAX_RAILS) {
+    throw std::invalid_argument("too many rails");
+  }
+  std::ranges::sort(m_publish_components);
+  m_publish_components.erase(std::ranges::unique(m_publish_components).begin(),
+                             m_publish_components.end());
+  const std::size_t num_rails = std::max<std::size_t>(m_rail_specs.size(), 1);
+  for (std::size_t i = 0; i < num_rails; ++i) {
+    m_rails.push_back(std::make_unique<BuilderRail>(this, i));
+  }
+
+  if (m_monitor != nullptr) {
+    auto& series = m_monitor->RegisterSeries("tsbuilder_publish",
+                                             {{"host", m_hostname}});
+    m_publish_count = series.Counter("timeslice_count");
+    m_publish_latency =
+        series.Histogram("latency_ns", {1000000, 2000000, 5000000, 10000000,
+                                        20000000, 50000000, 100000000,
+                                        200000000, 500000000, 1000000000});
+  }
+
   // Initialize event handling
   m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
   if (m_epoll_fd == -1) {
@@ -50,7 +77,10 @@ TsBuilder::~TsBuilder() {
 // Main operation loop
 
 void TsBuilder::run() {
-  if (!ucx::util::init(m_context, m_worker, m_epoll_fd, m_ucx_loop_mode)) {
+  const std::string_view rail0 =
+      m_rail_specs.empty() ? std::string_view() : m_rail_specs.front();
+  if (!ucx::util::init(m_context, m_worker, m_epoll_fd, m_ucx_loop_mode,
+                       false, rail0)) {
     ERROR("Failed to initialize UCX");
     return;
   }
@@ -63,12 +93,18 @@ void TsBuilder::run() {
     ERROR("Failed to register receive handlers");
     return;
   }
+  if (!init_rails()) {
+    cleanup_rails();
+    return;
+  }
   connect_to_manager_if_needed();
   send_periodic_status_to_manager();
   report_status();
 
+  // With multiple rails, waiting would only progress the main worker
+  const int timeout_ms = m_rails.size() > 1 ? 0 : 100;
   while (*m_signal_status == 0) {
-    if (ucp_worker_progress(m_worker) != 0) {
+    if (progress_rails() != 0) {
       continue;
     }
     if (auto id = m_timeslice_buffer.try_receive_completion()) {
@@ -77,7 +113,7 @@ void TsBuilder::run() {
     }
     m_tasks.timer();
 
-    if (!ucx::util::arm_worker_and_wait(m_worker, m_epoll_fd, 100,
+    if (!ucx::util::arm_worker_and_wait(m_worker, m_epoll_fd, timeout_ms,
                                         m_ucx_loop_mode)) {
       break;
     }
@@ -86,9 +122,10 @@ void TsBuilder::run() {
   disconnect_from_manager();
   disconnect_from_senders();
   // Drain remaining UCX internal operations (e.g., rendezvous protocol
-  // buffers) before destroying the worker
-  while (ucp_worker_progress(m_worker) != 0) {
+  // buffers) before destroying the workers
+  while (progress_rails() != 0) {
   }
+  cleanup_rails();
   if (m_buffer_memh != nullptr) {
     ucx::util::unregister_memory(m_context, m_buffer_memh);
     m_buffer_memh = nullptr;
@@ -96,10 +133,55 @@ void TsBuilder::run() {
   ucx::util::cleanup(m_context, m_worker);
 }
 
+// Rail management
+
+bool TsBuilder::init_rails() {
+  m_rails.front()->worker = m_worker;
+  for (std::size_t i = 1; i < m_rails.size(); ++i) {
+    BuilderRail& rail = *m_rails[i];
+    const std::string& spec = m_rail_specs[i];
+    if (!ucx::util::create_context(rail.context, m_ucx_loop_mode, false,
+                                   spec) ||
+        !ucx::util::create_worker(rail.context, rail.worker, m_epoll_fd,
+                                  m_ucx_loop_mode)) {
+      ERROR("Failed to initialize UCX for rail {} ('{}')", i, spec);
+      return false;
+    }
+    if (auto memh = ucx::util::register_memory(
+            rail.context, m_timeslice_buffer.get_memory_region())) {
+      rail.memh = *memh;
+    }
+    INFO("Using rail {} ('{}')", i, spec);
+  }
+  return true;
+}
+
+void TsBuilder::cleanup_rails() {
+  for (std::size_t i = 1; i < m_rails.size(); ++i) {
+    BuilderRail& rail = *m_rails[i];
+    if (rail.memh != nullptr) {
+      ucx::util::unregister_memory(rail.context, rail.memh);
+      rail.memh = nullptr;
+    }
+    ucx::util::cleanup(rail.context, rail.worker);
+  }
+  m_rails.front()->worker = nullptr;
+}
+
+std::size_t TsBuilder::progress_rails() {
+  std::size_t count = 0;
+  for (const auto& rail : m_rails) {
+    if (rail->worker != nullptr) {
+      count += ucp_worker_progress(rail->worker);
+    }
+  }
+  return count;
+}
+
 // Manager connection management
 
 void TsBuilder::connect_to_manager_if_needed() {
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
   if (!m_manager_connecting && !m_manager_connected && *m_signal_status == 0) {
     connect_to_manager();
   }
@@ -215,7 +297,9 @@ void TsBuilder::send_status_to_manager(uint64_t event, TsId id) {
     return;
   }
 
-  uint64_t bytes_free = m_timeslice_buffer.get_free_memory();
+  // Report the largest possible allocation, as the manager compares it to the
+  // size of the next timeslice
+  uint64_t bytes_free = m_timeslice_buffer.get_max_allocation();
   std::array<uint64_t, 3> hdr{event, id, bytes_free};
   auto header = std::as_bytes(std::span(hdr));
 
@@ -227,7 +311,7 @@ void TsBuilder::send_status_to_manager(uint64_t event, TsId id) {
 
 void TsBuilder::send_periodic_status_to_manager() {
   constexpr auto interval = std::chrono::seconds(1);
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
 
   if (m_manager_connected) {
     send_status_to_manager(BUILDER_EVENT_NO_OP, 0);
@@ -239,7 +323,7 @@ void TsBuilder::send_periodic_status_to_manager() {
 void TsBuilder::check_for_timeout(TsId id) {
   if (m_ts_handles.contains(id)) {
     auto& tsh = *m_ts_handles.at(id);
-    if (tsh.is_published) {
+    if (tsh.is_received) {
       return;
     }
     WARN("{}| Build timeout (after {} ms)", id,
@@ -286,22 +370,35 @@ ucs_status_t TsBuilder::handle_manager_assign_ts(
   }
 
   // Try to allocate memory for the content
-  auto* buffer = m_timeslice_buffer.allocate(ms_data_size);
-  if (buffer == nullptr) {
-    INFO("{}| Failed to allocate {} of contiguous memory (free: {} of {})", id,
-         human_readable_count(ms_data_size, true),
+  auto allocation = m_timeslice_buffer.allocate(ms_data_size);
+  if (!allocation) {
+    INFO("{}| Failed to allocate {} of contiguous memory (free: {} of {}, "
+         "largest: {})",
+         id, human_readable_count(ms_data_size, true),
          human_readable_count(m_timeslice_buffer.get_free_memory(), true),
-         human_readable_count(m_timeslice_buffer.get_size(), true));
+         human_readable_count(m_timeslice_buffer.get_size(), true),
+         human_readable_count(m_timeslice_buffer.get_max_allocation(), true));
     send_status_to_manager(BUILDER_EVENT_OUT_OF_MEMORY, id);
     return UCS_OK;
   }
 
-  m_ts_handles.emplace(id,
-                       std::make_unique<TsHandle>(buffer, std::move(*desc)));
+  m_ts_handles.emplace(
+      id, std::make_unique<TsHandle>(
+              *allocation, m_timeslice_buffer.get_address(*allocation),
+              std::move(*desc)));
   auto& tsh = *m_ts_handles.at(id);
   m_timeslice_count++;
   send_status_to_manager(BUILDER_EVENT_ALLOCATED, id);
 
+  // Publish early once the selected components (those present in this
+  // timeslice) are complete, if their reception can be tracked
+  if (tsh.has_component_layout) {
+    tsh.early_components_pending = static_cast<std::size_t>(
+        std::ranges::count_if(m_publish_components, [&](std::size_t k) {
+          return k < tsh.merged_descriptor.components.size();
+        }));
+  }
+
   DEBUG("{}| Received assignment ({}s, {})", id, tsh.sender_ids.size(),
         human_readable_count(ms_data_size, true));
 
@@ -318,174 +415,267 @@ ucs_status_t TsBuilder::handle_manager_assign_ts(
       // Posting the receives failed; do not trigger unmatched sends
       continue;
     }
-    send_request_to_sender(tsh.sender_ids[i], id, i);
+    send_request_to_sender(tsh, i);
     update_st_state(tsh, i, StState::Requested);
   }
 
-  // Handle potential future timeout
-  m_tasks.add([this, id] { check_for_timeout(id); },
-              std::chrono::system_clock::now() +
-                  std::chrono::nanoseconds(m_timeout_ns));
+  // Handle potential future timeout (cancelled when published)
+  tsh.timeout = m_tasks.add([this, id] { check_for_timeout(id); },
+                            Scheduler::clock::now() +
+                                std::chrono::nanoseconds(m_timeout_ns));
 
   return UCS_OK;
 }
 
 // Sender connection management
 
-void TsBuilder::connect_to_sender(const std::string& sender_id) {
+void TsBuilder::connect_to_sender(BuilderRail& rail,
+                                  const std::string& sender_id) {
   auto [address, port] =
       ucx::util::parse_address(sender_id, DEFAULT_SENDER_PORT);
-  auto ep = ucx::util::connect(m_worker, address, port, on_sender_error, this);
+  port = static_cast<uint16_t>(port + rail.index);
+  auto ep =
+      ucx::util::connect(rail.worker, address, port, on_sender_error, &rail);
   if (ep) {
-    DEBUG("Connecting to sender at '{}:{}'", address, port);
+    DEBUG("Connecting to sender at '{}:{}' (rail {})", address, port,
+          rail.index);
   } else {
-    ERROR("Failed to connect to sender at '{}:{}'", address, port);
+    ERROR("Failed to connect to sender at '{}:{}' (rail {})", address, port,
+          rail.index);
     return;
   }
 
-  m_sender_to_ep[sender_id] = *ep;
-  m_ep_to_sender[*ep] = sender_id;
+  rail.sender_to_ep[sender_id] = *ep;
+  rail.ep_to_sender[*ep] = sender_id;
 }
 
-void TsBuilder::handle_sender_error(ucp_ep_h ep, ucs_status_t status) {
-  if (!m_ep_to_sender.contains(ep)) {
+void TsBuilder::handle_sender_error(BuilderRail& rail,
+                                    ucp_ep_h ep,
+                                    ucs_status_t status) {
+  if (!rail.ep_to_sender.contains(ep)) {
     ERROR("Received error for unknown sender endpoint: {}", status);
     return;
   }
-  ucx::util::close_endpoint(m_worker, ep, true);
+  ucx::util::close_endpoint(rail.worker, ep, true);
 
-  auto sender = m_ep_to_sender[ep];
-  INFO("Sender '{}' disconnected: {}", sender, status);
+  auto sender = rail.ep_to_sender[ep];
+  INFO("Sender '{}' disconnected (rail {}): {}", sender, rail.index, status);
 
-  m_ep_to_sender.erase(ep);
-  m_sender_to_ep.erase(sender);
+  rail.ep_to_sender.erase(ep);
+  rail.sender_to_ep.erase(sender);
 }
 
 void TsBuilder::disconnect_from_senders() {
   // Cancel all in-flight receive operations first
-  for (const auto& [request, req_id] : m_active_data_recv_requests) {
-    ucp_request_cancel(m_worker, request);
-  }
-  // Progress worker to process cancellations
-  while (ucp_worker_progress(m_worker) != 0) {
+  for (const auto& [request, info] : m_active_data_recv_requests) {
+    ucp_request_cancel(m_rails[info.rail]->worker, request);
   }
-
-  if (m_ep_to_sender.empty()) {
-    return;
+  // Progress workers to process cancellations
+  while (progress_rails() != 0) {
   }
-  INFO("Disconnecting from {} senders", m_ep_to_sender.size());
 
-  // Collect endpoints and clear maps before closing, so that error
-  // callbacks during close do not modify the maps during iteration
-  std::vector<ucp_ep_h> eps_to_close;
-  eps_to_close.reserve(m_ep_to_sender.size());
-  for (const auto& [ep, _] : m_ep_to_sender) {
-    eps_to_close.push_back(ep);
-  }
-  m_ep_to_sender.clear();
-  m_sender_to_ep.clear();
+  for (const auto& rail : m_rails) {
+    if (rail->ep_to_sender.empty()) {
+      continue;
+    }
+    INFO("Disconnecting from {} senders (rail {})", rail->ep_to_sender.size(),
+         rail->index);
+
+    // Collect endpoints and clear maps before closing, so that error
+    // callbacks during close do not modify the maps during iteration
+    std::vector<ucp_ep_h> eps_to_close;
+    eps_to_close.reserve(rail->ep_to_sender.size());
+    for (const auto& [ep, _] : rail->ep_to_sender) {
+      eps_to_close.push_back(ep);
+    }
+    rail->ep_to_sender.clear();
+    rail->sender_to_ep.clear();
 
-  for (auto* ep : eps_to_close) {
-    ucx::util::close_endpoint(m_worker, ep, true);
+    for (auto* ep : eps_to_close) {
+      ucx::util::close_endpoint(rail->worker, ep, true);
+    }
   }
 }
 
 // Sender message handling
 
+std::size_t TsBuilder::count_chunks(const TsHandle& tsh,
+                                    std::size_t ci) const {
+  const auto& blocks = tsh.blocks[ci];
+  return for_each_rail_chunk(
+      blocks.size(), [&](std::size_t b) { return blocks[b].size; }, 0, 1,
+      stripe_size(), [](const StDataChunk&) {});
+}
+
 void TsBuilder::post_tag_recvs(TsHandle& tsh, std::size_t ci) {
   const ucp_tag_t tag = make_st_data_tag(tsh.id, static_cast<uint32_t>(ci));
   const ucp_tag_t tag_mask = ~ucp_tag_t{0}; // exact match
-
-  // Post one receive per transfer block, all with the same tag: tag matching
-  // is FIFO per tag, and the sender sends the blocks in the same order.
-  for (const auto& block : tsh.blocks[ci]) {
-    ucp_request_param_t req_param{};
-    req_param.op_attr_mask =
-        UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    req_param.cb.recv = on_sender_data_recv_complete;
-    req_param.user_data = this;
-
-    ucs_status_ptr_t request =
-        ucp_tag_recv_nbx(m_worker, tsh.buffer + block.offset, block.size, tag,
-                         tag_mask, &req_param);
-
-    if (UCS_PTR_IS_ERR(request)) {
-      ucs_status_t status = UCS_PTR_STATUS(request);
-      ERROR("{}|s{}/{}| Failed to post tag recv: {}", tsh.id, ci,
-            tsh.sender_ids.size(), status);
+  const auto& blocks = tsh.blocks[ci];
+  auto block_size = [&](std::size_t b) { return blocks[b].size; };
+
+  // Post one receive per transfer block (or chunk of a block, with multiple
+  // rails) on the worker of the rail it is sent over, all with the same tag:
+  // tag matching is FIFO per tag, and the sender sends the chunks of each
+  // rail in the same order. Chunks are received at their final position.
+  tsh.blocks_remaining[ci] = 0;
+  tsh.block_chunks_remaining[ci].assign(blocks.size(), 0);
+  for_each_rail_chunk(blocks.size(), block_size, 0, 1, stripe_size(),
+                      [&](const StDataChunk& chunk) {
+                        ++tsh.block_chunks_remaining[ci][chunk.block];
+                        ++tsh.blocks_remaining[ci];
+                      });
+  for (const auto& rail : m_rails) {
+    bool failed = false;
+    for_each_rail_chunk(
+        blocks.size(), block_size, rail->index, m_rails.size(), stripe_size(),
+        [&](const StDataChunk& chunk) {
+          if (failed) {
+            return;
+          }
+          ucp_request_param_t req_param{};
+          req_param.op_attr_mask =
+              UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
+          req_param.cb.recv = on_sender_data_recv_complete;
+          req_param.user_data = this;
+
+          std::byte* buffer =
+              tsh.buffer + blocks[chunk.block].offset + chunk.offset;
+          ucs_status_ptr_t request = ucp_tag_recv_nbx(
+              rail->worker, buffer, chunk.size, tag, tag_mask, &req_param);
+
+          if (UCS_PTR_IS_ERR(request)) {
+            ucs_status_t status = UCS_PTR_STATUS(request);
+            ERROR("{}|s{}/{}| Failed to post tag recv: {}", tsh.id, ci,
+                  tsh.sender_ids.size(), status);
+            failed = true;
+            return;
+          }
+
+          if (request == nullptr) {
+            // Already completed (shouldn't normally happen for a pre-posted
+            // recv since the matching send hasn't been requested yet, but
+            // handle it).
+            complete_chunk(tsh, ci, chunk.block);
+            return;
+          }
+
+          m_active_data_recv_requests[request] = {tsh.id, ci, chunk.size,
+                                                  rail->index, chunk.block};
+          tsh.recv_requests[ci].push_back(request);
+        });
+    if (failed) {
       update_st_state(tsh, ci, StState::Failed);
       cancel_data_recvs(tsh.id, ci);
       return;
     }
-
-    if (request == nullptr) {
-      // Already completed (shouldn't normally happen for a pre-posted recv
-      // since the matching send hasn't been requested yet, but handle it).
-      complete_block(tsh, ci);
-      continue;
-    }
-
-    m_active_data_recv_requests[request] = {tsh.id, ci, block.size};
   }
 }
 
 // Cancel all outstanding data receive operations of one contribution.
-// Collect the requests first: ucp_request_cancel may invoke the completion
-// callback inline, which erases from m_active_data_recv_requests.
-// That callback can also re-enter this function and cancel (and free) the
-// remaining requests of the contribution, so re-check every request against
-// the map before cancelling it.
+// Take the contribution's request list first: ucp_request_cancel may invoke
+// the completion callback inline, which erases from
+// m_active_data_recv_requests. That callback can also re-enter this function
+// and cancel (and free) the remaining requests of the contribution, so
+// re-check every request against the map before cancelling it. Completed
+// requests stay in the list, and UCX may have reused their memory for a
+// request of another contribution, so the map entry has to match as well.
 void TsBuilder::cancel_data_recvs(TsId id, std::size_t ci) {
-  std::vector<ucs_status_ptr_t> to_cancel;
-  for (const auto& [request, info] : m_active_data_recv_requests) {
-    if (info.id == id && info.ci == ci) {
-      to_cancel.push_back(request);
-    }
+  auto tsh_it = m_ts_handles.find(id);
+  if (tsh_it == m_ts_handles.end() ||
+      ci >= tsh_it->second->recv_requests.size()) {
+    return;
   }
+  const std::vector<ucs_status_ptr_t> to_cancel =
+      std::move(tsh_it->second->recv_requests[ci]);
+  tsh_it->second->recv_requests[ci].clear();
   for (auto* request : to_cancel) {
-    if (m_active_data_recv_requests.contains(request)) {
-      ucp_request_cancel(m_worker, request);
+    auto it = m_active_data_recv_requests.find(request);
+    if (it != m_active_data_recv_requests.end() && it->second.id == id &&
+        it->second.ci == ci) {
+      ucp_request_cancel(m_rails[it->second.rail]->worker, request);
     }
   }
 }
 
-// Account for a completed transfer block; the contribution is complete when
-// all of its blocks have been received.
-void TsBuilder::complete_block(TsHandle& tsh, std::size_t ci) {
+// Account for a received chunk. A component is complete when both of its
+// transfer blocks are, the contribution when all of its chunks are.
+void TsBuilder::complete_chunk(TsHandle& tsh,
+                               std::size_t ci,
+                               std::size_t block) {
   assert(tsh.blocks_remaining[ci] > 0);
+  auto& remaining = tsh.block_chunks_remaining[ci];
+  assert(remaining[block] > 0);
+  if (--remaining[block] == 0 &&
+      tsh.first_component[ci] != TsHandle::no_component) {
+    // A contribution with a component layout consists of a pair of blocks
+    // (descriptors, content) per component (see TsHandle)
+    assert(tsh.blocks[ci].size() % 2 == 0);
+    const std::size_t desc_block = block & ~std::size_t{1};
+    if (remaining[desc_block] == 0 && remaining[desc_block + 1] == 0) {
+      complete_component(tsh, tsh.first_component[ci] + block / 2);
+    }
+  }
   if (--tsh.blocks_remaining[ci] == 0) {
     m_component_count++;
     update_st_state(tsh, ci, StState::Complete);
   }
 }
 
-void TsBuilder::send_request_to_sender(const std::string& sender_id,
-                                       TsId id,
-                                       std::size_t ci) {
-  if (!m_sender_to_ep.contains(sender_id)) {
-    DEBUG("Connecting to sender '{}'", sender_id);
-    connect_to_sender(sender_id);
-    if (!m_sender_to_ep.contains(sender_id)) {
-      return;
-    }
+void TsBuilder::complete_component(TsHandle& tsh, std::size_t component) {
+  if (component >= m_component_latency.size()) {
+    m_component_latency.resize(component + 1);
   }
+  m_component_latency[component].record(fles::system::current_time_ns() -
+                                        tsh.allocated_at_ns);
 
-  auto* ep = m_sender_to_ep[sender_id];
-  const uint64_t tag = make_st_data_tag(id, static_cast<uint32_t>(ci));
-  std::array<uint64_t, 2> hdr{id, tag};
-  auto header = std::as_bytes(std::span(hdr));
+  if (tsh.early_components_pending == 0 ||
+      !std::ranges::binary_search(m_publish_components, component)) {
+    return;
+  }
+  if (--tsh.early_components_pending == 0 && !tsh.is_received) {
+    // The remaining contributions are received in the background
+    publish_early(tsh);
+  }
+}
 
-  // PROBLEM HERE: In the first invocation after connecting, we run into a UCX
-  // bug. UCX versions between 1.16 and 1.18 do not handle
-  // UCP_AM_SEND_FLAG_COPY_HEADER correctly when using protocol version 2,
-  // leading to data corruption. As a workaround, start the program with
-  // UCX_PROTO_ENABLE=n to disable protocol version 2 if you are not using
-  // UCX 1.19 or later. See: https://github.com/openucx/ucx/issues/10424
+void TsBuilder::send_request_to_sender(TsHandle& tsh, std::size_t ci) {
+  const std::string& sender_id = tsh.sender_ids[ci];
+  const uint64_t tag = make_st_data_tag(tsh.id, static_cast<uint32_t>(ci));
+  // Request the contribution on each rail that has chunks assigned. Requests
+  // for unsplit blocks over a single rail use the short header understood by
+  // all senders. The extended header (also on a single rail when publishing
+  // early) is only sent if --rails or --publish-components is given, and
+  // requires senders that support striped transfers.
+  const std::size_t num_rails = m_rails.size();
+  const std::size_t used_rails = std::min(num_rails, count_chunks(tsh, ci));
+  for (std::size_t r = 0; r < used_rails; ++r) {
+    BuilderRail& rail = *m_rails[r];
+    if (!rail.sender_to_ep.contains(sender_id)) {
+      DEBUG("Connecting to sender '{}' (rail {})", sender_id, r);
+      connect_to_sender(rail, sender_id);
+      if (!rail.sender_to_ep.contains(sender_id)) {
+        return;
+      }
+    }
 
-  ucx::util::send_active_message(ep, AM_BUILDER_REQUEST_ST, header, {},
-                                 ucx::util::on_generic_send_complete, this,
-                                 UCP_AM_SEND_FLAG_COPY_HEADER |
-                                     UCP_AM_SEND_FLAG_REPLY);
+    auto* ep = rail.sender_to_ep[sender_id];
+    std::array<uint64_t, 5> hdr{tsh.id, tag, r, num_rails, stripe_size()};
+    const bool extended = num_rails > 1 || stripe_size() != 0;
+    auto header =
+        std::as_bytes(std::span(hdr).first(extended ? hdr.size() : 2));
+
+    // PROBLEM HERE: In the first invocation after connecting, we run into a
+    // UCX bug. UCX versions between 1.16 and 1.18 do not handle
+    // UCP_AM_SEND_FLAG_COPY_HEADER correctly when using protocol version 2,
+    // leading to data corruption. As a workaround, start the program with
+    // UCX_PROTO_ENABLE=n to disable protocol version 2 if you are not using
+    // UCX 1.19 or later. See: https://github.com/openucx/ucx/issues/10424
+
+    ucx::util::send_active_message(ep, AM_BUILDER_REQUEST_ST, header, {},
+                                   ucx::util::on_generic_send_complete, this,
+                                   UCP_AM_SEND_FLAG_COPY_HEADER |
+                                       UCP_AM_SEND_FLAG_REPLY);
+  }
 }
 
 void TsBuilder::handle_sender_data_recv_complete(
@@ -499,7 +689,8 @@ void TsBuilder::handle_sender_data_recv_complete(
   if (!m_active_data_recv_requests.contains(request)) {
     ERROR("Received completion for unknown data recv request");
   } else {
-    auto [id, ci, expected_size] = m_active_data_recv_requests.at(request);
+    auto [id, ci, expected_size, rail, block] =
+        m_active_data_recv_requests.at(request);
     m_active_data_recv_requests.erase(request);
 
     if (!m_ts_handles.contains(id)) {
@@ -520,7 +711,7 @@ void TsBuilder::handle_sender_data_recv_complete(
     }
     if (status != UCS_OK || length != expected_size) {
       if (status == UCS_OK) {
-        ERROR("{}|s{}/{}| Unexpected received block length: expected {}, "
+        ERROR("{}|s{}/{}| Unexpected received chunk length: expected {}, "
               "got {}",
               id, ci, tsh.sender_ids.size(), expected_size, length);
       }
@@ -530,7 +721,7 @@ void TsBuilder::handle_sender_data_recv_complete(
       cancel_data_recvs(id, ci);
     } else {
       m_byte_count += length;
-      complete_block(tsh, ci);
+      complete_chunk(tsh, ci, block);
     }
   }
 
@@ -546,9 +737,27 @@ void TsBuilder::process_completion(TsId id) {
     ERROR("{}| Received completion for unknown timeslice", id);
     return;
   }
+  auto& tsh = *m_ts_handles.at(id);
+  if (tsh.is_early_outstanding) {
+    // The early subset is done; the complete timeslice is published as a
+    // separate work item (with the same item ID) once it is received
+    tsh.is_early_outstanding = false;
+    if (tsh.is_received) {
+      publish(tsh, build_published_descriptor(tsh));
+    } else {
+      DEBUG("{}| Early subset completed, awaiting remaining contributions",
+            id);
+    }
+    return;
+  }
+  release_timeslice(id);
+}
+
+void TsBuilder::release_timeslice(TsId id) {
   const uint64_t published_at_ns = m_ts_handles.at(id)->published_at_ns;
   const uint64_t now_ns = fles::system::current_time_ns();
-  m_timeslice_buffer.deallocate(m_ts_handles.at(id)->buffer);
+  m_timeslice_buffer.deallocate(m_ts_handles.at(id)->allocation);
+  m_tasks.cancel(m_ts_handles.at(id)->timeout);
   m_ts_handles.erase(id);
   send_status_to_manager(BUILDER_EVENT_RELEASED, id);
   DEBUG("{}| Released (after {} ms)", id,
@@ -578,31 +787,67 @@ void TsBuilder::update_st_state(TsHandle& tsh,
   }
   tsh.states[contribution_index] = new_state;
   tsh.state_change_at_ns[contribution_index] = now_ns;
-  if (new_state == StState::Complete || new_state == StState::Failed) {
-    if (std::all_of(tsh.states.begin(), tsh.states.end(), [](StState state) {
-          return state == StState::Complete || state == StState::Failed;
-        })) {
-      // All contributions are complete (or failed), publish the timeslice
-      if (!tsh.is_published) {
-        send_status_to_manager(BUILDER_EVENT_RECEIVED, tsh.id);
-        StDescriptor ts_desc = build_published_descriptor(tsh);
-        m_timeslice_buffer.send_work_item(tsh.buffer, tsh.id, ts_desc);
-        tsh.is_published = true;
-        tsh.published_at_ns = fles::system::current_time_ns();
-        if (ts_desc.has_flag(TsFlag::MissingSubtimeslices)) {
-          INFO("{}| Published incomplete timeslice (after {} ms)", tsh.id,
-               (tsh.published_at_ns - tsh.allocated_at_ns + 500000) / 1000000);
-          m_timeslice_incomplete_count++;
-        } else {
-          DEBUG("{}| Published (after {} ms)", tsh.id,
-                (tsh.published_at_ns - tsh.allocated_at_ns + 500000) / 1000000);
-        }
-      }
+  if ((new_state == StState::Complete || new_state == StState::Failed) &&
+      !tsh.is_received &&
+      std::all_of(tsh.states.begin(), tsh.states.end(), [](StState state) {
+        return state == StState::Complete || state == StState::Failed;
+      })) {
+    // All contributions are complete (or failed)
+    tsh.is_received = true;
+    m_tasks.cancel(tsh.timeout);
+    send_status_to_manager(BUILDER_EVENT_RECEIVED, tsh.id);
+    // An item ID can only be outstanding once, so a complete timeslice that
+    // was published early follows when the consumers are done with the subset
+    if (!tsh.is_early_outstanding) {
+      publish(tsh, build_published_descriptor(tsh));
     }
   }
 }
 
-StDescriptor TsBuilder::build_published_descriptor(TsHandle& tsh) {
+void TsBuilder::publish(TsHandle& tsh, const StDescriptor& ts_desc) {
+  m_timeslice_buffer.send_work_item(tsh.buffer, tsh.id, ts_desc);
+  tsh.is_published = true;
+  tsh.published_at_ns = fles::system::current_time_ns();
+  m_publish_count.Add();
+  m_publish_latency.Record(tsh.published_at_ns - tsh.allocated_at_ns);
+  const uint64_t elapsed_ms =
+      (tsh.published_at_ns - tsh.allocated_at_ns + 500000) / 1000000;
+  if (ts_desc.has_flag(TsFlag::MissingSubtimeslices)) {
+    INFO("{}| Published incomplete timeslice (after {} ms)", tsh.id,
+         elapsed_ms);
+    m_timeslice_incomplete_count++;
+  } else {
+    DEBUG("{}| Published (after {} ms)", tsh.id, elapsed_ms);
+  }
+}
+
+// Publish the selected components as a partial timeslice, the complete
+// timeslice is published when the remaining contributions are received
+void TsBuilder::publish_early(TsHandle& tsh) {
+  const StDescriptor ts_desc = build_early_descriptor(tsh);
+  m_timeslice_buffer.send_work_item(tsh.buffer, tsh.id, ts_desc);
+  tsh.is_early_outstanding = true;
+  m_timeslice_early_count++;
+  DEBUG("{}| Published {} of {} components early (after {} ms)", tsh.id,
+        ts_desc.components.size(), tsh.merged_descriptor.components.size(),
+        (fles::system::current_time_ns() - tsh.allocated_at_ns + 500000) /
+            1000000);
+}
+
+// The early published timeslice consists of the selected components only
+StDescriptor TsBuilder::build_early_descriptor(const TsHandle& tsh) const {
+  StDescriptor d = tsh.merged_descriptor;
+  d.components.clear();
+  for (std::size_t k : m_publish_components) {
+    if (k < tsh.merged_descriptor.components.size()) {
+      d.components.push_back(tsh.merged_descriptor.components[k]);
+    }
+  }
+  d.set_flag(TsFlag::PartialTimeslice);
+  return d;
+}
+
+StDescriptor TsBuilder::build_published_descriptor(const TsHandle& tsh) {
   // The manager has already merged per-sender descriptors into
   // tsh.merged_descriptor with absolute offsets. Here we only have to mark the
   // timeslice as incomplete if any contribution did not arrive.
@@ -616,7 +861,7 @@ StDescriptor TsBuilder::build_published_descriptor(TsHandle& tsh) {
 
 void TsBuilder::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
 
   if (m_monitor != nullptr) {
     size_t timeslices_allocated = m_ts_handles.size();
@@ -628,8 +873,50 @@ void TsBuilder::report_status() {
          {"component_count", m_component_count},
          {"byte_count", m_byte_count},
          {"timeslice_incomplete_count", m_timeslice_incomplete_count},
+         {"timeslice_early_count", m_timeslice_early_count},
          {"timeslices_allocated", timeslices_allocated},
          {"bytes_allocated", bytes_allocated}});
+
+    const auto& allocator = m_timeslice_buffer.get_allocator();
+    auto buffer = allocator.statistics();
+    m_monitor->QueueMetric(
+        "tsbuilder_buffer_status", {{"host", m_hostname}},
+        {{"allocation_count", buffer.allocation_count},
+         {"failure_count", buffer.failure_count},
+         {"fragmentation_failure_count", buffer.fragmentation_failure_count},
+         {"used_bytes", buffer.used_bytes},
+         {"live_bytes", buffer.live_bytes},
+         {"blocked_bytes", buffer.blocked_bytes},
+         {"padding_bytes", buffer.padding_bytes},
+         {"max_allocation", allocator.max_allocation()},
+         {"fragmentation", allocator.fragmentation()}});
+
+    // Reception latency histograms of the components since the last report
+    for (std::size_t k = 0; k < m_component_latency.size(); ++k) {
+      auto& histogram = m_component_latency[k];
+      if (histogram.count() == 0) {
+        continue;
+      }
+      cbm::MetricFieldSet fields{
+          {"count", histogram.count()},
+          {"latency_ns_sum", histogram.sum_ns()},
+          {"latency_ns_p50", histogram.quantile_ns(0.5)},
+          {"latency_ns_p90", histogram.quantile_ns(0.9)},
+          {"latency_ns_p99", histogram.quantile_ns(0.99)},
+          {"latency_ns_max", histogram.max_ns()}};
+      for (std::size_t b = 0; b < LatencyHistogram::bucket_count; ++b) {
+        if (histogram.buckets()[b] != 0) {
+          fields.emplace_back(
+              "bucket_" + std::to_string(LatencyHistogram::upper_bound_ns(b)),
+              histogram.buckets()[b]);
+        }
+      }
+      m_monitor->QueueMetric("tsbuilder_component_latency",
+                             {{"host", m_hostname},
+                              {"component", std::to_string(k)}},
+                             std::move(fields));
+      histogram.reset();
+    }
   }
 
   m_tasks.add([this] { report_status(); }, now + interval);
@@ -3,6 +3,8 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include "FlatHashMap.hpp"
+#include "LatencyHistogram.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "Monitor.hpp"
 #include "Scheduler.hpp"
@@ -15,6 +17,7 @@
 #include <cstdint>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <string_view>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
@@ -23,6 +26,7 @@
 #include <ucp/api/ucp_def.h>
 #include <unistd.h>
 #include <unordered_map>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -55,20 +59,25 @@ inline std::string to_string(StState state) {
 }
 
 /// A contiguous destination range within the timeslice buffer, received as
-/// one tagged message
+/// one tagged message (or as several chunks when striped across rails)
 struct StDataBlock {
   uint64_t offset = 0; ///< absolute offset within the timeslice buffer
   uint64_t size = 0;
 };
 
 struct TsHandle {
-  TsHandle(std::byte* buffer, StCollection contributions)
+  TsHandle(RingAllocator::Allocation allocation,
+           std::byte* buffer,
+           StCollection contributions)
       : id(contributions.id), allocated_at_ns(fles::system::current_time_ns()),
-        buffer(buffer), sender_ids(std::move(contributions.sender_ids)),
+        allocation(allocation), buffer(buffer),
+        sender_ids(std::move(contributions.sender_ids)),
         ms_data_sizes(std::move(contributions.ms_data_sizes)),
         merged_descriptor(std::move(contributions.merged_descriptor)),
         offsets(sender_ids.size()), states(sender_ids.size()),
-        state_change_at_ns(sender_ids.size()) {
+        state_change_at_ns(sender_ids.size()),
+        recv_requests(sender_ids.size()),
+        first_component(sender_ids.size(), no_component) {
     // Initialize offsets
     if (!ms_data_sizes.empty()) {
       std::partial_sum(ms_data_sizes.begin(), ms_data_sizes.end() - 1,
@@ -85,10 +94,13 @@ struct TsHandle {
     // absolute offsets, components in sender order.
     blocks.resize(sender_ids.size());
     blocks_remaining.resize(sender_ids.size(), 0);
+    block_chunks_remaining.resize(sender_ids.size());
+    has_component_layout = true;
     std::size_t comp = 0; // running index into merged_descriptor.components
     for (std::size_t ci = 0; ci < sender_ids.size(); ++ci) {
       uint64_t remaining = ms_data_sizes[ci];
       uint64_t pos = offsets[ci];
+      const std::size_t ci_first_component = comp;
       while (remaining > 0 && comp < merged_descriptor.components.size()) {
         const auto& c = merged_descriptor.components[comp];
         const uint64_t desc_size =
@@ -108,13 +120,19 @@ struct TsHandle {
         // full-size block (the transfer will fail via the timeout if the
         // sender disagrees)
         blocks[ci].assign(1, {offsets[ci], ms_data_sizes[ci]});
+        has_component_layout = false;
       } else if (blocks[ci].empty()) {
         // Empty contribution: the sender sends a single zero-size message to
         // keep the protocol synchronous
         blocks[ci].assign(1, {offsets[ci], 0});
+      } else {
+        first_component[ci] = ci_first_component;
       }
       blocks_remaining[ci] = blocks[ci].size();
     }
+    if (comp != merged_descriptor.components.size()) {
+      has_component_layout = false;
+    }
   }
 
   // Cannot be moved or copied (pointer to data is used by ucx)
@@ -124,6 +142,7 @@ struct TsHandle {
   const TsId id;
   const uint64_t allocated_at_ns;
   uint64_t published_at_ns = 0;
+  const RingAllocator::Allocation allocation;
   std::byte* const buffer;
   std::vector<std::string> sender_ids; // IDs of the senders
   std::vector<uint64_t> ms_data_sizes; // Sizes of the content data
@@ -132,8 +151,48 @@ struct TsHandle {
   std::vector<StState> states;
   std::vector<uint64_t> state_change_at_ns;
   std::vector<std::vector<StDataBlock>> blocks; ///< per contribution
-  std::vector<std::size_t> blocks_remaining;    ///< per contribution
-  bool is_published = false;
+  std::vector<std::size_t> blocks_remaining;    ///< chunks per contribution
+  /// Chunks remaining per transfer block, per contribution
+  std::vector<std::vector<std::size_t>> block_chunks_remaining;
+  /// Posted receive requests per contribution (possibly completed already)
+  std::vector<std::vector<ucs_status_ptr_t>> recv_requests;
+
+  static constexpr std::size_t no_component = SIZE_MAX;
+  /// Index of the first component of each contribution in the merged
+  /// descriptor (no_component if it has none or the layout is inconsistent)
+  std::vector<std::size_t> first_component;
+  /// Whether all components map to a pair of transfer blocks
+  bool has_component_layout = false;
+  /// Selected components still missing for early publishing (0: disabled)
+  std::size_t early_components_pending = 0;
+  /// The early published subset is not yet completed by the consumers
+  bool is_early_outstanding = false;
+
+  bool is_published = false; ///< complete timeslice published
+  bool is_received = false;  ///< all contributions complete or failed
+  Scheduler::Handle timeout; ///< pending build timeout
+};
+
+class TsBuilder;
+
+/// A UCX worker with its connections to the senders. Rail 0 uses the main
+/// context and worker, which also serve the manager connection. Additional
+/// rails (for striped transfers) use a context of their own, restricted to
+/// the rail's network devices, and connect to the sender port + rail.
+struct BuilderRail {
+  BuilderRail(TsBuilder* builder, std::size_t index)
+      : builder(builder), index(index) {}
+  BuilderRail(const BuilderRail&) = delete;
+  BuilderRail& operator=(const BuilderRail&) = delete;
+
+  TsBuilder* const builder;
+  const std::size_t index;
+  ucp_context_h context = nullptr; ///< own context (rail > 0 only)
+  ucp_worker_h worker = nullptr;
+  ucp_mem_h memh = nullptr; ///< registration in own context
+
+  std::unordered_map<std::string, ucp_ep_h> sender_to_ep;
+  std::unordered_map<ucp_ep_h, std::string> ep_to_sender;
 };
 
 class TsBuilder {
@@ -142,6 +201,9 @@ public:
             TsBuffer& timeslice_buffer,
             std::string_view manager_address,
             int64_t timeout_ns,
+            std::vector<std::string> rails,
+            uint64_t stripe_size,
+            std::vector<std::size_t> publish_components,
             cbm::Monitor* monitor);
   ~TsBuilder();
   TsBuilder(const TsBuilder&) = delete;
@@ -156,6 +218,11 @@ private:
 
   std::string m_manager_address;
   int64_t m_timeout_ns;
+  /// Device specifications of the rails (empty: single rail, UCX defaults)
+  std::vector<std::string> m_rail_specs;
+  uint64_t m_stripe_size; ///< chunk size of striped transfers
+  /// Components (sorted indices) after which a timeslice is published early
+  std::vector<std::size_t> m_publish_components;
   static constexpr ucx::util::LoopMode m_ucx_loop_mode =
       ucx::util::LoopMode::busy_poll;
   std::string m_hostname;
@@ -168,17 +235,17 @@ private:
   ucp_worker_h m_worker = nullptr;
   ucp_mem_h m_buffer_memh = nullptr;
 
-  std::unordered_map<std::string, ucp_ep_h> m_sender_to_ep;
-  std::unordered_map<ucp_ep_h, std::string> m_ep_to_sender;
+  std::vector<std::unique_ptr<BuilderRail>> m_rails;
 
-  std::unordered_map<TsId, std::unique_ptr<TsHandle>> m_ts_handles;
+  FlatHashMap<TsId, std::unique_ptr<TsHandle>> m_ts_handles;
   struct RecvRequestInfo {
     TsId id = 0;
     std::size_t ci = 0;
     uint64_t expected_size = 0;
+    std::size_t rail = 0;
+    std::size_t block = 0;
   };
-  std::unordered_map<ucs_status_ptr_t, RecvRequestInfo>
-      m_active_data_recv_requests;
+  FlatHashMap<ucs_status_ptr_t, RecvRequestInfo> m_active_data_recv_requests;
 
   static constexpr auto m_manager_retry_interval = 2s;
   bool m_mute_manager_reconnect = false;
@@ -191,6 +258,13 @@ private:
   size_t m_component_count = 0; ///< total number of received components
   size_t m_byte_count = 0;      ///< total number of processed bytes
   size_t m_timeslice_incomplete_count = 0; ///< number of incomplete timeslices
+  size_t m_timeslice_early_count = 0; ///< number of early published timeslices
+  /// Time from assignment to reception, per component index
+  std::vector<LatencyHistogram> m_component_latency;
+  /// Published timeslices and time from allocation to publication, updated
+  /// per timeslice and reported by the monitor
+  cbm::MetricCounter m_publish_count;
+  cbm::MetricHistogram m_publish_latency;
 
   // Manager connection management
   void connect_to_manager_if_needed();
@@ -210,29 +284,47 @@ private:
                                         size_t length,
                                         const ucp_am_recv_param_t* param);
 
+  // Rail management
+  bool init_rails();
+  void cleanup_rails();
+  std::size_t progress_rails();
+
   // Sender connection management
-  void connect_to_sender(const std::string& sender_id);
-  void handle_sender_error(ucp_ep_h ep, ucs_status_t status);
+  void connect_to_sender(BuilderRail& rail, const std::string& sender_id);
+  void
+  handle_sender_error(BuilderRail& rail, ucp_ep_h ep, ucs_status_t status);
   void disconnect_from_senders();
 
   // Sender message handling
+  /// Transfer blocks are split into chunks with multiple rails and when
+  /// publishing early (0: not split)
+  [[nodiscard]] uint64_t stripe_size() const {
+    return m_rails.size() > 1 || !m_publish_components.empty() ? m_stripe_size
+                                                               : 0;
+  }
+  [[nodiscard]] std::size_t count_chunks(const TsHandle& tsh,
+                                         std::size_t ci) const;
   void post_tag_recvs(TsHandle& tsh, std::size_t ci);
   void cancel_data_recvs(TsId id, std::size_t ci);
-  void complete_block(TsHandle& tsh, std::size_t ci);
-  void
-  send_request_to_sender(const std::string& sender_id, TsId id, std::size_t ci);
+  void complete_chunk(TsHandle& tsh, std::size_t ci, std::size_t block);
+  void complete_component(TsHandle& tsh, std::size_t component);
+  void send_request_to_sender(TsHandle& tsh, std::size_t ci);
   void handle_sender_data_recv_complete(void* request,
                                         ucs_status_t status,
                                         size_t length);
 
   // Queue processing
   void process_completion(TsId id);
+  void release_timeslice(TsId id);
 
   // Helper methods
   void update_st_state(TsHandle& tsh,
                        std::size_t contribution_index,
                        StState new_state);
-  static StDescriptor build_published_descriptor(TsHandle& tsh);
+  void publish(TsHandle& tsh, const StDescriptor& ts_desc);
+  void publish_early(TsHandle& tsh);
+  static StDescriptor build_published_descriptor(const TsHandle& tsh);
+  [[nodiscard]] StDescriptor build_early_descriptor(const TsHandle& tsh) const;
   void report_status();
 
   // UCX static callbacks (trampolines)
@@ -255,7 +347,8 @@ private:
         header, header_length, data, length, param);
   }
   static void on_sender_error(void* arg, ucp_ep_h ep, ucs_status_t status) {
-    static_cast<TsBuilder*>(arg)->handle_sender_error(ep, status);
+    auto* rail = static_cast<BuilderRail*>(arg);
+    rail->builder->handle_sender_error(*rail, ep, status);
   }
   static void on_sender_data_recv_complete(void* request,
                                            ucs_status_t status,
@@ -4,6 +4,7 @@
 
 #include "Application.hpp"
 #include "Parameters.hpp"
+#include "MemoryPlacement.hpp"
 #include "log.hpp"
 #include <csignal>
 
@@ -19,6 +20,14 @@ int main(int argc, char* argv[]) {
 
   try {
     Parameters par(argc, argv);
+    // Threads are started during application setup and inherit the affinity
+    if (par.numa_node() >= 0) {
+      if (run_on_numa_node(par.numa_node())) {
+        INFO("Running on NUMA node {}", par.numa_node());
+      } else {
+        WARN("Cannot run on NUMA node {}", par.numa_node());
+      }
+    }
     Application app(par, &signal_status);
     app.run();
   } catch (std::exception const& e) {
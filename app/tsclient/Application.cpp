@@ -2,7 +2,9 @@
 
 #include "Application.hpp"
 #include "ArchiveDescriptor.hpp"
+#include "ArchiveIndex.hpp"
 #include "Benchmark.hpp"
+#include "Crc32c.hpp"
 #include "ManagedTimesliceBuffer.hpp"
 #include "Monitor.hpp"
 #include "Parameters.hpp"
@@ -12,6 +14,7 @@
 #include "TimesliceAnalyzer.hpp"
 #include "TimesliceAutoSource.hpp"
 #include "TimesliceDebugger.hpp"
+#include "TimesliceInputArchive.hpp"
 #include "TimesliceOutputArchive.hpp"
 #include "TimeslicePublisher.hpp"
 #include "Utility.hpp"
@@ -20,6 +23,7 @@
 #include <csignal>
 #include <cstdint>
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -39,17 +43,43 @@ Application::Application(Parameters const& par,
     output_prefix_ = std::to_string(par_.client_index()) + ": ";
   }
 
-  source_ = std::make_unique<fles::TimesliceAutoSource>(par_.input_uri());
+  // Skip unselected timeslices without reading them if the input is a single
+  // indexed archive file
+  if (par_.offset() > 0 || par_.stride() > 1) {
+    UriComponents uri{par_.input_uri()};
+    const auto file_path = uri.authority + uri.path;
+    if ((uri.scheme == "file" || uri.scheme.empty()) &&
+        uri.query_components.empty() &&
+        std::filesystem::is_regular_file(file_path) &&
+        std::filesystem::exists(fles::ArchiveIndex::filename(file_path))) {
+      auto archive = std::make_unique<fles::TimesliceInputArchive>(file_path);
+      if (archive->has_index()) {
+        L_(debug) << output_prefix_ << "using archive index for random access";
+        seekable_source_ = archive.get();
+        source_ = std::move(archive);
+      }
+    }
+  }
+  if (!source_) {
+    source_ = std::make_unique<fles::TimesliceAutoSource>(par_.input_uri());
+  }
 
   if (par_.analyze()) {
+    if (par_.crc_engine()) {
+      set_crc32c_engine(*par_.crc_engine());
+    }
+    L_(debug) << output_prefix_
+              << "CRC-32C engine: " << to_string(crc32c_engine());
     if (par_.histograms()) {
       sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
           new TimesliceAnalyzer(1000, status_log_.stream, output_prefix_,
-                                &std::cout, monitor_.get())));
+                                &std::cout, monitor_.get(),
+                                par_.analyze_threads())));
     } else {
       sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
           new TimesliceAnalyzer(1000, status_log_.stream, output_prefix_,
-                                nullptr, monitor_.get())));
+                                nullptr, monitor_.get(),
+                                par_.analyze_threads())));
     }
   }
 
@@ -66,17 +96,37 @@ Application::Application(Parameters const& par,
     if (uri.scheme == "file" || uri.scheme.empty()) {
       size_t items = SIZE_MAX;
       size_t bytes = SIZE_MAX;
+      bool write_index = false;
       fles::ArchiveCompression compression = fles::ArchiveCompression::None;
+      int compression_level = 1;
+      size_t compression_threads = 1;
       for (auto& [key, value] : uri.query_components) {
         if (key == "items") {
           items = stoull(value);
         } else if (key == "bytes") {
           bytes = stoull(value);
+        } else if (key == "index") {
+          write_index = (value != "0");
+        } else if (key == "level") {
+          compression_level = stoi(value);
+          if (compression_level < 1) {
+            throw std::runtime_error(
+                "invalid compression level for scheme file: " + value);
+          }
+        } else if (key == "threads") {
+          compression_threads = stoull(value);
+          if (compression_threads < 1) {
+            throw std::runtime_error(
+                "invalid number of compression threads for scheme file: " +
+                value);
+          }
         } else if (key == "c") {
           if (value == "none") {
             compression = fles::ArchiveCompression::None;
           } else if (value == "zstd") {
             compression = fles::ArchiveCompression::Zstd;
+          } else if (value == "zstd-components") {
+            compression = fles::ArchiveCompression::ZstdComponents;
           } else {
             throw std::runtime_error(
                 "invalid compression type for scheme file: " + value);
@@ -89,11 +139,14 @@ Application::Application(Parameters const& par,
       const auto file_path = uri.authority + uri.path;
       if (items == SIZE_MAX && bytes == SIZE_MAX) {
         sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
-            new fles::TimesliceOutputArchive(file_path, compression)));
+            new fles::TimesliceOutputArchive(file_path, compression,
+                                             write_index, compression_level,
+                                             compression_threads)));
       } else {
         sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
-            new fles::TimesliceOutputArchiveSequence(file_path, items, bytes,
-                                                     compression)));
+            new fles::TimesliceOutputArchiveSequence(
+                file_path, items, bytes, compression, write_index,
+                compression_level, compression_threads)));
       }
 
     } else if (uri.scheme == "tcp") {
@@ -144,7 +197,7 @@ Application::Application(Parameters const& par,
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
 
-  if (par_.benchmark()) {
+  if (!par_.benchmark().empty()) {
     benchmark_ = std::make_unique<Benchmark>();
   }
 
@@ -204,13 +257,29 @@ void Application::try_delay(std::chrono::nanoseconds sleep_duration) const {
 
 void Application::run() {
   if (benchmark_) {
-    benchmark_->run();
+    const std::string name = par_.benchmark();
+    if (name == "time-index") {
+      benchmark_->run_time_index();
+    } else if (name == "work-item") {
+      benchmark_->run_work_item_encoding();
+    } else if (name == "ring-allocator") {
+      benchmark_->run_ring_allocator();
+    } else if (name == "hash-map") {
+      benchmark_->run_hash_map();
+    } else {
+      benchmark_->run();
+      benchmark_->run_pattern_check();
+    }
     return;
   }
 
   uint64_t limit = par_.maximum_number();
 
   uint64_t index = 0;
+  if (seekable_source_ != nullptr) {
+    seekable_source_->seek(par_.offset());
+    index = par_.offset();
+  }
   while (auto timeslice = source_->get()) {
     if (index >= par_.offset() &&
         (index - par_.offset()) % par_.stride() == 0) {
@@ -245,6 +314,10 @@ void Application::run() {
     }
     // avoid unneccessary pipelining
     timeslice.reset();
+    if (seekable_source_ != nullptr && par_.stride() > 1) {
+      index += par_.stride() - 1;
+      seekable_source_->seek(index);
+    }
   }
 
   // Loop over sinks. For all sinks of type ManagedTimesliceBuffer, check if
@@ -5,6 +5,7 @@
 #include "Monitor.hpp"
 #include "Parameters.hpp"
 #include "Sink.hpp"
+#include "TimesliceInputArchive.hpp"
 #include "TimesliceSource.hpp"
 #include "log.hpp"
 #include <chrono>
@@ -36,6 +37,8 @@ private:
   zmq::context_t zmq_context_{1};
 
   std::unique_ptr<fles::TimesliceSource> source_;
+  /// The source as an indexed archive (if random access is possible)
+  fles::TimesliceInputArchive* seekable_source_ = nullptr;
   std::vector<std::unique_ptr<fles::TimesliceSink>> sinks_;
   std::unique_ptr<Benchmark> benchmark_;
 
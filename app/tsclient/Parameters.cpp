@@ -4,6 +4,7 @@
 #include "GitRevision.hpp"
 #include "System.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <boost/log/sinks/syslog_constants.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
@@ -21,6 +22,7 @@ void Parameters::parse_options(int argc, char* argv[]) {
   unsigned log_level = 2;
   unsigned log_syslog = 2;
   std::string log_file;
+  std::string crc_engine;
 
   auto terminal_width = fles::system::current_terminal_width();
   po::options_description desc("Allowed options", terminal_width,
@@ -46,14 +48,29 @@ void Parameters::parse_options(int argc, char* argv[]) {
            "index of this executable in the list of processor tasks");
   desc_add("analyze-pattern,a", po::bool_switch(&analyze_),
            "enable pattern check");
+  desc_add("analyze-threads",
+           po::value<size_t>(&analyze_threads_)
+               ->default_value(analyze_threads_)
+               ->value_name("N"),
+           "number of threads for the pattern check (the components of a "
+           "timeslice are checked in parallel)");
+  desc_add("crc-engine",
+           po::value<std::string>(&crc_engine)->value_name("NAME"),
+           "CRC-32C implementation for the pattern check, one of 'software', "
+           "'crc32', 'pclmul', or 'vpclmul' (default: fastest supported)");
   desc_add("monitor,m",
            po::value<std::string>(&monitor_uri_)
                ->value_name("URI")
                ->implicit_value("influx1:login:8086:tsclient_status"),
            "publish tsclient status to InfluxDB (or \"file:cout\" for "
            "console output)");
-  desc_add("benchmark,b", po::bool_switch(&benchmark_),
-           "run local CRC benchmark test only");
+  desc_add("benchmark,b",
+           po::value<std::string>(&benchmark_)
+               ->implicit_value("crc")
+               ->value_name("NAME"),
+           "run local CRC and pattern check benchmarks only; NAME selects "
+           "another benchmark, one of 'time-index', 'work-item', "
+           "'ring-allocator', or 'hash-map'");
   desc_add("verbose,v", po::value<size_t>(&verbosity_),
            "set verbosity for outputs (option -o or --output-uri);\n"
            "larger means more details (e.g., 1 or 2); needs log level <= 1 to "
@@ -74,14 +91,20 @@ void Parameters::parse_options(int argc, char* argv[]) {
       "process),\n"
       " 'tcp' \t(enable timeslice publisher on given address).\n"
       "Supported parameters for 'file':\n"
-      " 'c' \t(compression 'none' (default) or 'zstd'),\n"
+      " 'c' \t(compression 'none' (default), 'zstd', or 'zstd-components' "
+      "(compress each timeslice component individually)),\n"
+      " 'level' \t(compression level, default: 1),\n"
+      " 'threads' \t(number of compression threads, default: 1; if larger, "
+      "independent blocks are compressed in parallel),\n"
       " 'items' \t(limit number of timeslices per file to given number, "
       "create sequence of output archive files; use placeholder %n in "
       "filename),\n"
       " 'bytes' \t(limit number of bytes per file to given number, create "
       "sequence of output archive files; use placeholder "
-      "%n in filename).\n"
-      " Example: 'file:///tmp/output%n.tsa?items=100&c=zstd'.\n"
+      "%n in filename),\n"
+      " 'index' \t(write an index file for random access, e.g., with "
+      "--offset and --stride; not with 'c=zstd').\n"
+      " Example: 'file:///tmp/output%n.tsa?items=100&c=zstd&threads=8'.\n"
       "Supported parameters for 'shm':\n"
       "'n' \t(number of components), 'datasize', 'descsize'.\n"
       " Example: "
@@ -141,8 +164,16 @@ void Parameters::parse_options(int argc, char* argv[]) {
     output_uris_ = vm["output-uri"].as<std::vector<std::string>>();
   }
 
+  const std::vector<std::string> benchmarks = {
+      "crc", "time-index", "work-item", "ring-allocator", "hash-map"};
+  if (!benchmark_.empty() &&
+      std::find(benchmarks.begin(), benchmarks.end(), benchmark_) ==
+          benchmarks.end()) {
+    throw ParametersException("invalid benchmark: " + benchmark_);
+  }
+
   size_t input_sources = vm.count("input-uri");
-  if (input_sources == 0 && !benchmark_) {
+  if (input_sources == 0 && benchmark_.empty()) {
     throw ParametersException(
         "no input source specified (use option -i or --input-uri)");
   }
@@ -158,4 +189,19 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (stride_ == 0) {
     throw ParametersException("stride must be greater than zero");
   }
+
+  if (analyze_threads_ == 0) {
+    throw ParametersException("analyze-threads must be greater than zero");
+  }
+
+  if (vm.count("crc-engine") != 0u) {
+    crc_engine_ = crc32c_engine_from_string(crc_engine);
+    if (!crc_engine_) {
+      throw ParametersException("invalid crc-engine: " + crc_engine);
+    }
+    if (!crc32c_engine_supported(*crc_engine_)) {
+      throw ParametersException("crc-engine not supported by this CPU: " +
+                                crc_engine);
+    }
+  }
 }
@@ -1,7 +1,9 @@
 // Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "Crc32c.hpp"
 #include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -33,7 +35,14 @@ public:
 
   [[nodiscard]] bool analyze() const { return analyze_; }
 
-  [[nodiscard]] bool benchmark() const { return benchmark_; }
+  [[nodiscard]] size_t analyze_threads() const { return analyze_threads_; }
+
+  [[nodiscard]] std::optional<Crc32cEngine> crc_engine() const {
+    return crc_engine_;
+  }
+
+  /// The selected benchmark (empty if none)
+  [[nodiscard]] std::string benchmark() const { return benchmark_; }
 
   [[nodiscard]] size_t verbosity() const { return verbosity_; }
 
@@ -60,7 +69,9 @@ private:
   std::string input_uri_;
   std::vector<std::string> output_uris_;
   bool analyze_ = false;
-  bool benchmark_ = false;
+  size_t analyze_threads_ = 1;
+  std::optional<Crc32cEngine> crc_engine_;
+  std::string benchmark_;
   size_t verbosity_ = 0;
   bool histograms_ = false;
   uint64_t maximum_number_ = UINT64_MAX;
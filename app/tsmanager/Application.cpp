@@ -16,7 +16,8 @@ Application::Application(Parameters const& par,
 
   m_ts_manager = std::make_unique<TsManager>(
       signal_status, par.listen_port(), par.timeslice_duration_ns(),
-      par.timeout_ns(), par.max_in_flight(), m_monitor.get());
+      par.timeout_ns(), par.max_in_flight(), par.assignment_policy(),
+      par.batch_delay(), par.ingest_shards(), m_monitor.get());
 }
 
 void Application::run() { m_ts_manager->run(); }
@@ -0,0 +1,44 @@
+/* Copyright (C) 2025 FIAS, Goethe-Universität Frankfurt am Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Author: Jan de Cuveland */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Strategy used by the TsManager to pick the builder for a timeslice. All
+// policies only consider builders with enough free memory and fewer than
+// max-in-flight assigned timeslices.
+enum class AssignmentPolicy {
+  round_robin,       // first eligible builder, starting at id % num_builders
+  least_outstanding, // builder with the fewest assigned but unreceived bytes
+  power_of_two,      // better of two randomly chosen builders (by bytes)
+  latency_weighted   // lowest in-flight count times mean completion latency
+};
+
+inline std::string_view to_string(AssignmentPolicy policy) {
+  switch (policy) {
+  case AssignmentPolicy::round_robin:
+    return "round-robin";
+  case AssignmentPolicy::least_outstanding:
+    return "least-outstanding";
+  case AssignmentPolicy::power_of_two:
+    return "power-of-two";
+  case AssignmentPolicy::latency_weighted:
+    return "latency-weighted";
+  }
+  return "unknown";
+}
+
+inline std::optional<AssignmentPolicy>
+parse_assignment_policy(std::string_view str) {
+  for (auto policy :
+       {AssignmentPolicy::round_robin, AssignmentPolicy::least_outstanding,
+        AssignmentPolicy::power_of_two, AssignmentPolicy::latency_weighted}) {
+    if (str == to_string(policy)) {
+      return policy;
+    }
+  }
+  return std::nullopt;
+}
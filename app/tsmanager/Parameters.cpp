@@ -11,6 +11,20 @@
 
 namespace po = boost::program_options;
 
+// Overload validate for the timeslice assignment policy
+void validate(boost::any& v,
+              const std::vector<std::string>& values,
+              AssignmentPolicy* /*unused*/,
+              int /*unused*/) {
+  po::validators::check_first_occurrence(v);
+  const std::string& s = po::validators::get_single_string(values);
+  auto policy = parse_assignment_policy(s);
+  if (!policy) {
+    throw po::validation_error(po::validation_error::invalid_option_value);
+  }
+  v = boost::any(*policy);
+}
+
 void Parameters::parse_options(int argc, char* argv[]) {
 
   std::string config_file;
@@ -64,6 +78,25 @@ void Parameters::parse_options(int argc, char* argv[]) {
       "max-in-flight",
       po::value<uint32_t>(&m_max_in_flight)->default_value(m_max_in_flight),
       "maximum number of timeslices in flight per builder");
+  config_add("assignment-policy",
+             po::value<AssignmentPolicy>(&m_assignment_policy)
+                 ->default_value(m_assignment_policy,
+                                 std::string(to_string(m_assignment_policy)))
+                 ->value_name("<policy>"),
+             "builder selection policy for timeslices (round-robin, "
+             "least-outstanding, power-of-two, latency-weighted)");
+  config_add(
+      "batch-delay",
+      po::value<Nanoseconds>(&m_batch_delay)->default_value(m_batch_delay),
+      "maximum time to hold back releases to a sender for batching at high "
+      "message rates (with suffix ns, us, ms, s)");
+  config_add("ingest-shards",
+             po::value<uint32_t>(&m_ingest_shards)
+                 ->default_value(m_ingest_shards)
+                 ->value_name("<n>"),
+             "number of threads receiving and sending the messages of the "
+             "stsender and tsbuilder connections (connections are "
+             "distributed across them)");
 
   po::options_description cmdline_options("Allowed options", terminal_width,
                                           terminal_width / 2);
@@ -109,6 +142,12 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (timeout_ns() <= 0) {
     throw ParametersException("timeout must be greater than 0");
   }
+  if (m_batch_delay.count() < 0) {
+    throw ParametersException("batch delay must not be negative");
+  }
+  if (m_ingest_shards == 0) {
+    throw ParametersException("number of ingest shards must be at least 1");
+  }
   if (m_max_in_flight == 0) {
     throw ParametersException("max-in-flight must be greater than 0");
   }
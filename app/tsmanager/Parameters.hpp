@@ -3,6 +3,7 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include "AssignmentPolicy.hpp"
 #include "OptionValues.hpp"
 #include "TsbProtocol.hpp"
 #include <chrono>
@@ -34,6 +35,13 @@ public:
   }
   [[nodiscard]] int64_t timeout_ns() const { return m_timeout.count(); }
   [[nodiscard]] uint32_t max_in_flight() const { return m_max_in_flight; }
+  [[nodiscard]] AssignmentPolicy assignment_policy() const {
+    return m_assignment_policy;
+  }
+  [[nodiscard]] std::chrono::nanoseconds batch_delay() const {
+    return m_batch_delay;
+  }
+  [[nodiscard]] uint32_t ingest_shards() const { return m_ingest_shards; }
 
 private:
   void parse_options(int argc, char* argv[]);
@@ -43,4 +51,7 @@ private:
   Nanoseconds m_timeslice_duration = 40_ms;
   Nanoseconds m_timeout = 40_ms;
   uint32_t m_max_in_flight = 1;
+  AssignmentPolicy m_assignment_policy = AssignmentPolicy::round_robin;
+  Nanoseconds m_batch_delay = 100_us;
+  uint32_t m_ingest_shards = 1;
 };
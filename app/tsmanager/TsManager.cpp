@@ -8,12 +8,20 @@
 #include "TsbProtocol.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
+#include "monitoring/SystemInfo.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <latch>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <optional>
+#include <random>
 #include <sched.h>
 #include <span>
 #include <sys/socket.h>
@@ -24,74 +32,117 @@
 
 using namespace std::chrono_literals;
 
+// BuilderConnection
+
+void BuilderConnection::add_assignment(TsId id, uint64_t ms_data_size) {
+  auto [it, inserted] = assigned_ts.try_emplace(
+      id, ms_data_size, std::chrono::steady_clock::now());
+  if (inserted) {
+    outstanding_bytes += ms_data_size;
+  }
+}
+
+std::optional<std::chrono::nanoseconds>
+BuilderConnection::remove_assignment(TsId id) {
+  auto it = assigned_ts.find(id);
+  if (it == assigned_ts.end()) {
+    return std::nullopt;
+  }
+  outstanding_bytes -= it->second.ms_data_size;
+  auto elapsed = std::chrono::steady_clock::now() - it->second.time;
+  assigned_ts.erase(it);
+  return elapsed;
+}
+
 TsManager::TsManager(volatile sig_atomic_t* signal_status,
                      uint16_t listen_port,
                      int64_t timeslice_duration_ns,
                      int64_t timeout_ns,
                      uint32_t max_in_flight,
+                     AssignmentPolicy assignment_policy,
+                     std::chrono::nanoseconds batch_delay,
+                     std::size_t num_shards,
                      cbm::Monitor* monitor)
     : m_signal_status(signal_status), m_listen_port(listen_port),
       m_timeslice_duration_ns{timeslice_duration_ns}, m_timeout_ns{timeout_ns},
-      m_max_in_flight{max_in_flight},
+      m_max_in_flight{max_in_flight}, m_assignment_policy{assignment_policy},
+      m_batch_delay{batch_delay}, m_random_engine{std::random_device{}()},
       m_hostname(fles::system::current_hostname()), m_monitor(monitor) {
+  if (num_shards == 0) {
+    throw std::invalid_argument("number of ingest shards must be at least 1");
+  }
+  for (std::size_t i = 0; i < num_shards; ++i) {
+    m_shards.push_back(
+        std::make_unique<IngestShard>(this, i, m_queue_capacity));
+  }
+  m_outgoing.resize(num_shards);
+
+  if (m_monitor != nullptr) {
+    auto& series = m_monitor->RegisterSeries("tsmanager_completion",
+                                             {{"host", m_hostname}});
+    m_completion_count = series.Counter("timeslice_count");
+    m_completion_latency =
+        series.Histogram("latency_ns", {1000000, 2000000, 5000000, 10000000,
+                                        20000000, 50000000, 100000000,
+                                        200000000, 500000000, 1000000000});
+  }
+
   // Initialize event handling
+  m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (m_event_fd == -1) {
+    throw std::runtime_error("eventfd failed");
+  }
   m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
   if (m_epoll_fd == -1) {
     throw std::runtime_error("epoll_create1 failed");
   }
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLET; // Edge-triggered
+  ev.data.fd = m_event_fd;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &ev) == -1) {
+    throw std::runtime_error("epoll_ctl failed for event queue");
+  }
 }
 
 TsManager::~TsManager() {
+  stop_shards();
+
   if (m_epoll_fd != -1) {
     close(m_epoll_fd);
   }
+  if (m_event_fd != -1) {
+    close(m_event_fd);
+  }
 }
 
-// Main operation loop
+// Main operation loop (merge stage)
 
 void TsManager::run() {
-  if (!ucx::util::init(m_context, m_worker, m_epoll_fd, m_ucx_loop_mode)) {
+  if (!ucx::util::create_context(m_context, m_ucx_loop_mode,
+                                 m_shards.size() > 1)) {
     ERROR("Failed to initialize UCX");
     return;
   }
-  if (!ucx::util::set_receive_handler(m_worker, AM_SENDER_REGISTER,
-                                      on_sender_register, this) ||
-      !ucx::util::set_receive_handler(m_worker, AM_SENDER_ANNOUNCE_ST,
-                                      on_sender_announce, this) ||
-      !ucx::util::set_receive_handler(m_worker, AM_SENDER_RETRACT_ST,
-                                      on_sender_retract, this) ||
-      !ucx::util::set_receive_handler(m_worker, AM_BUILDER_REGISTER,
-                                      on_builder_register, this) ||
-      !ucx::util::set_receive_handler(m_worker, AM_BUILDER_STATUS,
-                                      on_builder_status, this)) {
-    ERROR("Failed to register receive handlers");
-    return;
-  }
-  if (!ucx::util::create_listener(m_worker, m_listener, m_listen_port,
-                                  on_new_connection, this)) {
-    ERROR("Failed to create UCX listener at port {}", m_listen_port);
+  if (!start_shards()) {
+    stop_shards();
+    ucp_worker_h no_worker = nullptr;
+    ucx::util::cleanup(m_context, no_worker);
     return;
   }
 
   m_id = fles::system::current_time_ns() / m_timeslice_duration_ns;
+  m_report_time_last = Scheduler::clock::now();
   report_status();
   log_status();
 
   while (*m_signal_status == 0) {
-    if (ucp_worker_progress(m_worker) != 0) {
+    flush_commands();
+    if (process_events() > 0) {
       continue;
     }
     m_tasks.timer();
 
-    bool try_later =
-        std::none_of(m_senders.begin(), m_senders.end(),
-                     [](const auto& s) {
-                       return s.second.state == SenderState::active;
-                     }) ||
-        std::any_of(m_senders.begin(), m_senders.end(), [this](const auto& s) {
-          return s.second.state == SenderState::active &&
-                 s.second.last_received_st < m_id;
-        });
+    bool try_later = m_active_sender_count == 0 || m_lagging_sender_count > 0;
     uint64_t current_time_ns = fles::system::current_time_ns();
     uint64_t timeout_ns = (m_id + 1) * m_timeslice_duration_ns + m_timeout_ns;
 
@@ -101,104 +152,303 @@ void TsManager::run() {
       int timer_wait_ms = std::max(
           static_cast<int>(
               std::chrono::duration_cast<std::chrono::milliseconds>(
-                  m_tasks.when_next() - std::chrono::system_clock::now())
+                  m_tasks.when_next() - Scheduler::clock::now())
                   .count() +
               1),
           0);
-      int timeout_ms = std::min(sender_wait_ms, timer_wait_ms);
-      if (!ucx::util::arm_worker_and_wait(m_worker, m_epoll_fd, timeout_ms,
-                                          m_ucx_loop_mode)) {
-        break;
-      }
+      flush_commands();
+      wait_for_events(std::min(sender_wait_ms, timer_wait_ms));
       continue;
     }
 
     assign_timeslice(m_id);
-    m_id++;
+    advance_id();
+  }
+
+  flush_commands();
+  stop_shards();
+  m_senders.clear();
+  m_builders.clear();
+  m_announced.clear();
+  ucp_worker_h no_worker = nullptr;
+  ucx::util::cleanup(m_context, no_worker);
+}
+
+// Ingest shard management
+
+bool TsManager::start_shards() {
+  // Wait for all shards to be initialized (or to have failed), so that no
+  // connection is assigned to a shard that is not ready
+  std::latch initialized(static_cast<std::ptrdiff_t>(m_shards.size()));
+  for (auto& shard : m_shards) {
+    IngestShard& s = *shard;
+    s.thread = std::jthread([this, &s, &initialized](std::stop_token st) {
+      cbm::system::set_thread_name("TsManager/" + std::to_string(s.index));
+      s.stop_token = st;
+      bool ok = init_shard(s);
+      initialized.count_down();
+      if (ok) {
+        run_shard(s);
+      }
+      for (int* fd : {&s.epoll_fd, &s.queue_event_fd}) {
+        if (*fd != -1) {
+          close(*fd);
+          *fd = -1;
+        }
+      }
+    });
+  }
+  initialized.wait();
+
+  if (!m_shards.front()->is_ready) {
+    return false;
+  }
+  std::size_t ready =
+      std::count_if(m_shards.begin(), m_shards.end(),
+                    [](const auto& s) { return s->is_ready.load(); });
+  INFO("Using {} of {} ingest shards", ready, m_shards.size());
+  return true;
+}
+
+void TsManager::stop_shards() {
+  for (auto& s : m_shards) {
+    if (s->thread.joinable()) {
+      s->thread.request_stop();
+      s->thread.join();
+    }
+  }
+}
+
+bool TsManager::init_shard(IngestShard& s) {
+  s.queue_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  s.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (s.queue_event_fd == -1 || s.epoll_fd == -1) {
+    ERROR("Ingest shard {}: failed to create event handling", s.index);
+    return false;
+  }
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLET; // Edge-triggered
+  ev.data.fd = s.queue_event_fd;
+  if (epoll_ctl(s.epoll_fd, EPOLL_CTL_ADD, s.queue_event_fd, &ev) == -1) {
+    ERROR("Ingest shard {}: epoll_ctl failed for command queue", s.index);
+    return false;
+  }
+
+  // The worker is created on the shard's thread, which is the only one
+  // accessing it
+  if (!ucx::util::create_worker(m_context, s.worker, s.epoll_fd,
+                                m_ucx_loop_mode)) {
+    ERROR("Ingest shard {}: failed to create UCX worker", s.index);
+    return false;
+  }
+  if (!ucx::util::set_receive_handler(s.worker, AM_SENDER_REGISTER,
+                                      on_sender_register, &s) ||
+      !ucx::util::set_receive_handler(s.worker, AM_SENDER_ANNOUNCE_ST,
+                                      on_sender_announce, &s) ||
+      !ucx::util::set_receive_handler(s.worker, AM_SENDER_ANNOUNCE_ST_BATCH,
+                                      on_sender_announce_batch, &s) ||
+      !ucx::util::set_receive_handler(s.worker, AM_SENDER_RETRACT_ST,
+                                      on_sender_retract, &s) ||
+      !ucx::util::set_receive_handler(s.worker, AM_BUILDER_REGISTER,
+                                      on_builder_register, &s) ||
+      !ucx::util::set_receive_handler(s.worker, AM_BUILDER_STATUS,
+                                      on_builder_status, &s)) {
+    ERROR("Ingest shard {}: failed to register receive handlers", s.index);
+    ucx::util::destroy_worker(s.worker);
+    return false;
+  }
+  if (s.index == 0 &&
+      !ucx::util::create_listener(s.worker, s.listener, m_listen_port,
+                                  on_new_connection, this)) {
+    ERROR("Failed to create UCX listener at port {}", m_listen_port);
+    ucx::util::destroy_worker(s.worker);
+    return false;
+  }
+
+  s.is_ready = true;
+  return true;
+}
+
+void TsManager::run_shard(IngestShard& s) {
+  while (!s.stop_token.stop_requested()) {
+    const bool progressed = ucp_worker_progress(s.worker) != 0;
+    if (s.events_pushed) {
+      s.events_pushed = false;
+      notify(m_event_fd);
+    }
+    if (progressed) {
+      continue;
+    }
+    if (process_pending_connections(s) > 0 || process_commands(s) > 0) {
+      continue;
+    }
+    // Releases queued in a burst of commands are sent together
+    flush_due_releases(s);
+    s.tasks.timer();
+
+    auto timer_wait_ms = std::chrono::ceil<std::chrono::milliseconds>(
+                             s.tasks.when_next() - Scheduler::clock::now())
+                             .count();
+    int timeout_ms = static_cast<int>(std::clamp<int64_t>(
+        timer_wait_ms, 0, ucx::util::EPOLL_TIMEOUT_MS));
+    if (!ucx::util::arm_worker_and_wait(s.worker, s.epoll_fd, timeout_ms,
+                                        m_ucx_loop_mode)) {
+      break;
+    }
   }
 
-  if (m_listener != nullptr) {
-    ucp_listener_destroy(m_listener);
-    m_listener = nullptr;
+  s.is_ready = false;
+  if (s.listener != nullptr) {
+    ucp_listener_destroy(s.listener);
+    s.listener = nullptr;
+  }
+  disconnect_from_all(s);
+  while (ucp_worker_progress(s.worker) != 0) {
   }
-  disconnect_from_all();
-  ucx::util::cleanup(m_context, m_worker);
+  ucx::util::destroy_worker(s.worker);
+}
+
+std::size_t TsManager::process_pending_connections(IngestShard& s) {
+  std::deque<std::pair<ucp_conn_request_h, std::string>> connections;
+  {
+    std::lock_guard<std::mutex> lock(s.connections_mutex);
+    connections.swap(s.pending_connections);
+  }
+  for (const auto& [conn_request, client_address] : connections) {
+    accept_connection(s, conn_request, client_address);
+  }
+  return connections.size();
+}
+
+std::size_t TsManager::process_commands(IngestShard& s) {
+  s.local_commands.clear();
+  {
+    std::lock_guard<std::mutex> lock(s.commands_mutex);
+    s.local_commands.swap(s.commands);
+  }
+  for (auto& cmd : s.local_commands) {
+    switch (cmd.type) {
+    case ShardCommand::Type::release:
+      queue_release(s, cmd.ep, cmd.id);
+      break;
+    case ShardCommand::Type::assign:
+      send_assignment(s, cmd);
+      break;
+    }
+  }
+  return s.local_commands.size();
+}
+
+// Retrieve the slot for the next event of a shard. If the queue is full, wait
+// for the merge stage, which never waits for the shards (nullptr if the shard
+// is stopping).
+IngestEvent* TsManager::next_event(IngestShard& s) {
+  IngestEvent* ev = s.events.back();
+  while (ev == nullptr) {
+    if (s.stop_token.stop_requested()) {
+      return nullptr;
+    }
+    notify(m_event_fd);
+    std::this_thread::yield();
+    ev = s.events.back();
+  }
+  return ev;
+}
+
+void TsManager::push_event(IngestShard& s) {
+  s.events.push();
+  s.events_pushed = true;
 }
 
 // Connection management
 
 void TsManager::handle_new_connection(ucp_conn_request_h conn_request) {
+  IngestShard& s0 = *m_shards.front();
   auto client_address = ucx::util::get_client_address(conn_request);
   if (!client_address) {
     ERROR("{}", client_address.error());
-    ucp_listener_reject(m_listener, conn_request);
+    ucp_listener_reject(s0.listener, conn_request);
     return;
   }
 
-  auto ep = ucx::util::accept(m_worker, conn_request, on_endpoint_error, this);
+  // Assign the connection to the next ready shard (round-robin). The
+  // endpoint is created on that shard's thread.
+  IngestShard* s = nullptr;
+  for (std::size_t i = 0; i < m_shards.size() && s == nullptr; ++i) {
+    IngestShard& candidate = *m_shards[m_next_shard];
+    m_next_shard = (m_next_shard + 1) % m_shards.size();
+    if (candidate.is_ready) {
+      s = &candidate;
+    }
+  }
+  if (s == nullptr || s->index == 0) {
+    accept_connection(s0, conn_request, *client_address);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(s->connections_mutex);
+    s->pending_connections.emplace_back(conn_request, *client_address);
+  }
+  notify(s->queue_event_fd);
+}
+
+void TsManager::accept_connection(IngestShard& s,
+                                  ucp_conn_request_h conn_request,
+                                  const std::string& client_address) {
+  auto ep = ucx::util::accept(s.worker, conn_request, on_endpoint_error, &s);
   if (!ep) {
     ERROR("Failed to create endpoint for new connection");
     return;
   }
 
-  m_connections[*ep] = *client_address;
-  DEBUG("Accepted connection from {}", *client_address);
+  s.connections[*ep] = client_address;
+  DEBUG("Accepted connection from {} on ingest shard {}", client_address,
+        s.index);
 }
 
-void TsManager::handle_endpoint_error(ucp_ep_h ep, ucs_status_t status) {
-  auto it = m_connections.find(ep);
-  if (it != m_connections.end()) {
-    m_connections.erase(it);
-  } else {
+void TsManager::handle_endpoint_error(IngestShard& s,
+                                      ucp_ep_h ep,
+                                      ucs_status_t status) {
+  auto it = s.connections.find(ep);
+  if (it == s.connections.end()) {
     ERROR("Received error for unknown endpoint: {}", status);
+    return;
   }
+  DEBUG("Connection from {} closed: {}", it->second, status);
+  s.connections.erase(it);
+  s.release_batches.erase(ep);
 
-  auto sender_it = m_senders.find(ep);
-  if (sender_it != m_senders.end()) {
-    INFO("Disconnect from sender '{}': {}", sender_it->second.info.id(),
-         status);
-    m_senders.erase(sender_it);
-  }
-
-  if (auto it =
-          std::find_if(m_builders.begin(), m_builders.end(),
-                       [ep](const BuilderConnection& b) { return b.ep == ep; });
-      it != m_builders.end()) {
-    if (!it->assigned_ts.empty()) {
-      INFO("Releasing {} in-flight timeslice(s) from builder '{}'",
-           it->assigned_ts.size(), it->info.id());
-      for (auto ts_id : it->assigned_ts) {
-        send_release_to_senders(ts_id);
-      }
-    }
-    INFO("Disconnect from builder '{}': {}", it->info.id(), status);
-    m_builders.erase(it);
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
+    return;
   }
+  ev->type = IngestEvent::Type::disconnected;
+  ev->ep = ep;
+  push_event(s);
 }
 
-void TsManager::disconnect_from_all() {
-  if (m_connections.empty() && m_senders.empty() && m_builders.empty()) {
-    return;
+void TsManager::disconnect_from_all(IngestShard& s) {
+  if (!s.connections.empty()) {
+    DEBUG("Ingest shard {}: closing {} connections", s.index,
+          s.connections.size());
   }
-  INFO("Disconnecting from {} senders and {} builders", m_senders.size(),
-       m_builders.size());
-  for (auto& [ep, _] : m_connections) {
-    ucx::util::close_endpoint(m_worker, ep, true);
+  s.release_batches.clear();
+  auto connections = std::move(s.connections);
+  s.connections.clear();
+  for (auto& [ep, _] : connections) {
+    ucx::util::close_endpoint(s.worker, ep, true);
   }
-
-  m_connections.clear();
-  m_senders.clear();
-  m_builders.clear();
 }
 
-// Sender message handling
+// Message handling (shard threads)
 
 ucs_status_t
-TsManager::handle_sender_register(const void* header,
+TsManager::handle_sender_register(IngestShard& s,
+                                  const void* header,
                                   size_t header_length,
-                                  [[maybe_unused]] void* data,
                                   size_t length,
                                   const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
   if (header_length == 0 || length != 0 ||
       (param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP) == 0u) {
     ERROR("Invalid sender registration request received");
@@ -214,18 +464,29 @@ TsManager::handle_sender_register(const void* header,
   }
 
   ucp_ep_h ep = param->reply_ep;
-  m_senders[ep] = {*sender_info, ep, SenderState::registered, {}, 0};
-  INFO("Accepted sender registration from '{}'", sender_info->id());
+  auto& batch = s.release_batches[ep];
+  batch.ids.clear();
+  batch.batching = AdaptiveBatching(m_batch_delay, MAX_BATCH_SIZE);
 
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
+    return UCS_OK;
+  }
+  ev->type = IngestEvent::Type::sender_registered;
+  ev->ep = ep;
+  ev->sender_info = std::move(*sender_info);
+  push_event(s);
   return UCS_OK;
 }
 
 ucs_status_t
-TsManager::handle_sender_announce(const void* header,
+TsManager::handle_sender_announce(IngestShard& s,
+                                  const void* header,
                                   size_t header_length,
                                   void* data,
                                   size_t length,
                                   const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
   auto hdr = std::span<const uint64_t>(static_cast<const uint64_t*>(header),
                                        header_length / sizeof(uint64_t));
   if (hdr.size() != 2 || length == 0 ||
@@ -235,64 +496,83 @@ TsManager::handle_sender_announce(const void* header,
   }
 
   const TsId id = hdr[0];
-  const uint64_t ms_data_size = hdr[1];
-
-  auto it = m_senders.find(param->reply_ep);
-  if (it == m_senders.end()) {
+  if (!s.release_batches.contains(param->reply_ep)) {
     ERROR("{}| Received announcement from unknown sender", id);
     return UCS_OK;
   }
-  auto& sender_conn = it->second;
 
   auto st_descriptor_bytes =
       std::span(static_cast<const std::byte*>(data), length);
   auto st_descriptor = parse_descriptor(st_descriptor_bytes);
   if (!st_descriptor) {
-    ERROR("{}| Failed to deserialize announcement from sender '{}'", id,
-          sender_conn.info.id());
+    ERROR("{}| Failed to deserialize announcement", id);
     return UCS_OK;
   }
 
-  if (st_descriptor->duration_ns !=
-      static_cast<uint64_t>(m_timeslice_duration_ns)) {
-    ERROR("{}| Invalid timeslice duration from sender '{}'", id,
-          sender_conn.info.id());
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
     return UCS_OK;
   }
+  ev->type = IngestEvent::Type::announcement;
+  ev->ep = param->reply_ep;
+  ev->id = id;
+  ev->ms_data_size = hdr[1];
+  ev->st_descriptor = std::move(*st_descriptor);
+  push_event(s);
+  return UCS_OK;
+}
 
-  if (id < m_id) {
-    auto late_ts = m_id - id;
-    auto late_ns = late_ts * m_timeslice_duration_ns;
-    DEBUG("{}| Late announcement from '{}' by {} ts ({} ms), sending release",
-          id, sender_conn.info.id(), late_ts, (late_ns + 500000) / 1000000);
-    std::array<uint64_t, 1> hdr{id};
-    auto header = std::as_bytes(std::span(hdr));
-    ucx::util::send_active_message(param->reply_ep, AM_MANAGER_RELEASE_ST,
-                                   header, {},
-                                   ucx::util::on_generic_send_complete, this,
-                                   UCP_AM_SEND_FLAG_COPY_HEADER);
+ucs_status_t
+TsManager::handle_sender_announce_batch(IngestShard& s,
+                                        const void* header,
+                                        size_t header_length,
+                                        void* data,
+                                        size_t length,
+                                        const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
+  auto hdr = std::span<const uint64_t>(static_cast<const uint64_t*>(header),
+                                       header_length / sizeof(uint64_t));
+  if (hdr.size() != 1 || hdr[0] == 0 || hdr[0] > MAX_BATCH_SIZE ||
+      length == 0 ||
+      (param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP) == 0u) {
+    ERROR("Invalid subtimeslice announcement batch received");
     return UCS_OK;
   }
 
-  sender_conn.announced_st.emplace_back(id, ms_data_size,
-                                        std::move(*st_descriptor));
-  sender_conn.last_received_st = id;
-  if (sender_conn.state == SenderState::registered) {
-    sender_conn.state = SenderState::active;
-    INFO("Sender '{}' is now active", sender_conn.info.id());
+  if (!s.release_batches.contains(param->reply_ep)) {
+    ERROR("Received announcement batch from unknown sender");
+    return UCS_OK;
   }
-  DEBUG("{}| Announcement from '{}' ({})", id, sender_conn.info.id(),
-        human_readable_count(ms_data_size, true));
 
+  auto announcements = parse_announcements(
+      std::span(static_cast<const std::byte*>(data), length), hdr[0]);
+  if (!announcements) {
+    ERROR("Failed to deserialize announcement batch");
+    return UCS_OK;
+  }
+
+  for (auto& a : *announcements) {
+    IngestEvent* ev = next_event(s);
+    if (ev == nullptr) {
+      return UCS_OK;
+    }
+    ev->type = IngestEvent::Type::announcement;
+    ev->ep = param->reply_ep;
+    ev->id = a.id;
+    ev->ms_data_size = a.ms_data_size;
+    ev->st_descriptor = std::move(a.descriptor);
+    push_event(s);
+  }
   return UCS_OK;
 }
 
 ucs_status_t
-TsManager::handle_sender_retract(const void* header,
+TsManager::handle_sender_retract(IngestShard& s,
+                                 const void* header,
                                  size_t header_length,
-                                 [[maybe_unused]] void* data,
                                  size_t length,
                                  const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
   auto hdr = std::span<const uint64_t>(static_cast<const uint64_t*>(header),
                                        header_length / sizeof(uint64_t));
   if (hdr.size() != 1 || length != 0 ||
@@ -301,52 +581,24 @@ TsManager::handle_sender_retract(const void* header,
     return UCS_OK;
   }
 
-  const TsId id = hdr[0];
-
-  auto it = m_senders.find(param->reply_ep);
-  if (it == m_senders.end()) {
-    ERROR("{}| Received retraction from unknown sender", id);
-    return UCS_OK;
-  }
-  auto& conn = it->second;
-
-  auto st_it = std::find_if(conn.announced_st.begin(), conn.announced_st.end(),
-                            [id](const auto& st) { return st.id == id; });
-  if (st_it == conn.announced_st.end()) {
-    WARN("{}| Retraction for unannounced subtimeslice from sender '{}'", id,
-         conn.info.id());
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
     return UCS_OK;
   }
-  DEBUG("{}| Retraction for subtimeslice from sender '{}'", id, conn.info.id());
-  conn.announced_st.erase(st_it);
-
+  ev->type = IngestEvent::Type::retraction;
+  ev->ep = param->reply_ep;
+  ev->id = hdr[0];
+  push_event(s);
   return UCS_OK;
 }
 
-void TsManager::send_release_to_senders(TsId id) {
-  std::array<uint64_t, 1> hdr{id};
-  auto header = std::as_bytes(std::span(hdr));
-
-  for (auto& [ep, conn] : m_senders) {
-    // Check if this sender has announced the subtimeslice
-    auto it = std::find_if(conn.announced_st.begin(), conn.announced_st.end(),
-                           [id](const auto& st) { return st.id == id; });
-    if (it != conn.announced_st.end()) {
-      ucx::util::send_active_message(ep, AM_MANAGER_RELEASE_ST, header, {},
-                                     ucx::util::on_generic_send_complete, this,
-                                     UCP_AM_SEND_FLAG_COPY_HEADER);
-      conn.announced_st.erase(it);
-    }
-  }
-}
-
-// Builder message handling
 ucs_status_t
-TsManager::handle_builder_register(const void* header,
+TsManager::handle_builder_register(IngestShard& s,
+                                   const void* header,
                                    size_t header_length,
-                                   [[maybe_unused]] void* data,
                                    size_t length,
                                    const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
   if (header_length == 0 || length != 0 ||
       (param->recv_attr & UCP_AM_RECV_ATTR_FIELD_REPLY_EP) == 0u) {
     ERROR("Invalid builder registration request received");
@@ -361,19 +613,24 @@ TsManager::handle_builder_register(const void* header,
     return UCS_OK;
   }
 
-  ucp_ep_h ep = param->reply_ep;
-  m_builders.emplace_back(*builder_info, ep, 0, false);
-  INFO("Accepted builder registration from '{}'", builder_info->id());
-
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
+    return UCS_OK;
+  }
+  ev->type = IngestEvent::Type::builder_registered;
+  ev->ep = param->reply_ep;
+  ev->builder_info = std::move(*builder_info);
+  push_event(s);
   return UCS_OK;
 }
 
 ucs_status_t
-TsManager::handle_builder_status(const void* header,
+TsManager::handle_builder_status(IngestShard& s,
+                                 const void* header,
                                  size_t header_length,
-                                 [[maybe_unused]] void* data,
                                  size_t length,
                                  const ucp_am_recv_param_t* param) {
+  s.message_count.fetch_add(1, std::memory_order_relaxed);
   auto hdr = std::span<const uint64_t>(static_cast<const uint64_t*>(header),
                                        header_length / sizeof(uint64_t));
   if (hdr.size() != 3 || length != 0 ||
@@ -382,18 +639,243 @@ TsManager::handle_builder_status(const void* header,
     return UCS_OK;
   }
 
+  IngestEvent* ev = next_event(s);
+  if (ev == nullptr) {
+    return UCS_OK;
+  }
+  ev->type = IngestEvent::Type::builder_status;
+  ev->ep = param->reply_ep;
+  ev->event = hdr[0];
+  ev->id = hdr[1];
+  ev->bytes_free = hdr[2];
+  push_event(s);
+  return UCS_OK;
+}
+
+void TsManager::queue_release(IngestShard& s, ucp_ep_h ep, TsId id) {
+  auto it = s.release_batches.find(ep);
+  if (it == s.release_batches.end()) {
+    DEBUG("{}| Dropping release for disconnected sender", id);
+    return;
+  }
+  auto& batch = it->second;
+  auto now = Scheduler::clock::now();
+  const bool first = batch.ids.empty();
+  batch.ids.push_back(id);
+  batch.batching.add(now);
+  if (batch.batching.full()) {
+    flush_releases(s, ep, batch);
+  } else if (first && m_batch_delay.count() > 0) {
+    s.tasks.add([this, &s] { flush_due_releases(s); },
+                batch.batching.deadline());
+  }
+}
+
+void TsManager::flush_releases(IngestShard& s,
+                               ucp_ep_h ep,
+                               ReleaseBatch& batch) {
+  auto& ids = batch.ids;
+  if (ids.empty()) {
+    return;
+  }
+  s.release_count.fetch_add(ids.size(), std::memory_order_relaxed);
+  s.sent_message_count.fetch_add(1, std::memory_order_relaxed);
+
+  if (ids.size() == 1) {
+    std::array<uint64_t, 1> hdr{ids.front()};
+    auto header = std::as_bytes(std::span(hdr));
+    ucx::util::send_active_message(ep, AM_MANAGER_RELEASE_ST, header, {},
+                                   ucx::util::on_generic_send_complete, this,
+                                   UCP_AM_SEND_FLAG_COPY_HEADER);
+  } else {
+    std::array<uint64_t, 1> hdr{ids.size()};
+    auto header = std::as_bytes(std::span(hdr));
+    auto buffer = std::make_unique<std::vector<TsId>>(std::move(ids));
+    auto* raw_ptr = buffer.release();
+
+    if (!ucx::util::send_active_message(
+            ep, AM_MANAGER_RELEASE_ST_BATCH, header,
+            std::as_bytes(std::span(*raw_ptr)),
+            [](void* request, ucs_status_t status, void* user_data) {
+              auto buffer = std::unique_ptr<std::vector<TsId>>(
+                  static_cast<std::vector<TsId>*>(user_data));
+              ucx::util::on_generic_send_complete(request, status, user_data);
+            },
+            raw_ptr, UCP_AM_SEND_FLAG_COPY_HEADER)) {
+      delete raw_ptr;
+    }
+  }
+  ids.clear();
+  batch.batching.sent();
+}
+
+void TsManager::flush_due_releases(IngestShard& s) {
+  auto now = Scheduler::clock::now();
+  for (auto& [ep, batch] : s.release_batches) {
+    if (batch.batching.due(now)) {
+      flush_releases(s, ep, batch);
+    }
+  }
+}
+
+void TsManager::send_assignment(IngestShard& s, ShardCommand& cmd) {
+  if (!s.connections.contains(cmd.ep)) {
+    DEBUG("{}| Dropping assignment for disconnected builder", cmd.id);
+    return;
+  }
+  std::array<uint64_t, 2> hdr{cmd.id, cmd.ms_data_size};
+  auto header = std::as_bytes(std::span(hdr));
+  auto buffer =
+      std::make_unique<std::vector<std::byte>>(std::move(cmd.collection));
+  auto* raw_ptr = buffer.release();
+
+  if (!ucx::util::send_active_message(
+          cmd.ep, AM_MANAGER_ASSIGN_TS, header, *raw_ptr,
+          [](void* request, ucs_status_t status, void* user_data) {
+            auto buffer = std::unique_ptr<std::vector<std::byte>>(
+                static_cast<std::vector<std::byte>*>(user_data));
+            ucx::util::on_generic_send_complete(request, status, user_data);
+          },
+          raw_ptr, UCP_AM_SEND_FLAG_COPY_HEADER)) {
+    delete raw_ptr;
+  }
+  s.sent_message_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Event processing (merge stage)
+
+std::size_t TsManager::process_events() {
+  // Process at most one queue length per shard at a time, so that no shard
+  // is starved
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < m_shards.size(); ++i) {
+    auto& events = m_shards[i]->events;
+    for (std::size_t n = 0; n < events.capacity(); ++n) {
+      IngestEvent* ev = events.front();
+      if (ev == nullptr) {
+        break;
+      }
+      process_event(i, *ev);
+      events.pop();
+      ++count;
+    }
+  }
+  return count;
+}
+
+void TsManager::process_event(std::size_t shard, IngestEvent& ev) {
+  switch (ev.type) {
+  case IngestEvent::Type::sender_registered: {
+    auto& sender = m_senders[ev.ep];
+    sender = SenderConnection{ev.sender_info, ev.ep, shard};
+    INFO("Accepted sender registration from '{}'", sender.info.id());
+    break;
+  }
+  case IngestEvent::Type::builder_registered:
+    m_builders.emplace_back(ev.builder_info, ev.ep, shard);
+    INFO("Accepted builder registration from '{}'", ev.builder_info.id());
+    break;
+  case IngestEvent::Type::announcement:
+    process_announcement(ev);
+    break;
+  case IngestEvent::Type::retraction:
+    process_retraction(ev);
+    break;
+  case IngestEvent::Type::builder_status:
+    process_builder_status(ev);
+    break;
+  case IngestEvent::Type::disconnected:
+    process_disconnect(ev.ep);
+    break;
+  }
+}
+
+void TsManager::process_announcement(IngestEvent& ev) {
+  m_status_info.announcement_count++;
+  const TsId id = ev.id;
+  auto it = m_senders.find(ev.ep);
+  if (it == m_senders.end()) {
+    ERROR("{}| Received announcement from unknown sender", id);
+    return;
+  }
+  auto& sender_conn = it->second;
+
+  if (ev.st_descriptor.duration_ns !=
+      static_cast<uint64_t>(m_timeslice_duration_ns)) {
+    ERROR("{}| Invalid timeslice duration from sender '{}'", id,
+          sender_conn.info.id());
+    return;
+  }
+
+  if (id < m_id) {
+    auto late_ts = m_id - id;
+    auto late_ns = late_ts * m_timeslice_duration_ns;
+    DEBUG("{}| Late announcement from '{}' by {} ts ({} ms), sending release",
+          id, sender_conn.info.id(), late_ts, (late_ns + 500000) / 1000000);
+    post_command(sender_conn.shard,
+                 {ShardCommand::Type::release, sender_conn.ep, id, 0, {}});
+    return;
+  }
+
+  m_announced[id].push_back(
+      {sender_conn.ep, ev.ms_data_size, std::move(ev.st_descriptor)});
+  const bool was_lagging = is_lagging(sender_conn);
+  untrack_last_received(sender_conn);
+  sender_conn.last_received_st = id;
+  ++m_senders_by_last_st[id];
+  if (sender_conn.state == SenderState::registered) {
+    sender_conn.state = SenderState::active;
+    m_active_sender_count++;
+    INFO("Sender '{}' is now active", sender_conn.info.id());
+  }
+  if (is_lagging(sender_conn) != was_lagging) {
+    was_lagging ? --m_lagging_sender_count : ++m_lagging_sender_count;
+  }
+  DEBUG("{}| Announcement from '{}' ({})", id, sender_conn.info.id(),
+        human_readable_count(ev.ms_data_size, true));
+}
+
+void TsManager::process_retraction(const IngestEvent& ev) {
+  const TsId id = ev.id;
+  auto it = m_senders.find(ev.ep);
+  if (it == m_senders.end()) {
+    ERROR("{}| Received retraction from unknown sender", id);
+    return;
+  }
+  auto& conn = it->second;
+
+  auto ts_it = m_announced.find(id);
+  if (ts_it != m_announced.end()) {
+    auto& contributions = ts_it->second;
+    auto c_it =
+        std::find_if(contributions.begin(), contributions.end(),
+                     [ep = ev.ep](const auto& c) { return c.sender == ep; });
+    if (c_it != contributions.end()) {
+      DEBUG("{}| Retraction for subtimeslice from sender '{}'", id,
+            conn.info.id());
+      contributions.erase(c_it);
+      if (contributions.empty()) {
+        m_announced.erase(ts_it);
+      }
+      return;
+    }
+  }
+  WARN("{}| Retraction for unannounced subtimeslice from sender '{}'", id,
+       conn.info.id());
+}
+
+void TsManager::process_builder_status(const IngestEvent& ev) {
   // Find the builder connection
-  auto it = std::find_if(m_builders.begin(), m_builders.end(),
-                         [ep = param->reply_ep](const BuilderConnection& b) {
-                           return b.ep == ep;
-                         });
+  auto it = std::find_if(
+      m_builders.begin(), m_builders.end(),
+      [ep = ev.ep](const BuilderConnection& b) { return b.ep == ep; });
   if (it == m_builders.end()) {
     ERROR("Received status from unknown builder");
-    return UCS_OK;
+    return;
   }
-  const uint64_t event = hdr[0];
-  const TsId id = hdr[1];
-  const uint64_t new_bytes_free = hdr[2];
+  const uint64_t event = ev.event;
+  const TsId id = ev.id;
+  const uint64_t new_bytes_free = ev.bytes_free;
 
   switch (event) {
   case BUILDER_EVENT_NO_OP:
@@ -414,12 +896,23 @@ TsManager::handle_builder_status(const void* header,
   case BUILDER_EVENT_OUT_OF_MEMORY:
     INFO("{}| Builder '{}' has reported out of memory", id, it->info.id());
     it->is_out_of_memory = true;
-    it->assigned_ts.erase(id);
+    it->remove_assignment(id);
     assign_timeslice(id);
     break;
   case BUILDER_EVENT_RECEIVED:
     DEBUG("{}| Builder '{}' has received timeslice", id, it->info.id());
-    it->assigned_ts.erase(id);
+    if (auto elapsed = it->remove_assignment(id)) {
+      // Exponentially weighted moving average, as used for TCP RTT estimation
+      constexpr double weight = 0.125;
+      auto latency_ns = static_cast<double>(elapsed->count());
+      m_completion_count.Add();
+      m_completion_latency.Record(static_cast<uint64_t>(elapsed->count()));
+      it->completion_latency_ns =
+          (it->completion_latency_ns == 0)
+              ? latency_ns
+              : it->completion_latency_ns +
+                    weight * (latency_ns - it->completion_latency_ns);
+    }
     send_release_to_senders(id);
     break;
   case BUILDER_EVENT_RELEASED:
@@ -431,35 +924,143 @@ TsManager::handle_builder_status(const void* header,
     it->bytes_available = new_bytes_free;
     break;
   }
+}
 
-  return UCS_OK;
+void TsManager::process_disconnect(ucp_ep_h ep) {
+  auto sender_it = m_senders.find(ep);
+  if (sender_it != m_senders.end()) {
+    INFO("Disconnect from sender '{}'", sender_it->second.info.id());
+    if (is_lagging(sender_it->second)) {
+      m_lagging_sender_count--;
+    }
+    untrack_last_received(sender_it->second);
+    if (sender_it->second.state == SenderState::active) {
+      m_active_sender_count--;
+    }
+    // Drop the sender's announcements (rare, so a full scan is fine)
+    for (auto it = m_announced.begin(); it != m_announced.end();) {
+      auto& contributions = it->second;
+      std::erase_if(contributions,
+                    [ep](const Contribution& c) { return c.sender == ep; });
+      it = contributions.empty() ? m_announced.erase(it) : std::next(it);
+    }
+    m_senders.erase(sender_it);
+  }
+
+  if (auto it =
+          std::find_if(m_builders.begin(), m_builders.end(),
+                       [ep](const BuilderConnection& b) { return b.ep == ep; });
+      it != m_builders.end()) {
+    if (!it->assigned_ts.empty()) {
+      INFO("Releasing {} in-flight timeslice(s) from builder '{}'",
+           it->assigned_ts.size(), it->info.id());
+      for (const auto& [ts_id, _] : it->assigned_ts) {
+        send_release_to_senders(ts_id);
+      }
+    }
+    INFO("Disconnect from builder '{}'", it->info.id());
+    m_builders.erase(it);
+  }
 }
 
+void TsManager::post_command(std::size_t shard, ShardCommand cmd) {
+  m_outgoing[shard].push_back(std::move(cmd));
+}
+
+// Pass the commands of the current iteration on to the shards
+void TsManager::flush_commands() {
+  for (std::size_t i = 0; i < m_shards.size(); ++i) {
+    auto& outgoing = m_outgoing[i];
+    if (outgoing.empty()) {
+      continue;
+    }
+    IngestShard& s = *m_shards[i];
+    {
+      std::lock_guard<std::mutex> lock(s.commands_mutex);
+      if (s.commands.empty()) {
+        s.commands.swap(outgoing);
+      } else {
+        std::move(outgoing.begin(), outgoing.end(),
+                  std::back_inserter(s.commands));
+      }
+    }
+    outgoing.clear();
+    notify(s.queue_event_fd);
+  }
+}
+
+void TsManager::wait_for_events(int timeout_ms) {
+  std::array<epoll_event, 1> events{};
+  int nfds = epoll_wait(m_epoll_fd, events.data(), events.size(), timeout_ms);
+  if (nfds == -1 && errno != EINTR) {
+    ERROR("epoll_wait failed: {}", strerror(errno));
+  }
+  if (nfds > 0) {
+    uint64_t value = 0;
+    [[maybe_unused]] auto ret = read(m_event_fd, &value, sizeof(value));
+  }
+}
+
+void TsManager::send_release_to_senders(TsId id) {
+  auto it = m_announced.find(id);
+  if (it == m_announced.end()) {
+    return;
+  }
+  for (const auto& c : it->second) {
+    if (auto sender_it = m_senders.find(c.sender);
+        sender_it != m_senders.end()) {
+      post_command(sender_it->second.shard,
+                   {ShardCommand::Type::release, c.sender, id, 0, {}});
+    }
+  }
+  m_announced.erase(it);
+}
+
+// Whether the merge stage waits for an announcement of m_id by the sender
+bool TsManager::is_lagging(const SenderConnection& sender) const {
+  return sender.state == SenderState::active && sender.last_received_st < m_id;
+}
+
+// Remove the sender from the count of senders by last announced timeslice
+void TsManager::untrack_last_received(const SenderConnection& sender) {
+  if (sender.state != SenderState::active || sender.last_received_st < m_id) {
+    return;
+  }
+  auto it = m_senders_by_last_st.find(sender.last_received_st);
+  if (--it->second == 0) {
+    m_senders_by_last_st.erase(it);
+  }
+}
+
+void TsManager::advance_id() {
+  // Senders whose last announcement is m_id start lagging behind m_id + 1
+  if (auto it = m_senders_by_last_st.find(m_id);
+      it != m_senders_by_last_st.end()) {
+    m_lagging_sender_count += it->second;
+    m_senders_by_last_st.erase(it);
+  }
+  m_id++;
+}
+
+// Builder assignment (merge stage)
+
 void TsManager::assign_timeslice(TsId id) {
   StCollection coll = create_collection_descriptor(id);
   if (coll.sender_ids.empty()) {
-    auto active_count =
-        std::count_if(m_senders.begin(), m_senders.end(), [](const auto& s) {
-          return s.second.state == SenderState::active;
-        });
-    if (active_count > 0) {
-      WARN("{}| Sender(s) active ({}), but no contributions", id, active_count);
+    if (m_active_sender_count > 0) {
+      WARN("{}| Sender(s) active ({}), but no contributions", id,
+           m_active_sender_count);
     }
     return;
   }
 
-  for (std::size_t i = 0; i < m_builders.size(); ++i) {
-    auto& builder = m_builders[(id + i) % m_builders.size()];
-    if (builder.assigned_ts.size() < m_max_in_flight &&
-        builder.bytes_available >= coll.ms_data_size() &&
-        !builder.is_out_of_memory) {
-      builder.assigned_ts.insert(id);
-      send_assignment_to_builder(coll, builder);
-      DEBUG("{}| Assigned to '{}' ({}s, {})", id, builder.info.id(),
-            coll.sender_ids.size(),
-            human_readable_count(coll.ms_data_size(), true));
-      return;
-    }
+  if (auto* builder = select_builder(id, coll.ms_data_size())) {
+    builder->add_assignment(id, coll.ms_data_size());
+    send_assignment_to_builder(coll, *builder);
+    DEBUG("{}| Assigned to '{}' ({}s, {})", id, builder->info.id(),
+          coll.sender_ids.size(),
+          human_readable_count(coll.ms_data_size(), true));
+    return;
   }
   WARN("{}| No builder available ({}s, {})", id, coll.sender_ids.size(),
        human_readable_count(coll.ms_data_size(), true));
@@ -467,43 +1068,93 @@ void TsManager::assign_timeslice(TsId id) {
   send_release_to_senders(id);
 }
 
+BuilderConnection* TsManager::select_builder(TsId id, uint64_t ms_data_size) {
+  // Collect the eligible builders in round-robin order, starting at id
+  std::vector<BuilderConnection*> eligible;
+  eligible.reserve(m_builders.size());
+  for (std::size_t i = 0; i < m_builders.size(); ++i) {
+    auto& builder = m_builders[(id + i) % m_builders.size()];
+    if (builder.assigned_ts.size() < m_max_in_flight &&
+        builder.bytes_available >= ms_data_size && !builder.is_out_of_memory) {
+      eligible.push_back(&builder);
+    }
+  }
+  if (eligible.empty()) {
+    return nullptr;
+  }
+
+  // Ties are resolved in favor of the builder that comes first in
+  // round-robin order
+  auto by_outstanding_bytes = [](const BuilderConnection* a,
+                                 const BuilderConnection* b) {
+    return a->outstanding_bytes < b->outstanding_bytes;
+  };
+
+  switch (m_assignment_policy) {
+  case AssignmentPolicy::round_robin:
+    return eligible.front();
+  case AssignmentPolicy::least_outstanding:
+    return *std::min_element(eligible.begin(), eligible.end(),
+                             by_outstanding_bytes);
+  case AssignmentPolicy::power_of_two: {
+    if (eligible.size() == 1) {
+      return eligible.front();
+    }
+    std::uniform_int_distribution<std::size_t> dist(0, eligible.size() - 1);
+    std::size_t first = dist(m_random_engine);
+    std::size_t second = dist(m_random_engine);
+    while (second == first) {
+      second = dist(m_random_engine);
+    }
+    return by_outstanding_bytes(eligible[second], eligible[first])
+               ? eligible[second]
+               : eligible[first];
+  }
+  case AssignmentPolicy::latency_weighted:
+    // Expected time until the builder has caught up with its assignments.
+    // Builders without a latency estimate yet are preferred to obtain one.
+    return *std::min_element(
+        eligible.begin(), eligible.end(),
+        [](const BuilderConnection* a, const BuilderConnection* b) {
+          auto cost = [](const BuilderConnection* c) {
+            return static_cast<double>(c->assigned_ts.size() + 1) *
+                   c->completion_latency_ns;
+          };
+          return cost(a) < cost(b);
+        });
+  }
+  return eligible.front();
+}
+
 void TsManager::send_assignment_to_builder(const StCollection& coll,
                                            BuilderConnection& builder) {
-  std::array<uint64_t, 2> hdr{coll.id, coll.ms_data_size()};
-  auto header = std::as_bytes(std::span(hdr));
-  auto buffer =
-      std::make_unique<std::vector<std::byte>>(serialize_collection(coll));
-  auto* raw_ptr = buffer.release();
-
-  ucx::util::send_active_message(
-      builder.ep, AM_MANAGER_ASSIGN_TS, header, *raw_ptr,
-      [](void* request, ucs_status_t status, void* user_data) {
-        auto buffer = std::unique_ptr<std::vector<std::byte>>(
-            static_cast<std::vector<std::byte>*>(user_data));
-        ucx::util::on_generic_send_complete(request, status, user_data);
-      },
-      raw_ptr, UCP_AM_SEND_FLAG_COPY_HEADER);
+  post_command(builder.shard,
+               {ShardCommand::Type::assign, builder.ep, coll.id,
+                coll.ms_data_size(), serialize_collection(coll)});
 }
 
 // Helper methods
 
+void TsManager::notify(int event_fd) {
+  uint64_t value = 1;
+  ssize_t ret = write(event_fd, &value, sizeof(value));
+  if (ret != sizeof(value)) {
+    ERROR("Failed to write to event fd: {}", strerror(errno));
+  }
+}
+
 StCollection TsManager::create_collection_descriptor(TsId id) {
   StCollection coll;
   coll.id = id;
 
-  // First pass: collect contributors in iteration order and sum sizes
-  std::vector<const SenderConnection::StDesc*> contributions;
-  for (auto& [sender_ep, sender] : m_senders) {
-    auto it =
-        std::find_if(sender.announced_st.begin(), sender.announced_st.end(),
-                     [id](const auto& st) { return st.id == id; });
-    if (it != sender.announced_st.end()) {
-      coll.sender_ids.push_back(sender.info.advertise_id());
-      coll.ms_data_sizes.push_back(it->ms_data_size);
-      contributions.push_back(&*it);
-    } else if (sender.state == SenderState::active) {
-      DEBUG("{}| No contribution found from sender '{}'", id, sender.info.id());
-    }
+  auto it = m_announced.find(id);
+  if (it == m_announced.end()) {
+    return coll;
+  }
+  const auto& contributions = it->second;
+  if (contributions.size() < m_active_sender_count) {
+    DEBUG("{}| Contributions from {} of {} active senders", id,
+          contributions.size(), m_active_sender_count);
   }
 
   // Build the merged descriptor: per-sender offsets are the partial_sum of
@@ -511,8 +1162,11 @@ StCollection TsManager::create_collection_descriptor(TsId id) {
   // ms_data_offset shifted by that offset to become absolute within the
   // combined buffer.
   uint64_t running_offset = 0;
-  for (std::size_t i = 0; i < contributions.size(); ++i) {
-    const auto& contrib = contributions[i]->st_descriptor;
+  for (const auto& c : contributions) {
+    coll.sender_ids.push_back(m_senders.at(c.sender).info.advertise_id());
+    coll.ms_data_sizes.push_back(c.ms_data_size);
+
+    const auto& contrib = c.st_descriptor;
     if (coll.merged_descriptor.duration_ns == 0) {
       coll.merged_descriptor.start_time_ns = contrib.start_time_ns;
       coll.merged_descriptor.duration_ns = contrib.duration_ns;
@@ -521,37 +1175,77 @@ StCollection TsManager::create_collection_descriptor(TsId id) {
       ERROR("{}| Inconsistent start time or duration in contributions", id);
     }
     coll.merged_descriptor.flags |= contrib.flags;
-    for (const auto& c : contrib.components) {
-      coll.merged_descriptor.components.push_back(c);
+    for (const auto& component : contrib.components) {
+      coll.merged_descriptor.components.push_back(component);
       coll.merged_descriptor.components.back().ms_data_offset +=
           static_cast<std::ptrdiff_t>(running_offset);
     }
-    running_offset += coll.ms_data_sizes[i];
+    running_offset += c.ms_data_size;
   }
 
-  // ... TODO: remove this code
   m_status_info.timeslice_count++;
   m_status_info.component_count += coll.sender_ids.size();
-  // ...
+  m_status_info.data_bytes += running_offset;
   return coll;
 }
 
 void TsManager::report_status() {
   constexpr auto interval = 1s;
-  auto now = std::chrono::system_clock::now();
+  auto now = Scheduler::clock::now();
+
+  // Collect the counters of the shards
+  m_status_info.message_count = 0;
+  m_status_info.sent_message_count = 0;
+  m_status_info.release_count = 0;
+  for (const auto& s : m_shards) {
+    m_status_info.message_count += s->message_count.load();
+    m_status_info.sent_message_count += s->sent_message_count.load();
+    m_status_info.release_count += s->release_count.load();
+  }
+
+  auto dt = std::chrono::duration<double>(now - m_report_time_last).count();
+  StatusInfo diff = m_status_info - m_report_info_last;
+  m_report_info_last = m_status_info;
+  m_report_time_last = now;
 
   if (m_monitor != nullptr) {
-    m_monitor->QueueMetric("tsmanager_status", {{"host", m_hostname}},
-                           {{"timeslice_count", 0}});
+    m_monitor->QueueMetric(
+        "tsmanager_status", {{"host", m_hostname}},
+        {{"timeslice_count", m_status_info.timeslice_count},
+         {"component_count", m_status_info.component_count},
+         {"timeslice_discarded_count",
+          m_status_info.timeslice_discarded_count},
+         {"message_count", m_status_info.message_count},
+         {"announcement_count", m_status_info.announcement_count},
+         {"release_count", m_status_info.release_count},
+         {"sent_message_count", m_status_info.sent_message_count},
+         {"message_rate", static_cast<double>(diff.message_count) / dt},
+         {"announced_ts", m_announced.size()}});
+    for (const auto& s : m_shards) {
+      m_monitor->QueueMetric(
+          "tsmanager_shard_status",
+          {{"host", m_hostname}, {"shard", std::to_string(s->index)}},
+          {{"message_count", s->message_count.load()},
+           {"sent_message_count", s->sent_message_count.load()},
+           {"event_queue_size", s->events.size()}});
+    }
+    for (const auto& builder : m_builders) {
+      m_monitor->QueueMetric(
+          "tsmanager_builder_status",
+          {{"host", m_hostname}, {"builder", builder.info.id()}},
+          {{"assigned_ts", builder.assigned_ts.size()},
+           {"outstanding_bytes", builder.outstanding_bytes},
+           {"bytes_available", builder.bytes_available},
+           {"completion_latency_ns", builder.completion_latency_ns}});
+    }
   }
-  // TODO: Add real metrics
 
   m_tasks.add([this] { report_status(); }, now + interval);
 }
 
 void TsManager::log_status() {
   constexpr auto interval = 10s;
-  auto now = std::chrono::system_clock::now();
+  auto now = Scheduler::clock::now();
   m_tasks.add([this] { log_status(); }, now + interval);
 
   auto dt = std::chrono::duration<double>(now - m_status_time_last).count();
@@ -564,18 +1258,20 @@ void TsManager::log_status() {
   double data_rate = static_cast<double>(diff.data_bytes) / dt;
   m_status_info_last = m_status_info;
 
+  double message_rate = static_cast<double>(diff.message_count) / dt;
   std::string additional;
   if (diff.timeslice_discarded_count > 0) {
     additional =
         std::format(" [discarded: {} ts]", diff.timeslice_discarded_count);
   }
-  STATUS("* {} s, {} b, {} ts, {} c, {}, {}{}", m_senders.size(),
-         m_builders.size(), m_status_info.timeslice_count,
+  STATUS("* {} s, {} b, {} ts, {} c, {}, {}, {:.0f} msg/s{}",
+         m_senders.size(), m_builders.size(), m_status_info.timeslice_count,
          m_status_info.component_count,
          human_readable_count(m_status_info.data_bytes, true),
          human_readable_count(static_cast<uint64_t>(data_rate), true),
-         additional);
-  // STATUS: * 3 s, 2 b, 123 ts, 8285 c, 1.234 GB, 100.6 MB/s [discarded: 12 ts]
+         message_rate, additional);
+  // STATUS: * 3 s, 2 b, 123 ts, 8285 c, 1.234 GB, 100.6 MB/s, 950 msg/s
+  //         [discarded: 12 ts]
   // STATUS: * checked 41 ts, 82 c, 41164 m, 4.116 GB
   // TODO: Keep better track of timeslices in various states
   // (including: only send release to contributing senders)
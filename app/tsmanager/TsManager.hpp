@@ -3,45 +3,83 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include "AdaptiveBatching.hpp"
+#include "AssignmentPolicy.hpp"
+#include "FlatHashMap.hpp"
 #include "Monitor.hpp"
 #include "Scheduler.hpp"
+#include "SpscQueue.hpp"
 #include "SubTimeslice.hpp"
 #include "ucxutil.hpp"
+#include <atomic>
+#include <chrono>
 #include <csignal>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 #include <sys/types.h>
+#include <thread>
 #include <ucp/api/ucp.h>
 #include <ucp/api/ucp_def.h>
 #include <unistd.h>
-#include <unordered_set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // TsManager: Receive subtimeslice announcements from stsenders, aggregate,
 // and send subtimeslice handles to tsbuilders
+//
+// The connections are distributed across ingest shards, each a UCX worker
+// driven by a thread of its own. A shard receives and parses the messages of
+// its connections and sends the messages to them. The main thread (the merge
+// stage) keeps the announced subtimeslices indexed by timeslice, builds the
+// StCollections, and assigns them to builders. The shards and the merge
+// stage communicate through queues only; endpoints are accessed exclusively
+// by the thread of the owning shard.
 
 enum class SenderState { registered, active };
 
 struct SenderConnection {
   SenderInfo info;
   ucp_ep_h ep = nullptr;
+  std::size_t shard = 0;
   SenderState state = SenderState::registered;
-  struct StDesc {
-    TsId id;
-    uint64_t ms_data_size = 0;
-    StDescriptor st_descriptor;
-  };
-  std::deque<StDesc> announced_st;
   TsId last_received_st = 0;
 };
 
+/// A subtimeslice announced by a sender
+struct Contribution {
+  ucp_ep_h sender = nullptr;
+  uint64_t ms_data_size = 0;
+  StDescriptor st_descriptor;
+};
+
 struct BuilderConnection {
   BuilderInfo info;
   ucp_ep_h ep = nullptr;
+  std::size_t shard = 0;
   uint64_t bytes_available = 0;
   bool is_out_of_memory = false;
-  std::unordered_set<TsId> assigned_ts;
+  struct Assignment {
+    uint64_t ms_data_size = 0;
+    std::chrono::steady_clock::time_point time;
+  };
+  // Timeslices assigned, but not yet reported as received
+  std::unordered_map<TsId, Assignment> assigned_ts;
+  uint64_t outstanding_bytes = 0; ///< sum of ms_data_size in assigned_ts
+  /// Moving average of the time from assignment to reception (0 if unknown)
+  double completion_latency_ns = 0;
+
+  void add_assignment(TsId id, uint64_t ms_data_size);
+  /// Remove an assignment, returns the elapsed time if it existed.
+  std::optional<std::chrono::nanoseconds> remove_assignment(TsId id);
 };
 
 struct StatusInfo {
@@ -49,6 +87,10 @@ struct StatusInfo {
   size_t component_count = 0; ///< total number of processed components
   size_t data_bytes = 0;      ///< total number of processed data bytes
   size_t timeslice_discarded_count = 0; ///< number of discarded timeslices
+  size_t message_count = 0;      ///< total number of received messages
+  size_t announcement_count = 0; ///< total number of received announcements
+  size_t release_count = 0;      ///< total number of releases sent
+  size_t sent_message_count = 0; ///< total number of sent messages
 
   StatusInfo operator-(const StatusInfo& other) const {
     StatusInfo result;
@@ -57,12 +99,99 @@ struct StatusInfo {
     result.data_bytes = data_bytes - other.data_bytes;
     result.timeslice_discarded_count =
         timeslice_discarded_count - other.timeslice_discarded_count;
+    result.message_count = message_count - other.message_count;
+    result.announcement_count = announcement_count - other.announcement_count;
+    result.release_count = release_count - other.release_count;
+    result.sent_message_count = sent_message_count - other.sent_message_count;
     return result;
   }
 
   bool operator==(const StatusInfo& other) const = default;
 };
 
+/// A message received by an ingest shard, passed to the merge stage
+struct IngestEvent {
+  enum class Type {
+    sender_registered,
+    builder_registered,
+    announcement,
+    retraction,
+    builder_status,
+    disconnected
+  };
+  Type type = Type::announcement;
+  ucp_ep_h ep = nullptr;
+  TsId id = 0;
+  uint64_t ms_data_size = 0;  ///< announcements only
+  uint64_t event = 0;         ///< builder status only
+  uint64_t bytes_free = 0;    ///< builder status only
+  StDescriptor st_descriptor; ///< announcements only
+  SenderInfo sender_info;     ///< sender registrations only
+  BuilderInfo builder_info;   ///< builder registrations only
+};
+
+/// A message to be sent by an ingest shard on behalf of the merge stage
+struct ShardCommand {
+  enum class Type { release, assign };
+  Type type = Type::release;
+  ucp_ep_h ep = nullptr;
+  TsId id = 0;
+  uint64_t ms_data_size = 0;         ///< assignments only
+  std::vector<std::byte> collection; ///< assignments only (serialized)
+};
+
+/// Releases of a sender connection not yet sent
+struct ReleaseBatch {
+  std::vector<TsId> ids;
+  AdaptiveBatching batching;
+};
+
+class TsManager;
+
+/// A UCX worker with its own thread, owning a subset of the connections.
+/// Shard 0 additionally runs the listener and distributes new connections
+/// across the shards round-robin.
+struct IngestShard {
+  IngestShard(TsManager* manager, std::size_t index, std::size_t capacity)
+      : manager(manager), index(index), events(capacity) {}
+  IngestShard(const IngestShard&) = delete;
+  IngestShard& operator=(const IngestShard&) = delete;
+
+  TsManager* const manager;
+  const std::size_t index;
+  ucp_worker_h worker = nullptr;
+  ucp_listener_h listener = nullptr; ///< shard 0 only
+  int epoll_fd = -1;
+  int queue_event_fd = -1;
+  std::atomic_bool is_ready = false;
+  Scheduler tasks;
+
+  /// Connection requests accepted by the listener, to be completed on this
+  /// shard (together with the client address)
+  std::deque<std::pair<ucp_conn_request_h, std::string>> pending_connections;
+  std::mutex connections_mutex;
+
+  /// Commands from the merge stage, swapped out by the shard
+  std::vector<ShardCommand> commands;
+  std::mutex commands_mutex;
+  std::vector<ShardCommand> local_commands;
+
+  std::unordered_map<ucp_ep_h, std::string> connections;
+  std::unordered_map<ucp_ep_h, ReleaseBatch> release_batches;
+
+  /// Messages for the merge stage (single producer, single consumer)
+  SpscQueue<IngestEvent> events;
+  bool events_pushed = false; ///< merge stage not yet notified
+
+  // Counters (written by the shard thread, read for monitoring)
+  std::atomic<uint64_t> message_count = 0;      ///< received messages
+  std::atomic<uint64_t> sent_message_count = 0; ///< sent messages
+  std::atomic<uint64_t> release_count = 0;      ///< sent releases
+
+  std::jthread thread;
+  std::stop_token stop_token; ///< of the thread, set by the thread itself
+};
+
 class TsManager {
 public:
   TsManager(volatile sig_atomic_t* signal_status,
@@ -70,6 +199,9 @@ public:
             int64_t timeslice_duration_ns,
             int64_t timeout_ns,
             uint32_t max_in_flight,
+            AssignmentPolicy assignment_policy,
+            std::chrono::nanoseconds batch_delay,
+            std::size_t num_shards,
             cbm::Monitor* monitor);
   ~TsManager();
   TsManager(const TsManager&) = delete;
@@ -85,66 +217,128 @@ private:
   int64_t m_timeslice_duration_ns;
   int64_t m_timeout_ns;
   uint32_t m_max_in_flight;
+  AssignmentPolicy m_assignment_policy;
+  /// Maximum time a release is held back for batching
+  std::chrono::nanoseconds m_batch_delay;
+  std::minstd_rand m_random_engine;
   static constexpr ucx::util::LoopMode m_ucx_loop_mode =
       ucx::util::LoopMode::busy_poll;
   std::string m_hostname;
   cbm::Monitor* m_monitor = nullptr;
+  /// Received timeslices and time from assignment to reception, updated per
+  /// timeslice and reported by the monitor
+  cbm::MetricCounter m_completion_count;
+  cbm::MetricHistogram m_completion_latency;
+
+  /// Capacity of the event queue of each shard
+  static constexpr std::size_t m_queue_capacity = 4096;
 
   int m_epoll_fd = -1;
-  std::unordered_map<ucs_status_ptr_t, TsId> m_active_send_requests;
+  int m_event_fd = -1; ///< signalled by the shards on new events
 
   ucp_context_h m_context = nullptr;
-  ucp_worker_h m_worker = nullptr;
-  ucp_listener_h m_listener = nullptr;
-  std::unordered_map<ucp_ep_h, std::string> m_connections;
+  std::vector<std::unique_ptr<IngestShard>> m_shards;
+  std::size_t m_next_shard = 0; ///< round-robin connection assignment
+  /// Commands to the shards, passed on once per loop iteration
+  std::vector<std::vector<ShardCommand>> m_outgoing;
+
   std::unordered_map<ucp_ep_h, SenderConnection> m_senders;
   std::vector<BuilderConnection> m_builders;
+  /// Announced subtimeslices by timeslice, until released
+  FlatHashMap<TsId, std::vector<Contribution>> m_announced;
+  std::size_t m_active_sender_count = 0;
+  /// Number of active senders that have not yet announced m_id
+  std::size_t m_lagging_sender_count = 0;
+  /// Number of active senders by last announced timeslice (at least m_id)
+  FlatHashMap<TsId, std::size_t> m_senders_by_last_st;
   std::size_t m_ts_count = 0;
   uint64_t m_id = 0;
 
   StatusInfo m_status_info = {};
   StatusInfo m_status_info_last = {};
-  std::chrono::system_clock::time_point m_status_time_last;
+  Scheduler::time_type m_status_time_last;
+  StatusInfo m_report_info_last = {};
+  Scheduler::time_type m_report_time_last;
 
-  // Connection management
+  // Ingest shard management (shard threads)
+  bool start_shards();
+  void stop_shards();
+  bool init_shard(IngestShard& s);
+  void run_shard(IngestShard& s);
+  std::size_t process_pending_connections(IngestShard& s);
+  std::size_t process_commands(IngestShard& s);
+  IngestEvent* next_event(IngestShard& s);
+  void push_event(IngestShard& s);
+
+  // Connection management (shard threads)
   void handle_new_connection(ucp_conn_request_h conn_request);
-  void handle_endpoint_error(ucp_ep_h ep, ucs_status_t status);
-  void disconnect_from_all();
+  void accept_connection(IngestShard& s,
+                         ucp_conn_request_h conn_request,
+                         const std::string& client_address);
+  void handle_endpoint_error(IngestShard& s, ucp_ep_h ep, ucs_status_t status);
+  void disconnect_from_all(IngestShard& s);
 
-  // Sender message handling
-  ucs_status_t handle_sender_register(const void* header,
+  // Message handling (shard threads)
+  ucs_status_t handle_sender_register(IngestShard& s,
+                                      const void* header,
                                       size_t header_length,
-                                      void* data,
                                       size_t length,
                                       const ucp_am_recv_param_t* param);
-  ucs_status_t handle_sender_announce(const void* header,
+  ucs_status_t handle_sender_announce(IngestShard& s,
+                                      const void* header,
                                       size_t header_length,
                                       void* data,
                                       size_t length,
                                       const ucp_am_recv_param_t* param);
-  ucs_status_t handle_sender_retract(const void* header,
+  ucs_status_t handle_sender_announce_batch(IngestShard& s,
+                                            const void* header,
+                                            size_t header_length,
+                                            void* data,
+                                            size_t length,
+                                            const ucp_am_recv_param_t* param);
+  ucs_status_t handle_sender_retract(IngestShard& s,
+                                     const void* header,
                                      size_t header_length,
-                                     void* data,
                                      size_t length,
                                      const ucp_am_recv_param_t* param);
-  void send_release_to_senders(TsId id);
-
-  // Builder message handling
-  ucs_status_t handle_builder_register(const void* header,
+  ucs_status_t handle_builder_register(IngestShard& s,
+                                       const void* header,
                                        size_t header_length,
-                                       void* data,
                                        size_t length,
                                        const ucp_am_recv_param_t* param);
-  ucs_status_t handle_builder_status(const void* header,
+  ucs_status_t handle_builder_status(IngestShard& s,
+                                     const void* header,
                                      size_t header_length,
-                                     void* data,
                                      size_t length,
                                      const ucp_am_recv_param_t* param);
+  void queue_release(IngestShard& s, ucp_ep_h ep, TsId id);
+  void flush_releases(IngestShard& s, ucp_ep_h ep, ReleaseBatch& batch);
+  void flush_due_releases(IngestShard& s);
+  void send_assignment(IngestShard& s, ShardCommand& cmd);
+
+  // Event processing (merge stage)
+  std::size_t process_events();
+  void process_event(std::size_t shard, IngestEvent& ev);
+  void process_announcement(IngestEvent& ev);
+  void process_retraction(const IngestEvent& ev);
+  void process_builder_status(const IngestEvent& ev);
+  void process_disconnect(ucp_ep_h ep);
+  void post_command(std::size_t shard, ShardCommand cmd);
+  void flush_commands();
+  void wait_for_events(int timeout_ms);
+  void send_release_to_senders(TsId id);
+  [[nodiscard]] bool is_lagging(const SenderConnection& sender) const;
+  void untrack_last_received(const SenderConnection& sender);
+  void advance_id();
+
+  // Builder assignment (merge stage)
   void assign_timeslice(TsId id);
+  BuilderConnection* select_builder(TsId id, uint64_t ms_data_size);
   void send_assignment_to_builder(const StCollection& coll,
                                   BuilderConnection& builder);
 
   // Helper methods
+  static void notify(int event_fd);
   StCollection create_collection_descriptor(TsId id);
   void report_status();
   void log_status();
@@ -154,16 +348,18 @@ private:
     static_cast<TsManager*>(arg)->handle_new_connection(conn_request);
   }
   static void on_endpoint_error(void* arg, ucp_ep_h ep, ucs_status_t status) {
-    static_cast<TsManager*>(arg)->handle_endpoint_error(ep, status);
+    auto* s = static_cast<IngestShard*>(arg);
+    s->manager->handle_endpoint_error(*s, ep, status);
   }
   static ucs_status_t on_sender_register(void* arg,
                                          const void* header,
                                          size_t header_length,
-                                         void* data,
+                                         [[maybe_unused]] void* data,
                                          size_t length,
                                          const ucp_am_recv_param_t* param) {
-    return static_cast<TsManager*>(arg)->handle_sender_register(
-        header, header_length, data, length, param);
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_sender_register(*s, header, header_length,
+                                              length, param);
   }
   static ucs_status_t on_sender_announce(void* arg,
                                          const void* header,
@@ -171,34 +367,49 @@ private:
                                          void* data,
                                          size_t length,
                                          const ucp_am_recv_param_t* param) {
-    return static_cast<TsManager*>(arg)->handle_sender_announce(
-        header, header_length, data, length, param);
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_sender_announce(*s, header, header_length, data,
+                                              length, param);
+  }
+  static ucs_status_t
+  on_sender_announce_batch(void* arg,
+                           const void* header,
+                           size_t header_length,
+                           void* data,
+                           size_t length,
+                           const ucp_am_recv_param_t* param) {
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_sender_announce_batch(*s, header, header_length,
+                                                    data, length, param);
   }
   static ucs_status_t on_sender_retract(void* arg,
                                         const void* header,
                                         size_t header_length,
-                                        void* data,
+                                        [[maybe_unused]] void* data,
                                         size_t length,
                                         const ucp_am_recv_param_t* param) {
-    return static_cast<TsManager*>(arg)->handle_sender_retract(
-        header, header_length, data, length, param);
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_sender_retract(*s, header, header_length, length,
+                                             param);
   }
   static ucs_status_t on_builder_register(void* arg,
                                           const void* header,
                                           size_t header_length,
-                                          void* data,
+                                          [[maybe_unused]] void* data,
                                           size_t length,
                                           const ucp_am_recv_param_t* param) {
-    return static_cast<TsManager*>(arg)->handle_builder_register(
-        header, header_length, data, length, param);
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_builder_register(*s, header, header_length,
+                                               length, param);
   }
   static ucs_status_t on_builder_status(void* arg,
                                         const void* header,
                                         size_t header_length,
-                                        void* data,
+                                        [[maybe_unused]] void* data,
                                         size_t length,
                                         const ucp_am_recv_param_t* param) {
-    return static_cast<TsManager*>(arg)->handle_builder_status(
-        header, header_length, data, length, param);
+    auto* s = static_cast<IngestShard*>(arg);
+    return s->manager->handle_builder_status(*s, header, header_length, length,
+                                             param);
   }
 };
@@ -0,0 +1,534 @@
+/* Copyright (C) 2025 FIAS, Goethe-Universität Frankfurt am Main
+   SPDX-License-Identifier: GPL-3.0-only
+   Author: Jan de Cuveland */
+
+// Load generator for the timeslice manager
+//
+// Simulates N senders and M builders against a running tsmanager, without
+// any data transfer: every timeslice duration, each sender announces a
+// subtimeslice, and each builder immediately reports assigned timeslices as
+// allocated, received, and released. The assignment latency (from the
+// announcement to the reception of the assignment) and the message rates
+// are reported every second.
+//
+// Example (the timeslice duration has to match):
+//   tsmanager --ingest-shards 4 --timeslice-duration 100us
+//   tsmanager_loadgen --senders 64 --builders 8 --timeslice-duration 100us
+
+#include "FlatHashMap.hpp"
+#include "LatencyHistogram.hpp"
+#include "OptionValues.hpp"
+#include "SubTimeslice.hpp"
+#include "System.hpp"
+#include "TsbProtocol.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include "ucxutil.hpp"
+#include <array>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace option_value_literals;
+
+namespace {
+volatile sig_atomic_t signal_status = 0;
+}
+
+static void signal_handler(int sig) { signal_status = sig; }
+
+namespace {
+
+struct Options {
+  std::string manager_address = "localhost";
+  uint32_t num_senders = 16;
+  uint32_t num_builders = 4;
+  uint32_t num_components = 1;
+  SizeValue contribution_size = 1_MiB;
+  Nanoseconds timeslice_duration = 40_ms;
+  Nanoseconds run_time = 0;
+};
+
+class LoadGenerator {
+public:
+  explicit LoadGenerator(Options options) : m_options(std::move(options)) {}
+  LoadGenerator(const LoadGenerator&) = delete;
+  void operator=(const LoadGenerator&) = delete;
+  ~LoadGenerator();
+
+  bool run();
+
+private:
+  struct Sender {
+    ucp_ep_h ep = nullptr;
+    std::vector<std::byte> info_bytes;
+  };
+
+  // Each builder needs its own worker, as the manager does not send
+  // assignments with a reply endpoint
+  struct Builder {
+    LoadGenerator* generator = nullptr;
+    std::size_t index = 0;
+    ucp_worker_h worker = nullptr;
+    ucp_ep_h ep = nullptr;
+    std::vector<std::byte> info_bytes;
+  };
+
+  // A serialized descriptor shared by the announcements of all senders
+  struct SharedBuffer {
+    std::vector<std::byte> bytes;
+    std::size_t references = 0;
+  };
+
+  struct Counters {
+    uint64_t announcements = 0;
+    uint64_t releases = 0;
+    uint64_t release_messages = 0;
+    uint64_t assignments = 0;
+    uint64_t incomplete = 0;
+    LatencyHistogram latency;
+  };
+
+  bool connect();
+  void disconnect();
+  void announce(TsId id);
+  void send_status(Builder& builder, uint64_t event, TsId id);
+  void report(std::chrono::steady_clock::time_point now);
+
+  ucs_status_t handle_release(const void* header,
+                              size_t header_length,
+                              void* data,
+                              size_t length);
+  ucs_status_t handle_assignment(Builder& builder,
+                                 const void* header,
+                                 size_t header_length,
+                                 void* data,
+                                 size_t length);
+
+  static ucs_status_t on_release(void* arg,
+                                 const void* header,
+                                 size_t header_length,
+                                 void* data,
+                                 size_t length,
+                                 [[maybe_unused]] const ucp_am_recv_param_t*
+                                     param) {
+    return static_cast<LoadGenerator*>(arg)->handle_release(
+        header, header_length, data, length);
+  }
+  static ucs_status_t on_assignment(void* arg,
+                                    const void* header,
+                                    size_t header_length,
+                                    void* data,
+                                    size_t length,
+                                    [[maybe_unused]] const ucp_am_recv_param_t*
+                                        param) {
+    auto* builder = static_cast<Builder*>(arg);
+    return builder->generator->handle_assignment(*builder, header,
+                                                 header_length, data, length);
+  }
+  static void on_endpoint_error(void* arg,
+                                [[maybe_unused]] ucp_ep_h ep,
+                                ucs_status_t status) {
+    auto* generator = static_cast<LoadGenerator*>(arg);
+    if (!generator->m_connection_lost) {
+      ERROR("Lost connection to manager: {}", status);
+      generator->m_connection_lost = true;
+    }
+  }
+  static void on_announce_complete(void* request,
+                                   ucs_status_t status,
+                                   void* user_data) {
+    auto* buffer = static_cast<SharedBuffer*>(user_data);
+    if (--buffer->references == 0) {
+      delete buffer;
+    }
+    ucx::util::on_generic_send_complete(request, status, user_data);
+  }
+
+  Options m_options;
+  ucp_context_h m_context = nullptr;
+  ucp_worker_h m_sender_worker = nullptr;
+  std::vector<Sender> m_senders;
+  std::vector<std::unique_ptr<Builder>> m_builders;
+  bool m_connection_lost = false;
+
+  /// Time of announcement (in ns) of the timeslices not assigned yet
+  FlatHashMap<uint64_t, uint64_t> m_announce_time_ns;
+
+  Counters m_interval;
+  Counters m_total;
+  std::chrono::steady_clock::time_point m_report_time_last;
+};
+
+LoadGenerator::~LoadGenerator() { disconnect(); }
+
+bool LoadGenerator::connect() {
+  constexpr auto loop_mode = ucx::util::LoopMode::busy_poll;
+  if (!ucx::util::create_context(m_context, loop_mode) ||
+      !ucx::util::create_worker(m_context, m_sender_worker, -1, loop_mode) ||
+      !ucx::util::set_receive_handler(m_sender_worker, AM_MANAGER_RELEASE_ST,
+                                      on_release, this) ||
+      !ucx::util::set_receive_handler(m_sender_worker,
+                                      AM_MANAGER_RELEASE_ST_BATCH, on_release,
+                                      this)) {
+    ERROR("Failed to initialize UCX");
+    return false;
+  }
+
+  auto [address, port] = ucx::util::parse_address(m_options.manager_address,
+                                                  DEFAULT_MANAGER_PORT);
+  const auto hostname = fles::system::current_hostname();
+  const auto pid = fles::system::current_pid();
+
+  m_senders.resize(m_options.num_senders);
+  for (std::size_t i = 0; i < m_senders.size(); ++i) {
+    auto& sender = m_senders[i];
+    auto ep = ucx::util::connect(m_sender_worker, address, port,
+                                 on_endpoint_error, this);
+    if (!ep) {
+      ERROR("Failed to connect to manager at '{}:{}': {}", address, port,
+            ep.error());
+      return false;
+    }
+    sender.ep = *ep;
+    // Distinct sender IDs, as used by the manager in the collections
+    SenderInfo info{hostname + "/loadgen" + std::to_string(i), pid, hostname,
+                    static_cast<uint16_t>(i)};
+    sender.info_bytes = to_bytes(info);
+    if (!ucx::util::send_active_message(
+            sender.ep, AM_SENDER_REGISTER, sender.info_bytes, {},
+            ucx::util::on_generic_send_complete, this,
+            UCP_AM_SEND_FLAG_REPLY)) {
+      return false;
+    }
+  }
+
+  for (std::size_t i = 0; i < m_options.num_builders; ++i) {
+    auto builder = std::make_unique<Builder>();
+    builder->generator = this;
+    builder->index = i;
+    if (!ucx::util::create_worker(m_context, builder->worker, -1,
+                                  loop_mode) ||
+        !ucx::util::set_receive_handler(builder->worker, AM_MANAGER_ASSIGN_TS,
+                                        on_assignment, builder.get())) {
+      ERROR("Failed to initialize UCX worker for builder {}", i);
+      return false;
+    }
+    auto ep = ucx::util::connect(builder->worker, address, port,
+                                 on_endpoint_error, this);
+    if (!ep) {
+      ERROR("Failed to connect to manager at '{}:{}': {}", address, port,
+            ep.error());
+      return false;
+    }
+    builder->ep = *ep;
+    BuilderInfo info{hostname + "/loadgen" + std::to_string(i), pid};
+    builder->info_bytes = to_bytes(info);
+    if (!ucx::util::send_active_message(
+            builder->ep, AM_BUILDER_REGISTER, builder->info_bytes, {},
+            ucx::util::on_generic_send_complete, this,
+            UCP_AM_SEND_FLAG_REPLY)) {
+      return false;
+    }
+    send_status(*builder, BUILDER_EVENT_NO_OP, 0);
+    m_builders.push_back(std::move(builder));
+  }
+
+  INFO("Connected {} senders and {} builders to manager at '{}:{}'",
+       m_senders.size(), m_builders.size(), address, port);
+  return true;
+}
+
+void LoadGenerator::disconnect() {
+  for (auto& builder : m_builders) {
+    if (builder->ep != nullptr) {
+      ucx::util::close_endpoint(builder->worker, builder->ep, true);
+      builder->ep = nullptr;
+    }
+    ucx::util::destroy_worker(builder->worker);
+  }
+  m_builders.clear();
+  for (auto& sender : m_senders) {
+    if (sender.ep != nullptr) {
+      ucx::util::close_endpoint(m_sender_worker, sender.ep, true);
+      sender.ep = nullptr;
+    }
+  }
+  m_senders.clear();
+  ucx::util::cleanup(m_context, m_sender_worker);
+}
+
+bool LoadGenerator::run() {
+  if (!connect()) {
+    return false;
+  }
+
+  const auto duration_ns =
+      static_cast<uint64_t>(m_options.timeslice_duration.count());
+  const uint64_t start_ns = fles::system::current_time_ns();
+  const uint64_t end_ns =
+      m_options.run_time.count() > 0
+          ? start_ns + static_cast<uint64_t>(m_options.run_time.count())
+          : UINT64_MAX;
+  // Like the senders, announce a subtimeslice once it has ended
+  uint64_t next_id = start_ns / duration_ns + 1;
+  m_report_time_last = std::chrono::steady_clock::now();
+  auto report_time = m_report_time_last + std::chrono::seconds(1);
+
+  while (signal_status == 0 && !m_connection_lost) {
+    while (ucp_worker_progress(m_sender_worker) != 0) {
+    }
+    for (auto& builder : m_builders) {
+      while (ucp_worker_progress(builder->worker) != 0) {
+      }
+    }
+
+    const uint64_t now_ns = fles::system::current_time_ns();
+    if (now_ns >= end_ns) {
+      break;
+    }
+    while ((next_id + 1) * duration_ns <= now_ns) {
+      announce(next_id++);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= report_time) {
+      report(now);
+      report_time += std::chrono::seconds(1);
+    }
+  }
+
+  STATUS("Total: {} announcements, {} releases ({} messages), {} ts "
+         "assigned ({} incomplete), latency p50 {} us, p99 {} us, max {} us",
+         m_total.announcements, m_total.releases, m_total.release_messages,
+         m_total.assignments, m_total.incomplete,
+         m_total.latency.quantile_ns(0.5) / 1000,
+         m_total.latency.quantile_ns(0.99) / 1000,
+         m_total.latency.max_ns() / 1000);
+  disconnect();
+  return !m_connection_lost;
+}
+
+void LoadGenerator::announce(TsId id) {
+  const auto duration_ns =
+      static_cast<uint64_t>(m_options.timeslice_duration.count());
+  const uint64_t component_size =
+      m_options.contribution_size.value() / m_options.num_components;
+
+  StDescriptor descriptor;
+  descriptor.start_time_ns = id * duration_ns;
+  descriptor.duration_ns = duration_ns;
+  for (uint32_t c = 0; c < m_options.num_components; ++c) {
+    StComponentDescriptor component;
+    component.ms_data_offset = static_cast<std::ptrdiff_t>(c * component_size);
+    component.ms_data_size = component_size;
+    component.num_microslices = 1;
+    descriptor.components.push_back(component);
+  }
+
+  auto* buffer = new SharedBuffer{serialize_descriptor(descriptor), 1};
+  std::array<uint64_t, 2> hdr{id, descriptor.ms_data_size()};
+  auto header = std::as_bytes(std::span(hdr));
+  for (auto& sender : m_senders) {
+    ++buffer->references;
+    if (!ucx::util::send_active_message(
+            sender.ep, AM_SENDER_ANNOUNCE_ST, header, buffer->bytes,
+            on_announce_complete, buffer,
+            UCP_AM_SEND_FLAG_COPY_HEADER | UCP_AM_SEND_FLAG_REPLY)) {
+      --buffer->references;
+      continue;
+    }
+    m_interval.announcements++;
+  }
+  if (--buffer->references == 0) {
+    delete buffer;
+  }
+  m_announce_time_ns[id] = fles::system::current_time_ns();
+}
+
+void LoadGenerator::send_status(Builder& builder, uint64_t event, TsId id) {
+  // Simulated builders never run out of memory
+  constexpr uint64_t bytes_free = UINT64_C(1) << 40;
+  std::array<uint64_t, 3> hdr{event, id, bytes_free};
+  auto header = std::as_bytes(std::span(hdr));
+  ucx::util::send_active_message(
+      builder.ep, AM_BUILDER_STATUS, header, {},
+      ucx::util::on_generic_send_complete, this,
+      UCP_AM_SEND_FLAG_COPY_HEADER | UCP_AM_SEND_FLAG_REPLY);
+}
+
+ucs_status_t LoadGenerator::handle_release(const void* header,
+                                           size_t header_length,
+                                           [[maybe_unused]] void* data,
+                                           size_t length) {
+  if (header_length != sizeof(uint64_t)) {
+    ERROR("Invalid release received");
+    return UCS_OK;
+  }
+  // A batch has the count in the header and the IDs as data, a single
+  // release the ID in the header and no data
+  const uint64_t count =
+      length == 0 ? 1 : *static_cast<const uint64_t*>(header);
+  m_interval.releases += count;
+  m_interval.release_messages++;
+  return UCS_OK;
+}
+
+ucs_status_t
+LoadGenerator::handle_assignment(Builder& builder,
+                                 [[maybe_unused]] const void* header,
+                                 size_t header_length,
+                                 void* data,
+                                 size_t length) {
+  const uint64_t now_ns = fles::system::current_time_ns();
+  if (header_length != 2 * sizeof(uint64_t) || length == 0) {
+    ERROR("Builder {}: invalid assignment received", builder.index);
+    return UCS_OK;
+  }
+  auto collection =
+      parse_collection(std::span(static_cast<const std::byte*>(data), length));
+  if (!collection) {
+    ERROR("Builder {}: failed to deserialize assignment", builder.index);
+    return UCS_OK;
+  }
+  const TsId id = collection->id;
+
+  m_interval.assignments++;
+  if (collection->sender_ids.size() < m_senders.size()) {
+    m_interval.incomplete++;
+  }
+  auto it = m_announce_time_ns.find(id);
+  if (it != m_announce_time_ns.end()) {
+    const uint64_t latency_ns = now_ns - std::min(now_ns, it->second);
+    m_interval.latency.record(latency_ns);
+    m_total.latency.record(latency_ns);
+    m_announce_time_ns.erase(it);
+  }
+
+  send_status(builder, BUILDER_EVENT_ALLOCATED, id);
+  send_status(builder, BUILDER_EVENT_RECEIVED, id);
+  send_status(builder, BUILDER_EVENT_RELEASED, id);
+  return UCS_OK;
+}
+
+void LoadGenerator::report(std::chrono::steady_clock::time_point now) {
+  const double dt =
+      std::chrono::duration<double>(now - m_report_time_last).count();
+  m_report_time_last = now;
+  auto rate = [dt](uint64_t count) {
+    return static_cast<uint64_t>(static_cast<double>(count) / dt);
+  };
+
+  const auto& i = m_interval;
+  STATUS("{} ts/s ({} incomplete), {} ann/s, {} rel/s ({} msg/s), "
+         "latency p50 {} us, p99 {} us, max {} us",
+         rate(i.assignments), i.incomplete, rate(i.announcements),
+         rate(i.releases), rate(i.release_messages),
+         i.latency.quantile_ns(0.5) / 1000, i.latency.quantile_ns(0.99) / 1000,
+         i.latency.max_ns() / 1000);
+
+  m_total.announcements += i.announcements;
+  m_total.releases += i.releases;
+  m_total.release_messages += i.release_messages;
+  m_total.assignments += i.assignments;
+  m_total.incomplete += i.incomplete;
+  m_interval = Counters();
+
+  // Forget timeslices that have not been assigned for a long time
+  const uint64_t now_ns = fles::system::current_time_ns();
+  constexpr uint64_t forget_after_ns = 10'000'000'000;
+  for (auto it = m_announce_time_ns.begin();
+       it != m_announce_time_ns.end();) {
+    if (now_ns - it->second > forget_after_ns) {
+      it = m_announce_time_ns.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::signal(SIGINT, signal_handler);
+  std::signal(SIGTERM, signal_handler);
+
+  Options options;
+  unsigned log_level = 2;
+
+  auto terminal_width = fles::system::current_terminal_width();
+  po::options_description desc("Allowed options", terminal_width,
+                               terminal_width / 2);
+  auto desc_add = desc.add_options();
+  desc_add("help,h", "produce help message");
+  desc_add("log-level,l",
+           po::value<unsigned>(&log_level)
+               ->default_value(log_level)
+               ->value_name("<n>"),
+           "set the console log level (all:0)");
+  desc_add("manager-address,a",
+           po::value<std::string>(&options.manager_address)
+               ->default_value(options.manager_address),
+           "address of the tsmanager (with optional port)");
+  desc_add("senders,s",
+           po::value<uint32_t>(&options.num_senders)
+               ->default_value(options.num_senders),
+           "number of simulated senders");
+  desc_add("builders,b",
+           po::value<uint32_t>(&options.num_builders)
+               ->default_value(options.num_builders),
+           "number of simulated builders");
+  desc_add("components,c",
+           po::value<uint32_t>(&options.num_components)
+               ->default_value(options.num_components),
+           "number of components per subtimeslice");
+  desc_add("contribution-size",
+           po::value<SizeValue>(&options.contribution_size)
+               ->default_value(options.contribution_size),
+           "announced size of a subtimeslice (with suffix, e.g., KiB, MiB)");
+  desc_add("timeslice-duration",
+           po::value<Nanoseconds>(&options.timeslice_duration)
+               ->default_value(options.timeslice_duration),
+           "duration of a timeslice, must match the tsmanager setting (with "
+           "suffix ns, us, ms, s)");
+  desc_add("run-time,t",
+           po::value<Nanoseconds>(&options.run_time)
+               ->default_value(options.run_time),
+           "stop after the given time, 0: run until interrupted (with suffix "
+           "ns, us, ms, s)");
+
+  try {
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if (vm.count("help") != 0u) {
+      std::cout << desc << "\n";
+      return EXIT_SUCCESS;
+    }
+    logging::add_console(static_cast<severity_level>(log_level));
+    if (options.timeslice_duration.count() <= 0) {
+      throw std::runtime_error("timeslice duration must be greater than 0");
+    }
+    if (options.num_senders == 0 || options.num_builders == 0 ||
+        options.num_components == 0) {
+      throw std::runtime_error(
+          "at least one sender, builder, and component required");
+    }
+
+    LoadGenerator generator(options);
+    if (!generator.run()) {
+      return EXIT_FAILURE;
+    }
+  } catch (std::exception const& e) {
+    FATAL("{}", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * \brief Policy for batching messages to a single destination.
+ *
+ * Items added in a burst (e.g., while processing a queue) are always sent
+ * together. Beyond that, a batch is held back for at most `max_delay`, but
+ * only as long as another item is expected before this deadline, based on a
+ * moving average of the time between items. At low rates, items are thus
+ * sent without delay, and at high rates batches grow up to `max_size` items.
+ *
+ * The caller adds items, sends the batch immediately if it is full(), and
+ * checks due() when idle and at the deadline().
+ */
+class AdaptiveBatching {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit AdaptiveBatching(clock::duration max_delay = {},
+                            std::size_t max_size = 64)
+      : max_delay_(max_delay), max_size_(std::max<std::size_t>(max_size, 1)) {}
+
+  /// Account for an item added to the batch.
+  void add(clock::time_point now) {
+    if (last_add_ != clock::time_point()) {
+      // Exponentially weighted moving average of the time between items
+      const auto interval = now - last_add_;
+      interval_ = (interval_ == clock::duration::max())
+                      ? interval
+                      : interval_ + (interval - interval_) / 8;
+    }
+    last_add_ = now;
+    if (pending_++ == 0) {
+      first_add_ = now;
+    }
+  }
+
+  /// Mark the batch as sent.
+  void sent() { pending_ = 0; }
+
+  /// Whether the batch has reached its maximum size.
+  [[nodiscard]] bool full() const { return pending_ >= max_size_; }
+
+  /// Whether the batch should be sent at the given time (unless more items
+  /// are added immediately).
+  [[nodiscard]] bool due(clock::time_point now) const {
+    if (pending_ == 0) {
+      return false;
+    }
+    if (full() || now >= deadline()) {
+      return true;
+    }
+    // Waiting only makes sense if the next item is expected in time
+    return interval_ == clock::duration::max() ||
+           last_add_ + interval_ >= deadline();
+  }
+
+  /// Latest time to send the current batch (time_point::max() if empty).
+  [[nodiscard]] clock::time_point deadline() const {
+    return pending_ == 0 ? clock::time_point::max() : first_add_ + max_delay_;
+  }
+
+  [[nodiscard]] std::size_t pending() const { return pending_; }
+  [[nodiscard]] std::size_t max_size() const { return max_size_; }
+  [[nodiscard]] clock::duration max_delay() const { return max_delay_; }
+
+  /// Estimated time between items (duration::max() if unknown).
+  [[nodiscard]] clock::duration interval() const { return interval_; }
+
+private:
+  clock::duration max_delay_;
+  std::size_t max_size_;
+  std::size_t pending_ = 0;
+  clock::time_point first_add_;
+  clock::time_point last_add_;
+  clock::duration interval_ = clock::duration::max();
+};
@@ -1,12 +1,18 @@
-// Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2015, 2025 Jan de Cuveland <cmail@cuveland.de>
 
 #include "Benchmark.hpp"
+#include "Crc32c.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "MicrosliceView.hpp"
+#include "PatternChecker.hpp"
+#include "RampCheck.hpp"
 #include "interface.h" // crcutil_interface
 #include <algorithm>   // std::generate_n
 #include <boost/crc.hpp>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <random>
@@ -17,6 +23,67 @@
 #include <arm_acle.h>
 #endif
 
+namespace {
+
+// Fill a microslice with the content of the FLES software pattern generator
+void fill_flesnet_pattern(fles::MicrosliceDescriptor& desc,
+                          std::vector<uint8_t>& content) {
+  desc.sys_ver =
+      static_cast<uint8_t>(fles::SubsystemFormatFLES::BasicRampPattern);
+  uint64_t xor_all = 0;
+  for (size_t i = 0; i < content.size() / sizeof(uint64_t); ++i) {
+    const uint64_t word = (UINT64_C(1) << 48) | (i * sizeof(uint64_t));
+    std::memcpy(&content[i * sizeof(uint64_t)], &word, sizeof(word));
+    xor_all ^= word;
+  }
+  desc.crc = static_cast<uint32_t>(xor_all) ^
+             static_cast<uint32_t>(xor_all >> 32);
+}
+
+// Fill a microslice with the content of a FLIB/FLIM hardware pattern
+// generator (header word, 64-bit ramp, last word)
+void fill_hardware_pattern(fles::MicrosliceDescriptor& desc,
+                           std::vector<uint8_t>& content,
+                           bool flim) {
+  desc.sys_ver = static_cast<uint8_t>(
+      flim ? fles::SubsystemFormatFLES::FlimPattern
+           : fles::SubsystemFormatFLES::FlibPattern);
+  const size_t header_words = flim ? 2 : 1;
+  const size_t last_word_size = flim ? 16 : 4;
+  const size_t words = (content.size() - last_word_size) / sizeof(uint64_t);
+  for (size_t i = header_words; i < words; ++i) {
+    const uint64_t word = 0xABCD000000000000 + i - header_words;
+    std::memcpy(&content[i * sizeof(uint64_t)], &word, sizeof(word));
+  }
+  for (size_t i = 0; i < last_word_size; ++i) {
+    content[words * sizeof(uint64_t) + i] =
+        static_cast<uint8_t>(flim ? 0xA0 + i : 0xFA);
+  }
+  const uint32_t header = (0xBBFF << 16) | last_word_size;
+  const uint32_t packet_number = 1;
+  std::memcpy(&content[0], &header, sizeof(header));
+  std::memcpy(&content[4], &packet_number, sizeof(packet_number));
+  if (flim) {
+    std::memcpy(&content[8], &desc.idx, sizeof(desc.idx));
+  }
+}
+
+// The CRC-32C engine benchmarked by the given algorithm
+Crc32cEngine engine_of(Benchmark::Algorithm algorithm) {
+  switch (algorithm) {
+  case Benchmark::Algorithm::Crc32c_Crc32:
+    return Crc32cEngine::crc32;
+  case Benchmark::Algorithm::Crc32c_Pclmul:
+    return Crc32cEngine::pclmul;
+  case Benchmark::Algorithm::Crc32c_Vpclmul:
+    return Crc32cEngine::vpclmul;
+  default:
+    return Crc32cEngine::software;
+  }
+}
+
+} // namespace
+
 Benchmark::Benchmark() {
   random_data_.reserve(size_);
 
@@ -131,6 +198,18 @@ uint32_t Benchmark::compute_crc32(Algorithm algorithm) {
     crc_32->Delete();
     break;
   }
+
+  case Algorithm::Crc32c_Software:
+  case Algorithm::Crc32c_Crc32:
+  case Algorithm::Crc32c_Pclmul:
+  case Algorithm::Crc32c_Vpclmul: {
+    // Castagnoli
+    const Crc32cEngine engine = engine_of(algorithm);
+    for (size_t i = 0; i < cycles_; ++i) {
+      crc = crc32c(engine, random_data_.data(), random_data_.size(), crc);
+    }
+    break;
+  }
   }
 
   return crc;
@@ -151,6 +230,16 @@ void Benchmark::run() {
   run_single(Algorithm::CrcUtil_C);
   std::cout << "CRC32 Benchmark: CrcUtil (IEEE)" << std::endl;
   run_single(Algorithm::CrcUtil_I);
+  for (auto algorithm :
+       {Algorithm::Crc32c_Software, Algorithm::Crc32c_Crc32,
+        Algorithm::Crc32c_Pclmul, Algorithm::Crc32c_Vpclmul}) {
+    const Crc32cEngine engine = engine_of(algorithm);
+    if (crc32c_engine_supported(engine)) {
+      std::cout << "CRC32 Benchmark: Crc32c " << to_string(engine)
+                << " (Castagnoli)" << std::endl;
+      run_single(algorithm);
+    }
+  }
 }
 
 void Benchmark::run_single(Algorithm algorithm) {
@@ -165,3 +254,65 @@ void Benchmark::run_single(Algorithm algorithm) {
   std::cout << "crc32=" << std::hex << crc32 << "  " << rate << " MiB/s"
             << std::endl;
 }
+
+void Benchmark::run_pattern_check() {
+  struct Pattern {
+    const char* name;
+    size_t size;
+    void (*fill)(fles::MicrosliceDescriptor&, std::vector<uint8_t>&);
+  };
+  // sizes consistent with the last word size of the respective generator
+  const Pattern patterns[] = {
+      {"Flesnet", size_, fill_flesnet_pattern},
+      {"Flib", size_ + 4,
+       [](fles::MicrosliceDescriptor& d, std::vector<uint8_t>& c) {
+         fill_hardware_pattern(d, c, false);
+       }},
+      {"Flim", size_ + 16,
+       [](fles::MicrosliceDescriptor& d, std::vector<uint8_t>& c) {
+         fill_hardware_pattern(d, c, true);
+       }}};
+
+  const SimdLevel previous_level = simd_level();
+  for (const auto& pattern : patterns) {
+    std::vector<uint8_t> content(pattern.size);
+    fles::MicrosliceDescriptor desc{};
+    desc.sys_id = static_cast<uint8_t>(fles::Subsystem::FLES);
+    desc.idx = 1000;
+    desc.size = static_cast<uint32_t>(content.size());
+    pattern.fill(desc, content);
+    fles::MicrosliceView ms(desc, content.data());
+    const uint32_t reference_crc = crc32c(content.data(), content.size());
+
+    for (auto level :
+         {SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512}) {
+      if (!simd_level_supported(level)) {
+        continue;
+      }
+      set_simd_level(level);
+      auto checker = PatternChecker::create(desc.sys_id, desc.sys_ver);
+
+      bool ok = true;
+      uint32_t crc = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < cycles_; ++i) {
+        checker->reset();
+        ok &= checker->check_with_crc(ms, crc);
+      }
+      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start);
+      ok &= crc == reference_crc;
+
+      const double rate = static_cast<double>(content.size() * cycles_) /
+                          static_cast<double>(duration.count());
+      std::cout << "Pattern check benchmark: " << pattern.name << " ("
+                << to_string(level) << ", CRC-32C "
+                << to_string(crc32c_engine()) << ")" << std::endl;
+      std::cout << "crc32c=" << std::hex << crc << std::dec
+                << (ok ? "" : " (check failed)") << "  " << rate << " GB/s"
+                << std::endl;
+    }
+  }
+  set_simd_level(previous_level);
+}
+
@@ -1,4 +1,4 @@
-// Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2015, 2025 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
 #include <cstddef>
@@ -11,6 +11,26 @@ public:
   Benchmark();
   void run();
 
+  /// Measure the throughput of the pattern checkers (including the CRC-32C)
+  /// for each supported instruction set.
+  void run_pattern_check();
+
+  /// Measure the microslice start time search in the shadow time index
+  /// against the search in the descriptor ring buffer.
+  void run_time_index();
+
+  /// Measure the encoding and decoding of timeslice shm work items in the
+  /// binary and the Boost serialization format.
+  void run_work_item_encoding();
+
+  /// Replay timeslice size and release-order traces on the ring allocator
+  /// and on the best-fit allocator of a Boost managed memory segment.
+  void run_ring_allocator();
+
+  /// Measure the bookkeeping of in-flight receive requests with
+  /// std::unordered_map and FlatHashMap.
+  void run_hash_map();
+
   enum class Algorithm {
     Boost_C,
     Boost_I,
@@ -21,7 +41,11 @@ public:
     Intrinsic64,
 #endif
     CrcUtil_C,
-    CrcUtil_I
+    CrcUtil_I,
+    Crc32c_Software,
+    Crc32c_Crc32,
+    Crc32c_Pclmul,
+    Crc32c_Vpclmul
   };
   uint32_t compute_crc32(Algorithm algorithm);
   void run_single(Algorithm algorithm);
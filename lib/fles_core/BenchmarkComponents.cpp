@@ -0,0 +1,402 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+//
+// Benchmarks of timeslice building and distribution components, selected by
+// name with tsclient --benchmark
+
+#include "Benchmark.hpp"
+#include "FlatHashMap.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "MicrosliceTimeIndex.hpp"
+#include "RingAllocator.hpp"
+#include "RingBufferView.hpp"
+#include "TimesliceShmWorkItemEncoding.hpp"
+#include <algorithm>
+#include <boost/interprocess/managed_heap_memory.hpp>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// A timeslice buffer trace: timeslice sizes and the jitter of the processing
+// time (in timeslices). Without jitter, timeslices are released in order.
+struct AllocatorTrace {
+  std::string name;
+  std::vector<size_t> sizes;
+  size_t jitter;
+};
+
+struct ReplayResult {
+  double ns_per_timeslice;
+  uint64_t failure_count;
+  uint64_t fragmentation_failure_count;
+};
+
+// Replay a trace. Each timeslice is released a fixed number of timeslices
+// (such that the buffer is about 75% full) plus jitter after its allocation.
+// When an allocation fails, the next timeslices due are released until it
+// succeeds, as the builder waits for the consumers.
+template <typename Allocate, typename Release>
+ReplayResult replay(const AllocatorTrace& trace,
+                    size_t capacity,
+                    size_t lifetime,
+                    Allocate allocate,
+                    Release release) {
+  // allocate returns an optional region
+  using Region = typename decltype(allocate(size_t{}))::value_type;
+  struct Live {
+    Region region;
+    size_t due;
+  };
+  std::vector<Live> live;
+  size_t live_bytes = 0;
+  std::minstd_rand engine(1);
+  std::uniform_int_distribution<size_t> jitter(0, trace.jitter);
+  ReplayResult result{};
+
+  auto release_next = [&] {
+    auto next = std::min_element(
+        live.begin(), live.end(),
+        [](const Live& a, const Live& b) { return a.due < b.due; });
+    live_bytes -= release(next->region);
+    live.erase(next);
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < trace.sizes.size(); ++t) {
+    while (!live.empty() &&
+           std::any_of(live.begin(), live.end(),
+                       [t](const Live& l) { return l.due <= t; })) {
+      release_next();
+    }
+    const size_t size = trace.sizes[t];
+    decltype(allocate(size)) region;
+    while (!(region = allocate(size))) {
+      ++result.failure_count;
+      if (live_bytes + size <= capacity) {
+        ++result.fragmentation_failure_count;
+      }
+      release_next();
+    }
+    live.push_back({*region, t + lifetime + jitter(engine)});
+    live_bytes += size;
+  }
+  while (!live.empty()) {
+    release_next();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  result.ns_per_timeslice =
+      std::chrono::duration<double, std::nano>(elapsed).count() /
+      static_cast<double>(trace.sizes.size());
+  return result;
+}
+
+// Bookkeeping of in-flight receive requests as in the timeslice builder: a
+// window of timeslices, each with a number of contributions that consist of
+// several transfer blocks. The oldest timeslice is retired (its requests
+// complete in random order) before a new one is assigned. Some
+// contributions fail, and their outstanding requests are cancelled.
+struct RequestInfo {
+  uint64_t id = 0;
+  size_t ci = 0;
+};
+
+struct TimesliceRequests {
+  std::vector<std::vector<void*>> per_contribution;
+};
+
+struct BookkeepingResult {
+  double ns_per_request;
+  size_t checksum;
+};
+
+template <typename RequestMap, typename HandleMap, bool ContributionLists>
+BookkeepingResult run_bookkeeping(size_t window,
+                                  size_t contributions,
+                                  size_t blocks,
+                                  size_t timeslices) {
+  const size_t requests_per_ts = contributions * blocks;
+  // Request objects are reused in LIFO order, like from a memory pool
+  std::vector<char> request_memory((window + 1) * requests_per_ts * 64);
+  std::vector<void*> free_requests;
+  for (size_t i = 0; i < request_memory.size(); i += 64) {
+    free_requests.push_back(&request_memory[i]);
+  }
+
+  RequestMap requests;
+  HandleMap handles;
+  std::deque<uint64_t> in_flight;
+  std::mt19937_64 rng(1);
+  std::vector<void*> completion_order;
+  size_t checksum = 0;
+
+  auto cancel = [&](uint64_t id, size_t ci) {
+    std::vector<void*> to_cancel;
+    if constexpr (ContributionLists) {
+      to_cancel = std::move(handles.at(id)->per_contribution[ci]);
+    } else {
+      for (const auto& [request, info] : requests) {
+        if (info.id == id && info.ci == ci) {
+          to_cancel.push_back(request);
+        }
+      }
+    }
+    for (void* request : to_cancel) {
+      auto it = requests.find(request);
+      if (it != requests.end() && it->second.id == id &&
+          it->second.ci == ci) {
+        requests.erase(it);
+        free_requests.push_back(request);
+      }
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t id = 0; id < window + timeslices; ++id) {
+    if (in_flight.size() == window) {
+      const uint64_t old = in_flight.front();
+      in_flight.pop_front();
+      auto& tsh = *handles.at(old);
+      if (old % 8 == 0) {
+        cancel(old, old % contributions);
+      }
+      completion_order.clear();
+      for (const auto& list : tsh.per_contribution) {
+        completion_order.insert(completion_order.end(), list.begin(),
+                                list.end());
+      }
+      std::shuffle(completion_order.begin(), completion_order.end(), rng);
+      for (void* request : completion_order) {
+        auto it = requests.find(request);
+        if (it != requests.end()) {
+          checksum += it->second.ci;
+          requests.erase(it);
+          free_requests.push_back(request);
+        }
+      }
+      handles.erase(old);
+    }
+
+    auto tsh = std::make_unique<TimesliceRequests>();
+    tsh->per_contribution.resize(contributions);
+    for (size_t ci = 0; ci < contributions; ++ci) {
+      for (size_t b = 0; b < blocks; ++b) {
+        void* request = free_requests.back();
+        free_requests.pop_back();
+        requests[request] = {id, ci};
+        tsh->per_contribution[ci].push_back(request);
+      }
+    }
+    handles.emplace(id, std::move(tsh));
+    in_flight.push_back(id);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return {std::chrono::duration<double, std::nano>(elapsed).count() /
+              static_cast<double>(timeslices * requests_per_ts),
+          checksum};
+}
+
+} // namespace
+
+void Benchmark::run_time_index() {
+  constexpr size_t size = 1 << 18;
+  constexpr size_t lookups = 200000;
+  constexpr uint64_t start_time = 1000000000;
+  constexpr uint64_t ms_duration = 102400; // ns
+
+  // Descriptor ring buffer with jittered equidistant start times, wrapped
+  // around several times
+  std::vector<fles::MicrosliceDescriptor> descs(size);
+  RingBufferView<fles::MicrosliceDescriptor, false> ring(descs.data(), size);
+  const uint64_t write_index = 3 * size + size / 2;
+  const uint64_t read_index = write_index - size;
+  std::mt19937_64 engine(3);
+  std::uniform_int_distribution<uint64_t> jitter(0, ms_duration / 4);
+  for (uint64_t n = 0; n < write_index; ++n) {
+    ring.at(n).idx = start_time + n * ms_duration + jitter(engine);
+  }
+  MicrosliceTimeIndex index(size);
+  index.update(ring, write_index);
+
+  std::uniform_int_distribution<uint64_t> time(
+      start_time + read_index * ms_duration,
+      start_time + write_index * ms_duration);
+  std::vector<uint64_t> times(lookups);
+  std::generate(times.begin(), times.end(), [&] { return time(engine); });
+
+  auto measure = [&](const char* name, auto&& search) {
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t t : times) {
+      checksum += search(t);
+    }
+    auto duration = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Time index benchmark: " << name << " (" << size
+              << " descriptors)" << std::endl;
+    std::cout << "checksum=" << std::hex << checksum << std::dec << "  "
+              << duration.count() / lookups << " ns/lookup" << std::endl;
+  };
+
+  measure("descriptor search", [&](uint64_t t) {
+    return std::upper_bound(
+               ring.get_iter(read_index), ring.get_iter(write_index), t,
+               [](uint64_t t, const fles::MicrosliceDescriptor& desc) {
+                 return t < desc.idx;
+               })
+        .get_index();
+  });
+  measure("time index", [&](uint64_t t) {
+    return index.upper_bound(read_index, write_index, t);
+  });
+}
+
+void Benchmark::run_work_item_encoding() {
+  constexpr size_t cycles = 20000;
+  constexpr uint32_t num_components = 16;
+
+  fles::TimesliceShmWorkItem item{};
+  item.shm_identifier = "flesnet_ts_builder";
+  item.ts_desc.index = 42;
+  item.ts_desc.num_components = num_components;
+  for (uint32_t c = 0; c < num_components; ++c) {
+    item.data.push_back(4096 * (c + 1));
+    item.tsc_desc.push_back({42, 0, 1000 + c, 10 + c, c});
+  }
+  const std::string boost_payload = fles::encode_work_item_boost(item);
+  const std::string binary_payload = fles::encode_work_item_binary(item);
+
+  auto measure = [&](const char* name, size_t bytes, auto&& function) {
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < cycles; ++i) {
+      checksum += function();
+    }
+    auto duration = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Work item benchmark: " << name << " (" << num_components
+              << " components, " << bytes << " bytes)" << std::endl;
+    std::cout << "checksum=" << std::hex << checksum << std::dec << "  "
+              << duration.count() / cycles << " ns/item" << std::endl;
+  };
+
+  measure("encode boost", boost_payload.size(),
+          [&] { return fles::encode_work_item_boost(item).size(); });
+  measure("encode binary", binary_payload.size(),
+          [&] { return fles::encode_work_item_binary(item).size(); });
+  measure("decode boost", boost_payload.size(), [&] {
+    return fles::decode_work_item(boost_payload).data.size();
+  });
+  measure("decode binary", binary_payload.size(), [&] {
+    auto ref = fles::TimesliceShmWorkItemRef::parse(binary_payload);
+    return ref->tsc_desc(ref->num_components() - 1)->size;
+  });
+}
+
+void Benchmark::run_ring_allocator() {
+  constexpr size_t count = 100000;
+  constexpr size_t mean_size = 1 << 20;
+  constexpr size_t capacity = 24 * mean_size;
+  constexpr size_t lifetime = 24 * 3 / 4;
+  std::minstd_rand engine(42);
+
+  // Similar timeslices (+-10%)
+  std::vector<size_t> uniform(count);
+  std::uniform_int_distribution<size_t> uniform_size(mean_size * 9 / 10,
+                                                     mean_size * 11 / 10);
+  for (auto& size : uniform) {
+    size = uniform_size(engine);
+  }
+  // Mixed timeslice sizes, e.g., from varying detector activity
+  std::vector<size_t> mixed(count);
+  std::lognormal_distribution<double> mixed_size(-0.125, 0.5);
+  for (auto& size : mixed) {
+    size = static_cast<size_t>(std::min(4.0, mixed_size(engine)) *
+                               static_cast<double>(mean_size));
+  }
+
+  // Jitter from several parallel consumers
+  const std::vector<AllocatorTrace> traces{{"uniform, in order", uniform, 0},
+                                           {"uniform, jitter 4", uniform, 4},
+                                           {"mixed, in order", mixed, 0},
+                                           {"mixed, jitter 4", mixed, 4}};
+
+  auto print = [](const AllocatorTrace& trace, const char* allocator,
+                  const ReplayResult& r) {
+    std::cout << "Allocator benchmark: " << allocator << " (" << trace.name
+              << ")" << std::endl;
+    std::cout << r.failure_count << " failures ("
+              << r.fragmentation_failure_count << " due to fragmentation)  "
+              << r.ns_per_timeslice << " ns/timeslice" << std::endl;
+  };
+
+  for (const auto& trace : traces) {
+    RingAllocator ring(capacity);
+    print(trace, "ring",
+          replay(
+              trace, capacity, lifetime,
+              [&](size_t size) { return ring.allocate(size); },
+              [&](const RingAllocator::Allocation& a) {
+                ring.release(a);
+                return a.size;
+              }));
+
+    // Add space for the segment management data
+    boost::interprocess::managed_heap_memory heap(capacity + 4096);
+    print(trace, "best-fit",
+          replay(
+              trace, capacity, lifetime,
+              [&](size_t size) -> std::optional<std::pair<void*, size_t>> {
+                if (void* p = heap.allocate(size, std::nothrow)) {
+                  return std::make_pair(p, size);
+                }
+                return std::nullopt;
+              },
+              [&](const std::pair<void*, size_t>& a) {
+                heap.deallocate(a.first);
+                return a.second;
+              }));
+  }
+}
+
+void Benchmark::run_hash_map() {
+  struct Config {
+    size_t window;
+    size_t contributions;
+    size_t blocks;
+  };
+  constexpr size_t timeslices = 4000;
+  using Handles = std::unique_ptr<TimesliceRequests>;
+  using StdRequests = std::unordered_map<void*, RequestInfo>;
+  using StdHandles = std::unordered_map<uint64_t, Handles>;
+  using FlatRequests = FlatHashMap<void*, RequestInfo>;
+  using FlatHandles = FlatHashMap<uint64_t, Handles>;
+
+  for (auto [window, contributions, blocks] :
+       {Config{16, 16, 4}, Config{64, 32, 4}, Config{128, 64, 2}}) {
+    auto print = [&](const char* name, const BookkeepingResult& r) {
+      std::cout << "Request bookkeeping benchmark: " << name << " ("
+                << window << " ts x " << contributions << " contributions x "
+                << blocks << " blocks)" << std::endl;
+      std::cout << "checksum=" << std::hex << r.checksum << std::dec << "  "
+                << r.ns_per_request << " ns/request" << std::endl;
+    };
+    print("unordered_map, scan cancel",
+          run_bookkeeping<StdRequests, StdHandles, false>(
+              window, contributions, blocks, timeslices));
+    print("unordered_map, list cancel",
+          run_bookkeeping<StdRequests, StdHandles, true>(
+              window, contributions, blocks, timeslices));
+    print("FlatHashMap, list cancel",
+          run_bookkeeping<FlatRequests, FlatHandles, true>(
+              window, contributions, blocks, timeslices));
+  }
+}
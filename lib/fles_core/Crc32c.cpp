@@ -0,0 +1,327 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "Crc32c.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__SSE4_2__)
+#include <immintrin.h>
+#define CRC32C_HARDWARE 1
+#define CRC32C_X86 1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32C_HARDWARE 1
+#endif
+
+// All engines operate on the CRC register, i.e., the inverted CRC value.
+
+namespace {
+
+// Reflected Castagnoli polynomial
+constexpr uint32_t polynomial = 0x82f63b78;
+
+// Lookup table for the bytewise software implementation
+constexpr std::array<uint32_t, 256> crc32c_table = [] {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) != 0 ? polynomial : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+uint32_t crc32c_software(const uint8_t* p, std::size_t size, uint32_t crc) {
+  for (; size > 0; --size) {
+    crc = (crc >> 8) ^ crc32c_table[(crc ^ *p++) & 0xff];
+  }
+  return crc;
+}
+
+#ifdef CRC32C_HARDWARE
+inline uint64_t load_u64(const uint8_t* p) {
+  uint64_t word = 0;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+inline uint32_t crc32c_u64(uint32_t crc, uint64_t word) {
+#ifdef CRC32C_X86
+  return static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+#else
+  return __crc32cd(crc, word);
+#endif
+}
+
+uint32_t crc32c_hardware(const uint8_t* p, std::size_t size, uint32_t crc) {
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+    crc = crc32c_u64(crc, load_u64(p));
+    p += sizeof(uint64_t);
+  }
+  for (; size > 0; --size) {
+#ifdef CRC32C_X86
+    crc = _mm_crc32_u8(crc, *p++);
+#else
+    crc = __crc32cb(crc, *p++);
+#endif
+  }
+  return crc;
+}
+#endif
+
+#ifdef CRC32C_X86
+// The polynomial x^n mod P in the reflected representation
+constexpr uint32_t x_pow_mod(std::size_t n) {
+  uint32_t r = 0x80000000; // x^0
+  for (; n > 0; --n) {
+    r = (r >> 1) ^ ((r & 1) != 0 ? polynomial : 0);
+  }
+  return r;
+}
+
+// Three-way interleaving: the CRC instruction has a latency of three cycles
+// but a throughput of one per cycle. Three adjacent blocks are processed as
+// independent streams, the CRCs are then combined by shifting them over the
+// following blocks, i.e., multiplying them by x^(8 * block) mod P.
+constexpr std::size_t long_block = 1024;
+constexpr std::size_t short_block = 128;
+
+// Multiplier for a shift by n bytes: the carry-less product of two 32-bit
+// reflected values carries an extra factor of x, the CRC instruction
+// another one of x^32.
+constexpr uint32_t shift_constant(std::size_t n) {
+  return x_pow_mod(8 * n - 33);
+}
+
+__attribute__((target("pclmul"))) uint32_t shift(uint32_t crc,
+                                                 uint32_t constant) {
+  const __m128i product =
+      _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(crc)),
+                           _mm_cvtsi32_si128(static_cast<int>(constant)), 0);
+  return crc32c_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product)));
+}
+
+__attribute__((target("pclmul"))) uint32_t
+crc32c_pclmul(const uint8_t* p, std::size_t size, uint32_t crc) {
+  constexpr uint32_t long_shift = shift_constant(long_block);
+  constexpr uint32_t short_shift = shift_constant(short_block);
+  for (const std::size_t block : {long_block, short_block}) {
+    const uint32_t constant = block == long_block ? long_shift : short_shift;
+    for (; size >= 3 * block; size -= 3 * block) {
+      uint32_t crc1 = 0;
+      uint32_t crc2 = 0;
+      for (std::size_t i = 0; i < block; i += sizeof(uint64_t)) {
+        crc = crc32c_u64(crc, load_u64(p + i));
+        crc1 = crc32c_u64(crc1, load_u64(p + block + i));
+        crc2 = crc32c_u64(crc2, load_u64(p + 2 * block + i));
+      }
+      crc = shift(crc, constant) ^ crc1;
+      crc = shift(crc, constant) ^ crc2;
+      p += 3 * block;
+    }
+  }
+  return crc32c_hardware(p, size, crc);
+}
+
+// Folding: each 128-bit lane X (low quadword first in memory) is replaced by
+// a value congruent to X * x^(8 * n) mod P, which is then added to the lane n
+// bytes ahead. The low quadword is multiplied by x^(8n + 31), the high one by
+// x^(8n - 33) (see shift_constant()).
+struct FoldConstants {
+  uint32_t low;
+  uint32_t high;
+};
+
+constexpr FoldConstants fold_constants(std::size_t n) {
+  return {x_pow_mod(8 * n + 31), x_pow_mod(8 * n - 33)};
+}
+
+// The constants for folding by the same distance in all four lanes
+__attribute__((target("avx512f"))) __m512i broadcast(FoldConstants k) {
+  return _mm512_set_epi64(k.high, k.low, k.high, k.low, k.high, k.low, k.high,
+                          k.low);
+}
+
+__attribute__((target("avx512f"))) __m512i load(const uint8_t* p) {
+  return _mm512_loadu_si512(p);
+}
+
+__attribute__((target("avx512f,vpclmulqdq"))) __m512i fold(__m512i x,
+                                                           __m512i k) {
+  return _mm512_xor_si512(_mm512_clmulepi64_epi128(x, k, 0x00),
+                          _mm512_clmulepi64_epi128(x, k, 0x11));
+}
+
+__attribute__((target("avx512f,vpclmulqdq"))) uint32_t
+crc32c_vpclmul(const uint8_t* p, std::size_t size, uint32_t crc) {
+  constexpr std::size_t stride = 4 * sizeof(__m512i);
+  if (size < stride) {
+    return crc32c_pclmul(p, size, crc);
+  }
+
+  constexpr FoldConstants k_16 = fold_constants(16);
+  constexpr FoldConstants k_32 = fold_constants(32);
+  constexpr FoldConstants k_48 = fold_constants(48);
+  constexpr FoldConstants k_64 = fold_constants(64);
+  constexpr FoldConstants k_stride = fold_constants(stride);
+
+  // the CRC register is equivalent to the first 32 bits of the message
+  const __m512i initial = _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, crc);
+  __m512i x0 = _mm512_xor_si512(load(p), initial);
+  __m512i x1 = load(p + 64);
+  __m512i x2 = load(p + 128);
+  __m512i x3 = load(p + 192);
+  p += stride;
+  size -= stride;
+
+  const __m512i k4 = broadcast(k_stride);
+  for (; size >= stride; size -= stride) {
+    x0 = _mm512_xor_si512(fold(x0, k4), load(p));
+    x1 = _mm512_xor_si512(fold(x1, k4), load(p + 64));
+    x2 = _mm512_xor_si512(fold(x2, k4), load(p + 128));
+    x3 = _mm512_xor_si512(fold(x3, k4), load(p + 192));
+    p += stride;
+  }
+
+  const __m512i k1 = broadcast(k_64);
+  __m512i x = _mm512_xor_si512(fold(x0, k1), x1);
+  x = _mm512_xor_si512(fold(x, k1), x2);
+  x = _mm512_xor_si512(fold(x, k1), x3);
+  for (; size >= 64; size -= 64) {
+    x = _mm512_xor_si512(fold(x, k1), load(p));
+    p += 64;
+  }
+
+  // fold the first three lanes onto the last one
+  const __m512i k_lanes =
+      _mm512_set_epi64(0, 0, k_16.high, k_16.low, k_32.high, k_32.low,
+                       k_48.high, k_48.low);
+  alignas(64) uint64_t folded[8];
+  alignas(64) uint64_t last[8];
+  _mm512_store_si512(folded, fold(x, k_lanes));
+  _mm512_store_si512(last, x);
+  const uint64_t low = folded[0] ^ folded[2] ^ folded[4] ^ last[6];
+  const uint64_t high = folded[1] ^ folded[3] ^ folded[5] ^ last[7];
+
+  // the remaining 128 bits are processed as regular message
+  crc = crc32c_u64(crc32c_u64(0, low), high);
+  return crc32c_hardware(p, size, crc);
+}
+#endif
+
+Crc32cEngine best_engine() {
+  for (auto engine : {Crc32cEngine::vpclmul, Crc32cEngine::pclmul,
+                      Crc32cEngine::crc32}) {
+    if (crc32c_engine_supported(engine)) {
+      return engine;
+    }
+  }
+  return Crc32cEngine::software;
+}
+
+std::atomic<Crc32cEngine> current_engine{best_engine()};
+
+} // namespace
+
+std::string_view to_string(Crc32cEngine engine) {
+  switch (engine) {
+  case Crc32cEngine::software:
+    return "software";
+  case Crc32cEngine::crc32:
+    return "crc32";
+  case Crc32cEngine::pclmul:
+    return "pclmul";
+  case Crc32cEngine::vpclmul:
+    return "vpclmul";
+  }
+  return "unknown";
+}
+
+std::optional<Crc32cEngine> crc32c_engine_from_string(std::string_view name) {
+  for (auto engine : {Crc32cEngine::software, Crc32cEngine::crc32,
+                      Crc32cEngine::pclmul, Crc32cEngine::vpclmul}) {
+    if (name == to_string(engine)) {
+      return engine;
+    }
+  }
+  return std::nullopt;
+}
+
+bool crc32c_engine_supported(Crc32cEngine engine) {
+  switch (engine) {
+  case Crc32cEngine::software:
+    return true;
+#ifdef CRC32C_HARDWARE
+  case Crc32cEngine::crc32:
+    return true;
+#endif
+#ifdef CRC32C_X86
+  case Crc32cEngine::pclmul:
+    // may be called during static initialization
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") != 0;
+  case Crc32cEngine::vpclmul:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") != 0 &&
+           __builtin_cpu_supports("vpclmulqdq") != 0;
+#endif
+  default:
+    return false;
+  }
+}
+
+Crc32cEngine crc32c_engine() {
+  return current_engine.load(std::memory_order_relaxed);
+}
+
+void set_crc32c_engine(Crc32cEngine engine) {
+  if (crc32c_engine_supported(engine)) {
+    current_engine.store(engine, std::memory_order_relaxed);
+  }
+}
+
+uint32_t crc32c(const void* data, std::size_t size, uint32_t crc) {
+  return crc32c(crc32c_engine(), data, size, crc);
+}
+
+uint32_t crc32c(Crc32cEngine engine,
+                const void* data,
+                std::size_t size,
+                uint32_t crc) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+
+  switch (engine) {
+#ifdef CRC32C_X86
+  case Crc32cEngine::vpclmul:
+    crc = crc32c_vpclmul(p, size, crc);
+    break;
+  case Crc32cEngine::pclmul:
+    crc = crc32c_pclmul(p, size, crc);
+    break;
+#endif
+#ifdef CRC32C_HARDWARE
+  case Crc32cEngine::crc32:
+    crc = crc32c_hardware(p, size, crc);
+    break;
+#endif
+  default:
+    crc = crc32c_software(p, size, crc);
+    break;
+  }
+
+  return ~crc;
+}
+
+uint32_t crc32c_ring(const void* ring,
+                     std::size_t ring_size,
+                     std::size_t begin,
+                     std::size_t size) {
+  const auto* p = static_cast<const uint8_t*>(ring);
+  const std::size_t first = std::min(size, ring_size - begin);
+  return crc32c(p, size - first, crc32c(p + begin, first));
+}
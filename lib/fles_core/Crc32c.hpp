@@ -0,0 +1,48 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/// Implementation used to compute the CRC-32C.
+enum class Crc32cEngine {
+  software, ///< portable table-driven implementation
+  crc32,    ///< CRC instruction (SSE4.2 or ARMv8), single stream
+  pclmul,   ///< three interleaved CRC instruction streams, combined using
+            ///< carry-less multiplication (PCLMULQDQ)
+  vpclmul   ///< folding with 512-bit carry-less multiplication (AVX-512
+            ///< VPCLMULQDQ)
+};
+
+std::string_view to_string(Crc32cEngine engine);
+
+/// Parse the name of an engine as returned by to_string().
+std::optional<Crc32cEngine> crc32c_engine_from_string(std::string_view name);
+
+/// Whether the given engine is supported by the CPU.
+[[nodiscard]] bool crc32c_engine_supported(Crc32cEngine engine);
+
+/// The engine used by crc32c(). Initially the fastest one supported, can be
+/// changed (e.g., for benchmarks) with set_crc32c_engine().
+[[nodiscard]] Crc32cEngine crc32c_engine();
+void set_crc32c_engine(Crc32cEngine engine);
+
+/// Compute the CRC-32C (Castagnoli) of a buffer, as used for the microslice
+/// content CRC. The CRC can be computed incrementally by passing the result
+/// for the preceding data: crc32c(b, crc32c(a)) equals the CRC of a and b.
+uint32_t crc32c(const void* data, std::size_t size, uint32_t crc = 0);
+
+/// Compute the CRC-32C using the given (supported) engine.
+uint32_t crc32c(Crc32cEngine engine,
+                const void* data,
+                std::size_t size,
+                uint32_t crc = 0);
+
+/// Compute the CRC-32C of `size` bytes in a ring buffer of `ring_size` bytes,
+/// starting at byte offset `begin` and possibly wrapping around.
+uint32_t crc32c_ring(const void* ring,
+                     std::size_t ring_size,
+                     std::size_t begin,
+                     std::size_t size);
@@ -0,0 +1,276 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Hash function for FlatHashMap. Integer and pointer keys (like timeslice
+/// indices and UCX request pointers) are mixed, as their low bits are often
+/// regular and the table index is taken from the low bits.
+template <typename Key> struct FlatHash {
+  std::size_t operator()(const Key& key) const {
+    uint64_t x = 0;
+    if constexpr (std::is_pointer_v<Key>) {
+      x = reinterpret_cast<std::uintptr_t>(key);
+    } else if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>) {
+      x = static_cast<uint64_t>(key);
+    } else {
+      x = std::hash<Key>{}(key);
+    }
+    // Finalizer of MurmurHash3: every input bit affects the low bits
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+  }
+};
+
+/**
+ * \brief Hash map with open addressing in a single flat array.
+ *
+ * Intended for the small, frequently modified bookkeeping maps on the data
+ * paths (e.g., in-flight requests), where std::unordered_map allocates a
+ * node per element. Collisions are resolved by linear probing. Erased slots
+ * are marked (unless they end a probe sequence) and reused on insertion. The
+ * table is rebuilt when more than half of the slots are in use or marked.
+ *
+ * Differences to std::unordered_map:
+ * - Key and value types must be default constructible, the value of an
+ *   erased element is reset to a default-constructed one.
+ * - Insertion invalidates all iterators and references (store large or
+ *   address-sensitive values through a std::unique_ptr). Erasing does not
+ *   invalidate anything but the erased element, so elements can be erased
+ *   while iterating.
+ */
+template <typename Key, typename T, typename Hash = FlatHash<Key>>
+class FlatHashMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = FlatHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using map_type = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+    using reference =
+        std::conditional_t<Const, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+    Iterator() = default;
+    Iterator(map_type* map, std::size_t index) : map_(map), index_(index) {
+      skip_unused();
+    }
+    // Conversion from iterator to const_iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other)
+        : map_(other.map_), index_(other.index_) {}
+
+    reference operator*() const { return map_->slots_[index_]; }
+    pointer operator->() const { return &map_->slots_[index_]; }
+    Iterator& operator++() {
+      ++index_;
+      skip_unused();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const Iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+  private:
+    friend class FlatHashMap;
+    friend class Iterator<true>;
+
+    void skip_unused() {
+      while (index_ < map_->states_.size() &&
+             map_->states_[index_] != State::full) {
+        ++index_;
+      }
+    }
+
+    map_type* map_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatHashMap() = default;
+  explicit FlatHashMap(std::size_t capacity) { reserve(capacity); }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, states_.size()}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, states_.size()}; }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  iterator find(const Key& key) { return {this, find_index(key)}; }
+  const_iterator find(const Key& key) const {
+    return {this, find_index(key)};
+  }
+  [[nodiscard]] bool contains(const Key& key) const {
+    return find_index(key) != states_.size();
+  }
+
+  T& at(const Key& key) {
+    const std::size_t index = find_index(key);
+    if (index == states_.size()) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return slots_[index].second;
+  }
+  const T& at(const Key& key) const {
+    return const_cast<FlatHashMap*>(this)->at(key);
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+  /// Insert an element constructed from the given arguments if the key is
+  /// not present yet.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    std::size_t index = find_index(key);
+    if (index != states_.size()) {
+      return {{this, index}, false};
+    }
+    if ((size_ + deleted_ + 1) * 2 > states_.size()) {
+      rehash(size_ + 1);
+    }
+    index = insert_index(key);
+    if (states_[index] == State::deleted) {
+      --deleted_;
+    }
+    states_[index] = State::full;
+    slots_[index].first = key;
+    slots_[index].second = T(std::forward<Args>(args)...);
+    ++size_;
+    return {{this, index}, true};
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+    return try_emplace(key, std::forward<Args>(args)...);
+  }
+
+  /// Erase an element, return the iterator following it.
+  iterator erase(const_iterator pos) {
+    const std::size_t index = pos.index_;
+    const std::size_t mask = states_.size() - 1;
+    slots_[index] = value_type();
+    --size_;
+    if (states_[(index + 1) & mask] == State::empty) {
+      // End of a probe sequence: clear the slot and the marks before it
+      states_[index] = State::empty;
+      for (std::size_t i = (index - 1) & mask; states_[i] == State::deleted;
+           i = (i - 1) & mask) {
+        states_[i] = State::empty;
+        --deleted_;
+      }
+    } else {
+      states_[index] = State::deleted;
+      ++deleted_;
+    }
+    return {this, index + 1};
+  }
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  std::size_t erase(const Key& key) {
+    const std::size_t index = find_index(key);
+    if (index == states_.size()) {
+      return 0;
+    }
+    erase(const_iterator(this, index));
+    return 1;
+  }
+
+  void clear() {
+    for (std::size_t i = 0; i < states_.size(); ++i) {
+      if (states_[i] != State::empty) {
+        states_[i] = State::empty;
+        slots_[i] = value_type();
+      }
+    }
+    size_ = 0;
+    deleted_ = 0;
+  }
+
+  /// Reserve space for the given number of elements without rehashing.
+  void reserve(std::size_t count) {
+    if (count * 2 > states_.size()) {
+      rehash(count);
+    }
+  }
+
+private:
+  enum class State : uint8_t { empty, full, deleted };
+
+  // Find the slot of a key (states_.size() if not present)
+  [[nodiscard]] std::size_t find_index(const Key& key) const {
+    if (size_ == 0) {
+      return states_.size();
+    }
+    const std::size_t mask = states_.size() - 1;
+    for (std::size_t i = Hash{}(key) & mask;; i = (i + 1) & mask) {
+      if (states_[i] == State::empty) {
+        return states_.size();
+      }
+      if (states_[i] == State::full && slots_[i].first == key) {
+        return i;
+      }
+    }
+  }
+
+  // Find the first unused slot for a key known not to be present
+  [[nodiscard]] std::size_t insert_index(const Key& key) const {
+    const std::size_t mask = states_.size() - 1;
+    std::size_t i = Hash{}(key) & mask;
+    while (states_[i] == State::full) {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+
+  // Rebuild the table with room for at least the given number of elements
+  void rehash(std::size_t count) {
+    std::size_t capacity = 16;
+    while (capacity * 3 < std::max(count, size_) * 8) {
+      capacity <<= 1;
+    }
+    std::vector<State> states(capacity, State::empty);
+    std::vector<value_type> slots(capacity);
+    std::swap(states, states_);
+    std::swap(slots, slots_);
+    deleted_ = 0;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      if (states[i] == State::full) {
+        const std::size_t index = insert_index(slots[i].first);
+        states_[index] = State::full;
+        slots_[index] = std::move(slots[i]);
+      }
+    }
+  }
+
+  std::vector<State> states_;
+  std::vector<value_type> slots_;
+  std::size_t size_ = 0;
+  std::size_t deleted_ = 0;
+};
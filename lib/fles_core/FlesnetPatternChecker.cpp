@@ -1,21 +1,47 @@
 // Copyright 2013, 2015 Jan de Cuveland <cmail@cuveland.de>
 
 #include "FlesnetPatternChecker.hpp"
+#include "Crc32c.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "RampCheck.hpp"
 #include <sys/types.h>
 
 bool FlesnetPatternChecker::check(const fles::Microslice& m) {
-  const auto* content = reinterpret_cast<const uint64_t*>(m.content());
+  return check_pattern(m, nullptr);
+}
+
+bool FlesnetPatternChecker::check_with_crc(const fles::Microslice& m,
+                                           uint32_t& crc) {
+  crc = 0;
+  return check_pattern(m, &crc);
+}
+
+bool FlesnetPatternChecker::check_pattern(const fles::Microslice& m,
+                                          uint32_t* crc) {
+  const uint8_t* content = m.content();
   if (!component && m.desc().size >= sizeof(uint)) {
-    component = content[0] >> 48;
+    component = reinterpret_cast<const uint64_t*>(content)[0] >> 48;
   }
-  uint32_t crc = 0x00000000;
-  for (size_t pos = 0; pos < m.desc().size / sizeof(uint64_t); ++pos) {
-    uint64_t data_word = content[pos];
-    crc ^= (data_word & 0xffffffff) ^ (data_word >> 32);
-    uint64_t expected = (*component << 48) | (pos * sizeof(uint64_t));
-    if (data_word != expected) {
-      return false;
-    }
+
+  // word i is expected to be (component << 48) | (i * 8)
+  const size_t count = m.desc().size / sizeof(uint64_t);
+  RampCheckResult ramp{};
+  if (count > 0) {
+    ramp = check_ramp(content, count, *component << 48, sizeof(uint64_t), crc);
+  }
+  if (crc != nullptr) {
+    *crc = crc32c(content + count * sizeof(uint64_t),
+                  m.desc().size % sizeof(uint64_t), *crc);
+  }
+
+  // Without the CrcValid flag, the generator stores the XOR of all 32-bit
+  // halves as descriptor CRC. Otherwise, it is a real CRC-32C (which is
+  // checked by the caller).
+  if ((m.desc().flags &
+       static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0) {
+    return ramp.mismatch == count;
   }
-  return crc == m.desc().crc;
+  const uint32_t xor_crc = static_cast<uint32_t>(ramp.xor_all) ^
+                           static_cast<uint32_t>(ramp.xor_all >> 32);
+  return ramp.mismatch == count && xor_crc == m.desc().crc;
 }
@@ -7,8 +7,11 @@
 class FlesnetPatternChecker : public PatternChecker {
 public:
   bool check(const fles::Microslice& m) override;
+  bool check_with_crc(const fles::Microslice& m, uint32_t& crc) override;
   void reset() override { component.reset(); }
 
 private:
+  bool check_pattern(const fles::Microslice& m, uint32_t* crc);
+
   std::optional<uint64_t> component;
 };
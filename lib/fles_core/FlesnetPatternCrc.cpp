@@ -0,0 +1,25 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "FlesnetPatternCrc.hpp"
+#include "Crc32c.hpp"
+
+FlesnetPatternCrc::FlesnetPatternCrc(uint64_t component, std::size_t max_size)
+    : component_(component) {
+  extend(max_size / sizeof(uint64_t));
+}
+
+uint32_t FlesnetPatternCrc::crc(std::size_t size) {
+  const std::size_t words = size / sizeof(uint64_t);
+  if (words >= crc_.size()) {
+    extend(words);
+  }
+  return crc_[words];
+}
+
+void FlesnetPatternCrc::extend(std::size_t words) {
+  crc_.reserve(words + 1);
+  for (std::size_t i = crc_.size() - 1; i < words; ++i) {
+    const uint64_t word = (component_ << 48) | (i * sizeof(uint64_t));
+    crc_.push_back(crc32c(&word, sizeof(word), crc_.back()));
+  }
+}
@@ -0,0 +1,33 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Precomputed CRC-32C values of the Flesnet software pattern.
+ *
+ * The pattern of a component depends only on the content size (word i is
+ * `(component << 48) | (i * 8)`), and each pattern is a prefix of the longer
+ * ones. The CRC-32C of every prefix is therefore computed only once, which
+ * allows a pattern generator to provide real CRCs at line rate.
+ */
+class FlesnetPatternCrc {
+public:
+  /// Precompute the CRCs for content sizes up to `max_size` (the table is
+  /// extended on demand for larger sizes).
+  explicit FlesnetPatternCrc(uint64_t component, std::size_t max_size = 0);
+
+  /// The CRC-32C of the pattern content of the given size in bytes (a
+  /// multiple of eight).
+  [[nodiscard]] uint32_t crc(std::size_t size);
+
+private:
+  void extend(std::size_t words);
+
+  uint64_t component_;
+
+  /// CRC-32C of the first n words of the pattern
+  std::vector<uint32_t> crc_{0};
+};
@@ -1,10 +1,12 @@
-// Copyright 2012-2014 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2012-2014, 2025 Jan de Cuveland <cmail@cuveland.de>
 
 #include "FlesnetPatternGenerator.hpp"
 
+#include "Crc32c.hpp"
 #include "DualRingBuffer.hpp"
 #include "MicrosliceDescriptor.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 
@@ -51,7 +53,9 @@ void FlesnetPatternGenerator::proceed() {
     const auto hdr_ver =
         static_cast<uint8_t>(fles::HeaderFormatVersion::Standard);
     const uint16_t eq_id = 0xE001;
-    const uint16_t flags = 0x0000;
+    const uint16_t flags =
+        compute_crc_ ? static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)
+                     : 0x0000;
     const auto sys_id = static_cast<uint8_t>(fles::Subsystem::FLES);
     const auto sys_ver = static_cast<uint8_t>(
         generate_pattern_ ? fles::SubsystemFormatFLES::BasicRampPattern
@@ -74,6 +78,16 @@ void FlesnetPatternGenerator::proceed() {
       write_index_.data += content_bytes;
     }
 
+    if (compute_crc_) {
+      if (generate_pattern_) {
+        crc = pattern_crc_.crc(content_bytes);
+      } else {
+        // unmodified buffer content, possibly wrapping around
+        crc = crc32c_ring(data_buffer_view_.ptr(), data_buffer_view_.bytes(),
+                          data_buffer_view_.offset_bytes(offset), size);
+      }
+    }
+
     // write to descriptor buffer
     const_cast<fles::MicrosliceDescriptor&>(
         desc_buffer_.at(write_index_.desc++)) =
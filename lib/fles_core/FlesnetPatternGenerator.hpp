@@ -1,7 +1,8 @@
-// Copyright 2012-2014 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2012-2014, 2025 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
 #include "DualRingBuffer.hpp"
+#include "FlesnetPatternCrc.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "RingBuffer.hpp"
 #include "RingBufferView.hpp"
@@ -21,7 +22,8 @@ public:
                           bool generate_pattern = false,
                           bool randomize_sizes = false,
                           uint64_t delay_ns = 0,
-                          uint64_t initial_ns = 0)
+                          uint64_t initial_ns = 0,
+                          bool compute_crc = false)
       : data_buffer_(data_buffer_size_exp), desc_buffer_(desc_buffer_size_exp),
         data_buffer_view_(data_buffer_.ptr(), data_buffer_size_exp),
         desc_buffer_view_(desc_buffer_.ptr(), desc_buffer_size_exp),
@@ -29,7 +31,8 @@ public:
         typical_content_size_(typical_content_size),
         randomize_sizes_(randomize_sizes),
         random_distribution_(typical_content_size), delay_ns_(delay_ns),
-        initial_ns_(initial_ns) {
+        initial_ns_(initial_ns), compute_crc_(compute_crc),
+        pattern_crc_(input_index, compute_crc ? typical_content_size : 0) {
     begin_ = std::chrono::high_resolution_clock::now();
   }
 
@@ -79,6 +82,12 @@ private:
 
   uint64_t delay_ns_;
   uint64_t initial_ns_;
+
+  /// Whether to provide the real CRC-32C of the content.
+  bool compute_crc_;
+
+  /// Precomputed CRCs of the generated pattern.
+  FlesnetPatternCrc pattern_crc_;
   std::chrono::high_resolution_clock::time_point begin_;
 
   /// Number of acknowledged data bytes and microslices. Updated by input
@@ -11,13 +11,34 @@
 // Implementation is not dump parallelizable across ts components!
 
 #include "FlibPatternChecker.hpp"
+#include "Crc32c.hpp"
 #include "Microslice.hpp"
 #include "MicrosliceDescriptor.hpp" // MicrosliceFlags
+#include "RampCheck.hpp"
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 
 bool FlibPatternChecker::check(const fles::Microslice& m) {
+  return check_pattern(m, nullptr);
+}
+
+bool FlibPatternChecker::check_with_crc(const fles::Microslice& m,
+                                        uint32_t& crc) {
+  crc = 0;
+  return check_pattern(m, &crc);
+}
+
+bool FlibPatternChecker::check_pattern(const fles::Microslice& m,
+                                       uint32_t* crc) {
+  // on header errors, the CRC is computed in a separate pass
+  auto fail = [&] {
+    if (crc != nullptr) {
+      *crc = crc32c(m.content(), m.desc().size);
+    }
+    return false;
+  };
+
   uint8_t last_word_size = 0;
 
   // increment packte number if initialized
@@ -34,7 +55,7 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
       std::cerr << "last word " << static_cast<uint32_t>(last_word_size)
                 << std::endl;
       last_word_size = 0;
-      return false;
+      return fail();
     }
     // Do not check last word size consistency and last word content if ms was
     // truncated
@@ -47,7 +68,7 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
         std::cerr << "desc.size " << m.desc().size << std::endl;
         std::cerr << "last word " << static_cast<uint32_t>(last_word_size)
                   << std::endl;
-        return false;
+        return fail();
       }
     } else {
       // if truncated set to 0 to skip last word content check at the end
@@ -59,7 +80,7 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
     const uint16_t word = reinterpret_cast<const uint16_t*>(m.content())[1];
     if (word != 0xBBFF) {
       std::cerr << "Flib pgen: error in hdr word" << std::endl;
-      return false;
+      return fail();
     }
   }
 
@@ -70,7 +91,7 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
     if (flib_pgen_packet_number_ != 0 &&
         flib_pgen_packet_number_ != flib_pgen_packet_number) {
       std::cerr << "Flib pgen: error in packet number" << std::endl;
-      return false;
+      return fail();
     }
     // initialize if uninitialized
     if (flib_pgen_packet_number_ == 0) {
@@ -87,30 +108,39 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
     } else {
       ramp_limit = 9;
     }
-    size_t pos = 1;
-    uint64_t ramp = 0xABCD000000000000;
-    const uint64_t* content =
-        reinterpret_cast<const uint64_t*>(m.content()) + 0;
+    const uint8_t* content = m.content();
+    const size_t count = (m.desc().size - ramp_limit) / sizeof(uint64_t);
+    const uint64_t ramp = 0xABCD000000000000;
 
-    while (pos <= ((m.desc().size - ramp_limit) / sizeof(uint64_t))) {
-      if (content[pos] != ramp) {
-        std::cerr << "Flib pgen: error in ramp word "
-                  << " exp " << std::hex << ramp << " seen " << content[pos]
-                  << std::endl;
-        return false;
-      }
-      ++ramp;
-      ++pos;
+    if (crc != nullptr) {
+      *crc = crc32c(content, sizeof(uint64_t), *crc);
+    }
+    const RampCheckResult result =
+        check_ramp(content + sizeof(uint64_t), count, ramp, 1, crc);
+    size_t last_word_start = (count + 1) * sizeof(uint64_t);
+    if (crc != nullptr) {
+      *crc = crc32c(content + last_word_start,
+                    m.desc().size - last_word_start, *crc);
+    }
+
+    if (result.mismatch != count) {
+      const size_t pos = result.mismatch + 1;
+      std::cerr << "Flib pgen: error in ramp word "
+                << " exp " << std::hex << ramp + result.mismatch << " seen "
+                << reinterpret_cast<const uint64_t*>(content)[pos]
+                << std::endl;
+      return false;
     }
 
     // check last word if any
-    size_t last_word_start = pos * sizeof(uint64_t);
     for (size_t i = 0; i < last_word_size; ++i) {
       if (m.content()[last_word_start + i] != 0xFA) {
         std::cerr << "Flib pgen: error in last word" << std::endl;
         return false;
       }
     }
+  } else if (crc != nullptr) {
+    *crc = crc32c(m.content(), m.desc().size);
   }
 
   return true;
@@ -6,8 +6,11 @@
 class FlibPatternChecker : public PatternChecker {
 public:
   bool check(const fles::Microslice& m) override;
+  bool check_with_crc(const fles::Microslice& m, uint32_t& crc) override;
   void reset() override { flib_pgen_packet_number_ = 0; };
 
 private:
+  bool check_pattern(const fles::Microslice& m, uint32_t* crc);
+
   uint32_t flib_pgen_packet_number_ = 0;
 };
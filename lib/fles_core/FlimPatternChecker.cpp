@@ -10,13 +10,34 @@
 // Implementation is not dump parallelizable across ts components!
 
 #include "FlimPatternChecker.hpp"
+#include "Crc32c.hpp"
 #include "Microslice.hpp"
 #include "MicrosliceDescriptor.hpp" // MicrosliceFlags
+#include "RampCheck.hpp"
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 
 bool FlimPatternChecker::check(const fles::Microslice& m) {
+  return check_pattern(m, nullptr);
+}
+
+bool FlimPatternChecker::check_with_crc(const fles::Microslice& m,
+                                        uint32_t& crc) {
+  crc = 0;
+  return check_pattern(m, &crc);
+}
+
+bool FlimPatternChecker::check_pattern(const fles::Microslice& m,
+                                       uint32_t* crc) {
+  // on header errors, the CRC is computed in a separate pass
+  auto fail = [&] {
+    if (crc != nullptr) {
+      *crc = crc32c(m.content(), m.desc().size);
+    }
+    return false;
+  };
+
   uint8_t last_word_size = 0;
 
   // increment packte number if initialized
@@ -33,7 +54,7 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
       std::cerr << "last word " << static_cast<uint32_t>(last_word_size)
                 << std::endl;
       last_word_size = 0;
-      return false;
+      return fail();
     }
     // Do not check last word size consistency and last word content if ms was
     // truncated
@@ -46,7 +67,7 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
         std::cerr << "desc.size " << m.desc().size << std::endl;
         std::cerr << "last word " << static_cast<uint32_t>(last_word_size)
                   << std::endl;
-        return false;
+        return fail();
       }
     } else {
       // if truncated set to 0 to skip last word content check at the end
@@ -59,7 +80,7 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
     if (word != 0xBBFF) {
       std::cerr << "Flim pgen: error in hdr word. Found " << std::hex << word
                 << std::endl;
-      return false;
+      return fail();
     }
   }
 
@@ -71,7 +92,7 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
       std::cerr << "Flim pgen: error in packet number;"
                 << " exp " << std::hex << pgen_packet_number_ << " seen "
                 << pgen_packet_number << std::endl;
-      return false;
+      return fail();
     }
     // initialize if uninitialized
     if (pgen_packet_number_ == 0) {
@@ -85,7 +106,7 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
       std::cerr << "Flim pgen: error in packet timestamp; "
                 << " exp " << std::hex << m.desc().idx << " seen "
                 << pgen_timestamp << std::endl;
-      return false;
+      return fail();
     }
   }
 
@@ -104,13 +125,29 @@ bool FlimPatternChecker::check(const fles::Microslice& m) {
     size64 = m.desc().size / 8;
   }
 
-  for (size_t pos = 2; pos < size64; ++pos) {
-    uint64_t expect = 0xABCD000000000000 + pos - 2;
-    if (content[pos] != expect) {
-      std::cerr << "Flim pgen: error in ramp word " << (pos - 2) << " exp "
-                << std::hex << expect << " seen " << content[pos] << std::endl;
-      return false;
+  const size_t count = size64 > 2 ? size64 - 2 : 0;
+  const size_t ramp_start = 2 * sizeof(uint64_t);
+  RampCheckResult result{};
+  if (count > 0) {
+    if (crc != nullptr) {
+      *crc = crc32c(m.content(), ramp_start, *crc);
+    }
+    result = check_ramp(m.content() + ramp_start, count, 0xABCD000000000000, 1,
+                        crc);
+    if (crc != nullptr) {
+      const size_t ramp_end = ramp_start + count * sizeof(uint64_t);
+      *crc = crc32c(m.content() + ramp_end, m.desc().size - ramp_end, *crc);
     }
+  } else if (crc != nullptr) {
+    *crc = crc32c(m.content(), m.desc().size);
+  }
+
+  if (result.mismatch != count) {
+    const size_t pos = result.mismatch + 2;
+    uint64_t expect = 0xABCD000000000000 + pos - 2;
+    std::cerr << "Flim pgen: error in ramp word " << (pos - 2) << " exp "
+              << std::hex << expect << " seen " << content[pos] << std::endl;
+    return false;
   }
 
   // check last word if any
@@ -7,8 +7,11 @@
 class FlimPatternChecker : public PatternChecker {
 public:
   bool check(const fles::Microslice& m) override;
+  bool check_with_crc(const fles::Microslice& m, uint32_t& crc) override;
   void reset() override { pgen_packet_number_ = 0; };
 
 private:
+  bool check_pattern(const fles::Microslice& m, uint32_t* crc);
+
   uint32_t pgen_packet_number_ = 0;
 };
@@ -0,0 +1,71 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief Histogram of latencies with logarithmic buckets.
+ *
+ * Bucket 0 holds latencies below 1 us (1024 ns), bucket i > 0 holds latencies
+ * in [2^(9+i), 2^(10+i)) ns, and the last bucket everything above. Recording
+ * is a few instructions and does not allocate, so it can be used on the data
+ * path; quantiles are resolved to the upper bound of their bucket.
+ */
+class LatencyHistogram {
+public:
+  static constexpr std::size_t bucket_count = 32;
+
+  void record(uint64_t latency_ns) {
+    ++buckets_[bucket_of(latency_ns)];
+    ++count_;
+    sum_ns_ += latency_ns;
+    max_ns_ = std::max(max_ns_, latency_ns);
+  }
+
+  void reset() { *this = LatencyHistogram(); }
+
+  [[nodiscard]] uint64_t count() const { return count_; }
+  [[nodiscard]] uint64_t sum_ns() const { return sum_ns_; }
+  [[nodiscard]] uint64_t max_ns() const { return max_ns_; }
+  [[nodiscard]] const std::array<uint64_t, bucket_count>& buckets() const {
+    return buckets_;
+  }
+
+  /// Retrieve an upper bound for the given quantile (0..1) of the recorded
+  /// latencies (0 if empty).
+  [[nodiscard]] uint64_t quantile_ns(double q) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    const auto rank = static_cast<uint64_t>(q * static_cast<double>(count_));
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      cumulative += buckets_[i];
+      if (cumulative > rank || cumulative == count_) {
+        return std::min(upper_bound_ns(i), max_ns_);
+      }
+    }
+    return max_ns_;
+  }
+
+  /// Retrieve the (exclusive) upper latency bound of a bucket.
+  [[nodiscard]] static uint64_t upper_bound_ns(std::size_t bucket) {
+    return bucket + 1 < bucket_count ? uint64_t{1} << (10 + bucket)
+                                     : UINT64_MAX;
+  }
+
+  [[nodiscard]] static std::size_t bucket_of(uint64_t latency_ns) {
+    const auto width = static_cast<std::size_t>(std::bit_width(latency_ns));
+    return std::min(width < 10 ? 0 : width - 10, bucket_count - 1);
+  }
+
+private:
+  std::array<uint64_t, bucket_count> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ns_ = 0;
+  uint64_t max_ns_ = 0;
+};
@@ -0,0 +1,200 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "MemoryPlacement.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+#ifdef HAVE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
+
+namespace {
+
+constexpr std::size_t huge_page_size_2m = std::size_t{1} << 21;
+constexpr std::size_t huge_page_size_1g = std::size_t{1} << 30;
+
+std::size_t round_up(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Shrink a region to the whole pages it contains
+std::pair<void*, std::size_t> page_interior(void* addr, std::size_t size) {
+  const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = reinterpret_cast<std::uintptr_t>(addr);
+  const std::uintptr_t first = (begin + page_size - 1) / page_size * page_size;
+  const std::uintptr_t last = (begin + size) / page_size * page_size;
+  if (last <= first) {
+    return {nullptr, 0};
+  }
+  return {reinterpret_cast<void*>(first), last - first};
+}
+
+} // namespace
+
+std::string_view to_string(HugePages huge_pages) {
+  switch (huge_pages) {
+  case HugePages::none:
+    return "none";
+  case HugePages::transparent:
+    return "transparent";
+  case HugePages::size_2m:
+    return "2M";
+  case HugePages::size_1g:
+    return "1G";
+  }
+  return "unknown";
+}
+
+std::optional<HugePages> parse_huge_pages(std::string_view str) {
+  for (auto huge_pages : {HugePages::none, HugePages::transparent,
+                          HugePages::size_2m, HugePages::size_1g}) {
+    if (str == to_string(huge_pages)) {
+      return huge_pages;
+    }
+  }
+  return std::nullopt;
+}
+
+std::istream& operator>>(std::istream& in, HugePages& huge_pages) {
+  std::string str;
+  in >> str;
+  if (auto value = parse_huge_pages(str)) {
+    huge_pages = *value;
+  } else {
+    in.setstate(std::ios::failbit);
+  }
+  return in;
+}
+
+std::ostream& operator<<(std::ostream& out, HugePages huge_pages) {
+  return out << to_string(huge_pages);
+}
+
+MappedBuffer::MappedBuffer(std::size_t size, HugePages huge_pages) {
+  if (size == 0) {
+    return;
+  }
+
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+  std::size_t alignment = 0;
+  switch (huge_pages) {
+  case HugePages::none:
+    mapped_size_ = size;
+    break;
+  case HugePages::transparent:
+    // Transparent huge pages are only used for aligned 2 MiB ranges
+    alignment = huge_page_size_2m;
+    mapped_size_ = size + alignment;
+    break;
+#ifdef MAP_HUGETLB
+  case HugePages::size_2m:
+    flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+    mapped_size_ = round_up(size, huge_page_size_2m);
+    break;
+  case HugePages::size_1g:
+    flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+    mapped_size_ = round_up(size, huge_page_size_1g);
+    break;
+#else
+  default:
+    throw std::runtime_error("explicit huge pages not supported");
+#endif
+  }
+
+  void* addr =
+      mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (addr == MAP_FAILED) {
+    const int err = errno;
+    throw std::runtime_error("cannot map buffer of " + std::to_string(size) +
+                             " bytes with huge pages '" +
+                             std::string(to_string(huge_pages)) +
+                             "': " + std::strerror(err));
+  }
+  base_ = addr;
+  data_ = static_cast<std::byte*>(addr);
+  size_ = size;
+  if (alignment != 0) {
+    data_ = reinterpret_cast<std::byte*>(
+        round_up(reinterpret_cast<std::uintptr_t>(addr), alignment));
+    advise_huge_pages(data_, size_);
+  }
+}
+
+MappedBuffer::~MappedBuffer() {
+  if (base_ != nullptr) {
+    munmap(base_, mapped_size_);
+  }
+}
+
+MappedBuffer::MappedBuffer(MappedBuffer&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      mapped_size_(std::exchange(other.mapped_size_, 0)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedBuffer& MappedBuffer::operator=(MappedBuffer&& other) noexcept {
+  if (this != &other) {
+    if (base_ != nullptr) {
+      munmap(base_, mapped_size_);
+    }
+    base_ = std::exchange(other.base_, nullptr);
+    mapped_size_ = std::exchange(other.mapped_size_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+bool advise_huge_pages(void* addr, std::size_t size) {
+#ifdef MADV_HUGEPAGE
+  auto [begin, length] = page_interior(addr, size);
+  return length != 0 && madvise(begin, length, MADV_HUGEPAGE) == 0;
+#else
+  (void)addr;
+  (void)size;
+  return false;
+#endif
+}
+
+bool bind_memory_to_numa_node(void* addr, std::size_t size, int node) {
+#ifdef HAVE_NUMA
+  if (numa_available() < 0 || node < 0 || node > numa_max_node()) {
+    return false;
+  }
+  auto [begin, length] = page_interior(addr, size);
+  if (length == 0) {
+    return false;
+  }
+  struct bitmask* nodes = numa_allocate_nodemask();
+  numa_bitmask_setbit(nodes, static_cast<unsigned int>(node));
+  const long result = mbind(begin, length, MPOL_BIND, nodes->maskp,
+                            nodes->size + 1, MPOL_MF_MOVE);
+  numa_free_nodemask(nodes);
+  return result == 0;
+#else
+  (void)addr;
+  (void)size;
+  (void)node;
+  return false;
+#endif
+}
+
+bool run_on_numa_node(int node) {
+#ifdef HAVE_NUMA
+  if (numa_available() < 0 || node < 0 || node > numa_max_node()) {
+    return false;
+  }
+  return numa_run_on_node(node) == 0;
+#else
+  (void)node;
+  return false;
+#endif
+}
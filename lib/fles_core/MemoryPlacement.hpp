@@ -0,0 +1,67 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+
+/// Page size used for large data buffers.
+enum class HugePages {
+  none,        ///< regular pages
+  transparent, ///< transparent huge pages (madvise)
+  size_2m,     ///< explicit 2 MiB huge pages (anonymous memory only)
+  size_1g      ///< explicit 1 GiB huge pages (anonymous memory only)
+};
+
+std::string_view to_string(HugePages huge_pages);
+
+std::optional<HugePages> parse_huge_pages(std::string_view str);
+
+/// Stream operators, used for command line option values.
+std::istream& operator>>(std::istream& in, HugePages& huge_pages);
+std::ostream& operator<<(std::ostream& out, HugePages huge_pages);
+
+/**
+ * \brief Anonymous memory mapping for a large buffer.
+ *
+ * In contrast to a std::vector, the pages are not touched on construction,
+ * so the memory can be bound to a NUMA node before it is first used. With
+ * explicit huge pages, the size is rounded up to a multiple of the huge page
+ * size. Throws std::runtime_error if the mapping fails, e.g., because not
+ * enough huge pages are reserved.
+ */
+class MappedBuffer {
+public:
+  MappedBuffer() = default;
+  MappedBuffer(std::size_t size, HugePages huge_pages);
+  ~MappedBuffer();
+
+  MappedBuffer(const MappedBuffer&) = delete;
+  MappedBuffer& operator=(const MappedBuffer&) = delete;
+  MappedBuffer(MappedBuffer&& other) noexcept;
+  MappedBuffer& operator=(MappedBuffer&& other) noexcept;
+
+  [[nodiscard]] std::byte* data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+private:
+  void* base_ = nullptr;
+  std::size_t mapped_size_ = 0;
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+/// Request transparent huge pages for the given memory region, e.g., in a
+/// shared memory segment (requires shmem_enabled=advise for shared memory).
+/// Returns false if not supported.
+bool advise_huge_pages(void* addr, std::size_t size);
+
+/// Bind the pages of the given memory region to a NUMA node. Pages already
+/// touched are migrated. Returns false if not supported (without libnuma).
+bool bind_memory_to_numa_node(void* addr, std::size_t size, int node);
+
+/// Restrict the calling thread, and all threads it creates afterwards, to the
+/// CPUs of a NUMA node. Returns false if not supported (without libnuma).
+bool run_on_numa_node(int node);
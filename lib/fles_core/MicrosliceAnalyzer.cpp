@@ -6,8 +6,6 @@
 #include "PatternChecker.hpp"
 #include "TimesliceDebugger.hpp"
 #include "Utility.hpp"
-#include "interface.h"
-#include <cassert>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -21,31 +19,9 @@ MicrosliceAnalyzer::MicrosliceAnalyzer(uint64_t arg_output_interval,
                                        std::ostream& arg_out,
                                        std::string arg_output_prefix)
     : output_interval_(arg_output_interval), out_verbosity_(arg_out_verbosity),
-      out_(arg_out), output_prefix_(std::move(arg_output_prefix)) {
-  // create CRC-32C engine (Castagnoli polynomial)
-  crc32_engine_ = crcutil_interface::CRC::Create(
-      0x82f63b78, 0, 32, true, 0, 0, 0,
-      crcutil_interface::CRC::IsSSE42Available(), nullptr);
-}
-
-MicrosliceAnalyzer::~MicrosliceAnalyzer() {
-  if (crc32_engine_ != nullptr) {
-    crc32_engine_->Delete();
-  }
-}
-
-uint32_t MicrosliceAnalyzer::compute_crc(const fles::Microslice& ms) const {
-  assert(crc32_engine_);
+      out_(arg_out), output_prefix_(std::move(arg_output_prefix)) {}
 
-  crcutil_interface::UINT64 crc64 = 0;
-  crc32_engine_->Compute(ms.content(), ms.desc().size, &crc64);
-
-  return static_cast<uint32_t>(crc64);
-}
-
-bool MicrosliceAnalyzer::check_crc(const fles::Microslice& ms) const {
-  return compute_crc(ms) == ms.desc().crc;
-}
+MicrosliceAnalyzer::~MicrosliceAnalyzer() = default;
 
 void MicrosliceAnalyzer::initialize(const fles::Microslice& ms) {
   fles::MicrosliceDescriptor desc = ms.desc();
@@ -94,7 +70,15 @@ bool MicrosliceAnalyzer::check_microslice(const fles::Microslice& ms) {
     ++microslice_truncated_count_;
   }
 
-  if (!pattern_checker_->check(ms)) {
+  // the CRC is computed in the same pass as the pattern check
+  const bool crc_valid =
+      (ms.desc().flags &
+       static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0;
+  uint32_t crc = 0;
+  const bool pattern_ok = crc_valid
+                              ? pattern_checker_->check_with_crc(ms, crc)
+                              : pattern_checker_->check(ms);
+  if (!pattern_ok) {
     if (out_verbosity_ >= 3) {
       out_ << output_prefix_ << "pattern error in microslice "
            << microslice_count_ << std::endl;
@@ -102,9 +86,7 @@ bool MicrosliceAnalyzer::check_microslice(const fles::Microslice& ms) {
     result = false;
   }
 
-  if (((ms.desc().flags &
-        static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0) &&
-      !check_crc(ms)) {
+  if (crc_valid && crc != ms.desc().crc) {
     if (out_verbosity_ >= 3) {
       out_ << output_prefix_ << "crc failure in microslice "
            << microslice_count_ << std::endl;
@@ -4,7 +4,6 @@
 #include "Microslice.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "Sink.hpp"
-#include "interface.h" // crcutil_interface
 #include <memory>
 #include <ostream>
 #include <string>
@@ -26,14 +25,8 @@ private:
 
   [[nodiscard]] std::string statistics() const;
 
-  [[nodiscard]] uint32_t compute_crc(const fles::Microslice& ms) const;
-
-  [[nodiscard]] bool check_crc(const fles::Microslice& ms) const;
-
   void initialize(const fles::Microslice& ms);
 
-  crcutil_interface::CRC* crc32_engine_ = nullptr;
-
   fles::MicrosliceDescriptor reference_descriptor_{};
   std::unique_ptr<PatternChecker> pattern_checker_;
 
@@ -0,0 +1,82 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "MicrosliceTimeIndex.hpp"
+
+uint64_t MicrosliceTimeIndex::upper_bound(uint64_t begin,
+                                          uint64_t end,
+                                          uint64_t time) const {
+  if (begin == end || time < this->time(begin)) {
+    return begin;
+  }
+  const uint64_t last = end - 1;
+  if (time >= this->time(last)) {
+    return end;
+  }
+
+  // Here, time(begin) <= time < time(last). Guess the position assuming
+  // equidistant microslices...
+  const uint64_t begin_time = this->time(begin);
+  const double fraction = static_cast<double>(time - begin_time) /
+                          static_cast<double>(this->time(last) - begin_time);
+  const auto offset =
+      static_cast<uint64_t>(fraction * static_cast<double>(last - begin));
+  const uint64_t guess = std::min(begin + offset, last);
+
+  // ... then gallop from there to find lo, hi with time(lo) <= time < time(hi)
+  uint64_t lo = guess;
+  uint64_t hi = guess;
+  uint64_t step = 1;
+  if (this->time(guess) <= time) {
+    while (true) {
+      hi = std::min(lo + step, last);
+      if (this->time(hi) > time) {
+        break;
+      }
+      lo = hi;
+      step *= 2;
+    }
+  } else {
+    while (true) {
+      lo = hi - std::min(step, hi - begin);
+      if (this->time(lo) <= time) {
+        break;
+      }
+      hi = lo;
+      step *= 2;
+    }
+  }
+
+  // The result is in (lo, hi]
+  return lo + 1 + count_not_after(lo + 1, hi, time);
+}
+
+uint64_t MicrosliceTimeIndex::count_not_after(uint64_t begin,
+                                              uint64_t end,
+                                              uint64_t time) const {
+  // Short ranges are scanned linearly, which the compiler can vectorize
+  constexpr std::size_t linear_search_limit = 32;
+
+  const std::size_t size = times_.size();
+  uint64_t count = 0;
+  // Search each contiguous part of the (possibly wrapped) range in turn
+  while (begin < end) {
+    const std::size_t pos = begin % size;
+    const std::size_t len = std::min<uint64_t>(end - begin, size - pos);
+    const uint64_t* first = times_.data() + pos;
+    const uint64_t* last = first + len;
+    std::size_t n = 0;
+    if (len <= linear_search_limit) {
+      for (const uint64_t* p = first; p != last; ++p) {
+        n += static_cast<std::size_t>(*p <= time);
+      }
+    } else {
+      n = std::upper_bound(first, last, time) - first;
+    }
+    count += n;
+    if (n < len) {
+      break;
+    }
+    begin += len;
+  }
+  return count;
+}
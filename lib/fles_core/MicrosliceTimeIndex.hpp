@@ -0,0 +1,69 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Shadow index of the microslice start times in a descriptor ring
+ * buffer.
+ *
+ * The index mirrors the `idx` field of each microslice descriptor in a
+ * contiguous array of 64-bit keys at the same ring buffer position. It is
+ * updated incrementally as new descriptors arrive. Searching it avoids
+ * loading a full descriptor from the (DMA) ring buffer for each probe. As the
+ * microslice start times are close to equidistant, a search starts from an
+ * interpolated position and usually finishes after a few probes.
+ */
+class MicrosliceTimeIndex {
+public:
+  /// Construct an index for a descriptor ring buffer of the given size.
+  explicit MicrosliceTimeIndex(std::size_t size) : times_(size) {}
+
+  /// Add the start times of all descriptors up to (excluding) write_index.
+  template <typename DescBuffer>
+  void update(const DescBuffer& desc_buffer, uint64_t write_index) {
+    const std::size_t size = times_.size();
+    uint64_t n = next_index_;
+    if (write_index - n > size) {
+      n = write_index - size; // older entries have been overwritten
+    }
+    std::size_t pos = n % size;
+    for (; n < write_index; ++n) {
+      times_[pos] = desc_buffer.at(n).idx;
+      if (++pos == size) {
+        pos = 0;
+      }
+    }
+    next_index_ = std::max(next_index_, write_index);
+  }
+
+  /// Retrieve the start time of the microslice with the given index.
+  [[nodiscard]] uint64_t time(uint64_t n) const {
+    return times_[n % times_.size()];
+  }
+
+  /// Find the first microslice in [begin, end) with a start time > time.
+  [[nodiscard]] uint64_t
+  upper_bound(uint64_t begin, uint64_t end, uint64_t time) const;
+
+  /// Find the first microslice in [begin, end) with a start time >= time.
+  [[nodiscard]] uint64_t
+  lower_bound(uint64_t begin, uint64_t end, uint64_t time) const {
+    return (time == 0) ? begin : upper_bound(begin, end, time - 1);
+  }
+
+private:
+  /// Count the microslices in [begin, end) with a start time <= time.
+  [[nodiscard]] uint64_t
+  count_not_after(uint64_t begin, uint64_t end, uint64_t time) const;
+
+  /// The microslice start times, at the ring buffer position of the
+  /// corresponding descriptor
+  std::vector<uint64_t> times_;
+
+  /// The index of the next descriptor to be added
+  uint64_t next_index_ = 0;
+};
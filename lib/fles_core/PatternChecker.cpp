@@ -1,6 +1,7 @@
-// Copyright 2013, 2015 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2013, 2015, 2025 Jan de Cuveland <cmail@cuveland.de>
 
 #include "PatternChecker.hpp"
+#include "Crc32c.hpp"
 #include "FlesnetPatternChecker.hpp"
 #include "FlibLegacyPatternChecker.hpp"
 #include "FlibPatternChecker.hpp"
@@ -10,6 +11,11 @@
 #include <cstdlib>
 #include <memory>
 
+bool PatternChecker::check_with_crc(const fles::Microslice& m, uint32_t& crc) {
+  crc = crc32c(m.content(), m.desc().size);
+  return check(m);
+}
+
 std::unique_ptr<PatternChecker> PatternChecker::create(uint8_t arg_sys_id,
                                                        uint8_t arg_sys_ver) {
   auto sys_id = static_cast<fles::Subsystem>(arg_sys_id);
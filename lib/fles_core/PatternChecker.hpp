@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Microslice.hpp"
+#include <cstdint>
 #include <memory>
 
 class PatternChecker {
@@ -9,6 +10,12 @@ public:
   virtual ~PatternChecker() = default;
 
   virtual bool check(const fles::Microslice& m) = 0;
+
+  /// Check the pattern and compute the CRC-32C of the microslice content.
+  /// Checkers of generated patterns compute the CRC in the same pass over the
+  /// data.
+  virtual bool check_with_crc(const fles::Microslice& m, uint32_t& crc);
+
   virtual void reset() {};
 
   static std::unique_ptr<PatternChecker> create(uint8_t arg_sys_id,
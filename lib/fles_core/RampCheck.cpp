@@ -0,0 +1,228 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "RampCheck.hpp"
+#include "Crc32c.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RAMP_CHECK_X86 1
+#endif
+
+namespace {
+
+// Number of words per block, small enough for the block to still be in the
+// L1 cache when its CRC is computed
+constexpr std::size_t block_words = 512;
+
+inline uint64_t load_word(const uint8_t* p) {
+  uint64_t word = 0;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Find the first mismatching word (only called if there is one)
+std::size_t find_mismatch(const uint8_t* data,
+                          std::size_t count,
+                          uint64_t first,
+                          uint64_t step) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (load_word(data + i * sizeof(uint64_t)) != first + i * step) {
+      return i;
+    }
+  }
+  return count;
+}
+
+// The kernels compare a block of words, returning the XOR of all words and
+// whether any word differs from the ramp
+
+struct BlockResult {
+  uint64_t xor_all;
+  bool mismatch;
+};
+
+BlockResult check_block_scalar(const uint8_t* data,
+                               std::size_t count,
+                               uint64_t first,
+                               uint64_t step) {
+  uint64_t acc = 0;
+  uint64_t diff = 0;
+  uint64_t expect = first;
+  for (std::size_t i = 0; i < count; ++i) {
+    const uint64_t word = load_word(data + i * sizeof(uint64_t));
+    acc ^= word;
+    diff |= word ^ expect;
+    expect += step;
+  }
+  return {acc, diff != 0};
+}
+
+#ifdef RAMP_CHECK_X86
+__attribute__((target("avx2"))) BlockResult check_block_avx2(
+    const uint8_t* data, std::size_t count, uint64_t first, uint64_t step) {
+  auto at = [=](uint64_t k) {
+    return static_cast<long long>(first + k * step);
+  };
+  const __m256i inc = _mm256_set1_epi64x(static_cast<long long>(4 * step));
+  __m256i expect = _mm256_set_epi64x(at(3), at(2), at(1), at(0));
+  __m256i acc = _mm256_setzero_si256();
+  __m256i diff = _mm256_setzero_si256();
+
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(data + i * sizeof(uint64_t)));
+    acc = _mm256_xor_si256(acc, v);
+    diff = _mm256_or_si256(diff, _mm256_xor_si256(v, expect));
+    expect = _mm256_add_epi64(expect, inc);
+  }
+
+  const __m128i acc128 = _mm_xor_si128(_mm256_castsi256_si128(acc),
+                                       _mm256_extracti128_si256(acc, 1));
+  auto tail = check_block_scalar(data + i * sizeof(uint64_t), count - i,
+                                 first + i * step, step);
+  tail.xor_all ^= static_cast<uint64_t>(_mm_extract_epi64(acc128, 0)) ^
+                  static_cast<uint64_t>(_mm_extract_epi64(acc128, 1));
+  tail.mismatch |= _mm256_testz_si256(diff, diff) == 0;
+  return tail;
+}
+
+__attribute__((target("avx512f"))) BlockResult check_block_avx512(
+    const uint8_t* data, std::size_t count, uint64_t first, uint64_t step) {
+  auto at = [=](uint64_t k) {
+    return static_cast<long long>(first + k * step);
+  };
+  const __m512i inc = _mm512_set1_epi64(static_cast<long long>(8 * step));
+  __m512i expect = _mm512_set_epi64(at(7), at(6), at(5), at(4), at(3), at(2),
+                                    at(1), at(0));
+  __m512i acc = _mm512_setzero_si512();
+  __m512i diff = _mm512_setzero_si512();
+
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m512i v = _mm512_loadu_si512(data + i * sizeof(uint64_t));
+    acc = _mm512_xor_si512(acc, v);
+    diff = _mm512_or_si512(diff, _mm512_xor_si512(v, expect));
+    expect = _mm512_add_epi64(expect, inc);
+  }
+
+  alignas(64) uint64_t lanes[8];
+  _mm512_store_si512(lanes, acc);
+  auto tail = check_block_scalar(data + i * sizeof(uint64_t), count - i,
+                                 first + i * step, step);
+  for (const uint64_t lane : lanes) {
+    tail.xor_all ^= lane;
+  }
+  tail.mismatch |= _mm512_test_epi64_mask(diff, diff) != 0;
+  return tail;
+}
+#endif
+
+using BlockKernel = BlockResult (*)(const uint8_t*,
+                                    std::size_t,
+                                    uint64_t,
+                                    uint64_t);
+
+BlockKernel kernel(SimdLevel level) {
+  switch (level) {
+#ifdef RAMP_CHECK_X86
+  case SimdLevel::avx2:
+    return check_block_avx2;
+  case SimdLevel::avx512:
+    return check_block_avx512;
+#endif
+  default:
+    return check_block_scalar;
+  }
+}
+
+SimdLevel best_simd_level() {
+  if (simd_level_supported(SimdLevel::avx512)) {
+    return SimdLevel::avx512;
+  }
+  if (simd_level_supported(SimdLevel::avx2)) {
+    return SimdLevel::avx2;
+  }
+  return SimdLevel::scalar;
+}
+
+std::atomic<SimdLevel> current_level{best_simd_level()};
+
+} // namespace
+
+std::string_view to_string(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::scalar:
+    return "scalar";
+  case SimdLevel::avx2:
+    return "avx2";
+  case SimdLevel::avx512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+bool simd_level_supported(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::scalar:
+    return true;
+#ifdef RAMP_CHECK_X86
+  case SimdLevel::avx2:
+    // may be called during static initialization
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  case SimdLevel::avx512:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") != 0;
+#endif
+  default:
+    return false;
+  }
+}
+
+SimdLevel simd_level() {
+  return current_level.load(std::memory_order_relaxed);
+}
+
+void set_simd_level(SimdLevel level) {
+  if (simd_level_supported(level)) {
+    current_level.store(level, std::memory_order_relaxed);
+  }
+}
+
+RampCheckResult check_ramp(const uint8_t* data,
+                           std::size_t count,
+                           uint64_t first,
+                           uint64_t step,
+                           uint32_t* crc) {
+  return check_ramp(simd_level(), data, count, first, step, crc);
+}
+
+RampCheckResult check_ramp(SimdLevel level,
+                           const uint8_t* data,
+                           std::size_t count,
+                           uint64_t first,
+                           uint64_t step,
+                           uint32_t* crc) {
+  const BlockKernel check_block = kernel(level);
+  RampCheckResult result{count, 0};
+
+  for (std::size_t i = 0; i < count; i += block_words) {
+    const std::size_t n = std::min(block_words, count - i);
+    const uint8_t* block = data + i * sizeof(uint64_t);
+    const uint64_t block_first = first + i * step;
+    const BlockResult r = check_block(block, n, block_first, step);
+    result.xor_all ^= r.xor_all;
+    if (r.mismatch && result.mismatch == count) {
+      result.mismatch = i + find_mismatch(block, n, block_first, step);
+    }
+    if (crc != nullptr) {
+      *crc = crc32c(block, n * sizeof(uint64_t), *crc);
+    }
+  }
+
+  return result;
+}
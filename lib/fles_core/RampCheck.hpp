@@ -0,0 +1,62 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// Instruction set used for the vectorized ramp check.
+enum class SimdLevel {
+  scalar, ///< portable implementation
+  avx2,   ///< 256-bit AVX2 (x86-64)
+  avx512  ///< 512-bit AVX-512F (x86-64)
+};
+
+std::string_view to_string(SimdLevel level);
+
+/// Whether the given instruction set is supported by the CPU.
+[[nodiscard]] bool simd_level_supported(SimdLevel level);
+
+/// The instruction set used by check_ramp(). Initially the best one
+/// supported, can be changed (e.g., for benchmarks) with set_simd_level().
+[[nodiscard]] SimdLevel simd_level();
+void set_simd_level(SimdLevel level);
+
+/// Result of a ramp check.
+struct RampCheckResult {
+  /// Index of the first word not matching the ramp (the word count if all
+  /// words match)
+  std::size_t mismatch = 0;
+  /// Bitwise XOR of all words
+  uint64_t xor_all = 0;
+};
+
+/**
+ * \brief Check that a sequence of 64-bit words forms a ramp.
+ *
+ * The expected word i is `first + i * step`. If `crc` is not null, the
+ * CRC-32C in `*crc` is continued over the words (see crc32c()). The data is
+ * processed in blocks small enough to stay in the L1 cache: each block is
+ * compared using vector instructions and then added to the CRC, so the data
+ * is read from memory only once. The check does not stop at a mismatch, so
+ * the CRC is always complete.
+ *
+ * \param data  Start of the words (no alignment required)
+ * \param count Number of words
+ * \param first Expected first word
+ * \param step  Increment between consecutive words
+ * \param crc   CRC to continue (optional)
+ */
+RampCheckResult check_ramp(const uint8_t* data,
+                           std::size_t count,
+                           uint64_t first,
+                           uint64_t step,
+                           uint32_t* crc = nullptr);
+
+/// Check a ramp using the given (supported) instruction set.
+RampCheckResult check_ramp(SimdLevel level,
+                           const uint8_t* data,
+                           std::size_t count,
+                           uint64_t first,
+                           uint64_t step,
+                           uint32_t* crc = nullptr);
@@ -0,0 +1,106 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "RingAllocator.hpp"
+#include <algorithm>
+#include <cassert>
+
+std::optional<RingAllocator::Allocation>
+RingAllocator::allocate(std::size_t size) {
+  if (size == 0) {
+    return Allocation{};
+  }
+
+  if (size > capacity_) {
+    ++failure_count_;
+    return std::nullopt;
+  }
+
+  // Regions are not split, skip the end of the buffer if necessary
+  const std::size_t used = write_position_ - read_position_;
+  const std::size_t offset = write_position_ % capacity_;
+  const std::size_t padding =
+      (offset + size > capacity_) ? capacity_ - offset : 0;
+  if (used + padding + size > capacity_) {
+    ++failure_count_;
+    if (size <= capacity_ - live_bytes_) {
+      ++fragmentation_failure_count_;
+    }
+    return std::nullopt;
+  }
+
+  write_position_ += padding + size;
+  regions_.push_back({write_position_, size, padding, false});
+  live_bytes_ += size;
+  padding_bytes_ += padding;
+  ++allocation_count_;
+
+  return Allocation{(offset + padding) % capacity_, size,
+                    first_id_ + regions_.size() - 1};
+}
+
+void RingAllocator::release(const Allocation& allocation) {
+  if (allocation.size == 0) {
+    return;
+  }
+
+  assert(allocation.id >= first_id_ &&
+         allocation.id - first_id_ < regions_.size());
+  Region& region = regions_[allocation.id - first_id_];
+  assert(!region.released && region.size == allocation.size);
+  region.released = true;
+  ++released_count_;
+  live_bytes_ -= region.size;
+  blocked_bytes_ += region.size;
+
+  // Reclaim the space of all released regions at the read end
+  while (!regions_.empty() && regions_.front().released) {
+    const Region& front = regions_.front();
+    read_position_ = front.end;
+    blocked_bytes_ -= front.size;
+    padding_bytes_ -= front.padding;
+    --released_count_;
+    regions_.pop_front();
+    ++first_id_;
+  }
+
+  // Start over at offset 0 once the buffer is empty to avoid padding
+  if (regions_.empty()) {
+    read_position_ = 0;
+    write_position_ = 0;
+  }
+}
+
+RingAllocator::Statistics RingAllocator::statistics() const {
+  return {allocation_count_,
+          failure_count_,
+          fragmentation_failure_count_,
+          static_cast<std::size_t>(write_position_ - read_position_),
+          live_bytes_,
+          blocked_bytes_,
+          padding_bytes_};
+}
+
+double RingAllocator::fragmentation() const {
+  const std::size_t free_bytes = capacity_ - live_bytes_;
+  if (free_bytes == 0) {
+    return 0.0;
+  }
+  return 1.0 - static_cast<double>(max_allocation()) /
+                   static_cast<double>(free_bytes);
+}
+
+std::size_t RingAllocator::max_allocation() const {
+  const std::size_t used = write_position_ - read_position_;
+  if (used == 0) {
+    return capacity_;
+  }
+  if (used == capacity_) {
+    return 0;
+  }
+  const std::size_t write_offset = write_position_ % capacity_;
+  const std::size_t read_offset = read_position_ % capacity_;
+  if (write_offset < read_offset) {
+    return read_offset - write_offset;
+  }
+  return std::max(capacity_ - write_offset, read_offset);
+}
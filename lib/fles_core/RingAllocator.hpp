@@ -0,0 +1,95 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+/**
+ * \brief Allocator for contiguous regions in a buffer used as a ring.
+ *
+ * Regions are allocated in FIFO order at the write end of the ring. An
+ * allocation is never split: if it does not fit between the write position
+ * and the end of the buffer, the remainder is skipped and the region starts
+ * at offset 0 instead. Regions may be released in any order; the space of a
+ * released region is reused as soon as all older regions have been released
+ * as well. Both operations are O(1) (amortized).
+ *
+ * The allocator only manages offsets, it does not own the buffer memory.
+ */
+class RingAllocator {
+public:
+  /// A region of the buffer. A region of size 0 holds no memory.
+  struct Allocation {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    uint64_t id = 0; ///< Sequence number of the allocation
+  };
+
+  /// Allocator statistics, used for monitoring.
+  struct Statistics {
+    uint64_t allocation_count = 0; ///< successful allocations
+    uint64_t failure_count = 0;    ///< failed allocations
+    /// Failed allocations that would have succeeded without fragmentation
+    uint64_t fragmentation_failure_count = 0;
+    std::size_t used_bytes = 0;    ///< bytes between read and write position
+    std::size_t live_bytes = 0;    ///< bytes in regions not yet released
+    std::size_t blocked_bytes = 0; ///< bytes released, but not yet reusable
+    std::size_t padding_bytes = 0; ///< bytes skipped at the end of the buffer
+  };
+
+  /// Construct an allocator for a buffer of the given size.
+  explicit RingAllocator(std::size_t capacity) : capacity_(capacity) {}
+
+  /// Allocate a contiguous region (std::nullopt if there is no space).
+  [[nodiscard]] std::optional<Allocation> allocate(std::size_t size);
+
+  /// Release a region returned by allocate().
+  void release(const Allocation& allocation);
+
+  /// Retrieve the size of the managed buffer.
+  [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+  /// Retrieve the number of regions not yet released.
+  [[nodiscard]] std::size_t live_count() const {
+    return regions_.size() - released_count_;
+  }
+
+  /// Retrieve the current allocator statistics.
+  [[nodiscard]] Statistics statistics() const;
+
+  /// Retrieve the fraction of the buffer that is free, but not usable for
+  /// the largest possible allocation due to fragmentation (0.0 to 1.0).
+  [[nodiscard]] double fragmentation() const;
+
+  /// Retrieve the size of the largest region that can currently be allocated.
+  [[nodiscard]] std::size_t max_allocation() const;
+
+private:
+  struct Region {
+    uint64_t end;        ///< Ring position after the region
+    std::size_t size;    ///< Size of the region (excluding padding)
+    std::size_t padding; ///< Bytes skipped before the region
+    bool released;
+  };
+
+  std::size_t capacity_;
+
+  /// Outstanding regions in allocation order, starting with first_id_
+  std::deque<Region> regions_;
+  uint64_t first_id_ = 0;
+
+  /// Ring positions (in bytes, increasing monotonically while in use)
+  uint64_t read_position_ = 0;
+  uint64_t write_position_ = 0;
+
+  std::size_t released_count_ = 0;
+  std::size_t live_bytes_ = 0;
+  std::size_t blocked_bytes_ = 0;
+  std::size_t padding_bytes_ = 0;
+
+  uint64_t allocation_count_ = 0;
+  uint64_t failure_count_ = 0;
+  uint64_t fragmentation_failure_count_ = 0;
+};
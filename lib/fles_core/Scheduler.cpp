@@ -0,0 +1,170 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+Scheduler::Scheduler(clock::duration tick, std::size_t slot_count)
+    : tick_(tick), epoch_(clock::now()), slots_(slot_count, invalid_index) {
+  if (tick_ <= clock::duration::zero() || slot_count == 0) {
+    throw std::invalid_argument("invalid scheduler timer wheel geometry");
+  }
+}
+
+bool Scheduler::cancel(Handle& handle) {
+  const Handle h = std::exchange(handle, Handle());
+  if (!h.valid() || h.index_ >= nodes_.size()) {
+    return false;
+  }
+  Node& node = nodes_[h.index_];
+  if (node.generation != h.generation_ || node.state == NodeState::free) {
+    return false;
+  }
+  if (node.state == NodeState::linked) {
+    unlink(h.index_);
+  }
+  release_node(h.index_);
+  return true;
+}
+
+void Scheduler::timer() {
+  if (pending_count_ == 0) {
+    // Nothing to do, just keep up with the clock
+    next_tick_ = std::max(next_tick_, elapsed_ticks() + 1);
+    return;
+  }
+
+  // Process all ticks that have fully elapsed
+  const uint64_t now_tick = elapsed_ticks();
+  // An event due up to now is found in one revolution at the latest
+  if (now_tick >= next_tick_ + slots_.size()) {
+    next_tick_ = now_tick + 1 - slots_.size();
+  }
+  while (next_tick_ <= now_tick && pending_count_ != 0) {
+    const uint64_t tick = next_tick_++;
+    expire_slot(tick);
+  }
+  next_tick_ = std::max(next_tick_, now_tick + 1);
+}
+
+Scheduler::time_type Scheduler::when_next() const {
+  if (pending_count_ == 0) {
+    return time_type::max();
+  }
+  // Scan the slots in order of their tick until no earlier event can follow
+  uint64_t best = std::numeric_limits<uint64_t>::max();
+  for (uint64_t tick = next_tick_;
+       tick < next_tick_ + slots_.size() && tick < best; ++tick) {
+    for (uint32_t i = slots_[tick % slots_.size()]; i != invalid_index;
+         i = nodes_[i].next) {
+      best = std::min(best, nodes_[i].tick);
+    }
+  }
+  return time_of(best);
+}
+
+uint64_t Scheduler::elapsed_ticks() const {
+  return static_cast<uint64_t>((clock::now() - epoch_) / tick_);
+}
+
+uint64_t Scheduler::tick_of(const time_type& when) const {
+  if (when <= epoch_) {
+    return 0;
+  }
+  if (when == time_type::max()) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  // Round up, so that an event never fires early
+  const auto elapsed = when - epoch_;
+  return static_cast<uint64_t>(elapsed / tick_) +
+         static_cast<uint64_t>(elapsed % tick_ != clock::duration::zero());
+}
+
+Scheduler::time_type Scheduler::time_of(uint64_t tick) const {
+  const auto max_ticks =
+      static_cast<uint64_t>((time_type::max() - epoch_) / tick_);
+  if (tick >= max_ticks) {
+    return time_type::max();
+  }
+  return epoch_ + static_cast<clock::duration::rep>(tick) * tick_;
+}
+
+uint32_t Scheduler::acquire_node() {
+  uint32_t index = free_head_;
+  if (index != invalid_index) {
+    free_head_ = nodes_[index].next;
+  } else {
+    assert(nodes_.size() < invalid_index);
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  }
+  ++pending_count_;
+  return index;
+}
+
+void Scheduler::release_node(uint32_t index) {
+  Node& node = nodes_[index];
+  node.state = NodeState::free;
+  ++node.generation;
+  node.prev = invalid_index;
+  node.next = free_head_;
+  free_head_ = index;
+  --pending_count_;
+}
+
+void Scheduler::link(uint32_t index, uint64_t tick) {
+  // Events already due are executed at the next tick processed
+  tick = std::max(tick, next_tick_);
+  Node& node = nodes_[index];
+  uint32_t& head = slots_[tick % slots_.size()];
+  node.tick = tick;
+  node.state = NodeState::linked;
+  node.prev = invalid_index;
+  node.next = head;
+  if (head != invalid_index) {
+    nodes_[head].prev = index;
+  }
+  head = index;
+}
+
+void Scheduler::unlink(uint32_t index) {
+  Node& node = nodes_[index];
+  if (node.prev != invalid_index) {
+    nodes_[node.prev].next = node.next;
+  } else {
+    slots_[node.tick % slots_.size()] = node.next;
+  }
+  if (node.next != invalid_index) {
+    nodes_[node.next].prev = node.prev;
+  }
+  node.prev = invalid_index;
+  node.next = invalid_index;
+}
+
+void Scheduler::expire_slot(uint64_t tick) {
+  // Collect the due events first, as callbacks may add or cancel events
+  due_.clear();
+  uint32_t i = slots_[tick % slots_.size()];
+  while (i != invalid_index) {
+    const uint32_t next = nodes_[i].next;
+    if (nodes_[i].tick <= tick) {
+      unlink(i);
+      nodes_[i].state = NodeState::due;
+      due_.emplace_back(i, nodes_[i].generation);
+    }
+    i = next;
+  }
+  // The slot list is in reverse order of insertion
+  std::reverse(due_.begin(), due_.end());
+
+  for (std::size_t d = 0; d < due_.size(); ++d) {
+    const auto [index, generation] = due_[d];
+    if (nodes_[index].generation != generation) {
+      continue; // cancelled by a previous callback
+    }
+    Callback callback = nodes_[index].callback;
+    release_node(index);
+    callback();
+  }
+}
@@ -2,68 +2,125 @@
 #pragma once
 
 #include <chrono>
-#include <ctime>
-#include <functional>
-#include <queue>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
 #include <utility>
-
+#include <vector>
+
+/**
+ * \brief Timer for deferred tasks in an event loop (hashed timer wheel).
+ *
+ * Events are kept in a wheel of slots, one slot per tick of the steady
+ * clock, so adding, cancelling, and expiring an event are O(1). Events due
+ * more than one revolution ahead share a slot with earlier ones and are
+ * skipped until their time has come. An event never fires before its due
+ * time, but up to one tick later (or whenever timer() is called next).
+ *
+ * Callbacks are stored inline, so they must be small and trivially copyable
+ * (e.g., a lambda capturing `this` and an id). Event nodes are reused, so
+ * adding an event does not allocate once the pool has grown to the maximum
+ * number of pending events.
+ */
 class Scheduler {
 public:
-  struct event {
-    using callback_type = std::function<void()>;
-    using time_type = std::chrono::time_point<std::chrono::system_clock>;
-
-    event(callback_type cb, const time_type& when)
-        : callback_(std::move(cb)), when_(when) {}
-
-    void operator()() const { callback_(); }
-
-    callback_type callback_;
-    time_type when_;
+  using clock = std::chrono::steady_clock;
+  using time_type = clock::time_point;
+
+  /// Reference to a pending event, used to cancel it.
+  class Handle {
+  public:
+    Handle() = default;
+    [[nodiscard]] bool valid() const { return index_ != invalid_index; }
+
+  private:
+    friend class Scheduler;
+    Handle(uint32_t index, uint32_t generation)
+        : index_(index), generation_(generation) {}
+
+    uint32_t index_ = invalid_index;
+    uint32_t generation_ = 0;
   };
 
-  struct event_less : public std::less<> {
-    bool operator()(const event& e1, const event& e2) const {
-      return (e2.when_ < e1.when_);
-    }
-  };
-
-  void add(const event::callback_type& cb, const time_t& when) {
-    auto real_when = std::chrono::system_clock::from_time_t(when);
+  explicit Scheduler(clock::duration tick = std::chrono::milliseconds(1),
+                     std::size_t slot_count = 1024);
 
-    event_queue_.emplace(cb, real_when);
+  /// Add an event to be executed at the given time.
+  template <typename F> Handle add(F&& callback, const time_type& when) {
+    const uint32_t index = acquire_node();
+    nodes_[index].callback.assign(std::forward<F>(callback));
+    link(index, tick_of(when));
+    return {index, nodes_[index].generation};
   }
 
-  void add(const event::callback_type& cb, const timeval& when) {
-    auto real_when = std::chrono::system_clock::from_time_t(when.tv_sec) +
-                     std::chrono::microseconds(when.tv_usec);
+  /// Cancel a pending event. Returns false if the event has already been
+  /// executed or cancelled. The handle is reset in any case.
+  bool cancel(Handle& handle);
 
-    event_queue_.emplace(cb, real_when);
-  }
+  /// Execute all events that are due.
+  void timer();
 
-  void add(const event::callback_type& cb,
-           const std::chrono::time_point<std::chrono::system_clock>& when) {
-    event_queue_.emplace(cb, when);
-  }
+  [[nodiscard]] bool empty() const { return pending_count_ == 0; }
+  [[nodiscard]] std::size_t size() const { return pending_count_; }
 
-  void timer() {
-    event::time_type now = std::chrono::system_clock::now();
+  /// Retrieve the time of the next pending event (time_type::max() if none).
+  [[nodiscard]] time_type when_next() const;
 
-    while (!event_queue_.empty() && (event_queue_.top().when_ <= now)) {
-      event_queue_.top()();
-      event_queue_.pop();
+private:
+  static constexpr uint32_t invalid_index =
+      std::numeric_limits<uint32_t>::max();
+
+  // Allocation-free storage for a small, trivially copyable callable
+  class Callback {
+  public:
+    template <typename F> void assign(F&& f) {
+      using T = std::decay_t<F>;
+      static_assert(sizeof(T) <= sizeof(storage_) &&
+                        alignof(T) <= alignof(std::max_align_t),
+                    "Scheduler callback too large");
+      static_assert(std::is_trivially_copyable_v<T> &&
+                        std::is_trivially_destructible_v<T>,
+                    "Scheduler callback must be trivially copyable");
+      ::new (static_cast<void*>(storage_)) T(std::forward<F>(f));
+      invoke_ = [](void* p) { (*std::launder(static_cast<T*>(p)))(); };
     }
-  }
 
-  [[nodiscard]] bool empty() const { return event_queue_.empty(); }
+    void operator()() { invoke_(storage_); }
 
-  [[nodiscard]] event::time_type when_next() const {
-    if (event_queue_.empty()) {
-      return std::chrono::time_point<std::chrono::system_clock>::max();
-    }
-    return event_queue_.top().when_;
-  }
+  private:
+    alignas(std::max_align_t) unsigned char storage_[4 * sizeof(void*)];
+    void (*invoke_)(void*) = nullptr;
+  };
 
-private:
-  std::priority_queue<event, std::vector<event>, event_less> event_queue_;
+  enum class NodeState : uint8_t { free, linked, due };
+
+  struct Node {
+    Callback callback;
+    uint64_t tick = 0;
+    uint32_t prev = invalid_index;
+    uint32_t next = invalid_index;
+    uint32_t generation = 0;
+    NodeState state = NodeState::free;
+  };
+
+  [[nodiscard]] uint64_t elapsed_ticks() const;
+  [[nodiscard]] uint64_t tick_of(const time_type& when) const;
+  [[nodiscard]] time_type time_of(uint64_t tick) const;
+
+  uint32_t acquire_node();
+  void release_node(uint32_t index);
+  void link(uint32_t index, uint64_t tick);
+  void unlink(uint32_t index);
+  void expire_slot(uint64_t tick);
+
+  clock::duration tick_;
+  time_type epoch_;
+  uint64_t next_tick_ = 0; ///< first tick not yet processed
+  std::vector<uint32_t> slots_;
+  std::vector<Node> nodes_;
+  uint32_t free_head_ = invalid_index;
+  std::size_t pending_count_ = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> due_; ///< (index, generation)
 };
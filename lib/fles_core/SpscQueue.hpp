@@ -0,0 +1,118 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Bounded lock-free single-producer/single-consumer queue.
+ *
+ * The slots are allocated once and reused. The producer fills the next free
+ * slot in place (back(), then push()), the consumer processes the oldest slot
+ * in place (front(), then pop()). For element types that own memory (like
+ * vectors), assigning to a reused slot does not allocate once the slot has
+ * grown to the required capacity.
+ */
+template <typename T> class SpscQueue {
+public:
+  /// Construct a queue with the given capacity (rounded up to a power of two).
+  explicit SpscQueue(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// Producer: retrieve the next free slot (nullptr if the queue is full).
+  T* back() {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == slots_.size()) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == slots_.size()) {
+        return nullptr;
+      }
+    }
+    return &slots_[tail & mask_];
+  }
+
+  /// Producer: publish the slot filled after a successful call to back().
+  void push() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  /// Producer: append a copy of the given value (false if the queue is full).
+  template <typename U> bool try_push(U&& value) {
+    T* slot = back();
+    if (slot == nullptr) {
+      return false;
+    }
+    *slot = std::forward<U>(value);
+    push();
+    return true;
+  }
+
+  /// Consumer: retrieve the oldest element (nullptr if the queue is empty).
+  T* front() {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return nullptr;
+      }
+    }
+    return &slots_[head & mask_];
+  }
+
+  /// Consumer: release the slot after a successful call to front().
+  void pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  /// Consumer: remove the oldest element (false if the queue is empty).
+  bool try_pop(T& value) {
+    T* slot = front();
+    if (slot == nullptr) {
+      return false;
+    }
+    value = std::move(*slot);
+    pop();
+    return true;
+  }
+
+  /// Retrieve the number of elements (only approximate if used concurrently).
+  [[nodiscard]] std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  /// Retrieve the maximum number of elements.
+  [[nodiscard]] std::size_t capacity() const { return slots_.size(); }
+
+private:
+  static constexpr std::size_t cache_line_size = 64;
+
+  std::vector<T> slots_;
+  std::size_t mask_ = 0;
+
+  // Consumer side (on its own cache line)
+  /// Index of the next slot to read
+  alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+  /// The consumer's copy of tail_, updated only if the queue seems empty
+  std::size_t tail_cache_ = 0;
+
+  // Producer side (on its own cache line)
+  /// Index of the next slot to write
+  alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+  /// The producer's copy of head_, updated only if the queue seems full
+  std::size_t head_cache_ = 0;
+};
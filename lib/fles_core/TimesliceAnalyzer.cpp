@@ -1,4 +1,4 @@
-// Copyright 2013, 2015, 2021, 2023 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2013, 2015, 2021, 2023, 2025 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceAnalyzer.hpp"
 #include "MicrosliceDescriptor.hpp"
@@ -8,7 +8,6 @@
 #include "Timeslice.hpp"
 #include "TimesliceDebugger.hpp"
 #include "Utility.hpp"
-#include "interface.h"
 #include <boost/algorithm/string/split.hpp>
 #include <boost/format.hpp>
 #include <boost/format/free_funcs.hpp>
@@ -62,24 +61,30 @@ TimesliceAnalyzer::TimesliceAnalyzer(uint64_t arg_output_interval,
                                      std::ostream& arg_out,
                                      std::string arg_output_prefix,
                                      std::ostream* arg_hist,
-                                     cbm::Monitor* monitor)
+                                     cbm::Monitor* monitor,
+                                     size_t num_threads)
     : output_interval_(arg_output_interval), out_(arg_out),
       output_prefix_(std::move(arg_output_prefix)), hist_(arg_hist),
       previous_output_time_(std::chrono::system_clock::now()),
       monitor_(monitor) {
-  // create CRC-32C engine (Castagnoli polynomial)
-  crc32_engine_ = crcutil_interface::CRC::Create(
-      0x82f63b78, 0, 32, true, 0, 0, 0,
-      crcutil_interface::CRC::IsSSE42Available(), nullptr);
-
   hostname_ = fles::system::current_hostname();
 
+  // The calling thread takes part in the analysis
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers_.emplace_back(&TimesliceAnalyzer::worker_loop, this);
+  }
+
   report_status();
 }
 
 TimesliceAnalyzer::~TimesliceAnalyzer() {
-  if (crc32_engine_ != nullptr) {
-    crc32_engine_->Delete();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
   }
 }
 
@@ -177,9 +182,25 @@ bool TimesliceAnalyzer::check_timeslice(const fles::Timeslice& ts) {
   }
 
   // check the individual timeslice components
+  check_components(ts);
+
+  // merge the component results in order, filtering the messages as if the
+  // components had been checked sequentially
   for (size_t c = 0; c < ts.num_components(); ++c) {
-    bool component_success = check_component(ts, c);
-    if (!component_success) {
+    ComponentResult& r = component_results_[c];
+    for (const auto& message : r.messages) {
+      if (output_active(message.microslice_errors)) {
+        print(message.text, message.prefix);
+      }
+    }
+    if (hist_ != nullptr) {
+      *hist_ << r.hist.str();
+    }
+    ++component_count_;
+    microslice_count_ += r.microslice_count;
+    microslice_error_count_ += r.microslice_error_count;
+    content_bytes_ += r.content_bytes;
+    if (!r.success) {
       ++component_error_count_;
       ts_success = false;
     }
@@ -188,25 +209,81 @@ bool TimesliceAnalyzer::check_timeslice(const fles::Timeslice& ts) {
   return ts_success;
 }
 
-bool TimesliceAnalyzer::check_component(const fles::Timeslice& ts, size_t c) {
-  ++component_count_;
-  bool component_success = true;
+void TimesliceAnalyzer::check_components(const fles::Timeslice& ts) {
+  component_results_.clear();
+  component_results_.resize(ts.num_components());
+  next_component_ = 0;
+
+  if (workers_.empty() || ts.num_components() < 2) {
+    check_next_components(ts);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ts_ = &ts;
+    ++generation_;
+    busy_workers_ = workers_.size();
+  }
+  work_cv_.notify_all();
+  check_next_components(ts);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+  current_ts_ = nullptr;
+}
+
+void TimesliceAnalyzer::check_next_components(const fles::Timeslice& ts) {
+  for (size_t c = next_component_++; c < ts.num_components();
+       c = next_component_++) {
+    check_component(ts, c, component_results_[c]);
+  }
+}
+
+void TimesliceAnalyzer::worker_loop() {
+  uint64_t generation = 0;
+  for (;;) {
+    const fles::Timeslice* ts = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_cv_.wait(lock,
+                    [&] { return stopping_ || generation_ != generation; });
+      if (stopping_) {
+        return;
+      }
+      generation = generation_;
+      ts = current_ts_;
+    }
+    check_next_components(*ts);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--busy_workers_ == 0) {
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
 
+// Checks a single component, possibly concurrently to other components. Only
+// state of this component is modified, all output goes to the result.
+void TimesliceAnalyzer::check_component(const fles::Timeslice& ts,
+                                        size_t c,
+                                        ComponentResult& r) {
   if (ts.num_microslices(c) == 0) {
-    if (output_active()) {
+    if (output_active(r.microslice_error_count)) {
       auto location = location_string(ts.index(), c);
-      print("error in " + location + ": no microslices in component");
+      print(r, "error in " + location + ": no microslices in component");
     }
-    component_success = false;
+    r.success = false;
   }
 
   // check the individual microslices of the component
   pattern_checkers_.at(c)->reset();
   for (size_t m = 0; m < ts.num_microslices(c); ++m) {
-    bool microslice_success = check_microslice(ts, c, m);
+    bool microslice_success = check_microslice(ts, c, m, r);
     if (!microslice_success) {
-      ++microslice_error_count_;
-      component_success = false;
+      ++r.microslice_error_count;
+      r.success = false;
     }
   }
 
@@ -215,104 +292,109 @@ bool TimesliceAnalyzer::check_component(const fles::Timeslice& ts, size_t c) {
     uint64_t first = ts.get_microslice(c, 0).desc().idx;
     uint64_t second = ts.get_microslice(c, 1).desc().idx;
     if (second <= first) {
-      if (output_active()) {
+      if (output_active(r.microslice_error_count)) {
         auto location = location_string(ts.index(), c);
-        print("error in " + location +
-              ": start time not increasing in first two microslices");
-        print_microslice_descriptor(ts, c, 0);
-        print_microslice_descriptor(ts, c, 1);
+        print(r, "error in " + location +
+                     ": start time not increasing in first two microslices");
+        print_microslice_descriptor(r, ts, c, 0);
+        print_microslice_descriptor(r, ts, c, 1);
       }
-      component_success = false;
+      r.success = false;
     } else {
       uint64_t reference_delta = second - first;
       for (size_t m = 2; m < ts.num_microslices(c); ++m) {
         uint64_t this_start_time = ts.get_microslice(c, m).desc().idx;
         uint64_t expected_start_time = first + m * reference_delta;
         if (this_start_time != expected_start_time) {
-          if (output_active()) {
+          if (output_active(r.microslice_error_count)) {
             auto location = location_string(ts.index(), c, m);
-            print("error in " + location +
-                  ": unexpected microslice start time");
-            print_microslice_descriptor(ts, c, 0);
-            print_microslice_descriptor(ts, c, 1);
-            print_microslice_descriptor(ts, c, m);
+            print(r, "error in " + location +
+                         ": unexpected microslice start time");
+            print_microslice_descriptor(r, ts, c, 0);
+            print_microslice_descriptor(r, ts, c, 1);
+            print_microslice_descriptor(r, ts, c, m);
           }
-          component_success = false;
+          r.success = false;
         }
       }
     }
   }
-
-  return component_success;
 }
 
 bool TimesliceAnalyzer::check_microslice(const fles::Timeslice& ts,
                                          size_t c,
-                                         size_t m) {
+                                         size_t m,
+                                         ComponentResult& r) {
   auto mv = ts.get_microslice(c, m);
   const auto& d = mv.desc();
 
-  ++microslice_count_;
-  content_bytes_ += d.size;
+  ++r.microslice_count;
+  r.content_bytes += d.size;
   bool error = false;
+  // messages are only possible as long as the error limit is not reached
+  const bool output = output_active(r.microslice_error_count);
 
   // static descriptor checks
   if (d.hdr_id != 0xdd || d.hdr_ver != 0x01) {
     error = true;
-    if (output_active()) {
+    if (output) {
       auto location = location_string(ts.index(), c, m);
-      print("error in " + location +
-            ": unknown header format in microslice descriptor");
-      print_microslice_descriptor(ts, c, m);
+      print(r, "error in " + location +
+                   ": unknown header format in microslice descriptor");
+      print_microslice_descriptor(r, ts, c, m);
     }
   }
 
   // check descriptor consistency
-  auto r = reference_descriptors_.at(c);
-  if (d.eq_id != r.eq_id || d.sys_id != r.sys_id || d.sys_ver != r.sys_ver) {
+  const auto& ref = reference_descriptors_.at(c);
+  if (d.eq_id != ref.eq_id || d.sys_id != ref.sys_id ||
+      d.sys_ver != ref.sys_ver) {
     error = true;
-    if (output_active()) {
+    if (output) {
       auto location = location_string(ts.index(), c, m);
-      print("error in " + location +
-            ": unexpected change in microslice descriptor");
-      print_microslice_descriptor(ts, c, m);
+      print(r, "error in " + location +
+                   ": unexpected change in microslice descriptor");
+      print_microslice_descriptor(r, ts, c, m);
     }
   }
 
   bool truncated =
       (d.flags & static_cast<uint16_t>(fles::MicrosliceFlags::OverflowFlim)) !=
       0;
-  if (truncated && output_active()) {
+  if (truncated && output) {
     auto location = location_string(ts.index(), c, m);
-    print("error in " + location + ": microslice truncated by FLIM");
-    print_microslice_descriptor(ts, c, m);
-    print_microslice_content(ts, c, m);
+    print(r, "error in " + location + ": microslice truncated by FLIM");
+    print_microslice_descriptor(r, ts, c, m);
+    print_microslice_content(r, ts, c, m);
   }
 
-  bool pattern_error = !pattern_checkers_.at(c)->check(mv);
-  if (pattern_error && output_active()) {
+  // the CRC is computed in the same pass as the pattern check
+  const bool crc_valid =
+      (d.flags & static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0;
+  uint32_t crc = 0;
+  auto& pattern_checker = *pattern_checkers_.at(c);
+  bool pattern_error = crc_valid ? !pattern_checker.check_with_crc(mv, crc)
+                                 : !pattern_checker.check(mv);
+  if (pattern_error && output) {
     auto location = location_string(ts.index(), c, m);
-    print("error in " + location + ": pattern error");
-    print_microslice_descriptor(ts, c, m);
-    print_microslice_content(ts, c, m);
+    print(r, "error in " + location + ": pattern error");
+    print_microslice_descriptor(r, ts, c, m);
+    print_microslice_content(r, ts, c, m);
   }
 
-  bool crc_error =
-      ((d.flags & static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) !=
-       0) &&
-      !check_crc(mv);
-  if (crc_error && output_active()) {
+  bool crc_error = crc_valid && crc != d.crc;
+  if (crc_error && output) {
     auto location = location_string(ts.index(), c, m);
-    print("error in " + location + ": crc failure");
-    print_microslice_descriptor(ts, c, m);
-    print_microslice_content(ts, c, m);
+    print(r, "error in " + location + ": crc failure");
+    print_microslice_descriptor(r, ts, c, m);
+    print_microslice_content(r, ts, c, m);
   }
 
   error |= truncated || pattern_error || crc_error;
 
   // output ms stats
   if (hist_ != nullptr) {
-    *hist_ << c << " " << m << " " << d.eq_id << " " << d.flags << " "
+    r.hist << c << " " << m << " " << d.eq_id << " " << d.flags << " "
            << uint16_t(d.sys_id) << " " << uint16_t(d.sys_ver) << " " << d.idx
            << " " << d.size << " " << truncated << " " << pattern_error << " "
            << crc_error << "\n";
@@ -321,19 +403,6 @@ bool TimesliceAnalyzer::check_microslice(const fles::Timeslice& ts,
   return !error;
 }
 
-uint32_t TimesliceAnalyzer::compute_crc(const fles::MicrosliceView& m) const {
-  assert(crc32_engine_);
-
-  crcutil_interface::UINT64 crc64 = 0;
-  crc32_engine_->Compute(m.content(), m.desc().size, &crc64);
-
-  return static_cast<uint32_t>(crc64);
-}
-
-bool TimesliceAnalyzer::check_crc(const fles::MicrosliceView& m) const {
-  return compute_crc(m) == m.desc().crc;
-}
-
 void TimesliceAnalyzer::print(std::string text, const std::string& prefix) {
   if (text.back() == '\n') {
     text.erase(text.end() - 1);
@@ -345,6 +414,13 @@ void TimesliceAnalyzer::print(std::string text, const std::string& prefix) {
   }
 }
 
+void TimesliceAnalyzer::print(ComponentResult& r,
+                              std::string text,
+                              std::string prefix) {
+  r.messages.push_back(
+      {r.microslice_error_count, std::move(text), std::move(prefix)});
+}
+
 void TimesliceAnalyzer::print_reference() {
   print("timeslice analyzer initialized with " +
         std::to_string(reference_descriptors_.size()) + " components");
@@ -360,22 +436,26 @@ void TimesliceAnalyzer::print_reference() {
   }
 }
 
-void TimesliceAnalyzer::print_microslice_descriptor(const fles::Timeslice& ts,
+void TimesliceAnalyzer::print_microslice_descriptor(ComponentResult& r,
+                                                    const fles::Timeslice& ts,
                                                     size_t c,
-                                                    size_t m) {
+                                                    size_t m) const {
   auto location = location_string(ts.index(), c, m);
-  print("microslice descriptor of " + location + ":");
-  print(boost::str(boost::format("%s") %
+  print(r, "microslice descriptor of " + location + ":");
+  print(r,
+        boost::str(boost::format("%s") %
                    MicrosliceDescriptorDump(ts.get_microslice(c, m).desc())),
         "  ");
 }
 
-void TimesliceAnalyzer::print_microslice_content(const fles::Timeslice& ts,
+void TimesliceAnalyzer::print_microslice_content(ComponentResult& r,
+                                                 const fles::Timeslice& ts,
                                                  size_t c,
-                                                 size_t m) {
+                                                 size_t m) const {
   auto location = location_string(ts.index(), c, m);
-  print("microslice content of " + location + ":");
-  print(boost::str(boost::format("%s") %
+  print(r, "microslice content of " + location + ":");
+  print(r,
+        boost::str(boost::format("%s") %
                    BufferDump(ts.get_microslice(c, m).content(),
                               ts.get_microslice(c, m).desc().size)),
         "  ");
@@ -405,15 +485,17 @@ std::string TimesliceAnalyzer::location_string(size_t ts,
   return boost::str(boost::format("ts%d") % ts);
 }
 
-bool TimesliceAnalyzer::output_active() const {
+// Determine whether error messages are printed, given the number of
+// microslice errors not yet accounted for in the counters
+bool TimesliceAnalyzer::output_active(size_t pending_microslice_errors) const {
   constexpr size_t limit = 10;
   return timeslice_error_count_ < limit && component_error_count_ < limit &&
-         microslice_error_count_ < limit;
+         microslice_error_count_ + pending_microslice_errors < limit;
 }
 
 void TimesliceAnalyzer::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
-  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  Scheduler::time_type now = Scheduler::clock::now();
 
   if (monitor_ != nullptr) {
     const std::string prefix = output_prefix_.empty() ? ":" : output_prefix_;
@@ -6,27 +6,60 @@
 #include "Scheduler.hpp"
 #include "Sink.hpp"
 #include "Timeslice.hpp"
-#include "interface.h" // crcutil_interface
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 class PatternChecker;
 
+/**
+ * \brief Timeslice sink checking the consistency of the timeslice data.
+ *
+ * With more than one thread, the components of a timeslice are checked in
+ * parallel. The results of each component (counters, messages, and histogram
+ * data) are collected separately and merged in component order, so the
+ * output is identical to that of the single-threaded analysis.
+ */
 class TimesliceAnalyzer : public fles::TimesliceSink {
 public:
   TimesliceAnalyzer(uint64_t arg_output_interval,
                     std::ostream& arg_out,
                     std::string arg_output_prefix,
                     std::ostream* arg_hist,
-                    cbm::Monitor* monitor);
+                    cbm::Monitor* monitor,
+                    size_t num_threads = 1);
   ~TimesliceAnalyzer() override;
 
   void put(std::shared_ptr<const fles::Timeslice> timeslice) override;
 
 private:
+  /// A line of output, deferred until the component results are merged
+  struct Message {
+    /// The number of microslice errors in the component before the message
+    size_t microslice_errors;
+    std::string text;
+    std::string prefix;
+  };
+
+  /// The result of checking a single timeslice component
+  struct ComponentResult {
+    bool success = true;
+    size_t microslice_count = 0;
+    size_t microslice_error_count = 0;
+    size_t content_bytes = 0;
+    std::vector<Message> messages;
+    std::ostringstream hist;
+  };
+
   void initialize(const fles::Timeslice& ts);
   void reset() {
     microslice_count_ = 0;
@@ -34,18 +67,27 @@ private:
   }
 
   [[nodiscard]] bool check_timeslice(const fles::Timeslice& ts);
-  [[nodiscard]] bool check_component(const fles::Timeslice& ts, size_t c);
-  [[nodiscard]] bool
-  check_microslice(const fles::Timeslice& ts, size_t c, size_t m);
-
-  [[nodiscard]] uint32_t compute_crc(const fles::MicrosliceView& m) const;
-  [[nodiscard]] bool check_crc(const fles::MicrosliceView& m) const;
+  void check_components(const fles::Timeslice& ts);
+  void check_next_components(const fles::Timeslice& ts);
+  void check_component(const fles::Timeslice& ts, size_t c, ComponentResult& r);
+  [[nodiscard]] bool check_microslice(const fles::Timeslice& ts,
+                                      size_t c,
+                                      size_t m,
+                                      ComponentResult& r);
+  void worker_loop();
 
   void print(std::string text, const std::string& prefix = "");
+  static void
+  print(ComponentResult& r, std::string text, std::string prefix = "");
   void print_reference();
-  void
-  print_microslice_descriptor(const fles::Timeslice& ts, size_t c, size_t m);
-  void print_microslice_content(const fles::Timeslice& ts, size_t c, size_t m);
+  void print_microslice_descriptor(ComponentResult& r,
+                                   const fles::Timeslice& ts,
+                                   size_t c,
+                                   size_t m) const;
+  void print_microslice_content(ComponentResult& r,
+                                const fles::Timeslice& ts,
+                                size_t c,
+                                size_t m) const;
 
   [[nodiscard]] std::string statistics() const;
 
@@ -54,9 +96,7 @@ private:
                   std::optional<size_t> c = std::nullopt,
                   std::optional<size_t> m = std::nullopt) const;
 
-  [[nodiscard]] bool output_active() const;
-
-  crcutil_interface::CRC* crc32_engine_ = nullptr;
+  [[nodiscard]] bool output_active(size_t pending_microslice_errors = 0) const;
 
   uint64_t start_index_ = 0;
   std::vector<fles::MicrosliceDescriptor> reference_descriptors_;
@@ -84,4 +124,16 @@ private:
   std::string hostname_;
 
   Scheduler scheduler_;
+
+  // Parallel component analysis
+  std::vector<ComponentResult> component_results_;
+  std::atomic<size_t> next_component_{0};
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  const fles::Timeslice* current_ts_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t busy_workers_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
 };
@@ -36,7 +36,11 @@ constexpr const char* ArchiveTypeToString(ArchiveType e) noexcept {
 }
 
 /// The archive compression enum
-enum class ArchiveCompression { None, Zstd };
+//
+// Zstd compresses the whole stream of data sets following the archive
+// descriptor. ZstdComponents compresses the content of each timeslice
+// component separately (see fles::CompressedTimeslice).
+enum class ArchiveCompression { None, Zstd, ZstdComponents };
 
 constexpr const char*
 ArchiveCompressionToString(ArchiveCompression e) noexcept {
@@ -45,6 +49,8 @@ ArchiveCompressionToString(ArchiveCompression e) noexcept {
     return "none";
   case ArchiveCompression::Zstd:
     return "zstd";
+  case ArchiveCompression::ZstdComponents:
+    return "zstd-components";
   default:
     return "unknown compression type";
   }
@@ -52,6 +58,7 @@ ArchiveCompressionToString(ArchiveCompression e) noexcept {
 
 template <class Base, class Derived, ArchiveType archive_type>
 class InputArchive;
+class TimesliceMappedInputArchive;
 
 /**
  * \brief The ArchiveDescriptor class contains metadata on an archive.
@@ -103,6 +110,7 @@ private:
   friend class InputArchiveLoop;
   template <class Base, class Derived, ArchiveType archive_type>
   friend class InputArchiveSequence;
+  friend class TimesliceMappedInputArchive;
 
   ArchiveDescriptor() = default;
 
@@ -0,0 +1,68 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "ArchiveIndex.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <functional>
+
+namespace fles {
+
+std::optional<std::vector<uint64_t>>
+ArchiveIndex::read(const std::string& archive_file) {
+  const std::string index_file = filename(archive_file);
+  std::ifstream ifs(index_file, std::ios::binary);
+  if (!ifs) {
+    return std::nullopt;
+  }
+
+  std::array<char, sizeof(signature)> header{};
+  if (!ifs.read(header.data(), header.size()) ||
+      !std::equal(header.begin(), header.end(), std::begin(signature))) {
+    L_(warning) << "Ignoring invalid archive index file \"" << index_file
+                << "\"";
+    return std::nullopt;
+  }
+
+  std::vector<uint64_t> offsets;
+  uint64_t offset = 0;
+  while (ifs.read(reinterpret_cast<char*>(&offset), sizeof(offset))) {
+    offsets.push_back(offset);
+  }
+
+  // Reject an index that does not match the archive file (e.g., if the
+  // archive has been rewritten without an index)
+  std::error_code ec;
+  auto archive_size = std::filesystem::file_size(archive_file, ec);
+  bool increasing = std::adjacent_find(offsets.begin(), offsets.end(),
+                                       std::greater_equal<>()) == offsets.end();
+  if (ec || !increasing ||
+      (!offsets.empty() && offsets.back() >= archive_size)) {
+    L_(warning) << "Ignoring archive index file \"" << index_file
+                << "\" not matching the archive file";
+    return std::nullopt;
+  }
+
+  return offsets;
+}
+
+ArchiveIndexWriter::ArchiveIndexWriter(const std::string& archive_file)
+    : ofstream_(ArchiveIndex::filename(archive_file), std::ios::binary) {
+  if (!ofstream_) {
+    throw std::ios_base::failure("error creating file \"" +
+                                 ArchiveIndex::filename(archive_file) + "\"");
+  }
+  ofstream_.write(ArchiveIndex::signature, sizeof(ArchiveIndex::signature));
+}
+
+void ArchiveIndexWriter::add(uint64_t offset) {
+  ofstream_.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+}
+
+void ArchiveIndexWriter::remove(const std::string& archive_file) {
+  std::error_code ec;
+  std::filesystem::remove(ArchiveIndex::filename(archive_file), ec);
+}
+
+} // namespace fles
@@ -0,0 +1,84 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::ArchiveIndex and fles::ArchiveIndexWriter classes.
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The ArchiveIndex class provides access to the index of an archive
+ * file.
+ *
+ * The index is stored in a sidecar file next to the archive file (not
+ * supported for archives compressed as a whole stream). It contains the byte
+ * offset of each serialized data set in the archive file, allowing random
+ * access without deserializing the preceding data sets.
+ *
+ * File format: the 8-byte signature "flesidx1", followed by one 64-bit
+ * offset (host byte order) per data set.
+ */
+class ArchiveIndex {
+public:
+  /// Retrieve the file name of the index belonging to an archive file.
+  [[nodiscard]] static std::string filename(const std::string& archive_file) {
+    return archive_file + ".idx";
+  }
+
+  /**
+   * \brief Read the index of the given archive file.
+   *
+   * \return the offsets of the data sets, or std::nullopt if there is no
+   * (valid) index file
+   */
+  [[nodiscard]] static std::optional<std::vector<uint64_t>>
+  read(const std::string& archive_file);
+
+  /// The signature at the start of each index file.
+  static constexpr char signature[8] = {'f', 'l', 'e', 's',
+                                        'i', 'd', 'x', '1'};
+};
+
+/**
+ * \brief The ArchiveIndexWriter class writes the index of an archive file
+ * while the archive is being written.
+ */
+class ArchiveIndexWriter {
+public:
+  /// Create (or truncate) the index file belonging to an archive file.
+  explicit ArchiveIndexWriter(const std::string& archive_file);
+
+  /// Delete copy constructor (non-copyable).
+  ArchiveIndexWriter(const ArchiveIndexWriter&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const ArchiveIndexWriter&) = delete;
+
+  /// Append the offset of the next data set.
+  void add(uint64_t offset);
+
+  /// Remove a (possibly stale) index file belonging to an archive file.
+  static void remove(const std::string& archive_file);
+
+private:
+  std::ofstream ofstream_;
+};
+
+/**
+ * \brief Check whether all boost serialization class information has been
+ * written to the archive after a given data set.
+ *
+ * Class information precedes the first occurrence of each class type in an
+ * archive. A reader can only seek to an indexed position after having
+ * deserialized the data sets containing all of it. By default, this is the
+ * case after the first data set.
+ */
+template <class T> bool completes_class_info(const T& /* item */) {
+  return true;
+}
+
+} // namespace fles
@@ -5,14 +5,17 @@
 
 #include "AggregatingSource.hpp"
 #include "ArchiveDescriptor.hpp"
+#include "ComponentSelection.hpp"
 #include "InputArchive.hpp"
 #include "InputArchiveLoop.hpp"
 #include "InputArchiveSequence.hpp"
 #include "ItemWorkerProtocol.hpp"
 #include "MergingSource.hpp"
+#include "PrefetchingSource.hpp"
 #include "Source.hpp"
 #include "Subscriber.hpp"
 #include "System.hpp"
+#include "TimesliceMappedInputArchive.hpp"
 #include "TimesliceReceiver.hpp"
 #include "Utility.hpp"
 
@@ -50,6 +53,17 @@ namespace fles {
  * POSIX glob() function. It may also contain the special string `"%%n"` as a
  * placeholder for the file sequence number (starting at `"0000"`) as generated
  * by the OutputArchiveSequence class.
+ * - For timeslice archives, the query parameter `components=LIST` restricts
+ * the timeslice components to read to the given subsystem (and equipment)
+ * identifiers, see parse_component_selection(). In archives with
+ * per-component compression, the other components are not decompressed.
+ * - For file locators, the query parameter `prefetch=N` wraps the resulting
+ * sources in PrefetchingSource objects, which read up to N items ahead in a
+ * background thread.
+ * - For timeslice archives, the query parameter `mmap=1` selects a
+ * TimesliceMappedInputArchive for each (uncompressed) file locator instead of
+ * a deserializing source. It does not support the `"%%n"` placeholder or the
+ * `cycles` parameter.
  * - Glob patterns in the filepath are expanded at initialization, resulting in
  * a list of filepaths. If the original filepath contains a `"%%n"` placeholder,
  * a separate InputArchiveSequence instance is created for each
@@ -67,6 +81,8 @@ namespace fles {
  * 5. AutoSource("example_node?_%n.tsa")
  * 6. AutoSource({"example0.tsa", "example1.tsa"})
  * 7. AutoSource("{example0.tsa,example1.tsa}")
+ * 8. AutoSource("file://example.tsa?mmap=1")
+ * 9. AutoSource("file://example_%n.tsa?prefetch=8")
  * \endcode
  *
  * These examples will result in the creation of the following objects:
@@ -79,6 +95,8 @@ namespace fles {
  *    `"?"` wildcard expands to more than one instance)
  * 6. A MergingSource containing two InputArchive objects
  * 7. A single InputArchiveSequence
+ * 8. A single TimesliceMappedInputArchive
+ * 9. A PrefetchingSource containing a single InputArchiveSequence
 
  */
 template <class Base, class Storable, class View, ArchiveType archive_type>
@@ -137,9 +155,25 @@ private:
 
       if (uri.scheme == "file" || uri.scheme.empty()) {
         uint64_t cycles = 1;
+        bool mmap = false;
+        std::size_t prefetch = 0;
+        ComponentSelection selection;
+        std::size_t first_source = sources.size();
         for (auto& [key, value] : uri.query_components) {
           if (key == "cycles") {
             cycles = stoull(value);
+          } else if (key == "mmap") {
+            mmap = (value != "0");
+          } else if (key == "prefetch") {
+            prefetch = stoull(value);
+          } else if (key == "components") {
+            if constexpr (archive_type != ArchiveType::TimesliceArchive) {
+              throw std::runtime_error(
+                  std::string("query parameter components not supported for "
+                              "archive type ") +
+                  ArchiveTypeToString(archive_type));
+            }
+            selection = parse_component_selection(value);
           } else {
             throw std::runtime_error(
                 "query parameter not implemented for scheme file: " + key);
@@ -155,31 +189,57 @@ private:
         // string "0000". Nonexistant files are caught already at this stage by
         // glob() throwing a runtime_error.
         auto paths = system::glob(replace_all_copy(file_path, "%n", "0000"));
-        if (file_path.find("%n") != std::string::npos) {
+        if (mmap) {
+          if constexpr (archive_type == ArchiveType::TimesliceArchive) {
+            if (file_path.find("%n") != std::string::npos || cycles != 1 ||
+                selection) {
+              throw std::runtime_error(
+                  "query parameter mmap not supported with sequence "
+                  "placeholder, cycles, or components: " +
+                  locator);
+            }
+            std::unique_ptr<Source<Base>> source =
+                std::make_unique<TimesliceMappedInputArchive>(paths);
+            sources.emplace_back(std::move(source));
+          } else {
+            throw std::runtime_error(
+                std::string("query parameter mmap not supported for "
+                            "archive type ") +
+                ArchiveTypeToString(archive_type));
+          }
+        } else if (file_path.find("%n") != std::string::npos) {
           for (auto& path : paths) {
             replace_all(path, "0000", "%n");
-            std::unique_ptr<Source<Base>> source =
-                std::make_unique<TInputArchiveSequence>(path);
+            auto source = std::make_unique<TInputArchiveSequence>(path);
+            source->set_component_selection(selection);
             sources.emplace_back(std::move(source));
           }
         } else {
           if (paths.size() == 1) {
             if (cycles == 1) {
-              std::unique_ptr<Source<Base>> source =
-                  std::make_unique<TInputArchive>(paths.front());
+              auto source = std::make_unique<TInputArchive>(paths.front());
+              source->set_component_selection(selection);
               sources.emplace_back(std::move(source));
             } else {
-              std::unique_ptr<Source<Base>> source =
+              auto source =
                   std::make_unique<TInputArchiveLoop>(paths.front(), cycles);
+              source->set_component_selection(selection);
               sources.emplace_back(std::move(source));
             }
           } else if (paths.size() > 1) {
-            std::unique_ptr<Source<Base>> source =
-                std::make_unique<TInputArchiveSequence>(paths);
+            auto source = std::make_unique<TInputArchiveSequence>(paths);
+            source->set_component_selection(selection);
             sources.emplace_back(std::move(source));
           }
         }
 
+        if (prefetch > 0) {
+          for (auto i = first_source; i < sources.size(); ++i) {
+            sources[i] = std::make_unique<PrefetchingSource<Source<Base>>>(
+                std::move(sources[i]), prefetch);
+          }
+        }
+
       } else if (uri.scheme == "tcp") {
         uint32_t hwm = 1;
         for (auto& [key, value] : uri.query_components) {
@@ -200,6 +260,7 @@ private:
         WorkerParameters param{1, 0, WorkerQueuePolicy::QueueAll, 0,
                                "AutoSource at PID " +
                                    std::to_string(system::current_pid())};
+        bool shm_item_channel = false;
         for (auto& [key, value] : uri.query_components) {
           if (key == "stride") {
             param.stride = std::stoull(value);
@@ -213,6 +274,11 @@ private:
             param.queue_policy = queue_map.at(value);
           } else if (key == "group") {
             param.group_id = std::stoull(value);
+          } else if (key == "channel") {
+            if (value != "zmq" && value != "shm") {
+              throw std::runtime_error("invalid item channel: " + value);
+            }
+            shm_item_channel = (value == "shm");
           } else {
             throw std::runtime_error(
                 "query parameter not implemented for scheme " + uri.scheme +
@@ -221,7 +287,8 @@ private:
         }
         const auto ipc_identifier = uri.authority + uri.path;
         std::unique_ptr<Source<Base>> source =
-            std::make_unique<Receiver<Base, View>>(ipc_identifier, param);
+            std::make_unique<Receiver<Base, View>>(ipc_identifier, param,
+                                                   shm_item_channel);
         sources.emplace_back(std::move(source));
 
       } else {
@@ -0,0 +1,45 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "ComponentSelection.hpp"
+#include "Utility.hpp"
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+ComponentSelection parse_component_selection(const std::string& list) {
+  std::vector<std::pair<uint8_t, std::optional<uint16_t>>> entries;
+
+  for (const auto& entry : split(list, ",")) {
+    auto pos = entry.find(':');
+    try {
+      auto sys_id = std::stoul(entry.substr(0, pos), nullptr, 0);
+      if (sys_id > UINT8_MAX) {
+        throw std::out_of_range(entry);
+      }
+      std::optional<uint16_t> eq_id;
+      if (pos != std::string::npos) {
+        auto value = std::stoul(entry.substr(pos + 1), nullptr, 0);
+        if (value > UINT16_MAX) {
+          throw std::out_of_range(entry);
+        }
+        eq_id = static_cast<uint16_t>(value);
+      }
+      entries.emplace_back(static_cast<uint8_t>(sys_id), eq_id);
+    } catch (std::logic_error const&) {
+      throw std::invalid_argument("invalid component selection entry: \"" +
+                                  entry + "\"");
+    }
+  }
+
+  return [entries = std::move(entries)](uint8_t sys_id, uint16_t eq_id) {
+    return std::any_of(entries.begin(), entries.end(), [&](const auto& e) {
+      return e.first == sys_id && (!e.second || *e.second == eq_id);
+    });
+  };
+}
+
+} // namespace fles
@@ -0,0 +1,29 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::ComponentSelection type.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace fles {
+
+/**
+ * \brief A predicate selecting timeslice components by the subsystem and
+ * equipment identifiers of their microslices.
+ *
+ * An empty (default-constructed) selection selects all components.
+ */
+using ComponentSelection = std::function<bool(uint8_t sys_id, uint16_t eq_id)>;
+
+/**
+ * \brief Create a component selection from a list of identifiers.
+ *
+ * \param list Comma-separated list of entries of the form "sys_id" or
+ * "sys_id:eq_id", with numbers in decimal or hexadecimal (prefix "0x")
+ * notation, e.g., "0x10,0x40:0x1001"
+ */
+ComponentSelection parse_component_selection(const std::string& list);
+
+} // namespace fles
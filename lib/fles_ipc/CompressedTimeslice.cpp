@@ -0,0 +1,110 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "CompressedTimeslice.hpp"
+#include <stdexcept>
+#include <utility>
+#ifdef BOOST_IOS_HAS_ZSTD
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#endif
+
+namespace fles {
+
+namespace {
+
+std::vector<char>
+compress_component(const uint8_t* data, uint64_t size, int level) {
+#ifdef BOOST_IOS_HAS_ZSTD
+  std::vector<char> frame;
+  boost::iostreams::filtering_ostream out;
+  out.push(boost::iostreams::zstd_compressor(
+      boost::iostreams::zstd_params(static_cast<uint32_t>(level))));
+  out.push(boost::iostreams::back_inserter(frame));
+  out.write(reinterpret_cast<const char*>(data),
+            static_cast<std::streamsize>(size));
+  out.reset(); // finish the frame
+  return frame;
+#else
+  (void)data;
+  (void)size;
+  (void)level;
+  throw std::runtime_error("Per-component compression not supported. Your "
+                           "boost library does not support zstd.");
+#endif
+}
+
+void decompress_component(const std::vector<char>& frame,
+                          std::vector<uint8_t>& data) {
+#ifdef BOOST_IOS_HAS_ZSTD
+  boost::iostreams::filtering_istream in;
+  in.push(boost::iostreams::zstd_decompressor());
+  in.push(boost::iostreams::array_source(frame.data(), frame.size()));
+  in.read(reinterpret_cast<char*>(data.data()),
+          static_cast<std::streamsize>(data.size()));
+  if (static_cast<std::size_t>(in.gcount()) != data.size()) {
+    throw std::runtime_error("corrupt compressed timeslice component");
+  }
+#else
+  (void)frame;
+  (void)data;
+  throw std::runtime_error("Per-component compression not supported. Your "
+                           "boost library does not support zstd.");
+#endif
+}
+
+} // namespace
+
+CompressedTimeslice::CompressedTimeslice(const Timeslice& ts, int level)
+    : timeslice_descriptor_(ts.timeslice_descriptor_) {
+  const auto num_components = ts.num_components();
+  desc_.reserve(num_components);
+  sys_id_.reserve(num_components);
+  eq_id_.reserve(num_components);
+  data_.reserve(num_components);
+
+  for (uint64_t c = 0; c < num_components; ++c) {
+    desc_.push_back(*ts.desc_ptr_[c]);
+    if (ts.num_microslices(c) > 0) {
+      const auto& ms_desc = ts.descriptor(c, 0);
+      sys_id_.push_back(ms_desc.sys_id);
+      eq_id_.push_back(ms_desc.eq_id);
+    } else {
+      sys_id_.push_back(0);
+      eq_id_.push_back(0);
+    }
+    if (ts.desc_ptr_[c]->size > 0) {
+      data_.push_back(
+          compress_component(ts.data_ptr_[c], ts.desc_ptr_[c]->size, level));
+    } else {
+      data_.emplace_back();
+    }
+  }
+}
+
+void CompressedTimeslice::decompress(
+    StorableTimeslice& ts, const ComponentSelection& selection) const {
+  ts.timeslice_descriptor_ = timeslice_descriptor_;
+  ts.data_.clear();
+  ts.desc_.clear();
+
+  for (std::size_t c = 0; c < desc_.size(); ++c) {
+    if (selection &&
+        (desc_[c].num_microslices == 0 || !selection(sys_id_[c], eq_id_[c]))) {
+      continue;
+    }
+    std::vector<uint8_t> data(desc_[c].size);
+    if (!data.empty()) {
+      decompress_component(data_[c], data);
+    }
+    ts.data_.push_back(std::move(data));
+    ts.desc_.push_back(desc_[c]);
+  }
+  ts.timeslice_descriptor_.num_components =
+      static_cast<uint32_t>(ts.desc_.size());
+
+  ts.init_pointers();
+}
+
+} // namespace fles
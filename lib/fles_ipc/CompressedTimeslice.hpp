@@ -0,0 +1,121 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::CompressedTimeslice class.
+#pragma once
+
+#include "ArchiveDescriptor.hpp"
+#include "ComponentSelection.hpp"
+#include "StorableTimeslice.hpp"
+#include "Timeslice.hpp"
+#include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceDescriptor.hpp"
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The CompressedTimeslice class is the serialized representation of a
+ * timeslice in archives with per-component compression.
+ *
+ * The data of each timeslice component is compressed into an independent zstd
+ * frame. The subsystem and equipment identifiers of each component are stored
+ * uncompressed, so that a reader can decompress only the components it is
+ * interested in.
+ */
+class CompressedTimeslice {
+public:
+  /// Construct an empty object (to deserialize into).
+  CompressedTimeslice() = default;
+
+  /**
+   * \brief Construct by compressing the components of a given timeslice.
+   *
+   * \param ts    The timeslice to compress
+   * \param level zstd compression level
+   */
+  CompressedTimeslice(const Timeslice& ts, int level);
+
+  /**
+   * \brief Decompress the selected components into a given timeslice object.
+   *
+   * \param ts        The timeslice object to fill (previous content is lost)
+   * \param selection The components to decompress (all if empty)
+   */
+  void decompress(StorableTimeslice& ts,
+                  const ComponentSelection& selection) const;
+
+private:
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    ar & timeslice_descriptor_;
+    ar & desc_;
+    ar & sys_id_;
+    ar & eq_id_;
+    ar & data_;
+  }
+
+  TimesliceDescriptor timeslice_descriptor_{};
+  std::vector<TimesliceComponentDescriptor> desc_;
+  /// Subsystem identifier of the first microslice of each component
+  std::vector<uint8_t> sys_id_;
+  /// Equipment identifier of the first microslice of each component
+  std::vector<uint16_t> eq_id_;
+  /// Compressed data of each component (empty if without data)
+  std::vector<std::vector<char>> data_;
+};
+
+/**
+ * \brief Deserialize the next data set from an archive.
+ *
+ * For timeslice archives, this handles archives with per-component
+ * compression and applies the given component selection.
+ */
+template <class Archive, class Storable>
+void load_item(Archive& ar,
+               Storable& item,
+               ArchiveCompression compression,
+               const ComponentSelection& selection) {
+  if constexpr (std::is_same_v<Storable, StorableTimeslice>) {
+    if (compression == ArchiveCompression::ZstdComponents) {
+      CompressedTimeslice cts;
+      ar >> cts;
+      cts.decompress(item, selection);
+      return;
+    }
+    ar >> item;
+    if (selection) {
+      item.select_components(selection);
+    }
+  } else {
+    ar >> item;
+  }
+}
+
+/**
+ * \brief Serialize a data set to an archive.
+ *
+ * For timeslice archives with per-component compression, the timeslice is
+ * stored as a CompressedTimeslice.
+ */
+template <class Archive, class Storable>
+void save_item(Archive& ar,
+               const Storable& item,
+               ArchiveCompression compression,
+               int compression_level) {
+  if constexpr (std::is_same_v<Storable, StorableTimeslice>) {
+    if (compression == ArchiveCompression::ZstdComponents) {
+      const CompressedTimeslice cts(item, compression_level);
+      ar << cts;
+      return;
+    }
+  }
+  ar << item;
+}
+
+} // namespace fles
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "ArchiveDescriptor.hpp"
+#include "ArchiveIndex.hpp"
 #include "BoostHelper.hpp"
+#include "CompressedTimeslice.hpp"
 #include "Source.hpp"
 #include "log.hpp"
 #include <boost/archive/archive_exception.hpp>
@@ -15,14 +17,21 @@
 #endif
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/version.hpp>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fles {
 
 /**
  * \brief The InputArchive class deserializes data sets from an input file.
+ *
+ * If an index file exists for an archive file that is uncompressed or uses
+ * per-component compression (see fles::ArchiveIndex), the archive supports
+ * random access using seek().
  */
 template <class Base, class Storable, ArchiveType archive_type>
 class InputArchive : public Source<Base> {
@@ -33,12 +42,109 @@ public:
    *
    * \param filename File name of the archive file
    */
-  explicit InputArchive(const std::string& filename) {
+  explicit InputArchive(const std::string& filename) : filename_(filename) {
+    open();
+
+    if (descriptor_.archive_compression() == ArchiveCompression::None ||
+        descriptor_.archive_compression() ==
+            ArchiveCompression::ZstdComponents) {
+      if (auto index = ArchiveIndex::read(filename_)) {
+        index_ = std::move(*index);
+        has_index_ = true;
+      }
+    }
+  }
+
+  /// Delete copy constructor (non-copyable).
+  InputArchive(const InputArchive&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const InputArchive&) = delete;
+
+  ~InputArchive() override = default;
+
+  /// Read the next data set.
+  std::unique_ptr<Storable> get() {
+    return std::unique_ptr<Storable>(do_get());
+  };
+
+  /// Retrieve the archive descriptor.
+  [[nodiscard]] const ArchiveDescriptor& descriptor() const {
+    return descriptor_;
+  };
+
+  [[nodiscard]] bool eos() const override { return eos_; }
+
+  /**
+   * \brief Restrict the timeslice components to read (timeslice archives
+   * only).
+   *
+   * In archives with per-component compression, unselected components are
+   * not decompressed.
+   */
+  void set_component_selection(ComponentSelection selection) {
+    selection_ = std::move(selection);
+  }
+
+  /// Check whether the archive supports random access using seek().
+  [[nodiscard]] bool has_index() const { return has_index_; }
+
+  /// Retrieve the number of data sets in the archive (requires an index).
+  [[nodiscard]] std::size_t size() const { return index_.size(); }
+
+  /**
+   * \brief Position the archive so that the next call to get() reads the
+   * data set with the given number (counting from the start of the file).
+   *
+   * Seeking beyond the last data set results in end-of-stream. The data sets
+   * at the start of the file that contain the serialization class information
+   * are always read sequentially.
+   *
+   * \param n Number of the data set to read next
+   */
+  void seek(std::size_t n) {
+    if (!has_index_) {
+      throw std::runtime_error("Input archive file \"" + filename_ +
+                               "\" does not support seeking (no index).");
+    }
+    if (n >= index_.size()) {
+      position_ = n;
+      eos_ = true;
+      return;
+    }
+    // Data sets containing class information cannot be read out of order
+    if (!primed_ || n < primed_count_) {
+      if (position_ > n) {
+        open();
+      }
+      while (!primed_ && position_ < n) {
+        std::unique_ptr<Storable> item(do_get());
+        if (!item) {
+          return;
+        }
+      }
+      if (position_ == n) {
+        return;
+      }
+    }
+    ifstream_->clear();
+    ifstream_->seekg(static_cast<std::streamoff>(index_[n]));
+    position_ = n;
+    eos_ = false;
+  }
+
+private:
+  void open() {
+    iarchive_ = nullptr;
+    in_ = nullptr;
     ifstream_ =
-        std::make_unique<std::ifstream>(filename.c_str(), std::ios::binary);
+        std::make_unique<std::ifstream>(filename_.c_str(), std::ios::binary);
     if (!*ifstream_) {
-      throw std::ios_base::failure("error opening file \"" + filename + "\"");
+      throw std::ios_base::failure("error opening file \"" + filename_ +
+                                   "\"");
     }
+    position_ = 0;
+    primed_ = false;
+    eos_ = false;
 
     try {
       iarchive_ = std::make_unique<boost::archive::binary_iarchive>(*ifstream_);
@@ -51,7 +157,7 @@ public:
         // try to figure out the archive's version
         auto vers = boost_peek_for_archive_version(*ifstream_);
         L_(warning) << "Found archive version " << vers << " in file \""
-                    << filename << "\"." << std::endl;
+                    << filename_ << "\"." << std::endl;
         L_(warning) << "Consider recompiling with BOOST library >="
                     << boostlib_for_archive_version(vers)
                     << " (this uses boost " << BOOST_LIB_VERSION << ")."
@@ -68,13 +174,15 @@ public:
 
     if (descriptor_.archive_type() != archive_type) {
       throw std::runtime_error(
-          "File \"" + filename +
+          "File \"" + filename_ +
           "\" is not of correct archive type. InputArchive expected \"" +
           ArchiveTypeToString(archive_type) + "\" found \"" +
           ArchiveTypeToString(descriptor_.archive_type()) + "\".");
     }
 
-    if (descriptor_.archive_compression() != ArchiveCompression::None) {
+    if (descriptor_.archive_compression() != ArchiveCompression::None &&
+        descriptor_.archive_compression() !=
+            ArchiveCompression::ZstdComponents) {
 #ifdef BOOST_IOS_HAS_ZSTD
       in_ = std::make_unique<boost::iostreams::filtering_istream>();
       if (descriptor_.archive_compression() == ArchiveCompression::Zstd) {
@@ -82,7 +190,7 @@ public:
       } else {
         throw std::runtime_error(
             "Unsupported compression type for input archive file \"" +
-            filename + "\". Expected " +
+            filename_ + "\". Expected " +
             ArchiveCompressionToString(ArchiveCompression::Zstd) + ".");
       }
       in_->push(*ifstream_);
@@ -90,7 +198,7 @@ public:
           *in_, boost::archive::no_header);
 #else
       throw std::runtime_error(
-          "Unsupported compression type for input archive file \"" + filename +
+          "Unsupported compression type for input archive file \"" + filename_ +
           "\". Your boost library does not support \"" +
           ArchiveCompressionToString(descriptor_.archive_compression()) +
           "\".");
@@ -98,26 +206,6 @@ public:
     }
   }
 
-  /// Delete copy constructor (non-copyable).
-  InputArchive(const InputArchive&) = delete;
-  /// Delete assignment operator (non-copyable).
-  void operator=(const InputArchive&) = delete;
-
-  ~InputArchive() override = default;
-
-  /// Read the next data set.
-  std::unique_ptr<Storable> get() {
-    return std::unique_ptr<Storable>(do_get());
-  };
-
-  /// Retrieve the archive descriptor.
-  [[nodiscard]] const ArchiveDescriptor& descriptor() const {
-    return descriptor_;
-  };
-
-  [[nodiscard]] bool eos() const override { return eos_; }
-
-private:
   Storable* do_get() override {
     if (eos_) {
       return nullptr;
@@ -126,7 +214,8 @@ private:
     Storable* sts = nullptr;
     try {
       sts = new Storable(); // NOLINT
-      *iarchive_ >> *sts;
+      load_item(*iarchive_, *sts, descriptor_.archive_compression(),
+                selection_);
     } catch (boost::archive::archive_exception& e) {
       if (e.code == boost::archive::archive_exception::input_stream_error) {
         delete sts; // NOLINT
@@ -135,14 +224,32 @@ private:
       }
       throw;
     }
+    ++position_;
+    if (!primed_ && completes_class_info(*sts)) {
+      primed_ = true;
+      primed_count_ = position_;
+    }
     return sts;
   }
 
+  std::string filename_;
   std::unique_ptr<std::ifstream> ifstream_;
   std::unique_ptr<boost::iostreams::filtering_istream> in_;
   std::unique_ptr<boost::archive::binary_iarchive> iarchive_;
   ArchiveDescriptor descriptor_;
 
+  // Random access support
+  bool has_index_ = false;
+  std::vector<uint64_t> index_;
+  /// Number of the data set to be read next
+  std::size_t position_ = 0;
+  /// All class information has been read (seeking is possible)
+  bool primed_ = false;
+  /// Number of data sets containing class information
+  std::size_t primed_count_ = 0;
+
+  ComponentSelection selection_;
+
   bool eos_ = false;
 };
 
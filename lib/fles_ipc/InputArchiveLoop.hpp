@@ -6,6 +6,7 @@
 
 #include "ArchiveDescriptor.hpp"
 #include "BoostHelper.hpp"
+#include "CompressedTimeslice.hpp"
 #include "Source.hpp"
 #include "log.hpp"
 #include <boost/archive/binary_iarchive.hpp>
@@ -59,6 +60,17 @@ public:
 
   [[nodiscard]] bool eos() const override { return eos_; }
 
+  /**
+   * \brief Restrict the timeslice components to read (timeslice archives
+   * only).
+   *
+   * In archives with per-component compression, unselected components are
+   * not decompressed.
+   */
+  void set_component_selection(ComponentSelection selection) {
+    selection_ = std::move(selection);
+  }
+
 private:
   void init() {
     iarchive_ = nullptr;
@@ -104,7 +116,9 @@ private:
           ArchiveTypeToString(descriptor_.archive_type()) + "\".");
     }
 
-    if (descriptor_.archive_compression() != ArchiveCompression::None) {
+    if (descriptor_.archive_compression() != ArchiveCompression::None &&
+        descriptor_.archive_compression() !=
+            ArchiveCompression::ZstdComponents) {
 #ifdef BOOST_IOS_HAS_ZSTD
       in_ = std::make_unique<boost::iostreams::filtering_istream>();
       if (descriptor_.archive_compression() == ArchiveCompression::Zstd) {
@@ -139,7 +153,8 @@ private:
     Storable* sts = nullptr;
     try {
       sts = new Storable(); // NOLINT
-      *iarchive_ >> *sts;
+      load_item(*iarchive_, *sts, descriptor_.archive_compression(),
+                selection_);
       archive_has_data_ = true;
     } catch (boost::archive::archive_exception& e) {
       if (e.code == boost::archive::archive_exception::input_stream_error) {
@@ -163,6 +178,7 @@ private:
 
   std::string filename_;
   uint64_t cycles_;
+  ComponentSelection selection_;
 
   uint64_t cycle_ = 0;
   bool archive_has_data_ = false;
@@ -6,6 +6,7 @@
 
 #include "ArchiveDescriptor.hpp"
 #include "BoostHelper.hpp"
+#include "CompressedTimeslice.hpp"
 #include "Source.hpp"
 #include "log.hpp"
 #include <boost/algorithm/string.hpp>
@@ -79,6 +80,17 @@ public:
 
   [[nodiscard]] bool eos() const override { return eos_; }
 
+  /**
+   * \brief Restrict the timeslice components to read (timeslice archives
+   * only).
+   *
+   * In archives with per-component compression, unselected components are
+   * not decompressed.
+   */
+  void set_component_selection(ComponentSelection selection) {
+    selection_ = std::move(selection);
+  }
+
 private:
   std::unique_ptr<std::ifstream> ifstream_;
   std::unique_ptr<boost::iostreams::filtering_istream> in_;
@@ -89,6 +101,7 @@ private:
   const std::vector<std::string> filenames_;
   std::size_t file_count_ = 0;
 
+  ComponentSelection selection_;
   bool eos_ = false;
 
   [[nodiscard]] std::string filename_with_number(std::size_t n) const {
@@ -159,7 +172,9 @@ private:
           ArchiveTypeToString(descriptor_.archive_type()) + "\".");
     }
 
-    if (descriptor_.archive_compression() != ArchiveCompression::None) {
+    if (descriptor_.archive_compression() != ArchiveCompression::None &&
+        descriptor_.archive_compression() !=
+            ArchiveCompression::ZstdComponents) {
 #ifdef BOOST_IOS_HAS_ZSTD
       in_ = std::make_unique<boost::iostreams::filtering_istream>();
       if (descriptor_.archive_compression() == ArchiveCompression::Zstd) {
@@ -193,7 +208,8 @@ private:
     Storable* sts = nullptr;
     try {
       sts = new Storable(); // NOLINT
-      *iarchive_ >> *sts;
+      load_item(*iarchive_, *sts, descriptor_.archive_compression(),
+                selection_);
     } catch (boost::archive::archive_exception& e) {
       if (e.code == boost::archive::archive_exception::input_stream_error) {
         delete sts; // NOLINT
@@ -4,13 +4,18 @@
 #pragma once
 
 #include "ArchiveDescriptor.hpp"
+#include "ArchiveIndex.hpp"
+#include "CompressedTimeslice.hpp"
+#include "ParallelZstdCompressor.hpp"
 #include "Sink.hpp"
 #include <boost/archive/binary_oarchive.hpp>
 #ifdef BOOST_IOS_HAS_ZSTD
 #include <boost/iostreams/filter/zstd.hpp>
 #endif
 #include <boost/iostreams/filtering_stream.hpp>
+#include <cstddef>
 #include <fstream>
+#include <memory>
 #include <string>
 
 namespace fles {
@@ -27,31 +32,64 @@ public:
    *
    * \param filename File name of the archive file
    * \param compression Compression type to use
+   * \param write_index Write an index file for random access (not supported
+   * for zstd stream compression, see fles::ArchiveIndex)
+   * \param compression_level Compression level (zstd: 1 = best speed)
+   * \param compression_threads Number of compression threads (zstd stream
+   * compression only; if > 1, the data is compressed block-wise in parallel)
    */
   explicit OutputArchive(
       const std::string& filename,
-      ArchiveCompression compression = ArchiveCompression::None)
+      ArchiveCompression compression = ArchiveCompression::None,
+      bool write_index = false,
+      int compression_level = 1,
+      std::size_t compression_threads = 1)
       : ofstream_(filename, std::ios::binary),
-        descriptor_{archive_type, compression} {
+        descriptor_{archive_type, compression},
+        compression_level_(compression_level) {
+
+    if (write_index && compression == ArchiveCompression::Zstd) {
+      throw std::runtime_error(
+          "Index not supported for compressed output archive file \"" +
+          filename + "\"");
+    }
+    if (compression == ArchiveCompression::ZstdComponents &&
+        archive_type != ArchiveType::TimesliceArchive) {
+      throw std::runtime_error(
+          "Per-component compression not supported for output archive file \"" +
+          filename + "\"");
+    }
+    if (write_index) {
+      index_ = std::make_unique<ArchiveIndexWriter>(filename);
+    } else {
+      ArchiveIndexWriter::remove(filename);
+    }
 
     oarchive_ = std::make_unique<boost::archive::binary_oarchive>(ofstream_);
 
     *oarchive_ << descriptor_;
 
-    if (compression != ArchiveCompression::None) {
+    if (compression != ArchiveCompression::None &&
+        compression != ArchiveCompression::ZstdComponents) {
 #ifdef BOOST_IOS_HAS_ZSTD
-      out_ = std::make_unique<boost::iostreams::filtering_ostream>();
-      if (compression == ArchiveCompression::Zstd) {
-        out_->push(boost::iostreams::zstd_compressor(
-            boost::iostreams::zstd::best_speed));
-      } else {
+      if (compression != ArchiveCompression::Zstd) {
         throw std::runtime_error(
             "Unsupported compression type for output archive file \"" +
             filename + "\"");
       }
-      out_->push(ofstream_);
-      oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
-          *out_, boost::archive::no_header);
+      if (compression_threads > 1) {
+        compressor_ = std::make_unique<ParallelZstdCompressor>(
+            ofstream_, compression_level, compression_threads);
+        oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
+            *compressor_, boost::archive::no_header);
+      } else {
+        out_ = std::make_unique<boost::iostreams::filtering_ostream>();
+        out_->push(boost::iostreams::zstd_compressor(
+            boost::iostreams::zstd_params(compression_level)));
+        out_->push(ofstream_);
+        oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
+            *out_, boost::archive::no_header);
+      }
 #else
       throw std::runtime_error(
           "Unsupported compression type for output archive file \"" + filename +
@@ -74,10 +112,21 @@ public:
 private:
   std::ofstream ofstream_;
   std::unique_ptr<boost::iostreams::filtering_ostream> out_;
+#ifdef BOOST_IOS_HAS_ZSTD
+  std::unique_ptr<ParallelZstdCompressor> compressor_;
+#endif
   std::unique_ptr<boost::archive::binary_oarchive> oarchive_;
   ArchiveDescriptor descriptor_;
+  int compression_level_;
+  std::unique_ptr<ArchiveIndexWriter> index_;
 
-  void do_put(const Derived& item) { *oarchive_ << item; }
+  void do_put(const Derived& item) {
+    if (index_) {
+      index_->add(static_cast<uint64_t>(ofstream_.tellp()));
+    }
+    save_item(*oarchive_, item, descriptor_.archive_compression(),
+              compression_level_);
+  }
   // TODO(Jan): Solve this without the additional alloc/copy operation
 };
 
@@ -4,6 +4,9 @@
 #pragma once
 
 #include "ArchiveDescriptor.hpp"
+#include "ArchiveIndex.hpp"
+#include "CompressedTimeslice.hpp"
+#include "ParallelZstdCompressor.hpp"
 #include "Sink.hpp"
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -38,15 +41,38 @@ public:
    * \param items_per_file    Number of items to store in each file
    * \param bytes_per_file    bytes per file
    * \param compression       compression
+   * \param write_index       Write an index file for each archive file
+   *                          (not supported for zstd stream compression)
+   * \param compression_level Compression level (zstd: 1 = best speed)
+   * \param compression_threads Number of compression threads (zstd stream
+   *                          compression only; if > 1, the data is
+   *                          compressed block-wise in parallel)
    */
   explicit OutputArchiveSequence(
       std::string filename_template,
       std::size_t items_per_file = SIZE_MAX,
       std::size_t bytes_per_file = SIZE_MAX,
-      ArchiveCompression compression = ArchiveCompression::None)
+      ArchiveCompression compression = ArchiveCompression::None,
+      bool write_index = false,
+      int compression_level = 1,
+      std::size_t compression_threads = 1)
       : descriptor_{archive_type, compression},
         filename_template_(std::move(filename_template)),
-        items_per_file_(items_per_file), bytes_per_file_(bytes_per_file) {
+        items_per_file_(items_per_file), bytes_per_file_(bytes_per_file),
+        write_index_(write_index), compression_level_(compression_level),
+        compression_threads_(compression_threads) {
+    if (write_index_ && compression == ArchiveCompression::Zstd) {
+      throw std::runtime_error(
+          "Index not supported for compressed output archive sequence \"" +
+          filename_template_ + "\"");
+    }
+    if (compression == ArchiveCompression::ZstdComponents &&
+        archive_type != ArchiveType::TimesliceArchive) {
+      throw std::runtime_error(
+          "Per-component compression not supported for output archive "
+          "sequence \"" +
+          filename_template_ + "\"");
+    }
     if (items_per_file_ == 0) {
       items_per_file_ = SIZE_MAX;
     }
@@ -74,7 +100,11 @@ public:
   void put(std::shared_ptr<const Base> item) override { do_put(*item); }
 
   void end_stream() override {
+    index_ = nullptr;
     oarchive_ = nullptr;
+#ifdef BOOST_IOS_HAS_ZSTD
+    compressor_ = nullptr;
+#endif
     out_ = nullptr;
     ofstream_ = nullptr;
   }
@@ -82,12 +112,19 @@ public:
 private:
   std::unique_ptr<std::ofstream> ofstream_;
   std::unique_ptr<boost::iostreams::filtering_ostream> out_;
+#ifdef BOOST_IOS_HAS_ZSTD
+  std::unique_ptr<ParallelZstdCompressor> compressor_;
+#endif
   std::unique_ptr<boost::archive::binary_oarchive> oarchive_;
   ArchiveDescriptor descriptor_;
+  std::unique_ptr<ArchiveIndexWriter> index_;
 
   std::string filename_template_;
   std::size_t items_per_file_;
   std::size_t bytes_per_file_;
+  bool write_index_;
+  int compression_level_;
+  std::size_t compression_threads_;
   std::size_t file_count_ = 0;
   std::size_t file_item_count_ = 0;
 
@@ -96,7 +133,11 @@ private:
     if (file_limit_reached()) {
       next_file();
     }
-    *oarchive_ << item;
+    if (index_) {
+      index_->add(static_cast<uint64_t>(ofstream_->tellp()));
+    }
+    save_item(*oarchive_, item, descriptor_.archive_compression(),
+              compression_level_);
     ++file_item_count_;
   }
 
@@ -122,28 +163,45 @@ private:
   }
 
   void next_file() {
+    index_ = nullptr;
     oarchive_ = nullptr;
+#ifdef BOOST_IOS_HAS_ZSTD
+    compressor_ = nullptr;
+#endif
     out_ = nullptr;
     ofstream_ = nullptr;
     ofstream_ = std::make_unique<std::ofstream>(filename(file_count_),
                                                 std::ios::binary);
+    if (write_index_) {
+      index_ = std::make_unique<ArchiveIndexWriter>(filename(file_count_));
+    } else {
+      ArchiveIndexWriter::remove(filename(file_count_));
+    }
     oarchive_ = std::make_unique<boost::archive::binary_oarchive>(*ofstream_);
     *oarchive_ << descriptor_;
 
-    if (descriptor_.archive_compression() != ArchiveCompression::None) {
+    if (descriptor_.archive_compression() != ArchiveCompression::None &&
+        descriptor_.archive_compression() !=
+            ArchiveCompression::ZstdComponents) {
 #ifdef BOOST_IOS_HAS_ZSTD
-      out_ = std::make_unique<boost::iostreams::filtering_ostream>();
-      if (descriptor_.archive_compression() == ArchiveCompression::Zstd) {
-        out_->push(boost::iostreams::zstd_compressor(
-            boost::iostreams::zstd::best_speed));
-      } else {
+      if (descriptor_.archive_compression() != ArchiveCompression::Zstd) {
         throw std::runtime_error(
             "Unsupported compression type for output archive sequence file \"" +
             filename(file_count_) + "\"");
       }
-      out_->push(*ofstream_);
-      oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
-          *out_, boost::archive::no_header);
+      if (compression_threads_ > 1) {
+        compressor_ = std::make_unique<ParallelZstdCompressor>(
+            *ofstream_, compression_level_, compression_threads_);
+        oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
+            *compressor_, boost::archive::no_header);
+      } else {
+        out_ = std::make_unique<boost::iostreams::filtering_ostream>();
+        out_->push(boost::iostreams::zstd_compressor(
+            boost::iostreams::zstd_params(compression_level_)));
+        out_->push(*ofstream_);
+        oarchive_ = std::make_unique<boost::archive::binary_oarchive>(
+            *out_, boost::archive::no_header);
+      }
 #else
       throw std::runtime_error(
           "Unsupported compression type for output archive sequence file \"" +
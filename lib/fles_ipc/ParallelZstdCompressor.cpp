@@ -0,0 +1,173 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#ifdef BOOST_IOS_HAS_ZSTD
+
+#include "ParallelZstdCompressor.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <ios>
+
+namespace fles {
+
+ParallelZstdCompressor::ParallelZstdCompressor(std::ostream& sink,
+                                               int level,
+                                               std::size_t num_workers,
+                                               std::size_t block_size)
+    : sink_(sink), level_(level), block_size_(std::max<std::size_t>(
+                                      block_size, 1)),
+      max_pending_blocks_(2 * std::max<std::size_t>(num_workers, 1)),
+      block_(block_size_) {
+  setp(block_.data(), block_.data() + block_.size());
+
+  for (std::size_t i = 0; i < std::max<std::size_t>(num_workers, 1); ++i) {
+    workers_.emplace_back(&ParallelZstdCompressor::worker_loop, this);
+  }
+}
+
+ParallelZstdCompressor::~ParallelZstdCompressor() {
+  try {
+    close();
+  } catch (std::exception const& e) {
+    L_(error) << "error closing compressed output stream: " << e.what();
+  }
+}
+
+void ParallelZstdCompressor::close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+
+  std::exception_ptr exception;
+  try {
+    submit_block();
+    write_blocks(true);
+    sink_.flush();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+ParallelZstdCompressor::int_type ParallelZstdCompressor::overflow(int_type ch) {
+  if (closed_) {
+    return traits_type::eof();
+  }
+  submit_block();
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int ParallelZstdCompressor::sync() {
+  if (closed_) {
+    return 0;
+  }
+  try {
+    submit_block();
+    write_blocks(true);
+    sink_.flush();
+  } catch (std::exception const& e) {
+    L_(error) << "error writing compressed output stream: " << e.what();
+    return -1;
+  }
+  return sink_ ? 0 : -1;
+}
+
+void ParallelZstdCompressor::submit_block() {
+  auto size = static_cast<std::size_t>(pptr() - pbase());
+  if (size == 0) {
+    return;
+  }
+  block_.resize(size);
+
+  std::packaged_task<std::string()> task(
+      [data = std::move(block_), level = level_] {
+        return compress(data, level);
+      });
+  pending_blocks_.push_back(task.get_future());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+
+  block_ = std::vector<char>(block_size_);
+  setp(block_.data(), block_.data() + block_.size());
+
+  write_blocks(false);
+}
+
+void ParallelZstdCompressor::write_blocks(bool wait) {
+  while (!pending_blocks_.empty()) {
+    auto& front = pending_blocks_.front();
+    // Limit the number of blocks in flight, but do not block otherwise
+    if (!wait && pending_blocks_.size() <= max_pending_blocks_ &&
+        front.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      break;
+    }
+    std::string frame = front.get();
+    pending_blocks_.pop_front();
+    sink_.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    if (!sink_) {
+      throw std::ios_base::failure("error writing compressed data");
+    }
+  }
+}
+
+void ParallelZstdCompressor::worker_loop() {
+  while (true) {
+    std::packaged_task<std::string()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+std::string ParallelZstdCompressor::compress(const std::vector<char>& data,
+                                             int level) {
+  constexpr std::streamsize buffer_size = 128 * 1024;
+
+  std::string frame;
+  boost::iostreams::filtering_ostream out;
+  out.push(boost::iostreams::zstd_compressor(
+               boost::iostreams::zstd_params(static_cast<uint32_t>(level)),
+               buffer_size),
+           buffer_size);
+  out.push(boost::iostreams::back_inserter(frame));
+  out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  out.reset(); // finish the frame
+  return frame;
+}
+
+} // namespace fles
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::ParallelZstdCompressor class.
+#pragma once
+
+#ifdef BOOST_IOS_HAS_ZSTD
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The ParallelZstdCompressor class is a stream buffer that compresses
+ * its data on a pool of worker threads.
+ *
+ * The data is split into blocks of fixed size, each of which is compressed
+ * into an independent zstd frame. The frames are written to the underlying
+ * output stream in order. As a sequence of zstd frames is itself a valid zstd
+ * stream, the output can be read using an ordinary (streaming) zstd
+ * decompressor.
+ */
+class ParallelZstdCompressor : public std::streambuf {
+public:
+  /// The default size of the uncompressed blocks (in bytes).
+  static constexpr std::size_t default_block_size = 4UL << 20;
+
+  /**
+   * \brief Construct a compressor writing to the given output stream.
+   *
+   * \param sink        Output stream to write the compressed data to
+   * \param level       zstd compression level
+   * \param num_workers Number of worker threads
+   * \param block_size  Size of the uncompressed blocks (in bytes)
+   */
+  ParallelZstdCompressor(std::ostream& sink,
+                         int level,
+                         std::size_t num_workers,
+                         std::size_t block_size = default_block_size);
+
+  /// Delete copy constructor (non-copyable).
+  ParallelZstdCompressor(const ParallelZstdCompressor&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const ParallelZstdCompressor&) = delete;
+
+  /// Destruct the compressor, writing all remaining data.
+  ~ParallelZstdCompressor() override;
+
+  /// Compress and write all buffered data, then stop the worker threads.
+  void close();
+
+protected:
+  int_type overflow(int_type ch) override;
+  int sync() override;
+
+private:
+  void submit_block();
+  void write_blocks(bool wait);
+  void worker_loop();
+  static std::string compress(const std::vector<char>& data, int level);
+
+  std::ostream& sink_;
+  const int level_;
+  const std::size_t block_size_;
+  const std::size_t max_pending_blocks_;
+
+  /// The block currently being filled (the put area)
+  std::vector<char> block_;
+  /// Blocks in compression, in output order
+  std::deque<std::future<std::string>> pending_blocks_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::packaged_task<std::string()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+  bool closed_ = false;
+};
+
+} // namespace fles
+
+#endif
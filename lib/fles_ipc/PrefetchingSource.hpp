@@ -0,0 +1,162 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::PrefetchingSource template class.
+#pragma once
+
+#include "log.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#if __cplusplus >= 202002L
+#include <stop_token>
+#else
+#include <atomic>
+#endif
+
+namespace fles {
+
+/**
+ * \brief The PrefetchingSource class reads data sets from a given input source
+ * ahead of time in a background thread.
+ *
+ * Up to a configurable number of data sets is kept in a queue, so that reading
+ * (including decompression and deserialization) overlaps with the processing
+ * of the data sets by the consumer. The order of the data sets is preserved.
+ */
+template <class SourceType> class PrefetchingSource : public SourceType {
+public:
+  using item_type = typename SourceType::item_type;
+
+  /**
+   * \brief Construct a prefetching source object and start reading from the
+   * input source.
+   *
+   * \param source The input source to read data from
+   * \param depth  Maximum number of data sets to read ahead
+   */
+  PrefetchingSource(std::unique_ptr<SourceType> source, std::size_t depth)
+      : source_(std::move(source)), depth_(std::max<std::size_t>(depth, 1)) {
+#if __cplusplus >= 202002L
+    prefetch_thread_ =
+        std::jthread([this](std::stop_token st) { thread_loop(st); });
+#else
+    prefetch_thread_ = std::thread([this]() { thread_loop(); });
+#endif
+  }
+
+  /// Delete copy constructor (non-copyable).
+  PrefetchingSource(const PrefetchingSource&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const PrefetchingSource&) = delete;
+
+  ~PrefetchingSource() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+#if __cplusplus >= 202002L
+      prefetch_thread_.request_stop();
+#else
+      stop_requested_ = true;
+#endif
+    }
+    cv_consumed_.notify_one();
+#if __cplusplus < 202002L
+    if (prefetch_thread_.joinable()) {
+      prefetch_thread_.join();
+    }
+#endif
+  }
+
+  [[nodiscard]] bool eos() const override { return eos_; }
+
+private:
+  std::unique_ptr<SourceType> source_;
+  const std::size_t depth_;
+
+  // Synchronization primitives
+  std::mutex mutex_;
+  std::condition_variable cv_available_; // signaled when item was prefetched
+  std::condition_variable cv_consumed_;  // signaled when item was consumed
+  std::deque<std::unique_ptr<item_type>> items_;
+  bool source_exhausted_ = false; // true when source returned nullptr
+  std::exception_ptr exception_;  // error raised by the source
+
+  bool eos_ = false;
+
+#if __cplusplus >= 202002L
+  std::jthread prefetch_thread_;
+#else
+  std::atomic<bool> stop_requested_{false};
+  std::thread prefetch_thread_;
+#endif
+
+#if __cplusplus >= 202002L
+  void thread_loop(const std::stop_token& st) {
+    auto stop_requested = [&st] { return st.stop_requested(); };
+#else
+  void thread_loop() {
+    auto stop_requested = [this] { return stop_requested_.load(); };
+#endif
+    while (true) {
+      {
+        // Wait until there is space in the queue (or stop requested)
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_consumed_.wait(lock, [&] {
+          return items_.size() < depth_ || stop_requested();
+        });
+        if (stop_requested()) {
+          return;
+        }
+      }
+
+      // Fetch the next item (this may block)
+      std::unique_ptr<item_type> item;
+      try {
+        item = source_->get();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exception_ = std::current_exception();
+        source_exhausted_ = true;
+        cv_available_.notify_one();
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (item == nullptr) {
+        L_(debug) << "PrefetchingSource: source exhausted";
+        source_exhausted_ = true;
+        cv_available_.notify_one();
+        return;
+      }
+      items_.push_back(std::move(item));
+      cv_available_.notify_one();
+    }
+  }
+
+  item_type* do_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_available_.wait(lock,
+                       [this] { return !items_.empty() || source_exhausted_; });
+    if (items_.empty()) {
+      eos_ = true;
+      if (exception_) {
+        std::rethrow_exception(exception_);
+      }
+      return nullptr;
+    }
+    auto item = std::move(items_.front());
+    items_.pop_front();
+    cv_consumed_.notify_one();
+    return item.release();
+  }
+};
+
+} // namespace fles
@@ -37,4 +37,28 @@ StorableTimeslice::StorableTimeslice(const Timeslice& ts)
 
 StorableTimeslice::StorableTimeslice() = default;
 
+void StorableTimeslice::select_components(
+    const ComponentSelection& selection) {
+  std::size_t selected = 0;
+  for (std::size_t c = 0; c < desc_.size(); ++c) {
+    if (desc_[c].num_microslices == 0) {
+      continue;
+    }
+    const auto& desc = descriptor(c, 0);
+    if (!selection(desc.sys_id, desc.eq_id)) {
+      continue;
+    }
+    if (selected != c) {
+      data_[selected] = std::move(data_[c]);
+      desc_[selected] = desc_[c];
+    }
+    ++selected;
+  }
+  data_.resize(selected);
+  desc_.resize(selected);
+  timeslice_descriptor_.num_components = static_cast<uint32_t>(selected);
+
+  init_pointers();
+}
+
 } // namespace fles
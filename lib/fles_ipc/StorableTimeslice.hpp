@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ArchiveDescriptor.hpp"
+#include "ComponentSelection.hpp"
 #include "StorableMicroslice.hpp"
 #include "Timeslice.hpp"
 #include <algorithm>
@@ -115,8 +116,17 @@ public:
     return append_microslice(component, microslice, m.desc(), m.content());
   }
 
+  /**
+   * \brief Remove all components not matching the given selection.
+   *
+   * Components are identified by the subsystem and equipment identifiers of
+   * their first microslice. Components without microslices are removed.
+   */
+  void select_components(const ComponentSelection& selection);
+
 private:
   friend class boost::serialization::access;
+  friend class CompressedTimeslice;
   friend class InputArchive<Timeslice,
                             StorableTimeslice,
                             ArchiveType::TimesliceArchive>;
@@ -152,4 +162,11 @@ private:
   std::vector<TimesliceComponentDescriptor> desc_;
 };
 
+/// Check whether all class information has been serialized with the given
+/// timeslice (the component descriptor type only occurs in timeslices with
+/// components).
+inline bool completes_class_info(const StorableTimeslice& ts) {
+  return ts.num_components() > 0;
+}
+
 } // namespace fles
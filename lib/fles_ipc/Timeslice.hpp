@@ -117,6 +117,7 @@ protected:
   Timeslice() = default;
 
   friend class StorableTimeslice;
+  friend class CompressedTimeslice;
   friend class ::ManagedTimesliceBuffer;
 
   /// The timeslice descriptor.
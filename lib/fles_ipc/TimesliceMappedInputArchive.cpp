@@ -0,0 +1,299 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TimesliceMappedInputArchive.hpp"
+#include "log.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fles {
+
+namespace {
+
+/// Thrown if the serialized data ends within a timeslice.
+class truncated_archive : public std::runtime_error {
+public:
+  truncated_archive() : std::runtime_error("truncated archive") {}
+};
+
+} // namespace
+
+MappedFile::MappedFile(const std::string& filename) : filename_(filename) {
+  int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw std::ios_base::failure("error opening file \"" + filename + "\"");
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    throw std::ios_base::failure("error accessing file \"" + filename + "\"");
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  if (size_ > 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::ios_base::failure("error mapping file \"" + filename +
+                                   "\": " + std::strerror(errno));
+    }
+    data_ = static_cast<uint8_t*>(addr);
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+  close(fd); // the mapping stays valid
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+void MappedFile::will_need(std::size_t offset, std::size_t length) const {
+  if (offset >= size_) {
+    return;
+  }
+  static const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t begin = offset - offset % page_size;
+  std::size_t end = std::min(offset + length, size_);
+  madvise(data_ + begin, end - begin, MADV_WILLNEED);
+}
+
+TimesliceMappedInputArchive::TimesliceMappedInputArchive(
+    const std::string& filename, std::size_t readahead)
+    : TimesliceMappedInputArchive(std::vector<std::string>{filename},
+                                  readahead) {}
+
+TimesliceMappedInputArchive::TimesliceMappedInputArchive(
+    std::vector<std::string> filenames, std::size_t readahead)
+    : filenames_(std::move(filenames)), readahead_(readahead) {
+  if (filenames_.empty()) {
+    eos_ = true;
+    return;
+  }
+  open_file(filenames_.front());
+  ++file_count_;
+}
+
+const Timeslice* TimesliceMappedInputArchive::next() {
+  if (!current_) {
+    current_.reset(new TimesliceMappedView()); // NOLINT
+  }
+  return read(*current_) ? current_.get() : nullptr;
+}
+
+TimesliceMappedView* TimesliceMappedInputArchive::do_get() {
+  if (eos_) {
+    return nullptr;
+  }
+  std::unique_ptr<TimesliceMappedView> view(new TimesliceMappedView());
+  return read(*view) ? view.release() : nullptr;
+}
+
+void TimesliceMappedInputArchive::open_file(const std::string& filename) {
+  file_ = std::make_shared<const MappedFile>(filename);
+  position_ = 0;
+  advised_until_ = 0;
+  has_timeslice_class_info_ = false;
+  timeslice_descriptor_version_.reset();
+  has_data_vector_class_info_ = false;
+  has_desc_vector_class_info_ = false;
+  component_descriptor_version_.reset();
+
+  // Use boost to read the archive header and descriptor, then continue
+  // parsing in place
+  boost::iostreams::stream<boost::iostreams::array_source> stream(
+      reinterpret_cast<const char*>(file_->data()), file_->size());
+  boost::archive::binary_iarchive iarchive(stream);
+  iarchive >> descriptor_;
+  position_ = static_cast<std::size_t>(stream.tellg());
+
+  if (descriptor_.archive_type() != ArchiveType::TimesliceArchive) {
+    throw std::runtime_error(
+        "File \"" + filename +
+        "\" is not of correct archive type. TimesliceMappedInputArchive "
+        "expected \"" +
+        ArchiveTypeToString(ArchiveType::TimesliceArchive) + "\" found \"" +
+        ArchiveTypeToString(descriptor_.archive_type()) + "\".");
+  }
+  if (descriptor_.archive_compression() != ArchiveCompression::None) {
+    throw std::runtime_error(
+        "Unsupported compression type for memory-mapped input archive file "
+        "\"" +
+        filename + "\": " +
+        ArchiveCompressionToString(descriptor_.archive_compression()) + ".");
+  }
+  // The fixed-size encoding of versions and collection sizes parsed below is
+  // used by all archives written since boost 1.44
+  if (iarchive.get_library_version() <=
+      boost::serialization::library_version_type(7)) {
+    throw std::runtime_error(
+        "Unsupported archive version for memory-mapped input archive file "
+        "\"" +
+        filename + "\".");
+  }
+
+  advise_readahead();
+}
+
+bool TimesliceMappedInputArchive::read(TimesliceMappedView& view) {
+  while (!eos_) {
+    if (position_ < file_->size()) {
+      std::size_t start = position_;
+      try {
+        if (try_read(view)) {
+          advise_readahead();
+          return true;
+        }
+      } catch (truncated_archive const&) {
+        L_(warning) << "Ignoring truncated timeslice at offset " << start
+                    << " in file \"" << file_->filename() << "\"";
+      }
+    }
+    // End of the current file
+    if (file_count_ >= filenames_.size()) {
+      eos_ = true;
+      break;
+    }
+    open_file(filenames_.at(file_count_));
+    ++file_count_;
+  }
+  view.file_.reset();
+  return false;
+}
+
+bool TimesliceMappedInputArchive::try_read(TimesliceMappedView& view) {
+  // Parse a serialized StorableTimeslice. Class information (tracking level
+  // and version) precedes the first occurrence of each class type in the
+  // archive. Vectors of primitive types carry no class information.
+  if (!has_timeslice_class_info_) {
+    read_class_info();
+    has_timeslice_class_info_ = true;
+  }
+
+  // timeslice_descriptor_
+  if (!timeslice_descriptor_version_) {
+    timeslice_descriptor_version_ = read_class_info();
+  }
+  TimesliceDescriptor ts_desc{};
+  if (*timeslice_descriptor_version_ > 0) {
+    ts_desc.index = read_value<uint64_t>();
+  }
+  if (*timeslice_descriptor_version_ > 1) {
+    ts_desc.start_time = read_value<uint64_t>();
+    ts_desc.duration = read_value<uint64_t>();
+    ts_desc.flags = read_value<uint32_t>();
+  }
+  ts_desc.ts_pos = read_value<uint64_t>();
+  ts_desc.num_core_microslices = read_value<uint32_t>();
+  ts_desc.num_components = read_value<uint32_t>();
+
+  // data_: vector of vectors of bytes
+  if (!has_data_vector_class_info_) {
+    read_class_info();
+    has_data_vector_class_info_ = true;
+  }
+  auto num_data = read_value<uint64_t>();
+  read_value<uint32_t>(); // item version
+  if (num_data != ts_desc.num_components) {
+    throw std::runtime_error("inconsistent timeslice in file \"" +
+                             file_->filename() + "\"");
+  }
+  view.data_ptr_.resize(num_data);
+  for (auto& data_ptr : view.data_ptr_) {
+    auto size = read_value<uint64_t>();
+    // The mapping is read-only, the Timeslice interface provides no write
+    // access to the data
+    data_ptr = const_cast<uint8_t*>(consume(size)); // NOLINT
+  }
+
+  // desc_: vector of component descriptors
+  if (!has_desc_vector_class_info_) {
+    read_class_info();
+    has_desc_vector_class_info_ = true;
+  }
+  auto num_desc = read_value<uint64_t>();
+  read_value<uint32_t>(); // item version
+  if (num_desc != ts_desc.num_components) {
+    throw std::runtime_error("inconsistent timeslice in file \"" +
+                             file_->filename() + "\"");
+  }
+  if (num_desc > 0 && !component_descriptor_version_) {
+    component_descriptor_version_ = read_class_info();
+  }
+  view.desc_ptr_.resize(num_desc);
+  if (num_desc > 0 && *component_descriptor_version_ >= 1) {
+    // The serialized fields match the packed in-memory layout
+    static_assert(sizeof(TimesliceComponentDescriptor) ==
+                  4 * sizeof(uint64_t) + sizeof(uint32_t));
+    for (auto& desc_ptr : view.desc_ptr_) {
+      desc_ptr = reinterpret_cast<TimesliceComponentDescriptor*>( // NOLINT
+          const_cast<uint8_t*>(
+              consume(sizeof(TimesliceComponentDescriptor)))); // NOLINT
+    }
+  } else {
+    view.desc_storage_.resize(num_desc);
+    for (std::size_t c = 0; c < num_desc; ++c) {
+      auto& desc = view.desc_storage_[c];
+      desc.ts_num = read_value<uint64_t>();
+      desc.offset = read_value<uint64_t>();
+      desc.size = read_value<uint64_t>();
+      desc.num_microslices = read_value<uint64_t>();
+      desc.flags = 0;
+      view.desc_ptr_[c] = &desc;
+    }
+  }
+
+  view.timeslice_descriptor_ = ts_desc;
+  view.file_ = file_;
+  return true;
+}
+
+void TimesliceMappedInputArchive::advise_readahead() {
+  if (readahead_ == 0) {
+    return;
+  }
+  // Keep at least half of the readahead window in front of the current
+  // position in flight
+  if (advised_until_ < position_ + readahead_ / 2) {
+    advised_until_ = std::max(advised_until_, position_);
+    file_->will_need(advised_until_, readahead_);
+    advised_until_ += readahead_;
+  }
+}
+
+const uint8_t* TimesliceMappedInputArchive::consume(std::size_t length) {
+  if (length > file_->size() - position_) {
+    throw truncated_archive();
+  }
+  const uint8_t* ptr = file_->data() + position_;
+  position_ += length;
+  return ptr;
+}
+
+template <typename T> T TimesliceMappedInputArchive::read_value() {
+  T value;
+  std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+  return value;
+}
+
+uint32_t TimesliceMappedInputArchive::read_class_info() {
+  auto tracking = read_value<uint8_t>();
+  auto version = read_value<uint32_t>();
+  if (tracking != 0) {
+    throw std::runtime_error(
+        "unsupported object tracking in memory-mapped input archive file \"" +
+        file_->filename() + "\"");
+  }
+  return version;
+}
+
+} // namespace fles
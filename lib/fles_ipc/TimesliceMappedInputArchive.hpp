@@ -0,0 +1,183 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the fles::TimesliceMappedInputArchive class.
+#pragma once
+
+#include "ArchiveDescriptor.hpp"
+#include "Source.hpp"
+#include "Timeslice.hpp"
+#include "TimesliceComponentDescriptor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The MappedFile class provides a read-only memory mapping of a file.
+ *
+ * The mapping is shared between an archive and the timeslice views pointing
+ * into it, it is released when the last of them is destroyed.
+ */
+class MappedFile {
+public:
+  /// Map the given file read-only, advising sequential access.
+  explicit MappedFile(const std::string& filename);
+
+  /// Delete copy constructor (non-copyable).
+  MappedFile(const MappedFile&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const MappedFile&) = delete;
+
+  ~MappedFile();
+
+  /// Retrieve a pointer to the start of the mapped file.
+  [[nodiscard]] const uint8_t* data() const { return data_; }
+
+  /// Retrieve the size of the mapped file.
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+  /// Retrieve the name of the mapped file.
+  [[nodiscard]] const std::string& filename() const { return filename_; }
+
+  /// Advise the kernel to asynchronously read the given range into memory.
+  void will_need(std::size_t offset, std::size_t length) const;
+
+private:
+  std::string filename_;
+  uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+/**
+ * \brief The TimesliceMappedView class provides access to the data of a
+ * single timeslice in a memory-mapped archive file.
+ *
+ * The microslice descriptors and contents are not copied, but point directly
+ * into the (read-only) mapping.
+ */
+class TimesliceMappedView : public Timeslice {
+public:
+  /// Delete copy constructor (non-copyable).
+  TimesliceMappedView(const TimesliceMappedView&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceMappedView&) = delete;
+
+  ~TimesliceMappedView() override = default;
+
+private:
+  friend class TimesliceMappedInputArchive;
+
+  TimesliceMappedView() = default;
+
+  std::shared_ptr<const MappedFile> file_;
+
+  /// Converted component descriptors, only used for archives written with
+  /// an older descriptor layout than the in-memory one
+  std::vector<TimesliceComponentDescriptor> desc_storage_;
+};
+
+/**
+ * \brief The TimesliceMappedInputArchive class reads timeslices from
+ * uncompressed timeslice archive files without deserialization.
+ *
+ * The archive files are memory-mapped and parsed in place. The returned
+ * timeslice objects point directly into the mapping, so reading a timeslice
+ * does not copy its data. The kernel is advised to read ahead a configurable
+ * window in front of the current position.
+ *
+ * Objects returned by get() own a reference to the mapping and may outlive
+ * the archive. The object returned by next() is reused by subsequent calls,
+ * so that reading requires no heap allocation per timeslice.
+ */
+class TimesliceMappedInputArchive : public Source<Timeslice> {
+public:
+  /// The default size of the readahead window (in bytes).
+  static constexpr std::size_t default_readahead = 64UL << 20;
+
+  /**
+   * \brief Construct an input archive object, map the given archive file,
+   * and read the archive descriptor.
+   *
+   * \param filename File name of the archive file
+   * \param readahead Size of the readahead window (in bytes)
+   */
+  explicit TimesliceMappedInputArchive(
+      const std::string& filename,
+      std::size_t readahead = default_readahead);
+
+  /**
+   * \brief Construct an input archive object for a sequence of archive files,
+   * map the first archive file, and read the archive descriptor.
+   *
+   * \param filenames File names of the archive files
+   * \param readahead Size of the readahead window (in bytes)
+   */
+  explicit TimesliceMappedInputArchive(
+      std::vector<std::string> filenames,
+      std::size_t readahead = default_readahead);
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceMappedInputArchive(const TimesliceMappedInputArchive&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceMappedInputArchive&) = delete;
+
+  ~TimesliceMappedInputArchive() override = default;
+
+  /// Read the next timeslice.
+  std::unique_ptr<TimesliceMappedView> get() {
+    return std::unique_ptr<TimesliceMappedView>(do_get());
+  };
+
+  /**
+   * \brief Read the next timeslice into a view object owned by the archive.
+   *
+   * \return pointer to the timeslice (valid until the next call), or nullptr
+   * if end-of-stream
+   */
+  const Timeslice* next();
+
+  /// Retrieve the archive descriptor (of the current file).
+  [[nodiscard]] const ArchiveDescriptor& descriptor() const {
+    return descriptor_;
+  };
+
+  [[nodiscard]] bool eos() const override { return eos_; }
+
+private:
+  TimesliceMappedView* do_get() override;
+
+  void open_file(const std::string& filename);
+  bool read(TimesliceMappedView& view);
+  bool try_read(TimesliceMappedView& view);
+  void advise_readahead();
+
+  // Parsing of the serialized data at the current position
+  const uint8_t* consume(std::size_t length);
+  template <typename T> T read_value();
+  uint32_t read_class_info();
+
+  const std::vector<std::string> filenames_;
+  std::size_t file_count_ = 0;
+  const std::size_t readahead_;
+
+  std::shared_ptr<const MappedFile> file_;
+  ArchiveDescriptor descriptor_;
+  std::size_t position_ = 0;
+  std::size_t advised_until_ = 0;
+
+  // Class versions (if already seen in the current file)
+  bool has_timeslice_class_info_ = false;
+  std::optional<uint32_t> timeslice_descriptor_version_;
+  bool has_data_vector_class_info_ = false;
+  bool has_desc_vector_class_info_ = false;
+  std::optional<uint32_t> component_descriptor_version_;
+
+  std::unique_ptr<TimesliceMappedView> current_;
+  bool eos_ = false;
+};
+
+} // namespace fles
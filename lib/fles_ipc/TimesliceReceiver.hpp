@@ -5,23 +5,25 @@
 
 #include "ItemWorker.hpp"
 #include "ItemWorkerProtocol.hpp"
+#include "ShmItemWorker.hpp"
 #include "Source.hpp"
 #include "Timeslice.hpp"
 #include "TimesliceShmWorkItem.hpp"
+#include "TimesliceShmWorkItemEncoding.hpp"
 #include "TimesliceView.hpp"
-#include <boost/archive/binary_iarchive.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/uuid/nil_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace fles {
 
 template <class Base, class Derived> class Receiver : public Source<Base> {
 public:
-  Receiver(const std::string&, WorkerParameters) {};
+  Receiver(const std::string&, WorkerParameters, bool = false) {};
   [[nodiscard]] bool eos() const override { return true; };
 
 private:
@@ -36,9 +38,23 @@ template <>
 class Receiver<Timeslice, TimesliceView> : public Source<Timeslice> {
 public:
   /// Construct timeslice receiver connected to a given shared memory.
-  Receiver(const std::string& ipc_identifier, WorkerParameters parameters)
-      : worker_("ipc://@" + ipc_identifier, std::move(parameters)) {
-    worker_.set_disconnect_callback([this] { managed_shm_ = nullptr; });
+  /**
+   * If shm_item_channel is set, the work items are received through the item
+   * channel in the shared memory segment instead of the ZMQ-based
+   * ItemDistributor.
+   */
+  Receiver(const std::string& ipc_identifier,
+           WorkerParameters parameters,
+           bool shm_item_channel = false) {
+    if (shm_item_channel) {
+      shm_worker_ = std::make_unique<ShmItemWorker>(ipc_identifier,
+                                                    std::move(parameters));
+      shm_worker_->set_disconnect_callback([this] { managed_shm_ = nullptr; });
+    } else {
+      worker_ = std::make_unique<ItemWorker>("ipc://@" + ipc_identifier,
+                                             std::move(parameters));
+      worker_->set_disconnect_callback([this] { managed_shm_ = nullptr; });
+    }
   }
 
   /// Delete copy constructor (non-copyable).
@@ -67,33 +83,26 @@ private:
       return nullptr;
     }
 
-    while (auto item = worker_.get()) {
-      fles::TimesliceShmWorkItem timeslice_item;
-      std::istringstream istream(item->payload());
-      {
-        boost::archive::binary_iarchive iarchive(istream);
-        iarchive >> timeslice_item;
+    while (auto item = shm_worker_ ? shm_worker_->get() : worker_->get()) {
+      // the item channel worker is already connected to the shared memory
+      if (shm_worker_ && managed_shm_ != shm_worker_->segment()) {
+        managed_shm_ = shm_worker_->segment();
       }
 
-      // connect to matching shared memory if not already connected
-      if (managed_shm_uuid() != timeslice_item.shm_uuid) {
-        managed_shm_ =
-            std::make_unique<boost::interprocess::managed_shared_memory>(
-                boost::interprocess::open_read_only,
-                timeslice_item.shm_identifier.c_str());
-        std::cout << "TimesliceReceiver: opened shared memory "
-                  << timeslice_item.shm_identifier << " {" << managed_shm_uuid()
-                  << "}" << std::endl;
-        if (managed_shm_uuid() != timeslice_item.shm_uuid) {
-          std::cerr << "TimesliceReceiver: discarding item due to shm uuid "
-                       "mismatch (shm: "
-                    << managed_shm_uuid()
-                    << ", ts_item: " << timeslice_item.shm_uuid << ")"
-                    << std::endl;
+      if (auto timeslice_item =
+              TimesliceShmWorkItemRef::parse(item->payload())) {
+        if (!attach_shm(timeslice_item->shm_uuid(),
+                        timeslice_item->shm_identifier())) {
           continue;
         }
+        return new TimesliceView(managed_shm_, item, *timeslice_item); // NOLINT
       }
 
+      // fallback for producers using the Boost archive format
+      auto timeslice_item = decode_work_item(item->payload());
+      if (!attach_shm(timeslice_item.shm_uuid, timeslice_item.shm_identifier)) {
+        continue;
+      }
       return new TimesliceView(managed_shm_, item, timeslice_item); // NOLINT
     }
 
@@ -101,6 +110,27 @@ private:
     return nullptr;
   }
 
+  /// Connect to the matching shared memory if not already connected.
+  bool attach_shm(const boost::uuids::uuid& shm_uuid,
+                  std::string_view shm_identifier) {
+    if (managed_shm_uuid() == shm_uuid) {
+      return true;
+    }
+    managed_shm_ = std::make_unique<boost::interprocess::managed_shared_memory>(
+        boost::interprocess::open_read_only,
+        std::string(shm_identifier).c_str());
+    std::cout << "TimesliceReceiver: opened shared memory " << shm_identifier
+              << " {" << managed_shm_uuid() << "}" << std::endl;
+    if (managed_shm_uuid() != shm_uuid) {
+      std::cerr << "TimesliceReceiver: discarding item due to shm uuid "
+                   "mismatch (shm: "
+                << managed_shm_uuid() << ", ts_item: " << shm_uuid << ")"
+                << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   std::shared_ptr<boost::interprocess::managed_shared_memory> managed_shm_;
 
   [[nodiscard]] boost::uuids::uuid managed_shm_uuid() const {
@@ -118,8 +148,9 @@ private:
   /// The end-of-stream flag.
   bool eos_ = false;
 
-  // The respective item worker object
-  ItemWorker worker_;
+  // The respective item worker object (one of the two)
+  std::unique_ptr<ItemWorker> worker_;
+  std::unique_ptr<ShmItemWorker> shm_worker_;
 };
 
 } // namespace fles
@@ -0,0 +1,161 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TimesliceShmWorkItemEncoding.hpp"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace fles {
+
+namespace {
+
+using wire::TimesliceShmWorkItemHeader;
+
+constexpr std::size_t data_offset() {
+  return sizeof(TimesliceShmWorkItemHeader);
+}
+
+constexpr std::size_t tsc_desc_offset(std::size_t num_components) {
+  return data_offset() + num_components * sizeof(std::ptrdiff_t);
+}
+
+constexpr std::size_t shm_identifier_offset(std::size_t num_components) {
+  return tsc_desc_offset(num_components) +
+         num_components * sizeof(TimesliceComponentDescriptor);
+}
+
+TimesliceShmWorkItemHeader read_header(const char* payload) {
+  TimesliceShmWorkItemHeader h{};
+  std::memcpy(&h, payload, sizeof(h));
+  return h;
+}
+
+} // namespace
+
+std::optional<TimesliceShmWorkItemRef>
+TimesliceShmWorkItemRef::parse(std::string_view payload) noexcept {
+  if (payload.size() < sizeof(TimesliceShmWorkItemHeader)) {
+    return std::nullopt;
+  }
+  const auto h = read_header(payload.data());
+  if (h.magic != wire::timeslice_shm_work_item_magic ||
+      h.version != wire::timeslice_shm_work_item_version ||
+      h.ts_desc.num_components != h.num_components) {
+    return std::nullopt;
+  }
+  if (payload.size() !=
+      shm_identifier_offset(h.num_components) + h.shm_identifier_size) {
+    return std::nullopt;
+  }
+  return TimesliceShmWorkItemRef(payload.data(), h.num_components);
+}
+
+boost::uuids::uuid TimesliceShmWorkItemRef::shm_uuid() const {
+  boost::uuids::uuid uuid{};
+  std::memcpy(uuid.data,
+              payload_ + offsetof(TimesliceShmWorkItemHeader, shm_uuid),
+              sizeof(uuid.data));
+  return uuid;
+}
+
+std::string_view TimesliceShmWorkItemRef::shm_identifier() const {
+  uint32_t size = 0;
+  std::memcpy(&size,
+              payload_ +
+                  offsetof(TimesliceShmWorkItemHeader, shm_identifier_size),
+              sizeof(size));
+  return {payload_ + shm_identifier_offset(num_components_), size};
+}
+
+TimesliceDescriptor TimesliceShmWorkItemRef::ts_desc() const {
+  TimesliceDescriptor ts_desc{};
+  std::memcpy(&ts_desc,
+              payload_ + offsetof(TimesliceShmWorkItemHeader, ts_desc),
+              sizeof(ts_desc));
+  return ts_desc;
+}
+
+std::ptrdiff_t TimesliceShmWorkItemRef::data(std::size_t component) const {
+  std::ptrdiff_t handle = 0;
+  std::memcpy(&handle,
+              payload_ + data_offset() + component * sizeof(std::ptrdiff_t),
+              sizeof(handle));
+  return handle;
+}
+
+const TimesliceComponentDescriptor*
+TimesliceShmWorkItemRef::tsc_desc(std::size_t component) const {
+  // The descriptor struct is packed, so it may be accessed at any address
+  return reinterpret_cast<const TimesliceComponentDescriptor*>(
+             payload_ + tsc_desc_offset(num_components_)) +
+         component;
+}
+
+std::string encode_work_item_binary(const TimesliceShmWorkItem& item) {
+  const std::size_t num_components = item.data.size();
+  if (item.tsc_desc.size() != num_components) {
+    throw std::invalid_argument(
+        "binary work item encoding requires inline component descriptors");
+  }
+
+  TimesliceShmWorkItemHeader h{};
+  h.magic = wire::timeslice_shm_work_item_magic;
+  h.version = wire::timeslice_shm_work_item_version;
+  std::memcpy(h.shm_uuid, item.shm_uuid.data, sizeof(h.shm_uuid));
+  h.ts_desc = item.ts_desc;
+  h.num_components = static_cast<uint32_t>(num_components);
+  h.shm_identifier_size = static_cast<uint32_t>(item.shm_identifier.size());
+
+  std::string out(shm_identifier_offset(num_components) +
+                      item.shm_identifier.size(),
+                  '\0');
+  char* p = out.data();
+  std::memcpy(p, &h, sizeof(h));
+  if (num_components != 0) {
+    std::memcpy(p + data_offset(), item.data.data(),
+                num_components * sizeof(std::ptrdiff_t));
+    std::memcpy(p + tsc_desc_offset(num_components), item.tsc_desc.data(),
+                num_components * sizeof(TimesliceComponentDescriptor));
+  }
+  std::memcpy(p + shm_identifier_offset(num_components),
+              item.shm_identifier.data(), item.shm_identifier.size());
+  return out;
+}
+
+std::string encode_work_item_boost(const TimesliceShmWorkItem& item) {
+  std::ostringstream ostream;
+  {
+    boost::archive::binary_oarchive oarchive(ostream);
+    oarchive << item;
+  }
+  return ostream.str();
+}
+
+TimesliceShmWorkItem decode_work_item(std::string_view payload) {
+  TimesliceShmWorkItem item{};
+  if (auto ref = TimesliceShmWorkItemRef::parse(payload)) {
+    item.shm_uuid = ref->shm_uuid();
+    item.shm_identifier = ref->shm_identifier();
+    item.ts_desc = ref->ts_desc();
+    item.data.resize(ref->num_components());
+    item.tsc_desc.resize(ref->num_components());
+    for (std::size_t c = 0; c < ref->num_components(); ++c) {
+      item.data[c] = ref->data(c);
+      item.tsc_desc[c] = *ref->tsc_desc(c);
+    }
+    return item;
+  }
+
+  boost::iostreams::stream<boost::iostreams::array_source> istream(
+      payload.data(), payload.size());
+  boost::archive::binary_iarchive iarchive(istream);
+  iarchive >> item;
+  return item;
+}
+
+} // namespace fles
@@ -0,0 +1,98 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+/// \file
+/// \brief Defines the binary encoding of fles::TimesliceShmWorkItem.
+#pragma once
+
+#include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceDescriptor.hpp"
+#include "TimesliceShmWorkItem.hpp"
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace fles {
+
+// Fixed-layout (POD) encoding of a TimesliceShmWorkItem
+//
+// Work items are passed for every timeslice, so decoding them through a Boost
+// archive (stream setup and a heap-allocated vector per member) is avoidable
+// overhead. The binary encoding is a fixed header followed by the data
+// handles, the component descriptors, and the shared memory identifier. It
+// can be accessed in place without allocation. Producer and consumers share a
+// node, so the native endianness is used.
+//
+// A consumer recognizes the encoding by its magic number and falls back to
+// the Boost archive format otherwise.
+
+namespace wire {
+
+#pragma pack(1)
+
+struct TimesliceShmWorkItemHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint8_t shm_uuid[16];
+  TimesliceDescriptor ts_desc;
+  uint32_t num_components;
+  uint32_t shm_identifier_size;
+};
+
+#pragma pack()
+
+static_assert(sizeof(TimesliceShmWorkItemHeader) == 76);
+static_assert(std::is_trivially_copyable_v<TimesliceShmWorkItemHeader>);
+static_assert(std::is_trivially_copyable_v<TimesliceComponentDescriptor>);
+
+/// Magic number of the binary encoding ("TSWI" in memory order).
+constexpr uint32_t timeslice_shm_work_item_magic = 0x49575354;
+/// Current version of the binary encoding.
+constexpr uint32_t timeslice_shm_work_item_version = 1;
+
+} // namespace wire
+
+/**
+ * \brief In-place accessor for a TimesliceShmWorkItem in binary encoding.
+ *
+ * The accessor references the encoded payload, which must outlive it.
+ */
+class TimesliceShmWorkItemRef {
+public:
+  /// Access an encoded payload, or return nullopt if it is not (validly)
+  /// binary encoded.
+  static std::optional<TimesliceShmWorkItemRef>
+  parse(std::string_view payload) noexcept;
+
+  [[nodiscard]] boost::uuids::uuid shm_uuid() const;
+  [[nodiscard]] std::string_view shm_identifier() const;
+  [[nodiscard]] TimesliceDescriptor ts_desc() const;
+  [[nodiscard]] std::size_t num_components() const { return num_components_; }
+
+  /// Retrieve the shared memory handle of a component's data block.
+  [[nodiscard]] std::ptrdiff_t data(std::size_t component) const;
+
+  /// Retrieve a component's descriptor (stored in the payload).
+  [[nodiscard]] const TimesliceComponentDescriptor*
+  tsc_desc(std::size_t component) const;
+
+private:
+  TimesliceShmWorkItemRef(const char* payload, std::size_t num_components)
+      : payload_(payload), num_components_(num_components) {}
+
+  const char* payload_;
+  std::size_t num_components_;
+};
+
+/// Encode a work item in the binary format.
+std::string encode_work_item_binary(const TimesliceShmWorkItem& item);
+
+/// Encode a work item as a Boost binary archive (for older consumers).
+std::string encode_work_item_boost(const TimesliceShmWorkItem& item);
+
+/// Decode a work item in either format. Throws if the payload is invalid.
+TimesliceShmWorkItem decode_work_item(std::string_view payload);
+
+} // namespace fles
@@ -5,6 +5,7 @@
 #include "ItemWorkerProtocol.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "TimesliceShmWorkItem.hpp"
+#include "TimesliceShmWorkItemEncoding.hpp"
 
 #include <boost/interprocess/interprocess_fwd.hpp>
 #include <cstdint>
@@ -40,7 +41,33 @@ TimesliceView::TimesliceView(
         managed_shm_->get_address_from_handle(timeslice_item_.data.at(c)));
   }
 
-  // consistency check
+  check_consistency();
+}
+
+TimesliceView::TimesliceView(
+    std::shared_ptr<boost::interprocess::managed_shared_memory> managed_shm,
+    std::shared_ptr<const Item> work_item,
+    const TimesliceShmWorkItemRef& timeslice_item)
+    : managed_shm_(std::move(managed_shm)), work_item_(std::move(work_item)) {
+
+  timeslice_descriptor_ = timeslice_item.ts_desc();
+
+  // initialize access pointer vectors
+  data_ptr_.resize(num_components());
+  desc_ptr_.resize(num_components());
+
+  for (size_t c = 0; c < num_components(); ++c) {
+    // Not modified, as with the data in the read-only shared memory
+    desc_ptr_.at(c) = const_cast<fles::TimesliceComponentDescriptor*>(
+        timeslice_item.tsc_desc(c));
+    data_ptr_.at(c) = static_cast<uint8_t*>(
+        managed_shm_->get_address_from_handle(timeslice_item.data(c)));
+  }
+
+  check_consistency();
+}
+
+void TimesliceView::check_consistency() const {
   for (size_t c = 1; c < num_components(); ++c) {
     if (timeslice_descriptor_.index != desc_ptr_.at(c)->ts_num) {
       std::cerr << "TimesliceView consistency check failed: index="
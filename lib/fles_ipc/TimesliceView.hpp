@@ -6,6 +6,7 @@
 #include "ItemWorkerProtocol.hpp"
 #include "Timeslice.hpp"
 #include "TimesliceShmWorkItem.hpp"
+#include "TimesliceShmWorkItemEncoding.hpp"
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <memory>
 
@@ -35,8 +36,18 @@ private:
       std::shared_ptr<const Item> work_item,
       const TimesliceShmWorkItem& timeslice_item);
 
+  /// Construct from a binary encoded work item. The component descriptors are
+  /// accessed in the work item payload.
+  TimesliceView(
+      std::shared_ptr<boost::interprocess::managed_shared_memory> managed_shm,
+      std::shared_ptr<const Item> work_item,
+      const TimesliceShmWorkItemRef& timeslice_item);
+
+  void check_consistency() const;
+
   std::shared_ptr<boost::interprocess::managed_shared_memory> managed_shm_;
   std::shared_ptr<const Item> work_item_;
+  /// The decoded work item (only for the Boost archive format)
   fles::TimesliceShmWorkItem timeslice_item_;
 };
 
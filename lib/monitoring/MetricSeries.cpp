@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2025 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#include "MetricSeries.hpp"
+
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+namespace cbm {
+
+/*! \class MetricSeries
+  \brief Pre-registered metric with lock-free, allocation-free updates
+
+  A MetricSeries is a measurement with a fixed set of tags whose fields are
+  declared once and then updated via lightweight handles:
+  - Counter(): monotonic counter, updated with MetricCounter::Add()
+  - Gauge(): floating point value, updated with MetricGauge::Set()
+  - Histogram(): distribution over fixed buckets, updated with
+    MetricHistogram::Record()
+
+  An update is a single relaxed atomic operation (plus a binary search over
+  the bucket bounds for histograms), so handles can be used in per-event hot
+  loops. The Monitor takes a Snapshot() of all registered series periodically
+  and passes it to the sinks like a queued metric. Counters and histograms are
+  reported as totals since registration.
+
+  Declaring an existing field again with the same kind returns a handle to
+  the existing field, so independent code parts can share a field.
+
+  Series are created with Monitor::RegisterSeries() and live as long as the
+  Monitor, handles must not be used after the Monitor is destroyed.
+*/
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param bounds  upper bounds of the buckets, sorted ascending. An additional
+                 overflow bucket counts all larger values.
+  \throws std::runtime_error if `bounds` is not sorted
+ */
+
+MetricHistogramData::MetricHistogramData(std::vector<uint64_t> bounds)
+    : fBounds(std::move(bounds)),
+      fBucket(std::make_unique<std::atomic<uint64_t>[]>(fBounds.size() + 1)) {
+  if (!std::is_sorted(fBounds.begin(), fBounds.end()))
+    throw std::runtime_error("MetricHistogramData::ctor: bounds not sorted");
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Constructor
+  \param measurement  measurement id
+  \param tagset       set of tags
+ */
+
+MetricSeries::MetricSeries(const std::string& measurement,
+                           const MetricTagSet& tagset)
+    : fMeasurement(measurement), fTagset(tagset) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Registers a counter field
+  \param field  field name
+  \throws std::runtime_error if a field named `field` of another kind exists
+  \returns handle to the counter, the existing one if already registered
+ */
+
+MetricCounter MetricSeries::Counter(const std::string& field) {
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (auto pvalue = FindField(fCounters, field))
+    return MetricCounter(pvalue);
+  CheckField(field);
+  auto& entry = fCounters.emplace_back(
+      field, std::make_unique<std::atomic<uint64_t>>(0));
+  return MetricCounter(entry.second.get());
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Registers a gauge field
+  \param field  field name
+  \throws std::runtime_error if a field named `field` of another kind exists
+  \returns handle to the gauge, the existing one if already registered
+ */
+
+MetricGauge MetricSeries::Gauge(const std::string& field) {
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (auto pvalue = FindField(fGauges, field))
+    return MetricGauge(pvalue);
+  CheckField(field);
+  auto& entry =
+      fGauges.emplace_back(field, std::make_unique<std::atomic<double>>(0.));
+  return MetricGauge(entry.second.get());
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Registers a histogram
+  \param field   field name prefix
+  \param bounds  upper bounds of the buckets, sorted ascending
+  \throws std::runtime_error if a field named `field` of another kind or a
+    histogram with different bounds exists, or `bounds` is not sorted
+  \returns handle to the histogram, the existing one if already registered
+
+  The histogram is reported as fields `<field>_count`, `<field>_sum`, and
+  `<field>_bucket_<bound>` for each bucket, with `<field>_bucket_inf` for the
+  overflow bucket.
+ */
+
+MetricHistogram MetricSeries::Histogram(const std::string& field,
+                                        std::vector<uint64_t> bounds) {
+  auto pdata = std::make_unique<MetricHistogramData>(std::move(bounds));
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (auto pexisting = FindField(fHistograms, field)) {
+    if (pexisting->fBounds != pdata->fBounds)
+      throw std::runtime_error(fmt::format(
+          "MetricSeries::Histogram: histogram '{}' in '{}' already defined "
+          "with different bounds",
+          field, fMeasurement));
+    return MetricHistogram(pexisting);
+  }
+  CheckField(field);
+  auto& entry = fHistograms.emplace_back(field, std::move(pdata));
+  return MetricHistogram(entry.second.get());
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the current values of all fields
+  \param timestamp  timestamp of the returned Metric
+ */
+
+Metric MetricSeries::Snapshot(time_point timestamp) const {
+  MetricFieldSet fieldset;
+  std::lock_guard<std::mutex> lock(fMutex);
+  for (const auto& [name, pvalue] : fCounters)
+    fieldset.emplace_back(name, pvalue->load(std::memory_order_relaxed));
+  for (const auto& [name, pvalue] : fGauges)
+    fieldset.emplace_back(name, pvalue->load(std::memory_order_relaxed));
+  for (const auto& [name, pdata] : fHistograms) {
+    fieldset.emplace_back(name + "_count",
+                          pdata->fCount.load(std::memory_order_relaxed));
+    fieldset.emplace_back(name + "_sum",
+                          pdata->fSum.load(std::memory_order_relaxed));
+    for (size_t i = 0; i <= pdata->fBounds.size(); i++) {
+      auto bound = i < pdata->fBounds.size()
+                       ? std::to_string(pdata->fBounds[i])
+                       : std::string("inf");
+      fieldset.emplace_back(name + "_bucket_" + bound,
+                            pdata->fBucket[i].load(std::memory_order_relaxed));
+    }
+  }
+  return Metric(fMeasurement, fTagset, std::move(fieldset), timestamp);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Checks that no field named `field` exists, must be called with
+  fMutex held
+  \throws std::runtime_error if a field named `field` already exists
+ */
+
+void MetricSeries::CheckField(const std::string& field) const {
+  auto match = [&field](const auto& entry) { return entry.first == field; };
+  if (std::any_of(fCounters.begin(), fCounters.end(), match) ||
+      std::any_of(fGauges.begin(), fGauges.end(), match) ||
+      std::any_of(fHistograms.begin(), fHistograms.end(), match))
+    throw std::runtime_error(fmt::format(
+        "MetricSeries::CheckField: field '{}' already defined in '{}'", field,
+        fMeasurement));
+}
+
+} // end namespace cbm
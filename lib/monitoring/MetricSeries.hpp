@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2025 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+#ifndef included_Cbm_MetricSeries
+#define included_Cbm_MetricSeries 1
+
+#include "Metric.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cbm {
+
+struct MetricHistogramData {
+  explicit MetricHistogramData(std::vector<uint64_t> bounds);
+
+  std::vector<uint64_t> fBounds;                    //!< bucket upper bounds
+  std::unique_ptr<std::atomic<uint64_t>[]> fBucket; //!< bucket counts
+  std::atomic<uint64_t> fCount{0};                  //!< # of values
+  std::atomic<uint64_t> fSum{0};                    //!< sum of values
+};
+
+class MetricCounter {
+public:
+  MetricCounter() = default;
+  explicit MetricCounter(std::atomic<uint64_t>* pvalue);
+
+  void Add(uint64_t n = 1) const;
+
+private:
+  std::atomic<uint64_t>* fpValue{nullptr}; //!< counter storage
+};
+
+class MetricGauge {
+public:
+  MetricGauge() = default;
+  explicit MetricGauge(std::atomic<double>* pvalue);
+
+  void Set(double value) const;
+
+private:
+  std::atomic<double>* fpValue{nullptr}; //!< gauge storage
+};
+
+class MetricHistogram {
+public:
+  MetricHistogram() = default;
+  explicit MetricHistogram(MetricHistogramData* pdata);
+
+  void Record(uint64_t value) const;
+
+private:
+  MetricHistogramData* fpData{nullptr}; //!< histogram storage
+};
+
+class MetricSeries {
+public:
+  using time_point = std::chrono::system_clock::time_point;
+
+  MetricSeries(const std::string& measurement, const MetricTagSet& tagset);
+
+  MetricSeries(const MetricSeries&) = delete;
+  MetricSeries& operator=(const MetricSeries&) = delete;
+
+  MetricCounter Counter(const std::string& field);
+  MetricGauge Gauge(const std::string& field);
+  MetricHistogram Histogram(const std::string& field,
+                            std::vector<uint64_t> bounds);
+
+  [[nodiscard]] const std::string& Measurement() const;
+  [[nodiscard]] const MetricTagSet& Tagset() const;
+  [[nodiscard]] Metric Snapshot(time_point timestamp) const;
+
+private:
+  template <typename T>
+  using field_t = std::pair<std::string, std::unique_ptr<T>>;
+
+  template <typename T>
+  static T* FindField(const std::vector<field_t<T>>& fields,
+                      const std::string& field);
+  void CheckField(const std::string& field) const;
+
+  std::string fMeasurement; //!< measurement name
+  MetricTagSet fTagset;     //!< set of tags
+  std::vector<field_t<std::atomic<uint64_t>>> fCounters;  //!< counters
+  std::vector<field_t<std::atomic<double>>> fGauges;      //!< gauges
+  std::vector<field_t<MetricHistogramData>> fHistograms; //!< histograms
+  mutable std::mutex fMutex; //!< mutex for field list access
+};
+
+} // end namespace cbm
+
+#include "MetricSeries.ipp"
+
+#endif
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-3.0-only
+// (C) Copyright 2025 Johann Wolfgang Goethe-Universität Frankfurt
+// Original author: Jan de Cuveland <cuveland@compeng.uni-frankfurt.de>
+
+namespace cbm {
+
+/*! \class MetricCounter
+  \brief Handle to a monotonic counter of a MetricSeries
+
+  A default constructed handle is not bound to a series, all updates are
+  silently ignored.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Constructor, binds handle to counter storage
+
+inline MetricCounter::MetricCounter(std::atomic<uint64_t>* pvalue)
+    : fpValue(pvalue) {}
+
+//-----------------------------------------------------------------------------
+//! \brief Increments the counter by `n`
+
+inline void MetricCounter::Add(uint64_t n) const {
+  if (fpValue)
+    fpValue->fetch_add(n, std::memory_order_relaxed);
+}
+
+/*! \class MetricGauge
+  \brief Handle to a gauge of a MetricSeries
+
+  A default constructed handle is not bound to a series, all updates are
+  silently ignored.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Constructor, binds handle to gauge storage
+
+inline MetricGauge::MetricGauge(std::atomic<double>* pvalue)
+    : fpValue(pvalue) {}
+
+//-----------------------------------------------------------------------------
+//! \brief Sets the gauge to `value`
+
+inline void MetricGauge::Set(double value) const {
+  if (fpValue)
+    fpValue->store(value, std::memory_order_relaxed);
+}
+
+/*! \class MetricHistogram
+  \brief Handle to a histogram of a MetricSeries
+
+  A default constructed handle is not bound to a series, all updates are
+  silently ignored.
+*/
+
+//-----------------------------------------------------------------------------
+//! \brief Constructor, binds handle to histogram storage
+
+inline MetricHistogram::MetricHistogram(MetricHistogramData* pdata)
+    : fpData(pdata) {}
+
+//-----------------------------------------------------------------------------
+/*! \brief Records a value
+  \param value  value, counted in the first bucket with an upper bound not
+                less than `value`, or in the overflow bucket
+ */
+
+inline void MetricHistogram::Record(uint64_t value) const {
+  if (!fpData)
+    return;
+  const auto& bounds = fpData->fBounds;
+  auto ind = std::lower_bound(bounds.begin(), bounds.end(), value) -
+             bounds.begin();
+  fpData->fBucket[ind].fetch_add(1, std::memory_order_relaxed);
+  fpData->fCount.fetch_add(1, std::memory_order_relaxed);
+  fpData->fSum.fetch_add(value, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+/*! \brief Returns the storage of field `field` in `fields`, or nullptr if
+  there is none, must be called with fMutex held
+ */
+
+template <typename T>
+inline T* MetricSeries::FindField(const std::vector<field_t<T>>& fields,
+                                  const std::string& field) {
+  auto it = std::find_if(fields.begin(), fields.end(),
+                         [&field](const auto& entry) {
+                           return entry.first == field;
+                         });
+  return it != fields.end() ? it->second.get() : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns measurement name
+
+inline const std::string& MetricSeries::Measurement() const {
+  return fMeasurement;
+}
+
+//-----------------------------------------------------------------------------
+//! \brief Returns set of tags
+
+inline const MetricTagSet& MetricSeries::Tagset() const { return fTagset; }
+
+} // end namespace cbm
@@ -42,6 +42,22 @@ namespace cbm {
 
   See QueueMetric() for a more detailed description the Monitor input interface.
 
+  For metrics updated at high rate, e.g. per timeslice, queueing a Metric for
+  each update is too costly. Instead, a MetricSeries is registered once with
+  RegisterSeries() and its fields are declared to obtain handles, which are
+  updated with a single relaxed atomic operation
+  \code{.cpp}
+   auto& series = Monitor::Ref().RegisterSeries("TesterLoop",
+                                                {{"wid", WorkerId()}});
+   auto ndone = series.Counter("ndone");
+   auto dt = series.Histogram("dt_ns", {1000, 10000, 100000});
+   ...
+   ndone.Add();      // in the hot loop
+   dt.Record(dtns);
+  \endcode
+  The Monitor work thread takes a snapshot of all registered series every
+  kSnapshotInterval and processes it like a queued metric.
+
   The Monitor back end is provided by MonitorSink objects and controlled via
   - OpenSink(): creates a new sink
   - CloseSink(): removes a sink
@@ -61,6 +77,8 @@ namespace cbm {
     `mutex` is thus very unlikely:
     - at metrics queueing: just a `vector::push_back(move(...))`
     - at metrics processing: just a `vector::swap(...)`
+  - MetricSeries handles do not use the `mutex` at all, the registration of
+    series and fields is protected by separate `mutex`es
 */
 
 //-----------------------------------------------------------------------------
@@ -82,6 +100,7 @@ Monitor::Monitor(const std::string& sname) {
 
   // init heartbeat sequence
   fNextHeartbeat = std::chrono::system_clock::now();
+  fNextSnapshot = fNextHeartbeat + kSnapshotInterval;
 
   // start EventLoop
   fThread = std::thread([this]() { EventLoop(); });
@@ -265,6 +284,39 @@ void Monitor::QueueMetric(const std::string& measurement,
   QueueMetric(std::move(point));
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief Registers a metric series
+  \param measurement  measurement id
+  \param tagset       set of tags
+  \returns reference to the series, valid for the lifetime of the Monitor
+
+  If a series with the same measurement id and tags is already registered,
+  it is returned. Use MetricSeries::Counter(), MetricSeries::Gauge(), and
+  MetricSeries::Histogram() to declare fields and obtain update handles.
+ */
+
+MetricSeries& Monitor::RegisterSeries(const std::string& measurement,
+                                      const MetricTagSet& tagset) {
+  MetricSeries* pseries = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(fSeriesMutex);
+    for (auto& series : fSeries) {
+      if (series->Measurement() == measurement && series->Tagset() == tagset)
+        return *series;
+    }
+    fSeries.emplace_back(std::make_unique<MetricSeries>(measurement, tagset));
+    pseries = fSeries.back().get();
+  }
+
+  // wake up worker thread to schedule snapshots
+  {
+    std::lock_guard<std::mutex> lk(fControlMutex);
+    fSeriesAdded = true;
+  }
+  fControlCV.notify_one();
+  return *pseries;
+}
+
 //-----------------------------------------------------------------------------
 /*! \brief The event loop of Monitor work thread
  */
@@ -276,9 +328,17 @@ void Monitor::EventLoop() {
   bool stopped = false;
   while (!stopped) {
     std::unique_lock lk(fControlMutex);
-    stopped =
-        fControlCV.wait_for(lk, kELoopTimeout, [this] { return fStopped; });
+    auto deadline = std::chrono::system_clock::now() + kELoopTimeout;
+    {
+      std::lock_guard<std::mutex> lock(fSeriesMutex);
+      if (!fSeries.empty() && fNextSnapshot < deadline)
+        deadline = fNextSnapshot;
+    }
+    fControlCV.wait_until(lk, deadline,
+                          [this] { return fStopped || fSeriesAdded; });
     // timeout results in auto flush
+    stopped = fStopped;
+    fSeriesAdded = false;
 
     metvec_t metvec;
     {
@@ -298,6 +358,15 @@ void Monitor::EventLoop() {
       }
     }
 
+    auto now = std::chrono::system_clock::now();
+    if (now >= fNextSnapshot || stopped) {
+      // take the final snapshot at rundown
+      SnapshotSeries(metvec);
+      fNextSnapshot += kSnapshotInterval;
+      if (fNextSnapshot <= now) // skip missed snapshots
+        fNextSnapshot = now + kSnapshotInterval;
+    }
+
     if (metvec.size() > 0) {
       std::lock_guard<std::mutex> lock(fSinkMapMutex);
       for (auto& kv : fSinkMap)
@@ -313,6 +382,21 @@ void Monitor::EventLoop() {
   }
 }
 
+//-----------------------------------------------------------------------------
+/*! \brief Appends a snapshot of all registered series to a metric list
+  \param metvec  metric list
+ */
+
+void Monitor::SnapshotSeries(std::vector<Metric>& metvec) {
+  auto now = std::chrono::system_clock::now();
+  std::lock_guard<std::mutex> lock(fSeriesMutex);
+  for (auto& series : fSeries) {
+    auto point = series->Snapshot(now);
+    if (!point.fFieldset.empty()) // skip series without fields
+      metvec.emplace_back(std::move(point));
+  }
+}
+
 //-----------------------------------------------------------------------------
 /*! \brief Returns reference to a sink
   \param sname    sink name, given as proto:path
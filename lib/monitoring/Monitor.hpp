@@ -6,6 +6,7 @@
 #define included_Cbm_Monitor 1
 
 #include "Metric.hpp"
+#include "MetricSeries.hpp"
 #include "MonitorSink.hpp"
 
 #include "SystemInfo.hpp" // for convenience for the users of Monitor
@@ -51,6 +52,8 @@ public:
                    MetricTagSet&& tagset,
                    MetricFieldSet&& fieldset,
                    time_point timestamp = time_point());
+  MetricSeries& RegisterSeries(const std::string& measurement,
+                               const MetricTagSet& tagset);
   [[nodiscard]] const std::string& HostName() const;
 
   static Monitor& Ref();
@@ -61,19 +64,24 @@ public:
       std::chrono::seconds(10); //!< monitor flush time
   static constexpr auto kHeartbeat =
       std::chrono::seconds(60); //!< heartbeat interval
+  static constexpr auto kSnapshotInterval =
+      std::chrono::seconds(1); //!< MetricSeries snapshot interval
 
 private:
   void EventLoop();
   MonitorSink& SinkRef(const std::string& sname);
+  void SnapshotSeries(std::vector<Metric>& metvec);
 
   using metvec_t = std::vector<Metric>;
   using sink_uptr_t = std::unique_ptr<MonitorSink>;
   using smap_t = std::unordered_map<std::string, sink_uptr_t>;
+  using series_uptr_t = std::unique_ptr<MetricSeries>;
 
   std::thread fThread;                //!< worker thread
   std::condition_variable fControlCV; //!< condition variable for thread control
   std::mutex fControlMutex;           //!< mutex for thread control
   bool fStopped{false};               //!< signals thread rundown
+  bool fSeriesAdded{false};           //!< signals new metric series
 
   metvec_t fMetVec;            //!< metric list
   std::mutex fMetVecMutex;     //!< mutex for fMetVec access
@@ -82,6 +90,10 @@ private:
   std::mutex fSinkMapMutex;    //!< mutex for fSinkMap access
   time_point fNextHeartbeat;   //!< time of next heartbeat
   static Monitor* fpSingleton; //!< \glos{singleton} this
+
+  std::vector<series_uptr_t> fSeries; //!< registered metric series
+  std::mutex fSeriesMutex;            //!< mutex for fSeries access
+  time_point fNextSnapshot;           //!< time of next series snapshot
 };
 
 } // end namespace cbm
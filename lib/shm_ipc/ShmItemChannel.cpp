@@ -0,0 +1,56 @@
+#include "ShmItemChannel.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace shm_item_channel {
+
+// The futex word is shared between processes, so the non-private futex
+// operations are used. Without futex support, waiting falls back to polling.
+
+void futex_wait(std::atomic<uint32_t>* word,
+                uint32_t expected,
+                std::chrono::milliseconds timeout) {
+#ifdef __linux__
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+  const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  struct timespec ts {};
+  ts.tv_sec = seconds.count();
+  ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   timeout - seconds)
+                   .count();
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected,
+          &ts, nullptr, 0);
+#else
+  constexpr auto poll_interval = std::chrono::microseconds{100};
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (word->load() == expected &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(poll_interval);
+  }
+#endif
+}
+
+void futex_wake(std::atomic<uint32_t>* word) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+bool process_is_alive(int32_t pid) {
+  return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+}
+
+} // namespace shm_item_channel
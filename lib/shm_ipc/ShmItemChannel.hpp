@@ -0,0 +1,152 @@
+#ifndef SHM_IPC_SHMITEMCHANNEL_HPP
+#define SHM_IPC_SHMITEMCHANNEL_HPP
+
+#include "ItemWorkerProtocol.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * The shared memory item channel
+ *
+ * An alternative to the ZMQ-based ItemDistributor protocol for producers and
+ * workers on the same node. The channel is an object in the producer's
+ * managed shared memory segment. It has a fixed number of worker slots, each
+ * with a ring for work items (producer to worker) and a ring for completions
+ * (worker to producer). There is no broker: the producer distributes items to
+ * the worker slots itself.
+ *
+ * A worker claims a free slot, fills in its parameters and marks the slot as
+ * active. The producer picks it up on its next call. Work item payloads are
+ * allocated in the shared memory segment and referenced by handle. An idle
+ * worker sleeps on a futex, which the producer wakes after pushing an item.
+ * Completions are polled by the producer.
+ *
+ * A terminated worker is detected by its process ID, which it claims before the
+ * slot leaves the free state. Its slot is then cleaned up by the producer, even
+ * if the worker died while registering. A worker that is still running but
+ * violates the protocol is evicted: the producer stops serving the slot, but
+ * does not reuse it until the worker has acknowledged the eviction (or
+ * terminated), so the worker cannot interfere with the next occupant. The slot
+ * generation lets a worker detect that its slot has been handed over in any
+ * case. The producer marks the channel as closed on shutdown, and workers
+ * reconnect once a new channel is available.
+ */
+
+constexpr static const char* shm_item_channel_name = "ShmItemChannel";
+constexpr static std::size_t shm_item_channel_max_workers = 32;
+constexpr static std::size_t shm_item_ring_size = 64;
+constexpr static std::size_t shm_item_client_name_size = 64;
+constexpr static auto shm_item_channel_check_interval =
+    std::chrono::milliseconds{500};
+
+/// Lock-free single-producer/single-consumer ring in shared memory.
+template <typename T, std::size_t N> class ShmRing {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert((N & (N - 1)) == 0, "ring size must be a power of two");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+public:
+  bool try_push(const T& value) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+    entries_[tail & (N - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& value) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = entries_[head & (N - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Discard all entries (only if neither side is using the ring).
+  void reset() {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  // Objects in managed shared memory are not over-aligned, so the indices are
+  // kept on separate cache lines by padding instead of alignas
+  static constexpr std::size_t cache_line_size = 64;
+
+  std::atomic<uint64_t> head_{0};
+  char head_padding_[cache_line_size - sizeof(std::atomic<uint64_t>)]{};
+  std::atomic<uint64_t> tail_{0};
+  char tail_padding_[cache_line_size - sizeof(std::atomic<uint64_t>)]{};
+  T entries_[N]{};
+};
+
+/// A work item as transmitted through a worker slot.
+struct ShmWorkEntry {
+  ItemID id;
+  /// Handle of the payload in the shared memory segment (if size is not 0)
+  std::ptrdiff_t payload_handle;
+  uint64_t payload_size;
+};
+
+enum class ShmWorkerSlotState : uint32_t {
+  Free,        ///< available for a new worker
+  Registering, ///< claimed by a worker, parameters not yet valid
+  Active,      ///< parameters valid, worker is receiving items
+  Evicted,     ///< removed by the producer, to be acknowledged by the worker
+  Closing      ///< worker has disconnected, to be cleaned up by the producer
+};
+
+struct ShmWorkerSlot {
+  std::atomic<ShmWorkerSlotState> state{ShmWorkerSlotState::Free};
+  /// Incremented by the producer each time the slot is freed
+  std::atomic<uint32_t> generation{0};
+  /// Process ID of the worker, claimed before the slot leaves Free state
+  std::atomic<int32_t> pid{0};
+
+  // Worker parameters, valid in Active state
+  uint64_t stride = 1;
+  uint64_t offset = 0;
+  WorkerQueuePolicy queue_policy = WorkerQueuePolicy::QueueAll;
+  uint64_t group_id = 0;
+  char client_name[shm_item_client_name_size]{};
+
+  /// Futex word, incremented by the producer for each new work item
+  std::atomic<uint32_t> work_signal{0};
+  /// Set by the worker while it is (about to be) waiting on the futex
+  std::atomic<uint32_t> worker_waiting{0};
+
+  ShmRing<ShmWorkEntry, shm_item_ring_size> work;
+  ShmRing<ItemID, shm_item_ring_size> completions;
+};
+
+struct ShmItemChannel {
+  /// Set by the producer on shutdown
+  std::atomic<bool> closed{false};
+  int32_t producer_pid = 0;
+  ShmWorkerSlot slots[shm_item_channel_max_workers];
+};
+
+namespace shm_item_channel {
+
+/// Wait until the futex word differs from expected, or until timeout.
+void futex_wait(std::atomic<uint32_t>* word,
+                uint32_t expected,
+                std::chrono::milliseconds timeout);
+
+/// Wake all waiters on the futex word.
+void futex_wake(std::atomic<uint32_t>* word);
+
+/// Check if the process with the given ID is still running.
+bool process_is_alive(int32_t pid);
+
+} // namespace shm_item_channel
+
+#endif
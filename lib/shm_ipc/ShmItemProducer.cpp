@@ -0,0 +1,248 @@
+#include "ShmItemProducer.hpp"
+#include "log.hpp"
+
+#include <cstring>
+#include <exception>
+#include <set>
+#include <stdexcept>
+#include <unistd.h>
+#include <utility>
+
+ShmItemProducer::ShmItemProducer(
+    boost::interprocess::managed_shared_memory& shm)
+    : shm_(shm) {
+  channel_ = shm_.construct<ShmItemChannel>(shm_item_channel_name)();
+  channel_->producer_pid = getpid();
+}
+
+ShmItemProducer::~ShmItemProducer() {
+  channel_->closed.store(true, std::memory_order_release);
+  for (auto& slot : channel_->slots) {
+    slot.work_signal.fetch_add(1, std::memory_order_release);
+    shm_item_channel::futex_wake(&slot.work_signal);
+  }
+  workers_.clear();
+  for (auto& [id, payload] : payloads_) {
+    shm_.deallocate(payload.data);
+  }
+}
+
+void ShmItemProducer::send_work_item(ItemID id, const std::string& payload) {
+  update_workers();
+
+  if (!payload.empty()) {
+    void* data = shm_.allocate(payload.size(), std::nothrow);
+    if (data == nullptr) {
+      throw std::runtime_error("Cannot allocate work item payload");
+    }
+    std::memcpy(data, payload.data(), payload.size());
+    payloads_[id] = {data, payload.size()};
+  }
+
+  auto new_item = std::make_shared<Item>(&completed_items_, id, "");
+
+  // Distribute the new work item, as done by the ItemDistributor.
+  // If a group_id is set, send only once per group.
+  std::set<size_t> completed_groups;
+  std::vector<std::size_t> failed_workers;
+  for (auto& [index, worker] : workers_) {
+    if (worker->group_id() != 0 &&
+        completed_groups.find(worker->group_id()) != completed_groups.end()) {
+      // This group has already been served, skip it
+      continue;
+    }
+    if (!worker->wants(new_item->id())) {
+      continue;
+    }
+    if (worker->queue_policy() == WorkerQueuePolicy::PrebufferOne) {
+      worker->clear_queue();
+    }
+    if (worker->is_idle()) {
+      // The worker is idle, send the item immediately
+      if (worker->group_id() != 0) {
+        completed_groups.insert(worker->group_id());
+        // As we can send the item immediately, delete this work item from
+        // the queues of other (previous) workers with the same group_id
+        for (auto& [other_index, other_worker] : workers_) {
+          if (other_worker == worker) {
+            break;
+          }
+          if (other_worker->group_id() == worker->group_id()) {
+            other_worker->delete_from_queue(new_item->id());
+          }
+        }
+      }
+      try {
+        send_worker_work_item(index, *new_item);
+        worker->add_outstanding(new_item);
+      } catch (std::exception& e) {
+        L_(error) << e.what();
+        failed_workers.push_back(index);
+      }
+    } else if (worker->queue_policy() != WorkerQueuePolicy::Skip) {
+      // The worker is busy, enqueue the item
+      worker->push_queue(new_item);
+    }
+  }
+  for (auto index : failed_workers) {
+    evict_worker(index);
+  }
+  // The item is completed here if it is not sent to any worker
+}
+
+bool ShmItemProducer::try_receive_completion(ItemID* id) {
+  if (completed_items_.empty()) {
+    update_workers();
+    for (std::size_t index = 0; index < shm_item_channel_max_workers;
+         ++index) {
+      if (workers_.count(index) != 0) {
+        receive_worker_completions(index);
+      }
+    }
+  }
+  if (completed_items_.empty()) {
+    return false;
+  }
+
+  *id = completed_items_.front();
+  completed_items_.pop();
+  if (auto it = payloads_.find(*id); it != payloads_.end()) {
+    shm_.deallocate(it->second.data);
+    payloads_.erase(it);
+  }
+  return true;
+}
+
+void ShmItemProducer::update_workers() {
+  const auto now = std::chrono::steady_clock::now();
+  const bool check_liveness =
+      now > last_liveness_check_ + shm_item_channel_check_interval;
+  if (check_liveness) {
+    last_liveness_check_ = now;
+  }
+
+  for (std::size_t index = 0; index < shm_item_channel_max_workers; ++index) {
+    auto& slot = channel_->slots[index];
+    auto state = slot.state.load(std::memory_order_acquire);
+    const bool known = workers_.count(index) != 0;
+
+    if (state == ShmWorkerSlotState::Active && !known) {
+      // Handle new worker registration
+      const std::string client_name(
+          slot.client_name,
+          strnlen(slot.client_name, shm_item_client_name_size));
+      const std::string message =
+          "REGISTER " + std::to_string(slot.stride) + " " +
+          std::to_string(slot.offset) + " " + to_string(slot.queue_policy) +
+          " " + std::to_string(slot.group_id) + " " + client_name;
+      try {
+        workers_[index] = std::make_unique<ItemDistributorWorker>(message);
+        L_(info) << "worker connected: " << workers_.at(index)->description();
+      } catch (std::exception& e) {
+        L_(error) << e.what();
+        evict_worker(index);
+      }
+    } else if (state == ShmWorkerSlotState::Closing) {
+      free_slot(index);
+    } else if (check_liveness) {
+      // A free slot with a process ID has been claimed by a worker that may
+      // have terminated before leaving Free state
+      const int32_t pid = slot.pid.load(std::memory_order_acquire);
+      if ((state != ShmWorkerSlotState::Free || pid != 0) &&
+          !shm_item_channel::process_is_alive(pid)) {
+        L_(error) << "worker process " << pid << " has terminated";
+        free_slot(index);
+      }
+    }
+  }
+}
+
+void ShmItemProducer::evict_worker(std::size_t index) {
+  auto& slot = channel_->slots[index];
+  auto expected = ShmWorkerSlotState::Active;
+  if (!slot.state.compare_exchange_strong(expected,
+                                          ShmWorkerSlotState::Evicted,
+                                          std::memory_order_acq_rel)) {
+    // The worker has disconnected in the meantime
+    free_slot(index);
+    return;
+  }
+  if (auto it = workers_.find(index); it != workers_.end()) {
+    L_(info) << "worker evicted: " << it->second->description();
+    // Outstanding and queued items of this worker are released here
+    workers_.erase(it);
+  }
+
+  // Wake the worker so that it notices the eviction
+  slot.work_signal.fetch_add(1, std::memory_order_release);
+  shm_item_channel::futex_wake(&slot.work_signal);
+}
+
+void ShmItemProducer::free_slot(std::size_t index) {
+  auto it = workers_.find(index);
+  if (it != workers_.end()) {
+    L_(info) << "worker disconnected: " << it->second->description();
+    // Outstanding and queued items of this worker are released here
+    workers_.erase(it);
+  }
+  auto& slot = channel_->slots[index];
+  slot.work.reset();
+  slot.completions.reset();
+  slot.worker_waiting.store(0, std::memory_order_relaxed);
+  slot.generation.fetch_add(1, std::memory_order_release);
+  slot.state.store(ShmWorkerSlotState::Free, std::memory_order_release);
+  slot.pid.store(0, std::memory_order_release);
+}
+
+void ShmItemProducer::receive_worker_completions(std::size_t index) {
+  auto& slot = channel_->slots[index];
+  ItemID id{};
+  while (slot.completions.try_pop(id)) {
+    auto& worker = workers_.at(index);
+    try {
+      // Find the corresponding outstanding item object and delete it
+      worker->delete_outstanding(id);
+      // Send next item if available
+      if (!worker->queue_empty()) {
+        auto item = worker->pop_queue();
+        if (worker->group_id() != 0) {
+          // Delete this work item from the queues of other workers with the
+          // same group_id
+          for (auto& [other_index, other_worker] : workers_) {
+            if (worker != other_worker &&
+                other_worker->group_id() == worker->group_id()) {
+              other_worker->delete_from_queue(item->id());
+            }
+          }
+        }
+        send_worker_work_item(index, *item);
+        worker->add_outstanding(item);
+      }
+    } catch (std::exception& e) {
+      L_(error) << e.what();
+      L_(error) << "protocol violation, evicting worker";
+      evict_worker(index);
+      return;
+    }
+  }
+}
+
+void ShmItemProducer::send_worker_work_item(std::size_t index,
+                                            const Item& item) {
+  auto& slot = channel_->slots[index];
+  ShmWorkEntry entry{item.id(), 0, 0};
+  if (auto it = payloads_.find(item.id()); it != payloads_.end()) {
+    entry.payload_handle = shm_.get_handle_from_address(it->second.data);
+    entry.payload_size = it->second.size;
+  }
+  if (!slot.work.try_push(entry)) {
+    throw std::runtime_error("work item ring full");
+  }
+
+  // Wake the worker if it is waiting (see ShmItemWorker::get)
+  slot.work_signal.fetch_add(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (slot.worker_waiting.load(std::memory_order_seq_cst) != 0) {
+    shm_item_channel::futex_wake(&slot.work_signal);
+  }
+}
@@ -0,0 +1,67 @@
+#ifndef SHM_IPC_SHMITEMPRODUCER_HPP
+#define SHM_IPC_SHMITEMPRODUCER_HPP
+
+#include "ItemDistributorWorker.hpp"
+#include "ItemWorkerProtocol.hpp"
+#include "ShmItemChannel.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Item producer using a shared memory item channel (see ShmItemChannel.hpp).
+ *
+ * Provides the same interface as the ZMQ-based ItemProducer. Instead of
+ * passing the items to an ItemDistributor, the producer distributes them to
+ * the workers directly, with the same queueing and grouping semantics.
+ */
+class ShmItemProducer {
+public:
+  /// Create an item channel in the given managed shared memory segment.
+  explicit ShmItemProducer(boost::interprocess::managed_shared_memory& shm);
+
+  // ShmItemProducer is non-copyable
+  ShmItemProducer(const ShmItemProducer& other) = delete;
+  ShmItemProducer& operator=(const ShmItemProducer& other) = delete;
+
+  ~ShmItemProducer();
+
+  void send_work_item(ItemID id, const std::string& payload);
+
+  bool try_receive_completion(ItemID* id);
+
+private:
+  struct Payload {
+    void* data;
+    std::size_t size;
+  };
+
+  // Pick up newly registered workers, clean up disconnected ones
+  void update_workers();
+  // Stop serving a worker that is still running (see ShmItemChannel.hpp)
+  void evict_worker(std::size_t index);
+  // Make the slot available again, its worker must not use it anymore
+  void free_slot(std::size_t index);
+
+  // Handle completions from a worker, send next item if available
+  void receive_worker_completions(std::size_t index);
+
+  void send_worker_work_item(std::size_t index, const Item& item);
+
+  boost::interprocess::managed_shared_memory& shm_;
+  ShmItemChannel* channel_ = nullptr;
+
+  std::map<std::size_t, std::unique_ptr<ItemDistributorWorker>> workers_;
+  std::queue<ItemID> completed_items_;
+  std::unordered_map<ItemID, Payload> payloads_;
+  std::chrono::steady_clock::time_point last_liveness_check_ =
+      std::chrono::steady_clock::now();
+};
+
+#endif
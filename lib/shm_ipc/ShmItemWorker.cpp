@@ -0,0 +1,183 @@
+#include "ShmItemWorker.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <boost/interprocess/exceptions.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+ShmItemWorker::ShmItemWorker(std::string shm_identifier,
+                             WorkerParameters parameters)
+    : shm_identifier_(std::move(shm_identifier)),
+      parameters_(std::move(parameters)) {
+  if (parameters_.client_name.empty()) {
+    throw std::invalid_argument("WorkerParameters.client_name cannot be empty");
+  }
+  connect();
+}
+
+ShmItemWorker::~ShmItemWorker() { disconnect(); }
+
+std::shared_ptr<const Item> ShmItemWorker::get() {
+  while (!stopped_) {
+    if (slot_ == nullptr && !connect()) {
+      std::this_thread::sleep_for(worker_poll_timeout);
+      continue;
+    }
+    if (!owns_slot()) {
+      L_(warning) << "evicted from shared memory item channel "
+                  << shm_identifier_ << ", reconnecting";
+      disconnect();
+      continue;
+    }
+    send_pending_completions();
+
+    ShmWorkEntry entry{};
+    const uint32_t signal = slot_->work_signal.load(std::memory_order_acquire);
+    if (!slot_->work.try_pop(entry)) {
+      // Announce that we are going to sleep, then check again to not miss an
+      // item pushed in the meantime (see ShmItemProducer)
+      slot_->worker_waiting.store(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const bool received = slot_->work.try_pop(entry);
+      if (!received) {
+        shm_item_channel::futex_wait(&slot_->work_signal, signal,
+                                     worker_poll_timeout);
+      }
+      slot_->worker_waiting.store(0, std::memory_order_relaxed);
+      if (!received) {
+        if (producer_is_gone()) {
+          L_(info) << "shared memory item channel closed";
+          disconnect();
+          if (disconnect_callback_) {
+            disconnect_callback_();
+          }
+        }
+        continue;
+      }
+    }
+
+    std::string payload;
+    if (entry.payload_size != 0) {
+      payload.assign(static_cast<const char*>(
+                         shm_->get_address_from_handle(entry.payload_handle)),
+                     entry.payload_size);
+    }
+    // The producer releases the payloads of an evicted worker, so the copy
+    // is only valid if the slot still belonged to us afterwards
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!owns_slot()) {
+      continue;
+    }
+    items_.insert(entry.id);
+    return std::make_shared<Item>(&completed_items_, entry.id,
+                                  std::move(payload));
+  }
+  return nullptr;
+}
+
+bool ShmItemWorker::connect() {
+  std::shared_ptr<boost::interprocess::managed_shared_memory> shm;
+  try {
+    shm = std::make_shared<boost::interprocess::managed_shared_memory>(
+        boost::interprocess::open_only, shm_identifier_.c_str());
+  } catch (boost::interprocess::interprocess_exception& e) {
+    L_(debug) << "cannot open shared memory " << shm_identifier_ << ": "
+              << e.what();
+    return false;
+  }
+
+  auto* channel = shm->find<ShmItemChannel>(shm_item_channel_name).first;
+  if (channel == nullptr || channel->closed.load(std::memory_order_acquire)) {
+    L_(debug) << "no item channel in shared memory " << shm_identifier_;
+    return false;
+  }
+
+  const int32_t pid = getpid();
+  for (auto& slot : channel->slots) {
+    // Claim the process ID first, so that the producer can clean up the slot
+    // if this process terminates during registration
+    int32_t expected_pid = 0;
+    if (slot.state.load(std::memory_order_acquire) !=
+            ShmWorkerSlotState::Free ||
+        !slot.pid.compare_exchange_strong(expected_pid, pid,
+                                          std::memory_order_acq_rel)) {
+      continue;
+    }
+    auto expected = ShmWorkerSlotState::Free;
+    if (!slot.state.compare_exchange_strong(expected,
+                                            ShmWorkerSlotState::Registering,
+                                            std::memory_order_acq_rel)) {
+      slot.pid.store(0, std::memory_order_release);
+      continue;
+    }
+    generation_ = slot.generation.load(std::memory_order_acquire);
+    slot.stride = parameters_.stride;
+    slot.offset = parameters_.offset;
+    slot.queue_policy = parameters_.queue_policy;
+    slot.group_id = parameters_.group_id;
+    std::memset(slot.client_name, 0, sizeof(slot.client_name));
+    std::memcpy(slot.client_name, parameters_.client_name.data(),
+                std::min(parameters_.client_name.size(),
+                         sizeof(slot.client_name) - 1));
+    slot.state.store(ShmWorkerSlotState::Active, std::memory_order_release);
+
+    shm_ = std::move(shm);
+    channel_ = channel;
+    slot_ = &slot;
+    L_(info) << "connected to shared memory item channel " << shm_identifier_;
+    return true;
+  }
+
+  L_(error) << "no free worker slot in shared memory item channel "
+            << shm_identifier_;
+  return false;
+}
+
+void ShmItemWorker::disconnect() {
+  // Leave the slot (or acknowledge the eviction), unless it has already been
+  // handed over to another worker
+  if (slot_ != nullptr &&
+      slot_->generation.load(std::memory_order_acquire) == generation_) {
+    auto state = slot_->state.load(std::memory_order_acquire);
+    while ((state == ShmWorkerSlotState::Active ||
+            state == ShmWorkerSlotState::Evicted) &&
+           !slot_->state.compare_exchange_weak(state,
+                                               ShmWorkerSlotState::Closing,
+                                               std::memory_order_acq_rel)) {
+    }
+  }
+  slot_ = nullptr;
+  channel_ = nullptr;
+  shm_ = nullptr;
+  items_.clear();
+  std::queue<ItemID>().swap(completed_items_);
+}
+
+void ShmItemWorker::send_pending_completions() {
+  while (!completed_items_.empty()) {
+    auto id = completed_items_.front();
+    // Skip completions of items from a previous connection
+    if (items_.count(id) != 0) {
+      if (!slot_->completions.try_push(id)) {
+        return; // retry later
+      }
+      items_.erase(id);
+    }
+    completed_items_.pop();
+  }
+}
+
+bool ShmItemWorker::owns_slot() const {
+  return slot_->generation.load(std::memory_order_acquire) == generation_ &&
+         slot_->state.load(std::memory_order_acquire) ==
+             ShmWorkerSlotState::Active;
+}
+
+bool ShmItemWorker::producer_is_gone() const {
+  return channel_->closed.load(std::memory_order_acquire) ||
+         !shm_item_channel::process_is_alive(channel_->producer_pid);
+}
@@ -0,0 +1,71 @@
+#ifndef SHM_IPC_SHMITEMWORKER_HPP
+#define SHM_IPC_SHMITEMWORKER_HPP
+
+#include "ItemWorkerProtocol.hpp"
+#include "ShmItemChannel.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+
+/**
+ * Item worker using a shared memory item channel (see ShmItemChannel.hpp).
+ *
+ * Provides the same interface as the ZMQ-based ItemWorker. The worker opens
+ * the producer's shared memory segment and registers in a free worker slot.
+ * If the segment or the channel is not (yet) available, or the producer has
+ * shut down, it retries periodically.
+ */
+class ShmItemWorker {
+public:
+  using DisconnectCallback = std::function<void(void)>;
+
+  ShmItemWorker(std::string shm_identifier, WorkerParameters parameters);
+
+  // ShmItemWorker is non-copyable
+  ShmItemWorker(const ShmItemWorker& other) = delete;
+  ShmItemWorker& operator=(const ShmItemWorker& other) = delete;
+
+  ~ShmItemWorker();
+
+  void set_disconnect_callback(DisconnectCallback callback) {
+    disconnect_callback_ = std::move(callback);
+  }
+
+  std::shared_ptr<const Item> get();
+
+  [[nodiscard]] WorkerParameters parameters() const { return parameters_; }
+
+  /// Retrieve the shared memory segment of the current connection.
+  [[nodiscard]] std::shared_ptr<boost::interprocess::managed_shared_memory>
+  segment() const {
+    return shm_;
+  }
+
+  void stop() { stopped_ = true; }
+
+private:
+  bool connect();
+  void disconnect();
+  void send_pending_completions();
+  [[nodiscard]] bool owns_slot() const;
+  [[nodiscard]] bool producer_is_gone() const;
+
+  const std::string shm_identifier_;
+  const WorkerParameters parameters_;
+  DisconnectCallback disconnect_callback_;
+
+  std::shared_ptr<boost::interprocess::managed_shared_memory> shm_;
+  ShmItemChannel* channel_ = nullptr;
+  ShmWorkerSlot* slot_ = nullptr;
+  uint32_t generation_ = 0; ///< generation of the slot when it was claimed
+
+  std::set<ItemID> items_; ///< items received through the current connection
+  std::queue<ItemID> completed_items_;
+  bool stopped_ = false;
+};
+
+#endif
@@ -89,6 +89,10 @@ enum class TsFlag : uint32_t {
 
   // Timeslice is incomplete due to missing subtimeslices
   MissingSubtimeslices = 1 << 3,
+
+  // Timeslice consists of the components selected for early publishing only;
+  // the complete timeslice follows as a separate work item
+  PartialTimeslice = 1 << 4,
 };
 
 // 1: sender only
@@ -389,6 +393,14 @@ struct StCollectionHeader {
 static_assert(sizeof(StCollectionHeader) == 40);
 static_assert(std::is_trivially_copyable_v<StCollectionHeader>);
 
+struct StAnnouncementHeader {
+  uint64_t id;
+  uint64_t ms_data_size;
+  uint64_t descriptor_size; ///< size of the serialized StDescriptor
+};
+static_assert(sizeof(StAnnouncementHeader) == 24);
+static_assert(std::is_trivially_copyable_v<StAnnouncementHeader>);
+
 } // namespace wire
 
 inline std::vector<std::byte> serialize_descriptor(const StDescriptor& d) {
@@ -431,6 +443,55 @@ parse_descriptor(std::span<const std::byte> data) {
   return d;
 }
 
+// A subtimeslice announcement as sent to the manager
+struct StAnnouncement {
+  uint64_t id = 0;
+  uint64_t ms_data_size = 0;
+  StDescriptor descriptor;
+};
+
+/// Append an announcement to a batch: a wire::StAnnouncementHeader followed
+/// by the serialized StDescriptor (always a multiple of 8 bytes long).
+inline void append_announcement(std::vector<std::byte>& batch,
+                                uint64_t id,
+                                uint64_t ms_data_size,
+                                const StDescriptor& d) {
+  const std::vector<std::byte> descriptor = serialize_descriptor(d);
+  const wire::StAnnouncementHeader h{id, ms_data_size, descriptor.size()};
+  const std::size_t pos = batch.size();
+  batch.resize(pos + sizeof(h) + descriptor.size());
+  std::memcpy(batch.data() + pos, &h, sizeof(h));
+  std::memcpy(batch.data() + pos + sizeof(h), descriptor.data(),
+              descriptor.size());
+}
+
+inline std::optional<std::vector<StAnnouncement>>
+parse_announcements(std::span<const std::byte> data, std::size_t count) {
+  std::vector<StAnnouncement> announcements;
+  announcements.reserve(count);
+  while (!data.empty()) {
+    if (data.size() < sizeof(wire::StAnnouncementHeader)) {
+      return std::nullopt;
+    }
+    wire::StAnnouncementHeader h{};
+    std::memcpy(&h, data.data(), sizeof(h));
+    data = data.subspan(sizeof(h));
+    if (data.size() < h.descriptor_size) {
+      return std::nullopt;
+    }
+    auto d = parse_descriptor(data.first(h.descriptor_size));
+    if (!d) {
+      return std::nullopt;
+    }
+    announcements.push_back({h.id, h.ms_data_size, std::move(*d)});
+    data = data.subspan(h.descriptor_size);
+  }
+  if (announcements.size() != count) {
+    return std::nullopt;
+  }
+  return announcements;
+}
+
 inline std::vector<std::byte> serialize_collection(const StCollection& c) {
   std::size_t sender_id_total = 0;
   for (const auto& s : c.sender_ids) {
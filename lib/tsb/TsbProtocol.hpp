@@ -3,6 +3,7 @@
    Author: Jan de Cuveland */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 static constexpr uint16_t DEFAULT_MANAGER_PORT = 13373;
@@ -19,9 +20,19 @@ static constexpr unsigned int AM_SENDER_ANNOUNCE_ST =
         // data: serialized StDescriptor
 static constexpr unsigned int AM_SENDER_RETRACT_ST =
     22; // header: {StId}, data: none
+static constexpr unsigned int AM_SENDER_ANNOUNCE_ST_BATCH =
+    23; // header: {count},
+        // data: serialized announcements (see append_announcement)
 // tsmanager -> stsender
 static constexpr unsigned int AM_MANAGER_RELEASE_ST =
     30; // header: {StId}, data: none
+static constexpr unsigned int AM_MANAGER_RELEASE_ST_BATCH =
+    31; // header: {count}, data: {StId, ...}
+//
+// Announcements and releases are batched per connection (see
+// AdaptiveBatching). A batch of a single item is sent as the unbatched
+// message.
+static constexpr std::size_t MAX_BATCH_SIZE = 64;
 
 // 2. tsmanager (listen) <-> tsbuilder (connect)
 // tsbuilder -> tsmanager
@@ -46,7 +57,8 @@ static constexpr unsigned int AM_MANAGER_ASSIGN_TS =
 // 3. stsender (listen) <-> tsbuilder (connect)
 // tsbuilder -> stsender
 static constexpr unsigned int AM_BUILDER_REQUEST_ST =
-    60; // header: {StId, tag}, data: none
+    60; // header: {StId, tag} or {StId, tag, rail, num_rails, stripe_size},
+        // data: none
 //
 // The actual bulk transfer stsender -> tsbuilder uses UCX tag matching
 // (ucp_tag_send_nbx / ucp_tag_recv_nbx), not an active message. A
@@ -65,6 +77,18 @@ static constexpr unsigned int AM_BUILDER_REQUEST_ST =
 // immediately after receiving AM_MANAGER_ASSIGN_TS and before issuing the
 // request to the sender, so the recvs are "expected" by the time the sender
 // starts sending, avoiding the rendezvous CTS round-trip.
+//
+// Multi-rail transfers: a builder may connect to a sender over several rails,
+// i.e., separate UCX contexts restricted to different network devices, with
+// the sender listening on port + rail for rail > 0. The builder then requests
+// the contribution on each rail (with the extended header), and the sender
+// sends only the chunks assigned to that rail (see for_each_rail_chunk). The
+// chunks of a block are received in place at their final position in the
+// timeslice buffer, so no reassembly copy is needed. A builder publishing
+// timeslices early also uses the extended header on a single rail
+// (rail 0 of 1), to have the blocks split into chunks of stripe_size bytes.
+// Senders without multi-rail support only understand the short header; the
+// builder sends it whenever the blocks are neither striped nor split.
 
 // Tag encoding for the bulk sender->builder transfer.
 // Layout: high 48 bits = TsId, low 16 bits = contribution (sender) index
@@ -75,6 +99,50 @@ inline constexpr uint64_t make_st_data_tag(uint64_t ts_id,
   return (ts_id << 16) | (static_cast<uint64_t>(contribution_index) & 0xffffu);
 }
 
+/// Maximum number of rails of a sender/builder connection
+static constexpr std::size_t MAX_RAILS = 8;
+
+/// A part of a transfer block, sent as one tagged message over one rail
+struct StDataChunk {
+  std::size_t block = 0; ///< index of the block in the contribution
+  uint64_t offset = 0;   ///< offset within the block
+  uint64_t size = 0;
+};
+
+// Call `f` for each chunk of a contribution sent over `rail`, in sending
+// order, and return the number of chunks. `block_size(i)` yields the size of
+// block i. Blocks larger than `stripe_size` are split into chunks of
+// `stripe_size` bytes (stripe_size 0: no splitting). The chunks of the
+// contribution are assigned to the rails round-robin, so that small blocks
+// (like the microslice descriptors) are distributed as well. Sender and
+// builder derive the identical assignment from the same block layout.
+template <typename BlockSize, typename F>
+std::size_t for_each_rail_chunk(std::size_t num_blocks,
+                                BlockSize&& block_size,
+                                std::size_t rail,
+                                std::size_t num_rails,
+                                uint64_t stripe_size,
+                                F&& f) {
+  std::size_t chunk_index = 0;
+  std::size_t count = 0;
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    const uint64_t size = block_size(b);
+    uint64_t offset = 0;
+    do {
+      uint64_t chunk_size = size - offset;
+      if (stripe_size != 0 && chunk_size > stripe_size) {
+        chunk_size = stripe_size;
+      }
+      if (chunk_index++ % num_rails == rail) {
+        f(StDataChunk{b, offset, chunk_size});
+        ++count;
+      }
+      offset += chunk_size;
+    } while (offset < size);
+  }
+  return count;
+}
+
 static constexpr uint64_t BUILDER_EVENT_NO_OP = 0;
 static constexpr uint64_t BUILDER_EVENT_ALLOCATED = 1;
 static constexpr uint64_t BUILDER_EVENT_OUT_OF_MEMORY = 2;
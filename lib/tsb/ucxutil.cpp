@@ -17,12 +17,36 @@ namespace ucx::util {
 bool init(ucp_context_h& context,
           ucp_worker_h& worker,
           int epoll_fd,
-          LoopMode loop_mode) {
+          LoopMode loop_mode,
+          bool shared_context,
+          std::string_view rail) {
   if (context != nullptr || worker != nullptr) {
     ERROR("UCP context or worker already initialized");
     return false;
   }
 
+  if (!create_context(context, loop_mode, shared_context, rail)) {
+    return false;
+  }
+  if (!create_worker(context, worker, epoll_fd, loop_mode)) {
+    ucp_cleanup(context);
+    context = nullptr;
+    return false;
+  }
+
+  DEBUG("UCP context and worker initialized");
+  return true;
+}
+
+bool create_context(ucp_context_h& context,
+                    LoopMode loop_mode,
+                    bool shared_context,
+                    std::string_view rail) {
+  if (context != nullptr) {
+    ERROR("UCP context already initialized");
+    return false;
+  }
+
   // Initialize UCP context
   ucp_config_t* config = nullptr;
   ucs_status_t status = ucp_config_read(nullptr, nullptr, &config);
@@ -31,6 +55,21 @@ bool init(ucp_context_h& context,
     return false;
   }
 
+  if (!rail.empty()) {
+    const auto separator = rail.find('/');
+    const std::string devices(rail.substr(0, separator));
+    status = ucp_config_modify(config, "NET_DEVICES", devices.c_str());
+    if (status == UCS_OK && separator != std::string_view::npos) {
+      const std::string transports(rail.substr(separator + 1));
+      status = ucp_config_modify(config, "TLS", transports.c_str());
+    }
+    if (status != UCS_OK) {
+      ERROR("Invalid UCX rail configuration '{}': {}", rail, status);
+      ucp_config_release(config);
+      return false;
+    }
+  }
+
   ucp_params_t ucp_params = {};
   // Request Active Message support (control plane) and Tag Matching (used for
   // the bulk sender->builder data path, where the builder pre-posts receives
@@ -40,6 +79,12 @@ bool init(ucp_context_h& context,
   if (loop_mode == LoopMode::event_fd) {
     ucp_params.features |= UCP_FEATURE_WAKEUP;
   }
+  if (shared_context) {
+    // Workers of this context are driven by different threads (memory
+    // registrations are shared between them)
+    ucp_params.field_mask |= UCP_PARAM_FIELD_MT_WORKERS_SHARED;
+    ucp_params.mt_workers_shared = 1;
+  }
 
   status = ucp_init(&ucp_params, config, &context);
   ucp_config_release(config);
@@ -47,24 +92,32 @@ bool init(ucp_context_h& context,
     ERROR("Failed to initialize UCP context");
     return false;
   }
+  return true;
+}
+
+bool create_worker(ucp_context_h context,
+                   ucp_worker_h& worker,
+                   int epoll_fd,
+                   LoopMode loop_mode) {
+  if (worker != nullptr) {
+    ERROR("UCP worker already initialized");
+    return false;
+  }
 
   // Create UCP worker
   ucp_worker_params_t worker_params = {};
-  // Only the master thread can access (i.e. the thread that initialized the
-  // context; multiple threads may exist and never access)
+  // Only the master thread can access (i.e. the thread that created the
+  // worker; multiple threads may exist and never access)
   worker_params.field_mask = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
   worker_params.thread_mode = UCS_THREAD_MODE_SINGLE;
 
-  status = ucp_worker_create(context, &worker_params, &worker);
+  ucs_status_t status = ucp_worker_create(context, &worker_params, &worker);
   if (status != UCS_OK) {
     ERROR("Failed to create UCP worker");
-    ucp_cleanup(context);
-    context = nullptr;
     return false;
   }
 
   if (loop_mode == LoopMode::busy_poll) {
-    DEBUG("UCP context and worker initialized");
     return true;
   }
 
@@ -75,8 +128,6 @@ bool init(ucp_context_h& context,
     ERROR("Failed to get UCP worker event_fd: {}", status);
     ucp_worker_destroy(worker);
     worker = nullptr;
-    ucp_cleanup(context);
-    context = nullptr;
     return false;
   }
 
@@ -87,20 +138,21 @@ bool init(ucp_context_h& context,
     ERROR("Failed to set up epoll for UCP worker");
     ucp_worker_destroy(worker);
     worker = nullptr;
-    ucp_cleanup(context);
-    context = nullptr;
     return false;
   }
 
-  DEBUG("UCP context and worker initialized");
   return true;
 }
 
-void cleanup(ucp_context_h& context, ucp_worker_h& worker) {
+void destroy_worker(ucp_worker_h& worker) {
   if (worker != nullptr) {
     ucp_worker_destroy(worker);
     worker = nullptr;
   }
+}
+
+void cleanup(ucp_context_h& context, ucp_worker_h& worker) {
+  destroy_worker(worker);
   if (context != nullptr) {
     ucp_cleanup(context);
     context = nullptr;
@@ -14,10 +14,25 @@
 namespace ucx::util {
 static constexpr int EPOLL_TIMEOUT_MS = 1000;
 enum class LoopMode { event_fd, busy_poll };
+// A rail restricts a UCX context to a set of network devices and optionally
+// transports, given as "<devices>[/<transports>]" in the syntax of
+// UCX_NET_DEVICES and UCX_TLS (e.g., "mlx5_0:1" or "lo/tcp"). An empty rail
+// uses the UCX environment configuration.
 bool init(ucp_context_h& context,
           ucp_worker_h& worker,
           int epoll_fd,
-          LoopMode loop_mode = LoopMode::event_fd);
+          LoopMode loop_mode = LoopMode::event_fd,
+          bool shared_context = false,
+          std::string_view rail = {});
+bool create_context(ucp_context_h& context,
+                    LoopMode loop_mode = LoopMode::event_fd,
+                    bool shared_context = false,
+                    std::string_view rail = {});
+bool create_worker(ucp_context_h context,
+                   ucp_worker_h& worker,
+                   int epoll_fd,
+                   LoopMode loop_mode = LoopMode::event_fd);
+void destroy_worker(ucp_worker_h& worker);
 void cleanup(ucp_context_h& context, ucp_worker_h& worker);
 bool arm_worker_and_wait(ucp_worker_h worker,
                          int epoll_fd,
@@ -0,0 +1,75 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_AdaptiveBatching
+#include <boost/test/unit_test.hpp>
+
+#include "AdaptiveBatching.hpp"
+#include <chrono>
+
+using namespace std::chrono_literals;
+using clock_type = AdaptiveBatching::clock;
+
+BOOST_AUTO_TEST_CASE(burst_test) {
+  // Without delay, only items added together are batched
+  AdaptiveBatching batching(0ms, 4);
+  const auto t0 = clock_type::now();
+  BOOST_CHECK(!batching.due(t0));
+  BOOST_CHECK(batching.deadline() == clock_type::time_point::max());
+  for (int i = 0; i < 3; ++i) {
+    batching.add(t0);
+    BOOST_CHECK(!batching.full());
+  }
+  BOOST_CHECK(batching.due(t0));
+  batching.add(t0);
+  BOOST_CHECK(batching.full());
+  batching.sent();
+  BOOST_CHECK_EQUAL(batching.pending(), 0);
+  BOOST_CHECK(!batching.due(t0));
+}
+
+BOOST_AUTO_TEST_CASE(low_rate_test) {
+  // Items arriving less often than the maximum delay are not held back
+  AdaptiveBatching batching(1ms, 64);
+  auto t = clock_type::now();
+  for (int i = 0; i < 20; ++i) {
+    batching.add(t);
+    BOOST_CHECK(batching.due(t));
+    batching.sent();
+    t += 10ms;
+  }
+  BOOST_CHECK(batching.interval() == 10ms);
+}
+
+BOOST_AUTO_TEST_CASE(high_rate_test) {
+  // Items arriving every 100 us are collected for up to 1 ms
+  AdaptiveBatching batching(1ms, 64);
+  auto t = clock_type::now();
+  for (int i = 0; i < 20; ++i) {
+    batching.add(t);
+    batching.sent();
+    t += 100us;
+  }
+  std::size_t batch_size = 0;
+  while (true) {
+    batching.add(t);
+    ++batch_size;
+    if (batching.due(t)) {
+      break;
+    }
+    BOOST_CHECK(t < batching.deadline());
+    t += 100us;
+  }
+  BOOST_CHECK_GE(batch_size, 9);
+  BOOST_CHECK_LE(batch_size, 11);
+  BOOST_CHECK(batching.due(batching.deadline()));
+}
+
+BOOST_AUTO_TEST_CASE(max_size_test) {
+  AdaptiveBatching batching(1s, 8);
+  auto t = clock_type::now();
+  for (int i = 0; i < 8; ++i) {
+    batching.add(t);
+    t += 1us;
+  }
+  BOOST_CHECK(batching.full());
+  BOOST_CHECK(batching.due(t));
+}
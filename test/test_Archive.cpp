@@ -2,14 +2,28 @@
 #define BOOST_TEST_MODULE test_Archive
 #include <boost/test/unit_test.hpp>
 
+#include "ComponentSelection.hpp"
 #include "MergingSource.hpp"
 #include "MicrosliceInputArchive.hpp"
 #include "MicrosliceOutputArchive.hpp"
+#include "ParallelZstdCompressor.hpp"
+#include "StorableTimeslice.hpp"
 #include "TimesliceInputArchive.hpp"
 #include "TimesliceOutputArchive.hpp"
+#include "TimesliceMappedInputArchive.hpp"
 #include "TimesliceSource.hpp"
 
+#ifdef BOOST_IOS_HAS_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#endif
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(timeslice_output_archive_sequence_test) {
   fles::TimesliceInputArchiveLoop source("example1.tsa", 3);
@@ -57,6 +71,208 @@ BOOST_AUTO_TEST_CASE(timeslice_input_archive_sequence_vector_test2) {
       std::ios_base::failure);
 }
 
+BOOST_AUTO_TEST_CASE(timeslice_mapped_input_archive_test) {
+  fles::TimesliceInputArchive source("test3.tsa");
+  fles::TimesliceMappedInputArchive mapped_source("test3.tsa");
+  uint64_t count = 0;
+  while (auto timeslice = source.get()) {
+    const fles::Timeslice* mapped = mapped_source.next();
+    BOOST_REQUIRE(mapped != nullptr);
+    BOOST_CHECK_EQUAL(mapped->index(), timeslice->index());
+    BOOST_REQUIRE_EQUAL(mapped->num_components(), timeslice->num_components());
+    for (uint64_t c = 0; c < timeslice->num_components(); ++c) {
+      BOOST_REQUIRE_EQUAL(mapped->num_microslices(c),
+                          timeslice->num_microslices(c));
+      for (uint64_t m = 0; m < timeslice->num_microslices(c); ++m) {
+        auto size = timeslice->descriptor(c, m).size;
+        BOOST_CHECK_EQUAL(mapped->descriptor(c, m).size, size);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            mapped->content(c, m), mapped->content(c, m) + size,
+            timeslice->content(c, m), timeslice->content(c, m) + size);
+      }
+    }
+    ++count;
+  }
+  BOOST_CHECK(mapped_source.next() == nullptr);
+  BOOST_CHECK(mapped_source.eos());
+  BOOST_CHECK_EQUAL(count, 6);
+}
+
+BOOST_AUTO_TEST_CASE(timeslice_archive_index_test) {
+  {
+    fles::TimesliceOutputArchive sink("test4.tsa",
+                                      fles::ArchiveCompression::None, true);
+    // The first timeslice has no components and thus not all class
+    // information
+    for (uint64_t i = 0; i < 6; ++i) {
+      auto ts = std::make_shared<fles::StorableTimeslice>(1, i);
+      for (uint64_t c = 0; c < i; ++c) {
+        ts->append_component(1);
+      }
+      sink.put(ts);
+    }
+  }
+
+  fles::TimesliceInputArchive source("test4.tsa");
+  BOOST_REQUIRE(source.has_index());
+  BOOST_CHECK_EQUAL(source.size(), 6);
+  for (std::size_t n : {4, 1, 5, 0, 3, 3}) {
+    source.seek(n);
+    auto timeslice = source.get();
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), n);
+    BOOST_CHECK_EQUAL(timeslice->num_components(), n);
+  }
+  auto timeslice = source.get(); // sequential read continues after seek
+  BOOST_REQUIRE(timeslice);
+  BOOST_CHECK_EQUAL(timeslice->index(), 4);
+  source.seek(6);
+  BOOST_CHECK(source.eos());
+  BOOST_CHECK(!source.get());
+  source.seek(2);
+  BOOST_CHECK(!source.eos());
+  timeslice = source.get();
+  BOOST_REQUIRE(timeslice);
+  BOOST_CHECK_EQUAL(timeslice->index(), 2);
+
+  fles::TimesliceInputArchive unindexed_source("test3.tsa");
+  BOOST_CHECK(!unindexed_source.has_index());
+  BOOST_CHECK_THROW(unindexed_source.seek(1), std::runtime_error);
+}
+
+#ifdef BOOST_IOS_HAS_ZSTD
+BOOST_AUTO_TEST_CASE(parallel_zstd_compressor_test) {
+  std::string input;
+  for (int i = 0; i < 10000; ++i) {
+    input += "line " + std::to_string(i) + "\n";
+  }
+
+  std::stringstream compressed;
+  {
+    fles::ParallelZstdCompressor compressor(compressed, 3, 4, 1000);
+    std::ostream out(&compressor);
+    out << input;
+  }
+
+  boost::iostreams::filtering_istream in;
+  in.push(boost::iostreams::zstd_decompressor());
+  in.push(compressed);
+  std::string output((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+  BOOST_CHECK(output == input);
+}
+
+BOOST_AUTO_TEST_CASE(timeslice_parallel_compressed_archive_test) {
+  std::vector<uint64_t> indices;
+  {
+    fles::TimesliceInputArchive source("test3.tsa");
+    fles::TimesliceOutputArchive sink(
+        "test5.tsa", fles::ArchiveCompression::Zstd, false, 3, 4);
+    while (auto timeslice = source.get()) {
+      indices.push_back(timeslice->index());
+      std::shared_ptr<const fles::Timeslice> ts(std::move(timeslice));
+      sink.put(ts);
+    }
+  }
+
+  fles::TimesliceInputArchive source("test5.tsa");
+  BOOST_CHECK(source.descriptor().archive_compression() ==
+              fles::ArchiveCompression::Zstd);
+  std::vector<uint64_t> read_indices;
+  while (auto timeslice = source.get()) {
+    read_indices.push_back(timeslice->index());
+  }
+  BOOST_CHECK_EQUAL(read_indices.size(), 6);
+  BOOST_CHECK(read_indices == indices);
+}
+
+BOOST_AUTO_TEST_CASE(timeslice_component_compressed_archive_test) {
+  const std::vector<std::pair<uint8_t, uint16_t>> keys = {
+      {0x10, 0x1000}, {0x40, 0x4001}, {0x40, 0x4002}};
+  std::vector<std::shared_ptr<fles::StorableTimeslice>> timeslices;
+  for (uint64_t i = 0; i < 3; ++i) {
+    auto ts = std::make_shared<fles::StorableTimeslice>(2, i);
+    for (const auto& [sys_id, eq_id] : keys) {
+      auto c = ts->append_component(2);
+      for (uint64_t m = 0; m < 2; ++m) {
+        std::vector<uint8_t> content(100 * (c + 1), static_cast<uint8_t>(m));
+        fles::MicrosliceDescriptor desc{};
+        desc.sys_id = sys_id;
+        desc.eq_id = eq_id;
+        desc.idx = i * 2 + m;
+        desc.size = static_cast<uint32_t>(content.size());
+        ts->append_microslice(c, m, desc, content.data());
+      }
+    }
+    timeslices.push_back(ts);
+  }
+  {
+    fles::TimesliceOutputArchive sink(
+        "test6.tsa", fles::ArchiveCompression::ZstdComponents, true);
+    for (const auto& ts : timeslices) {
+      sink.put(ts);
+    }
+  }
+
+  // Compare the raw component data (microslice descriptors and contents)
+  auto equal_components = [](const fles::Timeslice& a, uint64_t ca,
+                             const fles::Timeslice& b, uint64_t cb) {
+    const auto* data_a = reinterpret_cast<const uint8_t*>(&a.descriptor(ca, 0));
+    const auto* data_b = reinterpret_cast<const uint8_t*>(&b.descriptor(cb, 0));
+    return a.size_component(ca) == b.size_component(cb) &&
+           std::equal(data_a, data_a + a.size_component(ca), data_b);
+  };
+
+  {
+    fles::TimesliceInputArchive source("test6.tsa");
+    BOOST_CHECK(source.descriptor().archive_compression() ==
+                fles::ArchiveCompression::ZstdComponents);
+    BOOST_REQUIRE(source.has_index());
+    for (const auto& ts : timeslices) {
+      auto timeslice = source.get();
+      BOOST_REQUIRE(timeslice);
+      BOOST_CHECK_EQUAL(timeslice->index(), ts->index());
+      BOOST_REQUIRE_EQUAL(timeslice->num_components(), keys.size());
+      for (uint64_t c = 0; c < keys.size(); ++c) {
+        BOOST_CHECK(equal_components(*timeslice, c, *ts, c));
+      }
+    }
+    BOOST_CHECK(!source.get());
+  }
+
+  {
+    fles::TimesliceInputArchive source("test6.tsa");
+    source.set_component_selection(fles::parse_component_selection("0x40:2"));
+    source.seek(2);
+    auto timeslice = source.get();
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), 2);
+    BOOST_REQUIRE_EQUAL(timeslice->num_components(), 0);
+  }
+
+  {
+    fles::TimesliceInputArchive source("test6.tsa");
+    source.set_component_selection(
+        fles::parse_component_selection("0x40:0x4002, 0x10"));
+    uint64_t count = 0;
+    while (auto timeslice = source.get()) {
+      BOOST_REQUIRE_EQUAL(timeslice->num_components(), 2);
+      BOOST_CHECK_EQUAL(timeslice->descriptor(0, 0).sys_id, 0x10);
+      BOOST_CHECK_EQUAL(timeslice->descriptor(1, 0).eq_id, 0x4002);
+      BOOST_CHECK(equal_components(*timeslice, 0, *timeslices[count], 0));
+      BOOST_CHECK(equal_components(*timeslice, 1, *timeslices[count], 2));
+      ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 3);
+  }
+
+  BOOST_CHECK_THROW(fles::parse_component_selection("0x10:"),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(fles::parse_component_selection("0x1000"),
+                    std::invalid_argument);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(microslice_output_archive_sequence_test) {
   fles::MicrosliceInputArchiveLoop source("example2.msa", 2);
   fles::MicrosliceOutputArchiveSequence sink("test3_%n.msa", 5);
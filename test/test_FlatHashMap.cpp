@@ -0,0 +1,88 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_FlatHashMap
+#include <boost/test/unit_test.hpp>
+
+#include "FlatHashMap.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(basic_test) {
+  FlatHashMap<uint64_t, std::string> map;
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.find(1) == map.end());
+
+  auto [it, inserted] = map.emplace(1, "one");
+  BOOST_CHECK(inserted);
+  BOOST_CHECK_EQUAL(it->second, "one");
+  BOOST_CHECK(!map.emplace(1, "uno").second);
+  map[2] = "two";
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.at(1), "one");
+  BOOST_CHECK_THROW(map.at(3), std::out_of_range);
+
+  BOOST_CHECK_EQUAL(map.erase(1), 1);
+  BOOST_CHECK_EQUAL(map.erase(1), 0);
+  BOOST_CHECK(!map.contains(1));
+  BOOST_CHECK(map.contains(2));
+  map.clear();
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+// Compare against std::unordered_map for a random operation sequence
+BOOST_AUTO_TEST_CASE(random_test) {
+  FlatHashMap<uint64_t, uint64_t> map;
+  std::unordered_map<uint64_t, uint64_t> reference;
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> key_dist(0, 2000);
+
+  for (int i = 0; i < 200000; ++i) {
+    const uint64_t key = key_dist(rng) * 4096; // regular low bits
+    switch (rng() % 3) {
+    case 0:
+      map[key] = i;
+      reference[key] = i;
+      break;
+    case 1:
+      BOOST_REQUIRE_EQUAL(map.erase(key), reference.erase(key));
+      break;
+    default:
+      BOOST_REQUIRE_EQUAL(map.contains(key), reference.contains(key));
+      if (reference.contains(key)) {
+        BOOST_REQUIRE_EQUAL(map.at(key), reference.at(key));
+      }
+    }
+    BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+  }
+
+  std::size_t count = 0;
+  for (const auto& [key, value] : map) {
+    BOOST_REQUIRE_EQUAL(reference.at(key), value);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, reference.size());
+}
+
+BOOST_AUTO_TEST_CASE(erase_while_iterating_test) {
+  FlatHashMap<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, std::make_unique<int>(i));
+  }
+  int visited = 0;
+  for (auto it = map.begin(); it != map.end();) {
+    ++visited;
+    if (*it->second % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  BOOST_CHECK_EQUAL(visited, 100);
+  BOOST_CHECK_EQUAL(map.size(), 50);
+  BOOST_CHECK(!map.contains(42));
+  BOOST_CHECK_EQUAL(*map.at(43), 43);
+}
@@ -0,0 +1,47 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_LatencyHistogram
+#include <boost/test/unit_test.hpp>
+
+#include "LatencyHistogram.hpp"
+#include <cstdint>
+
+BOOST_AUTO_TEST_CASE(bucket_test) {
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(0), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(1023), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(1024), 1);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(2047), 1);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(2048), 2);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(UINT64_MAX),
+                    LatencyHistogram::bucket_count - 1);
+  for (std::size_t i = 0; i + 1 < LatencyHistogram::bucket_count; ++i) {
+    const uint64_t bound = LatencyHistogram::upper_bound_ns(i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(bound - 1), i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::bucket_of(bound), i + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(quantile_test) {
+  LatencyHistogram h;
+  BOOST_CHECK_EQUAL(h.quantile_ns(0.5), 0);
+
+  // 90 fast (~5 us) and 10 slow (~3 ms) samples
+  for (int i = 0; i < 90; ++i) {
+    h.record(5000);
+  }
+  for (int i = 0; i < 10; ++i) {
+    h.record(3000000);
+  }
+  BOOST_CHECK_EQUAL(h.count(), 100);
+  BOOST_CHECK_EQUAL(h.sum_ns(), 90 * 5000 + 10 * 3000000);
+  BOOST_CHECK_EQUAL(h.max_ns(), 3000000);
+
+  // Quantiles are bounded by their bucket
+  BOOST_CHECK_GE(h.quantile_ns(0.5), 5000);
+  BOOST_CHECK_LT(h.quantile_ns(0.5), 2 * 5000);
+  BOOST_CHECK_GE(h.quantile_ns(0.95), 3000000);
+  BOOST_CHECK_EQUAL(h.quantile_ns(1.0), 3000000);
+
+  h.reset();
+  BOOST_CHECK_EQUAL(h.count(), 0);
+  BOOST_CHECK_EQUAL(h.max_ns(), 0);
+}
@@ -0,0 +1,48 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_MemoryPlacement
+#include <boost/test/unit_test.hpp>
+
+#include "MemoryPlacement.hpp"
+#include <cstdint>
+#include <sstream>
+#include <utility>
+
+BOOST_AUTO_TEST_CASE(parse_test) {
+  for (auto huge_pages : {HugePages::none, HugePages::transparent,
+                          HugePages::size_2m, HugePages::size_1g}) {
+    std::ostringstream out;
+    out << huge_pages;
+    std::istringstream in(out.str());
+    HugePages parsed = HugePages::none;
+    BOOST_CHECK(in >> parsed);
+    BOOST_CHECK(parsed == huge_pages);
+  }
+
+  BOOST_CHECK(!parse_huge_pages("4K"));
+  std::istringstream in("huge");
+  HugePages parsed = HugePages::none;
+  BOOST_CHECK(!(in >> parsed));
+}
+
+BOOST_AUTO_TEST_CASE(mapped_buffer_test) {
+  constexpr std::size_t size = 3 << 20;
+  for (auto huge_pages : {HugePages::none, HugePages::transparent}) {
+    MappedBuffer buffer(size, huge_pages);
+    BOOST_REQUIRE(buffer.data() != nullptr);
+    BOOST_CHECK_EQUAL(buffer.size(), size);
+    buffer.data()[0] = std::byte{1};
+    buffer.data()[size - 1] = std::byte{2};
+    if (huge_pages == HugePages::transparent) {
+      BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(buffer.data()) %
+                            (std::size_t{1} << 21),
+                        0);
+    }
+
+    MappedBuffer moved = std::move(buffer);
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK(moved.data()[size - 1] == std::byte{2});
+  }
+
+  BOOST_CHECK(MappedBuffer().empty());
+  BOOST_CHECK(MappedBuffer(0, HugePages::size_1g).empty());
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_MetricSeries
+#include <boost/test/unit_test.hpp>
+
+#include "MetricSeries.hpp"
+#include "Monitor.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <variant>
+
+namespace {
+
+cbm::MetricField field_value(const cbm::Metric& metric,
+                             const std::string& name) {
+  for (const auto& [field, value] : metric.fFieldset) {
+    if (field == name) {
+      return value;
+    }
+  }
+  throw std::out_of_range("no field " + name);
+}
+
+uint64_t counter_value(const cbm::Metric& metric, const std::string& name) {
+  return std::get<uint64_t>(field_value(metric, name));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(handle_test) {
+  cbm::MetricSeries series("test", {{"host", "localhost"}});
+  auto counter = series.Counter("count");
+  auto gauge = series.Gauge("level");
+  auto histogram = series.Histogram("latency", {10, 100});
+
+  counter.Add();
+  counter.Add(2);
+  gauge.Set(0.5);
+  for (uint64_t value : {5, 10, 11, 100, 1000}) {
+    histogram.Record(value);
+  }
+
+  auto metric = series.Snapshot(std::chrono::system_clock::now());
+  BOOST_CHECK_EQUAL(metric.fMeasurement, "test");
+  BOOST_CHECK_EQUAL(counter_value(metric, "count"), 3);
+  BOOST_CHECK_EQUAL(std::get<double>(field_value(metric, "level")), 0.5);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_count"), 5);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_sum"), 1126);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_bucket_10"), 2);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_bucket_100"), 2);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_bucket_inf"), 1);
+
+  // Unbound handles ignore updates
+  cbm::MetricCounter unbound;
+  unbound.Add();
+  cbm::MetricHistogram unbound_histogram;
+  unbound_histogram.Record(1);
+}
+
+BOOST_AUTO_TEST_CASE(reregister_test) {
+  cbm::MetricSeries series("test", {});
+  auto counter = series.Counter("count");
+  auto histogram = series.Histogram("latency", {10, 100});
+  counter.Add();
+  histogram.Record(1);
+
+  // Declaring a field again yields a handle to the same storage
+  series.Counter("count").Add();
+  series.Histogram("latency", {10, 100}).Record(1);
+  auto metric = series.Snapshot(std::chrono::system_clock::now());
+  BOOST_CHECK_EQUAL(metric.fFieldset.size(), 6);
+  BOOST_CHECK_EQUAL(counter_value(metric, "count"), 2);
+  BOOST_CHECK_EQUAL(counter_value(metric, "latency_count"), 2);
+
+  BOOST_CHECK_THROW(series.Gauge("count"), std::runtime_error);
+  BOOST_CHECK_THROW(series.Counter("latency"), std::runtime_error);
+  BOOST_CHECK_THROW(series.Histogram("latency", {10}), std::runtime_error);
+  BOOST_CHECK_THROW(series.Histogram("other", {100, 10}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(flush_test) {
+  const std::string path =
+      "test_MetricSeries_" + std::to_string(getpid()) + ".txt";
+  {
+    cbm::Monitor monitor("file:" + path);
+    auto& series = monitor.RegisterSeries("test", {{"host", "localhost"}});
+    BOOST_CHECK_EQUAL(&monitor.RegisterSeries("test", {{"host", "localhost"}}),
+                      &series);
+    series.Counter("count").Add(42);
+    // A series without fields is not reported
+    monitor.RegisterSeries("empty", {});
+  }
+
+  // The final snapshot is taken when the monitor is destroyed
+  std::ifstream file(path);
+  std::string line;
+  std::string last;
+  int empty_count = 0;
+  while (std::getline(file, line)) {
+    if (line.rfind("test,", 0) == 0) {
+      last = line;
+    }
+    if (line.rfind("empty", 0) == 0) {
+      ++empty_count;
+    }
+  }
+  std::remove(path.c_str());
+  BOOST_CHECK(last.find(" count=42i ") != std::string::npos);
+  BOOST_CHECK_EQUAL(empty_count, 0);
+}
@@ -2,8 +2,10 @@
 #define BOOST_TEST_MODULE test_MicrosliceReceiver
 #include <boost/test/unit_test.hpp>
 
+#include "Crc32c.hpp"
 #include "FlesnetPatternGenerator.hpp"
 #include "MicrosliceOutputArchive.hpp"
+#include "MicrosliceDescriptor.hpp"
 #include "MicrosliceReceiver.hpp"
 #include <iostream>
 
@@ -34,3 +36,26 @@ BOOST_AUTO_TEST_CASE(usage_test) {
 
   BOOST_CHECK_EQUAL(count, 1000);
 }
+
+BOOST_AUTO_TEST_CASE(crc_test) {
+  uint32_t typical_content_size = 10000;
+  std::size_t desc_buffer_size_exp = 7;  // 128 entries
+  std::size_t data_buffer_size_exp = 16; // 64 KiB, wraps around often
+
+  for (bool generate_pattern : {true, false}) {
+    FlesnetPatternGenerator data_source(data_buffer_size_exp,
+                                        desc_buffer_size_exp, 1,
+                                        typical_content_size, generate_pattern,
+                                        true, 0, 0, true);
+    fles::MicrosliceReceiver ms(data_source);
+
+    for (std::size_t count = 0; count < 200; ++count) {
+      auto microslice = ms.get();
+      BOOST_REQUIRE(microslice);
+      const auto& desc = microslice->desc();
+      BOOST_CHECK((desc.flags & static_cast<uint16_t>(
+                                    fles::MicrosliceFlags::CrcValid)) != 0);
+      BOOST_CHECK_EQUAL(desc.crc, crc32c(microslice->content(), desc.size));
+    }
+  }
+}
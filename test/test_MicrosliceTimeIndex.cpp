@@ -0,0 +1,128 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_MicrosliceTimeIndex
+#include <boost/test/unit_test.hpp>
+
+#include "MicrosliceDescriptor.hpp"
+#include "MicrosliceTimeIndex.hpp"
+#include "RingBufferView.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t ms_duration = 102400; // ns
+
+// Descriptor ring buffer with (jittered) equidistant microslice start times
+struct DescRing {
+  DescRing(std::size_t size, uint64_t num_written, uint64_t seed = 1)
+      : descs(size), ring(descs.data(), descs.size()) {
+    std::mt19937_64 engine(seed);
+    std::uniform_int_distribution<uint64_t> jitter(0, ms_duration / 4);
+    for (uint64_t n = 0; n < num_written; ++n) {
+      ring.at(n).idx = start_time + n * ms_duration + jitter(engine);
+    }
+    write_index = num_written;
+    read_index = num_written > size ? num_written - size : 0;
+  }
+
+  // The current implementation: search directly in the descriptor ring
+  [[nodiscard]] uint64_t upper_bound(uint64_t begin,
+                                     uint64_t end,
+                                     uint64_t time) {
+    return std::upper_bound(
+               ring.get_iter(begin), ring.get_iter(end), time,
+               [](uint64_t t, const fles::MicrosliceDescriptor& desc) {
+                 return t < desc.idx;
+               })
+        .get_index();
+  }
+
+  [[nodiscard]] uint64_t lower_bound(uint64_t begin,
+                                     uint64_t end,
+                                     uint64_t time) {
+    return std::lower_bound(
+               ring.get_iter(begin), ring.get_iter(end), time,
+               [](const fles::MicrosliceDescriptor& desc, uint64_t t) {
+                 return desc.idx < t;
+               })
+        .get_index();
+  }
+
+  static constexpr uint64_t start_time = 1000000000;
+  std::vector<fles::MicrosliceDescriptor> descs;
+  RingBufferView<fles::MicrosliceDescriptor, false> ring;
+  uint64_t read_index;
+  uint64_t write_index;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(search_test) {
+  // Use a size that is not a power of two, and wrap around several times
+  DescRing r(1000, 3456);
+  MicrosliceTimeIndex index(r.descs.size());
+  index.update(r.ring, r.write_index);
+
+  std::mt19937_64 engine(2);
+  std::uniform_int_distribution<uint64_t> pos(r.read_index, r.write_index);
+  for (int i = 0; i < 10000; ++i) {
+    uint64_t a = pos(engine);
+    uint64_t b = pos(engine);
+    const uint64_t begin = std::min(a, b);
+    const uint64_t end = std::max(a, b);
+    // Probe times in and around the searched range
+    std::uniform_int_distribution<uint64_t> time(
+        DescRing::start_time + (r.read_index - 2) * ms_duration,
+        DescRing::start_time + (r.write_index + 2) * ms_duration);
+    const uint64_t t = time(engine);
+    BOOST_REQUIRE_EQUAL(index.upper_bound(begin, end, t),
+                        r.upper_bound(begin, end, t));
+    BOOST_REQUIRE_EQUAL(index.lower_bound(begin, end, t),
+                        r.lower_bound(begin, end, t));
+  }
+
+  // Exact matches
+  for (uint64_t n = r.read_index; n < r.write_index; ++n) {
+    const uint64_t t = r.ring.at(n).idx;
+    BOOST_REQUIRE_EQUAL(index.time(n), t);
+    BOOST_REQUIRE_EQUAL(index.upper_bound(r.read_index, r.write_index, t),
+                        n + 1);
+    BOOST_REQUIRE_EQUAL(index.lower_bound(r.read_index, r.write_index, t), n);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_update_test) {
+  DescRing r(64, 1000);
+  MicrosliceTimeIndex index(r.descs.size());
+  // Add the descriptors in chunks as they would arrive from the hardware
+  for (uint64_t write_index = 0; write_index <= r.write_index;
+       write_index += 7) {
+    index.update(r.ring, write_index);
+    const uint64_t read_index = write_index > 64 ? write_index - 64 : 0;
+    for (uint64_t n = read_index; n < write_index; ++n) {
+      BOOST_REQUIRE_EQUAL(index.time(n), r.ring.at(n).idx);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_time_test) {
+  std::vector<fles::MicrosliceDescriptor> descs(10);
+  RingBufferView<fles::MicrosliceDescriptor, false> ring(descs.data(),
+                                                         descs.size());
+  const std::vector<uint64_t> times = {1, 2, 2, 2, 5, 5, 9, 9, 9, 9};
+  for (std::size_t n = 0; n < times.size(); ++n) {
+    ring.at(n).idx = times[n];
+  }
+  MicrosliceTimeIndex index(descs.size());
+  index.update(ring, times.size());
+  for (uint64_t t = 0; t <= 10; ++t) {
+    BOOST_CHECK_EQUAL(index.upper_bound(0, times.size(), t),
+                      std::upper_bound(times.begin(), times.end(), t) -
+                          times.begin());
+    BOOST_CHECK_EQUAL(index.lower_bound(0, times.size(), t),
+                      std::lower_bound(times.begin(), times.end(), t) -
+                          times.begin());
+  }
+}
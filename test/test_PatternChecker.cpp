@@ -0,0 +1,290 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_PatternChecker
+#include <boost/test/unit_test.hpp>
+
+#include "Crc32c.hpp"
+#include "FlesnetPatternCrc.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "MicrosliceView.hpp"
+#include "PatternChecker.hpp"
+#include "RampCheck.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const SimdLevel all_levels[] = {SimdLevel::scalar, SimdLevel::avx2,
+                                SimdLevel::avx512};
+
+void store_word(std::vector<uint8_t>& content, size_t pos, uint64_t word) {
+  std::memcpy(&content[pos], &word, sizeof(word));
+}
+
+// A microslice with content owned by the test
+struct TestMicroslice {
+  fles::MicrosliceDescriptor desc{};
+  std::vector<uint8_t> content;
+
+  TestMicroslice(fles::SubsystemFormatFLES sys_ver, size_t size)
+      : content(size) {
+    desc.sys_id = static_cast<uint8_t>(fles::Subsystem::FLES);
+    desc.sys_ver = static_cast<uint8_t>(sys_ver);
+    desc.idx = 4711;
+    desc.size = static_cast<uint32_t>(size);
+  }
+
+  fles::MicrosliceView view() { return {desc, content.data()}; }
+};
+
+TestMicroslice flesnet_microslice(size_t words) {
+  TestMicroslice ms(fles::SubsystemFormatFLES::BasicRampPattern, words * 8);
+  uint64_t xor_all = 0;
+  for (size_t i = 0; i < words; ++i) {
+    const uint64_t word = (UINT64_C(3) << 48) | (i * 8);
+    store_word(ms.content, i * 8, word);
+    xor_all ^= word;
+  }
+  ms.desc.crc = static_cast<uint32_t>(xor_all) ^
+                static_cast<uint32_t>(xor_all >> 32);
+  return ms;
+}
+
+// Header word with last word size and packet number
+void store_header(TestMicroslice& ms, uint8_t last_word_size) {
+  const uint32_t header = (0xBBFF << 16) | last_word_size;
+  const uint32_t packet_number = 1;
+  std::memcpy(&ms.content[0], &header, sizeof(header));
+  std::memcpy(&ms.content[4], &packet_number, sizeof(packet_number));
+}
+
+TestMicroslice flib_microslice(size_t words, uint8_t last_word_size) {
+  TestMicroslice ms(fles::SubsystemFormatFLES::FlibPattern,
+                    words * 8 + last_word_size);
+  store_header(ms, last_word_size);
+  for (size_t i = 1; i < words; ++i) {
+    store_word(ms.content, i * 8, 0xABCD000000000000 + i - 1);
+  }
+  std::memset(&ms.content[words * 8], 0xFA, last_word_size);
+  return ms;
+}
+
+TestMicroslice flim_microslice(size_t words256, uint8_t last_word_size) {
+  TestMicroslice ms(fles::SubsystemFormatFLES::FlimPattern,
+                    words256 * 32 + last_word_size);
+  store_header(ms, last_word_size);
+  store_word(ms.content, 8, ms.desc.idx);
+  for (size_t i = 2; i < words256 * 4; ++i) {
+    store_word(ms.content, i * 8, 0xABCD000000000000 + i - 2);
+  }
+  for (size_t i = 0; i < last_word_size; ++i) {
+    ms.content[words256 * 32 + i] = static_cast<uint8_t>(0xA0 + i);
+  }
+  return ms;
+}
+
+// Check a microslice with each supported instruction set, verify the CRC
+bool check_all_levels(TestMicroslice& ms) {
+  const SimdLevel previous_level = simd_level();
+  const uint32_t expected_crc = crc32c(ms.content.data(), ms.content.size());
+  bool first = true;
+  bool result = false;
+  for (auto level : all_levels) {
+    if (!simd_level_supported(level)) {
+      continue;
+    }
+    BOOST_TEST_CONTEXT("level: " << to_string(level)) {
+      set_simd_level(level);
+      auto checker = PatternChecker::create(ms.desc.sys_id, ms.desc.sys_ver);
+      auto view = ms.view();
+      uint32_t crc = 0;
+      const bool ok = checker->check_with_crc(view, crc);
+      BOOST_CHECK_EQUAL(crc, expected_crc);
+      checker->reset();
+      BOOST_CHECK_EQUAL(checker->check(view), ok);
+      if (!first) {
+        BOOST_CHECK_EQUAL(ok, result);
+      }
+      result = ok;
+      first = false;
+    }
+  }
+  set_simd_level(previous_level);
+  return result;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_crc32c) {
+  const char check[] = "123456789";
+  BOOST_CHECK_EQUAL(crc32c(check, 9), 0xE3069283);
+  BOOST_CHECK_EQUAL(crc32c(check, 0), 0);
+
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+  const uint32_t full = crc32c(data.data(), data.size());
+  for (size_t split : {0, 1, 7, 8, 333, 999, 1000}) {
+    const uint32_t head = crc32c(data.data(), split);
+    BOOST_CHECK_EQUAL(crc32c(data.data() + split, data.size() - split, head),
+                      full);
+  }
+
+  // Content wrapping around the end of a ring buffer
+  std::vector<uint8_t> ring(data.size());
+  const size_t begin = 900;
+  for (size_t i = 0; i < ring.size(); ++i) {
+    ring[(begin + i) % ring.size()] = data[i];
+  }
+  for (size_t size : {0, 50, 100, 101, 1000}) {
+    BOOST_CHECK_EQUAL(crc32c_ring(ring.data(), ring.size(), begin, size),
+                      crc32c(data.data(), size));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_crc32c_engines) {
+  std::vector<uint8_t> data(20000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 131 + (i >> 8));
+  }
+
+  // sizes around the block sizes of the engines, unaligned data
+  for (size_t offset : {0, 1, 5}) {
+    for (size_t size = 0; size < data.size() - offset;
+         size += size < 1100 ? 1 : 997) {
+      for (uint32_t initial : {0U, 0x12345678U}) {
+        const uint8_t* p = data.data() + offset;
+        const uint32_t reference =
+            crc32c(Crc32cEngine::software, p, size, initial);
+        for (auto engine : {Crc32cEngine::crc32, Crc32cEngine::pclmul,
+                            Crc32cEngine::vpclmul}) {
+          if (!crc32c_engine_supported(engine)) {
+            continue;
+          }
+          BOOST_TEST_CONTEXT("engine: " << to_string(engine) << ", offset: "
+                                        << offset << ", size: " << size) {
+            BOOST_CHECK_EQUAL(crc32c(engine, p, size, initial), reference);
+          }
+        }
+      }
+    }
+  }
+
+  BOOST_CHECK(crc32c_engine_from_string("pclmul") == Crc32cEngine::pclmul);
+  BOOST_CHECK(!crc32c_engine_from_string("crc64"));
+  BOOST_CHECK(crc32c_engine_supported(crc32c_engine()));
+}
+
+BOOST_AUTO_TEST_CASE(test_check_ramp) {
+  std::vector<uint8_t> buffer(8 * 2100 + 1);
+  const uint64_t first = 0x1234000000000000;
+  const uint64_t step = 8;
+
+  // unaligned data, counts around the vector widths and block size
+  for (size_t offset : {0, 1}) {
+    uint8_t* data = buffer.data() + offset;
+    for (size_t count : {0, 1, 3, 4, 7, 8, 9, 511, 512, 513, 2100}) {
+      for (size_t i = 0; i < count; ++i) {
+        const uint64_t word = first + i * step;
+        std::memcpy(data + i * 8, &word, sizeof(word));
+      }
+      for (size_t error : {count, count / 2, count - 1}) {
+        if (error > count) {
+          continue; // count - 1 for count == 0
+        }
+        if (error < count) {
+          data[error * 8 + 3] ^= 0x10;
+        }
+        uint32_t reference_crc = 0;
+        const auto reference = check_ramp(SimdLevel::scalar, data, count, first,
+                                          step, &reference_crc);
+        BOOST_TEST_CONTEXT("offset: " << offset << ", count: " << count
+                                      << ", error: " << error) {
+          BOOST_CHECK_EQUAL(reference.mismatch, error);
+          BOOST_CHECK_EQUAL(reference_crc, crc32c(data, count * 8));
+          for (auto level : all_levels) {
+            if (!simd_level_supported(level)) {
+              continue;
+            }
+            uint32_t crc = 0;
+            const auto result =
+                check_ramp(level, data, count, first, step, &crc);
+            BOOST_CHECK_EQUAL(result.mismatch, reference.mismatch);
+            BOOST_CHECK_EQUAL(result.xor_all, reference.xor_all);
+            BOOST_CHECK_EQUAL(crc, reference_crc);
+          }
+        }
+        if (error < count) {
+          data[error * 8 + 3] ^= 0x10;
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_flesnet_pattern) {
+  for (size_t words : {1, 5, 1000}) {
+    auto ms = flesnet_microslice(words);
+    BOOST_CHECK(check_all_levels(ms));
+    ms.content[(words - 1) * 8] ^= 1;
+    BOOST_CHECK(!check_all_levels(ms));
+  }
+  // a wrong descriptor CRC is a pattern error
+  auto ms = flesnet_microslice(100);
+  ms.desc.crc ^= 1;
+  BOOST_CHECK(!check_all_levels(ms));
+}
+
+BOOST_AUTO_TEST_CASE(test_flesnet_pattern_crc) {
+  FlesnetPatternCrc pattern_crc(3, 100);
+  // sizes within and beyond the precomputed range
+  for (size_t words : {0, 1, 12, 13, 200, 50}) {
+    auto ms = flesnet_microslice(words);
+    BOOST_CHECK_EQUAL(pattern_crc.crc(words * 8),
+                      crc32c(ms.content.data(), ms.content.size()));
+  }
+
+  // with a real CRC, the pseudo-CRC is not checked
+  auto ms = flesnet_microslice(100);
+  ms.desc.flags |= static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid);
+  ms.desc.crc = pattern_crc.crc(800);
+  BOOST_CHECK(check_all_levels(ms));
+  ms.content[8] ^= 1;
+  BOOST_CHECK(!check_all_levels(ms));
+}
+
+BOOST_AUTO_TEST_CASE(test_flib_pattern) {
+  for (size_t words : {2, 3, 1000}) {
+    for (uint8_t last_word_size : {0, 1, 5}) {
+      BOOST_TEST_CONTEXT("words: " << words << ", last word size: "
+                                   << int(last_word_size)) {
+        auto ms = flib_microslice(words, last_word_size);
+        BOOST_CHECK(check_all_levels(ms));
+        ms.content[words * 4] ^= 1;
+        BOOST_CHECK(!check_all_levels(ms));
+        ms.content[words * 4] ^= 1;
+        ms.content[2] ^= 1;
+        BOOST_CHECK(!check_all_levels(ms));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_flim_pattern) {
+  for (size_t words256 : {1, 2, 100}) {
+    for (uint8_t last_word_size : {1, 16, 31}) {
+      BOOST_TEST_CONTEXT("words256: " << words256 << ", last word size: "
+                                      << int(last_word_size)) {
+        auto ms = flim_microslice(words256, last_word_size);
+        BOOST_CHECK(check_all_levels(ms));
+        ms.content[words256 * 32 - 1] ^= 1;
+        BOOST_CHECK(!check_all_levels(ms));
+        ms.content[words256 * 32 - 1] ^= 1;
+        ms.content[words256 * 32 + last_word_size - 1] ^= 1;
+        BOOST_CHECK(!check_all_levels(ms));
+      }
+    }
+  }
+}
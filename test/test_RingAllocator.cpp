@@ -0,0 +1,123 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_RingAllocator
+#include <boost/test/unit_test.hpp>
+
+#include "RingAllocator.hpp"
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(fifo_test) {
+  RingAllocator allocator(100);
+
+  auto a = allocator.allocate(40);
+  auto b = allocator.allocate(40);
+  BOOST_REQUIRE(a && b);
+  BOOST_CHECK_EQUAL(a->offset, 0);
+  BOOST_CHECK_EQUAL(b->offset, 40);
+  BOOST_CHECK(!allocator.allocate(40));
+
+  // The region at the end of the buffer is skipped
+  allocator.release(*a);
+  auto c = allocator.allocate(30);
+  BOOST_REQUIRE(c);
+  BOOST_CHECK_EQUAL(c->offset, 0);
+  BOOST_CHECK_EQUAL(allocator.statistics().padding_bytes, 20);
+
+  allocator.release(*b);
+  allocator.release(*c);
+  auto stats = allocator.statistics();
+  BOOST_CHECK_EQUAL(stats.allocation_count, 3);
+  BOOST_CHECK_EQUAL(stats.failure_count, 1);
+  BOOST_CHECK_EQUAL(stats.used_bytes, 0);
+  BOOST_CHECK_EQUAL(stats.padding_bytes, 0);
+
+  // An empty buffer starts over at offset 0
+  auto d = allocator.allocate(100);
+  BOOST_REQUIRE(d);
+  BOOST_CHECK_EQUAL(d->offset, 0);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_order_release_test) {
+  RingAllocator allocator(100);
+
+  auto a = allocator.allocate(30);
+  auto b = allocator.allocate(30);
+  auto c = allocator.allocate(30);
+  BOOST_REQUIRE(a && b && c);
+
+  // Space of b cannot be reused before a is released
+  allocator.release(*b);
+  auto stats = allocator.statistics();
+  BOOST_CHECK_EQUAL(stats.live_bytes, 60);
+  BOOST_CHECK_EQUAL(stats.blocked_bytes, 30);
+  BOOST_CHECK_EQUAL(allocator.live_count(), 2);
+  BOOST_CHECK(!allocator.allocate(20));
+  BOOST_CHECK_EQUAL(allocator.statistics().fragmentation_failure_count, 1);
+  BOOST_CHECK_GT(allocator.fragmentation(), 0.0);
+
+  allocator.release(*a);
+  stats = allocator.statistics();
+  BOOST_CHECK_EQUAL(stats.blocked_bytes, 0);
+  BOOST_CHECK_EQUAL(stats.used_bytes, 30);
+  auto d = allocator.allocate(60);
+  BOOST_REQUIRE(d);
+  BOOST_CHECK_EQUAL(d->offset, 0);
+  // The remaining free space is the padding at the end, which is not usable
+  BOOST_CHECK_EQUAL(allocator.statistics().padding_bytes, 10);
+  BOOST_CHECK_EQUAL(allocator.fragmentation(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(zero_size_test) {
+  RingAllocator allocator(10);
+  auto a = allocator.allocate(0);
+  BOOST_REQUIRE(a);
+  BOOST_CHECK_EQUAL(a->size, 0);
+  allocator.release(*a);
+  BOOST_CHECK(!allocator.allocate(11));
+  BOOST_CHECK_EQUAL(allocator.statistics().allocation_count, 0);
+}
+
+// Allocate and release randomly sized regions mostly in order, and check that
+// live regions never overlap
+BOOST_AUTO_TEST_CASE(random_test) {
+  constexpr std::size_t capacity = 10000;
+  RingAllocator allocator(capacity);
+  std::vector<uint64_t> owner(capacity, 0);
+  std::deque<RingAllocator::Allocation> live;
+
+  std::mt19937 engine(1);
+  std::uniform_int_distribution<std::size_t> size(1, 1500);
+  std::uniform_int_distribution<int> percent(0, 99);
+  for (int i = 0; i < 100000; ++i) {
+    if (auto a = allocator.allocate(size(engine))) {
+      BOOST_REQUIRE_LE(a->offset + a->size, capacity);
+      for (std::size_t n = a->offset; n < a->offset + a->size; ++n) {
+        BOOST_REQUIRE_EQUAL(owner[n], 0);
+        owner[n] = a->id + 1;
+      }
+      live.push_back(*a);
+    }
+    if (!live.empty() && percent(engine) < 50) {
+      // Usually release the oldest region, sometimes a newer one
+      std::size_t pos = 0;
+      if (percent(engine) < 20) {
+        pos = std::uniform_int_distribution<std::size_t>(0, live.size() - 1)(
+            engine);
+      }
+      auto a = live[pos];
+      live.erase(live.begin() + static_cast<std::ptrdiff_t>(pos));
+      for (std::size_t n = a.offset; n < a.offset + a.size; ++n) {
+        owner[n] = 0;
+      }
+      allocator.release(a);
+    }
+    BOOST_REQUIRE_EQUAL(allocator.live_count(), live.size());
+  }
+  auto stats = allocator.statistics();
+  BOOST_CHECK_GT(stats.allocation_count, 0);
+  BOOST_CHECK_LE(stats.fragmentation_failure_count, stats.failure_count);
+  BOOST_CHECK_LE(stats.live_bytes + stats.blocked_bytes + stats.padding_bytes,
+                 capacity);
+}
@@ -0,0 +1,108 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_Scheduler
+#include <boost/test/unit_test.hpp>
+
+#include "Scheduler.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+void run_until_empty(Scheduler& scheduler) {
+  while (!scheduler.empty()) {
+    std::this_thread::sleep_until(scheduler.when_next());
+    scheduler.timer();
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(order_test) {
+  Scheduler scheduler;
+  std::vector<int> fired;
+  auto now = Scheduler::clock::now();
+  scheduler.add([&fired] { fired.push_back(3); }, now + 30ms);
+  scheduler.add([&fired] { fired.push_back(1); }, now + 10ms);
+  scheduler.add([&fired] { fired.push_back(2); }, now + 20ms);
+  scheduler.add([&fired] { fired.push_back(0); }, now - 1s);
+  BOOST_CHECK_EQUAL(scheduler.size(), 4);
+
+  std::this_thread::sleep_until(now + 5ms);
+  scheduler.timer();
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK(scheduler.when_next() >= now + 10ms);
+
+  run_until_empty(scheduler);
+  BOOST_CHECK(fired == std::vector<int>({0, 1, 2, 3}));
+  BOOST_CHECK(Scheduler::clock::now() >= now + 30ms);
+  BOOST_CHECK(scheduler.when_next() == Scheduler::time_type::max());
+}
+
+BOOST_AUTO_TEST_CASE(cancel_test) {
+  Scheduler scheduler;
+  int fired = 0;
+  auto now = Scheduler::clock::now();
+  auto a = scheduler.add([&fired] { fired += 1; }, now + 5ms);
+  auto b = scheduler.add([&fired] { fired += 10; }, now + 5ms);
+  BOOST_CHECK(scheduler.cancel(a));
+  BOOST_CHECK(!a.valid());
+  BOOST_CHECK(!scheduler.cancel(a));
+  BOOST_CHECK_EQUAL(scheduler.size(), 1);
+
+  run_until_empty(scheduler);
+  BOOST_CHECK_EQUAL(fired, 10);
+  // Handles of executed events are stale, even if the node is reused
+  scheduler.add([&fired] { fired += 100; }, now);
+  BOOST_CHECK(!scheduler.cancel(b));
+  run_until_empty(scheduler);
+  BOOST_CHECK_EQUAL(fired, 110);
+}
+
+// Callbacks may add and cancel events, including those due in the same tick
+BOOST_AUTO_TEST_CASE(reentrant_test) {
+  Scheduler scheduler;
+  int periodic = 0;
+  bool cancelled_fired = false;
+  Scheduler::Handle victim;
+  auto now = Scheduler::clock::now();
+
+  struct Periodic {
+    Scheduler* scheduler;
+    int* count;
+    void operator()() const {
+      if (++*count < 5) {
+        scheduler->add(*this, Scheduler::clock::now() + 2ms);
+      }
+    }
+  };
+  scheduler.add(Periodic{&scheduler, &periodic}, now);
+  scheduler.add([&] { scheduler.cancel(victim); }, now + 3ms);
+  victim = scheduler.add([&] { cancelled_fired = true; }, now + 3ms);
+
+  run_until_empty(scheduler);
+  BOOST_CHECK_EQUAL(periodic, 5);
+  BOOST_CHECK(!cancelled_fired);
+}
+
+// Events more than one revolution ahead must not fire early
+BOOST_AUTO_TEST_CASE(revolution_test) {
+  Scheduler scheduler(1ms, 8);
+  bool near_fired = false;
+  bool far_fired = false;
+  auto now = Scheduler::clock::now();
+  scheduler.add([&] { near_fired = true; }, now + 2ms);
+  scheduler.add([&] { far_fired = true; }, now + 2ms + 8 * 1ms * 3);
+
+  std::this_thread::sleep_until(now + 5ms);
+  scheduler.timer();
+  BOOST_CHECK(near_fired);
+  BOOST_CHECK(!far_fired);
+  BOOST_CHECK(scheduler.when_next() >= now + 26ms);
+
+  run_until_empty(scheduler);
+  BOOST_CHECK(far_fired);
+  BOOST_CHECK(Scheduler::clock::now() >= now + 26ms);
+}
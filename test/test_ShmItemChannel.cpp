@@ -0,0 +1,206 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_ShmItemChannel
+#include <boost/test/unit_test.hpp>
+
+#include "ShmItemProducer.hpp"
+#include "ShmItemWorker.hpp"
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct SharedMemory {
+  SharedMemory()
+      : name("test_ShmItemChannel_" + std::to_string(getpid())),
+        shm((boost::interprocess::shared_memory_object::remove(name.c_str()),
+             boost::interprocess::create_only),
+            name.c_str(),
+            1 << 20) {}
+  ~SharedMemory() {
+    boost::interprocess::shared_memory_object::remove(name.c_str());
+  }
+  std::string name;
+  boost::interprocess::managed_shared_memory shm;
+};
+
+// Poll for a completion, as the timeslice builder does
+ItemID wait_for_completion(ShmItemProducer& producer) {
+  ItemID id{};
+  while (!producer.try_receive_completion(&id)) {
+    std::this_thread::yield();
+  }
+  return id;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(transfer_test) {
+  SharedMemory s;
+  ShmItemProducer producer(s.shm);
+  auto worker = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{1, 0, WorkerQueuePolicy::QueueAll, 0, "all"});
+
+  // Boost.Test is not thread-safe, so the worker thread only records results
+  constexpr ItemID count = 1000;
+  bool received_all = true;
+  std::thread worker_thread([&worker, &received_all] {
+    for (ItemID i = 0; i < count; ++i) {
+      auto item = worker->get();
+      received_all = received_all && item && item->id() == i &&
+                     item->payload() == "payload " + std::to_string(i);
+    }
+  });
+
+  for (ItemID i = 0; i < count; ++i) {
+    producer.send_work_item(i, "payload " + std::to_string(i));
+  }
+  // The completion of an item is passed on with the next call to get()
+  for (ItemID i = 0; i < count - 1; ++i) {
+    BOOST_CHECK_EQUAL(wait_for_completion(producer), i);
+  }
+  worker_thread.join();
+  BOOST_CHECK(received_all);
+  worker = nullptr;
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), count - 1);
+}
+
+BOOST_AUTO_TEST_CASE(skip_test) {
+  SharedMemory s;
+  ShmItemProducer producer(s.shm);
+  auto worker = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{2, 1, WorkerQueuePolicy::Skip, 0, "odd"});
+
+  // Items not wanted by any worker are completed right away
+  producer.send_work_item(0, "");
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 0);
+
+  producer.send_work_item(1, "");
+  auto item = worker->get();
+  BOOST_REQUIRE(item);
+  BOOST_CHECK_EQUAL(item->id(), 1);
+  ItemID id{};
+  BOOST_CHECK(!producer.try_receive_completion(&id));
+
+  // The worker is busy, so the next odd item is skipped
+  producer.send_work_item(2, "");
+  producer.send_work_item(3, "");
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 2);
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 3);
+
+  // Items outstanding at a disconnected worker are released
+  item = nullptr;
+  worker = nullptr;
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 1);
+}
+
+BOOST_AUTO_TEST_CASE(queue_test) {
+  SharedMemory s;
+  ShmItemProducer producer(s.shm);
+  auto worker = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{1, 0, WorkerQueuePolicy::PrebufferOne, 0, "w"});
+
+  producer.send_work_item(0, "");
+  producer.send_work_item(1, "");
+  producer.send_work_item(2, "");
+  // Only the newest item is kept while the worker is busy
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 1);
+
+  std::vector<ItemID> received;
+  std::thread worker_thread([&worker, &received] {
+    for (int i = 0; i < 2; ++i) {
+      if (auto item = worker->get()) {
+        received.push_back(item->id());
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 0);
+  worker_thread.join();
+  BOOST_CHECK(received == std::vector<ItemID>({0, 2}));
+  worker = nullptr;
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 2);
+}
+
+BOOST_AUTO_TEST_CASE(evict_test) {
+  SharedMemory s;
+  ShmItemProducer producer(s.shm);
+  auto* channel = s.shm.find<ShmItemChannel>(shm_item_channel_name).first;
+  BOOST_REQUIRE(channel);
+  auto evicted = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{1, 0, WorkerQueuePolicy::QueueAll, 0, "a"});
+  ItemID id{};
+  BOOST_CHECK(!producer.try_receive_completion(&id));
+
+  // A completion for an item that was never sent is a protocol violation
+  BOOST_REQUIRE(channel->slots[0].completions.try_push(42));
+  BOOST_CHECK(!producer.try_receive_completion(&id));
+  BOOST_CHECK(channel->slots[0].state == ShmWorkerSlotState::Evicted);
+
+  // The slot is not reused while the evicted worker may still access it
+  auto next = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{1, 0, WorkerQueuePolicy::QueueAll, 0, "b"});
+  BOOST_CHECK(channel->slots[1].state == ShmWorkerSlotState::Active);
+
+  // The evicted worker leaves its slot on the next call and registers again
+  bool received = false;
+  std::thread worker_thread([&evicted, &received] {
+    auto item = evicted->get();
+    received = item && item->id() == 0 && item->payload() == "payload";
+  });
+  while (channel->slots[2].state.load() != ShmWorkerSlotState::Active) {
+    std::this_thread::yield();
+  }
+  BOOST_CHECK(channel->slots[0].state == ShmWorkerSlotState::Closing);
+
+  // Both workers receive the next item through their own slots
+  producer.send_work_item(0, "payload");
+  BOOST_CHECK(channel->slots[0].state == ShmWorkerSlotState::Free);
+  auto item = next->get();
+  BOOST_REQUIRE(item);
+  BOOST_CHECK_EQUAL(item->id(), 0);
+  BOOST_CHECK_EQUAL(item->payload(), "payload");
+  worker_thread.join();
+  BOOST_CHECK(received);
+
+  item = nullptr;
+  next = nullptr;
+  evicted = nullptr;
+  BOOST_CHECK_EQUAL(wait_for_completion(producer), 0);
+}
+
+BOOST_AUTO_TEST_CASE(terminated_test) {
+  SharedMemory s;
+  ShmItemProducer producer(s.shm);
+  auto* channel = s.shm.find<ShmItemChannel>(shm_item_channel_name).first;
+  BOOST_REQUIRE(channel);
+
+  // Obtain the process ID of a terminated process
+  const pid_t child = fork();
+  BOOST_REQUIRE(child >= 0);
+  if (child == 0) {
+    _exit(0);
+  }
+  BOOST_REQUIRE_EQUAL(waitpid(child, nullptr, 0), child);
+
+  // A worker that terminated during registration, and one that terminated
+  // after claiming a free slot
+  channel->slots[0].pid = child;
+  channel->slots[0].state = ShmWorkerSlotState::Registering;
+  channel->slots[1].pid = child;
+
+  std::this_thread::sleep_for(shm_item_channel_check_interval * 2);
+  ItemID id{};
+  BOOST_CHECK(!producer.try_receive_completion(&id));
+  BOOST_CHECK(channel->slots[0].state == ShmWorkerSlotState::Free);
+  BOOST_CHECK_EQUAL(channel->slots[0].pid.load(), 0);
+  BOOST_CHECK_EQUAL(channel->slots[1].pid.load(), 0);
+
+  // The slot is available to the next worker
+  auto worker = std::make_unique<ShmItemWorker>(
+      s.name, WorkerParameters{1, 0, WorkerQueuePolicy::QueueAll, 0, "a"});
+  BOOST_CHECK(channel->slots[0].state == ShmWorkerSlotState::Active);
+  BOOST_CHECK_EQUAL(channel->slots[0].pid.load(), getpid());
+}
@@ -0,0 +1,79 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_SpscQueue
+#include <boost/test/unit_test.hpp>
+
+#include "SpscQueue.hpp"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(capacity_test) {
+  SpscQueue<int> q(5);
+  BOOST_CHECK_EQUAL(q.capacity(), 8);
+  BOOST_CHECK_EQUAL(q.size(), 0);
+  BOOST_CHECK(q.front() == nullptr);
+
+  for (int i = 0; i < 8; ++i) {
+    BOOST_CHECK(q.try_push(i));
+  }
+  BOOST_CHECK(!q.try_push(8));
+  BOOST_CHECK(q.back() == nullptr);
+  BOOST_CHECK_EQUAL(q.size(), 8);
+
+  int value = -1;
+  BOOST_CHECK(q.try_pop(value));
+  BOOST_CHECK_EQUAL(value, 0);
+  BOOST_CHECK(q.try_push(8));
+  for (int i = 1; i <= 8; ++i) {
+    BOOST_REQUIRE(q.try_pop(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+  BOOST_CHECK(!q.try_pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(slot_reuse_test) {
+  SpscQueue<std::vector<int>> q(2);
+  std::vector<int> v(100, 1);
+
+  // Fill a slot in place, so that its memory is kept when it is reused
+  for (int round = 0; round < 4; ++round) {
+    std::vector<int>* slot = q.back();
+    BOOST_REQUIRE(slot != nullptr);
+    *slot = v;
+    q.push();
+    std::vector<int>* item = q.front();
+    BOOST_REQUIRE(item != nullptr);
+    BOOST_CHECK(*item == v);
+    q.pop();
+  }
+  BOOST_CHECK_GE(q.back()->capacity(), v.size());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test) {
+  constexpr uint64_t count = 1000000;
+  SpscQueue<uint64_t> q(64);
+
+  std::thread producer([&q] {
+    for (uint64_t i = 0; i < count; ++i) {
+      while (!q.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 0;
+  bool in_order = true;
+  while (expected < count) {
+    uint64_t value = 0;
+    if (q.try_pop(value)) {
+      in_order = in_order && (value == expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK(in_order);
+  BOOST_CHECK_EQUAL(q.size(), 0);
+}
@@ -0,0 +1,98 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_TimesliceAnalyzer
+#include <boost/test/unit_test.hpp>
+
+#include "MicrosliceDescriptor.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceAnalyzer.hpp"
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t num_components = 7;
+constexpr size_t num_microslices = 5;
+
+// Create a timeslice, optionally with errors scattered across the components
+std::shared_ptr<fles::StorableTimeslice> make_timeslice(uint64_t index,
+                                                        bool with_errors) {
+  auto ts = std::make_shared<fles::StorableTimeslice>(num_microslices, index);
+  std::vector<uint8_t> content(64);
+  for (size_t c = 0; c < num_components; ++c) {
+    ts->append_component(num_microslices, index);
+    for (size_t m = 0; m < num_microslices; ++m) {
+      fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+      desc.hdr_id =
+          static_cast<uint8_t>(fles::HeaderFormatIdentifier::Standard);
+      desc.hdr_ver = static_cast<uint8_t>(fles::HeaderFormatVersion::Standard);
+      desc.eq_id = static_cast<uint16_t>(0x1000 + c);
+      desc.sys_id = static_cast<uint8_t>(fles::Subsystem::FLES);
+      desc.sys_ver =
+          static_cast<uint8_t>(fles::SubsystemFormatFLES::Uninitialized);
+      desc.idx = (index * num_microslices + m) * 100;
+      desc.size = static_cast<uint32_t>(content.size());
+
+      const uint64_t n = index * 31 + c * 7 + m;
+      if (with_errors && n % 13 == 0) {
+        desc.hdr_id = 0;
+      }
+      if (with_errors && n % 17 == 0) {
+        desc.flags |= static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid);
+        desc.crc = 0xdeadbeef;
+      }
+      if (with_errors && n % 19 == 0) {
+        ++desc.eq_id;
+      }
+      if (with_errors && n % 23 == 0) {
+        desc.idx += 1;
+      }
+      for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<uint8_t>(n + i);
+      }
+      ts->append_microslice(static_cast<uint32_t>(c), m, desc,
+                            content.data());
+    }
+  }
+  return ts;
+}
+
+// Analyze a sequence of timeslices, return the status and histogram output
+std::pair<std::string, std::string>
+analyze(size_t num_threads, size_t num_timeslices, bool with_errors) {
+  std::ostringstream out;
+  std::ostringstream hist;
+  {
+    TimesliceAnalyzer analyzer(1, out, "", &hist, nullptr, num_threads);
+    for (size_t i = 0; i < num_timeslices; ++i) {
+      analyzer.put(make_timeslice(i, with_errors && i > 0));
+    }
+  }
+  return {out.str(), hist.str()};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_no_errors) {
+  auto [out, hist] = analyze(4, 10, false);
+  BOOST_CHECK(out.find("error") == std::string::npos);
+  BOOST_CHECK(out.find("checked 10 ts, 70 c, 350 m") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_output_matches_sequential) {
+  const auto reference = analyze(1, 20, true);
+  BOOST_CHECK(reference.first.find("error in ts1/c") != std::string::npos);
+  BOOST_CHECK(reference.first.find("[with errors:") != std::string::npos);
+  BOOST_CHECK(!reference.second.empty());
+
+  for (size_t num_threads : {2, 3, 8}) {
+    BOOST_TEST_CONTEXT("threads: " << num_threads) {
+      const auto result = analyze(num_threads, 20, true);
+      BOOST_CHECK(result.first == reference.first);
+      BOOST_CHECK(result.second == reference.second);
+    }
+  }
+}
@@ -41,6 +41,29 @@ BOOST_AUTO_TEST_CASE(merging_input_archive_test) {
   BOOST_CHECK_EQUAL(count, 8);
 }
 
+BOOST_AUTO_TEST_CASE(mapped_input_archive_test) {
+  fles::TimesliceAutoSource source("file://test3.tsa?mmap=1");
+  uint64_t count = 0;
+  std::unique_ptr<fles::Timeslice> last;
+  while (auto timeslice = source.get()) {
+    last = std::move(timeslice);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 6);
+  BOOST_REQUIRE(last);
+  BOOST_CHECK_EQUAL(last->num_components(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(prefetching_input_archive_test) {
+  fles::TimesliceAutoSource source("file://test2_%n.tsa?prefetch=2");
+  uint64_t count = 0;
+  while (auto timeslice = source.get()) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 6);
+  BOOST_CHECK(source.eos());
+}
+
 BOOST_AUTO_TEST_CASE(invalid_input_archive_test) {
   std::string filename("./example1.msa");
   BOOST_CHECK_THROW(fles::TimesliceAutoSource source(filename),
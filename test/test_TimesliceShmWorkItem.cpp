@@ -0,0 +1,91 @@
+// Copyright 2025 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_TimesliceShmWorkItem
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceShmWorkItemEncoding.hpp"
+#include <boost/uuid/random_generator.hpp>
+
+namespace {
+
+fles::TimesliceShmWorkItem make_item(uint32_t num_components) {
+  fles::TimesliceShmWorkItem item{};
+  item.shm_uuid = boost::uuids::random_generator()();
+  item.shm_identifier = "flesnet_ts_builder";
+  item.ts_desc.index = 42;
+  item.ts_desc.start_time = 12800000;
+  item.ts_desc.duration = 128000;
+  item.ts_desc.flags = 3;
+  item.ts_desc.num_components = num_components;
+  for (uint32_t c = 0; c < num_components; ++c) {
+    item.data.push_back(4096 * (c + 1));
+    item.tsc_desc.push_back({42, 0, 1000 + c, 10 + c, c});
+  }
+  return item;
+}
+
+void check_equal(const fles::TimesliceShmWorkItem& a,
+                 const fles::TimesliceShmWorkItem& b) {
+  BOOST_CHECK(a.shm_uuid == b.shm_uuid);
+  BOOST_CHECK_EQUAL(a.shm_identifier, b.shm_identifier);
+  BOOST_CHECK_EQUAL(a.ts_desc.index, b.ts_desc.index);
+  BOOST_CHECK_EQUAL(a.ts_desc.start_time, b.ts_desc.start_time);
+  BOOST_CHECK_EQUAL(a.ts_desc.duration, b.ts_desc.duration);
+  BOOST_CHECK_EQUAL(a.ts_desc.flags, b.ts_desc.flags);
+  BOOST_CHECK_EQUAL(a.ts_desc.num_components, b.ts_desc.num_components);
+  BOOST_CHECK(a.data == b.data);
+  BOOST_REQUIRE_EQUAL(a.tsc_desc.size(), b.tsc_desc.size());
+  for (std::size_t c = 0; c < a.tsc_desc.size(); ++c) {
+    BOOST_CHECK_EQUAL(a.tsc_desc[c].size, b.tsc_desc[c].size);
+    BOOST_CHECK_EQUAL(a.tsc_desc[c].num_microslices,
+                      b.tsc_desc[c].num_microslices);
+    BOOST_CHECK_EQUAL(a.tsc_desc[c].flags, b.tsc_desc[c].flags);
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(binary_test) {
+  const auto item = make_item(5);
+  const std::string payload = fles::encode_work_item_binary(item);
+
+  auto ref = fles::TimesliceShmWorkItemRef::parse(payload);
+  BOOST_REQUIRE(ref);
+  BOOST_CHECK(ref->shm_uuid() == item.shm_uuid);
+  BOOST_CHECK_EQUAL(ref->shm_identifier(), item.shm_identifier);
+  BOOST_CHECK_EQUAL(ref->ts_desc().index, 42);
+  BOOST_REQUIRE_EQUAL(ref->num_components(), 5);
+  BOOST_CHECK_EQUAL(ref->data(4), item.data[4]);
+  BOOST_CHECK_EQUAL(ref->tsc_desc(4)->size, 1004);
+  // The descriptors are accessed in place
+  BOOST_CHECK_GE(reinterpret_cast<const char*>(ref->tsc_desc(0)),
+                 payload.data());
+  BOOST_CHECK_LT(reinterpret_cast<const char*>(ref->tsc_desc(4)),
+                 payload.data() + payload.size());
+
+  check_equal(fles::decode_work_item(payload), item);
+}
+
+BOOST_AUTO_TEST_CASE(boost_fallback_test) {
+  const auto item = make_item(3);
+  const std::string payload = fles::encode_work_item_boost(item);
+
+  BOOST_CHECK(!fles::TimesliceShmWorkItemRef::parse(payload));
+  check_equal(fles::decode_work_item(payload), item);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_test) {
+  const std::string payload = fles::encode_work_item_binary(make_item(2));
+
+  BOOST_CHECK(!fles::TimesliceShmWorkItemRef::parse(""));
+  BOOST_CHECK(!fles::TimesliceShmWorkItemRef::parse(
+      std::string_view(payload).substr(0, payload.size() - 1)));
+  BOOST_CHECK(!fles::TimesliceShmWorkItemRef::parse(payload + "x"));
+  BOOST_CHECK_THROW(
+      fles::decode_work_item(std::string_view(payload).substr(0, 50)),
+      std::exception);
+
+  auto item = make_item(2);
+  item.tsc_desc.clear(); // legacy descriptor handles only
+  BOOST_CHECK_THROW(fles::encode_work_item_binary(item),
+                    std::invalid_argument);
+}